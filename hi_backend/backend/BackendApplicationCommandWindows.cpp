@@ -531,6 +531,7 @@ public:
 		selectors->setInfoTextForLastComponent(WavetableHelp::WindowType());
 		selectors->addComboBox("FFTSize", sizes, "FFT Size");
 		selectors->setInfoTextForLastComponent(WavetableHelp::WindowSize());
+		selectors->addComboBox("Mipmaps", { "None", "2 Octaves", "4 Octaves" }, "Mipmaps", 90);
 
 		selectors->setSize(512, 40);
 		addCustomComponent(selectors);
@@ -692,6 +693,10 @@ public:
 		{
 			converter->reverseOrder = comboBoxThatHasChanged->getSelectedItemIndex() == 0;
 		}
+		else if (comboBoxThatHasChanged->getName() == "Mipmaps")
+		{
+			converter->numMipmapLevels = 2 * comboBoxThatHasChanged->getSelectedItemIndex();
+		}
 		else
 		{
 			if (comboBoxThatHasChanged->getText() == "Lowest possible")
@@ -409,7 +409,7 @@ struct GlobalCableCollection : public SearchableListComponent::Collection,
 
 			if (auto cable = dynamic_cast<scriptnode::routing::GlobalRoutingManager::Cable*>(slot.get()))
 			{
-				g.setColour(c.withAlpha((float)jlimit(0.0, 1.0, cable->lastValue)));
+				g.setColour(c.withAlpha((float)jlimit(0.0, 1.0, cable->getLastValue())));
 				g.fillEllipse(led.reduced(2.0f));
 			}
 
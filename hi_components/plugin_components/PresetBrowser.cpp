@@ -505,6 +505,8 @@ expHandler(mc->getExpansionHandler())
 #endif
 
 	mc->getUserPresetHandler().getTagDataBase().setRootDirectory(rootFile);
+	mc->getUserPresetHandler().getTagDataBase().addChangeListener(this);
+	mc->getUserPresetHandler().getTagDataBase().startPolling();
 
 	loadPresetDatabase(rootFile);
 
@@ -586,6 +588,8 @@ expHandler(mc->getExpansionHandler())
 PresetBrowser::~PresetBrowser()
 {
 	getMainController()->getUserPresetHandler().removeListener(this);
+	getMainController()->getUserPresetHandler().getTagDataBase().removeChangeListener(this);
+	getMainController()->getUserPresetHandler().getTagDataBase().stopPolling();
 
 	if(rootFile.isDirectory())
 		savePresetDatabase(rootFile);
@@ -729,19 +733,33 @@ void PresetBrowser::paint(Graphics& g)
 	getPresetBrowserLookAndFeel().drawPresetBrowserBackground(g, this);
 }
 
-void PresetBrowser::rebuildAllPresets()
+void PresetBrowser::rebuildAllPresets(bool rescanIndex)
 {
+	auto& presetIndex = getMainController()->getUserPresetHandler().getTagDataBase();
+
+	// Picks up the presets that were just saved, renamed or deleted
+	if (rescanIndex)
+		presetIndex.buildDataBase(true);
+
 	allPresets.clear();
-	rootFile.findChildFiles(allPresets, File::findFiles, true, "*.preset");
 
-	for (int i = 0; i < allPresets.size(); i++)
+	MainController::UserPresetHandler::TagDataBase::Query query;
+	query.root = rootFile;
+	query.recursive = true;
+
+	if (!presetIndex.getPresets(query, allPresets))
 	{
-		const bool isNoPresetFile = allPresets[i].isHidden() || allPresets[i].getFileName().startsWith(".") || allPresets[i].getFileExtension() != ".preset";
-		const bool isNoDirectory = !allPresets[i].isDirectory();
+		rootFile.findChildFiles(allPresets, File::findFiles, true, "*.preset");
 
-		if (isNoDirectory && isNoPresetFile)
+		for (int i = 0; i < allPresets.size(); i++)
 		{
-			allPresets.remove(i--);
+			const bool isNoPresetFile = allPresets[i].isHidden() || allPresets[i].getFileName().startsWith(".") || allPresets[i].getFileExtension() != ".preset";
+			const bool isNoDirectory = !allPresets[i].isDirectory();
+
+			if (isNoDirectory && isNoPresetFile)
+			{
+				allPresets.remove(i--);
+			}
 		}
 	}
 
@@ -761,6 +779,15 @@ void PresetBrowser::rebuildAllPresets()
 	}
 }
 
+void PresetBrowser::changeListenerCallback(ChangeBroadcaster* )
+{
+	rebuildAllPresets(false);
+
+	bankColumn->updateContent();
+	categoryColumn->updateContent();
+	presetColumn->updateContent();
+}
+
 String PresetBrowser::getCurrentlyLoadedPresetName()
 {
 	if (currentlyLoadedPreset > 0 && currentlyLoadedPreset < allPresets.size())
@@ -1028,6 +1055,8 @@ void PresetBrowser::loadPresetDatabase(const File& rootDirectory)
 		presetDatabase = d;
 	else
 		presetDatabase = new DynamicObject();
+
+	getMainController()->getUserPresetHandler().getTagDataBase().setFavoriteDataBase(rootDirectory, presetDatabase);
 }
 
 
@@ -59,7 +59,8 @@ class PresetBrowser :			 public Component,
 								 public Label::Listener,
 								 public MainController::UserPresetHandler::Listener,
 								 public TagList::Listener,
-								 public ExpansionHandler::Listener
+								 public ExpansionHandler::Listener,
+								 public ChangeListener
 {
 public:
 
@@ -161,9 +162,13 @@ public:
 	void presetChanged(const File& newPreset) override;
 	void presetListUpdated() override;
 
-	void rebuildAllPresets();
+	/** Rebuilds the preset list. If rescanIndex is true, it will update the preset index first. */
+	void rebuildAllPresets(bool rescanIndex=true);
 	String getCurrentlyLoadedPresetName();
 
+	/** Called when the preset index was updated by its background thread. */
+	void changeListenerCallback(ChangeBroadcaster* b) override;
+
 	void buttonClicked(Button* b) override;
 	void selectionChanged(int columnIndex, int rowIndex, const File& clickedFile, bool doubleClick);
 	void renameEntry(int columnIndex, int rowIndex, const String& newName);
@@ -178,7 +178,7 @@ void TagList::toggleTag(Tag* n)
 
 		PresetBrowser::DataBaseHelpers::writeTagsInXml(currentFile, currentlyActiveTags);
 
-		parent->getMainController()->getUserPresetHandler().getTagDataBase().buildDataBase(true);
+		parent->getMainController()->getUserPresetHandler().getTagDataBase().updatePreset(currentFile);
 
 		for (auto l : listeners)
 		{
@@ -217,6 +217,12 @@ PresetBrowserColumn::ColumnListModel::ColumnListModel(PresetBrowser* p, int inde
 
 int PresetBrowserColumn::ColumnListModel::getNumRows()
 {
+	auto& presetIndex = parent->getMainController()->getUserPresetHandler().getTagDataBase();
+
+	presetIndex.buildDataBase();
+
+	MainController::UserPresetHandler::TagDataBase::Query query;
+
 	if (wildcard.isEmpty() && currentlyActiveTags.isEmpty())
 	{
 		const File& rootToUse = showFavoritesOnly ? totalRoot : root;
@@ -228,6 +234,19 @@ int PresetBrowserColumn::ColumnListModel::getNumRows()
 		}
 
 		entries.clear();
+
+		query.root = rootToUse;
+		query.recursive = allowRecursiveSearch || showFavoritesOnly;
+		query.favoritesOnly = showFavoritesOnly && index == 2;
+		query.expansionFilter = parent->getMainController();
+
+		if (!displayDirectories && presetIndex.getPresets(query, entries))
+		{
+			entries.sort();
+			empty = entries.isEmpty();
+			return entries.size();
+		}
+
 		rootToUse.findChildFiles(entries, displayDirectories ? File::findDirectories : File::findFiles, allowRecursiveSearch || showFavoritesOnly);
 
 		PresetBrowser::DataBaseHelpers::cleanFileList(parent->getMainController(), entries);
@@ -251,9 +270,23 @@ int PresetBrowserColumn::ColumnListModel::getNumRows()
 	else
 	{
 		jassert(index == 2);
+		entries.clear();
+
+		query.root = totalRoot;
+		query.recursive = true;
+		query.wildcard = wildcard;
+		query.tags = currentlyActiveTags;
+		query.favoritesOnly = showFavoritesOnly;
+
+		if (presetIndex.getPresets(query, entries))
+		{
+			entries.sort();
+			empty = entries.isEmpty();
+			return entries.size();
+		}
+
 		Array<File> allFiles;
 		totalRoot.findChildFiles(allFiles, File::findFiles, true);
-		entries.clear();
 
 		for (int i = 0; i < allFiles.size(); i++)
 		{
@@ -261,20 +294,14 @@ int PresetBrowserColumn::ColumnListModel::getNumRows()
 
 			bool matchesTags = currentlyActiveTags.size() == 0;
 
-			auto hash = allFiles[i].hashCode64();
-
 			if (currentlyActiveTags.size() > 0)
 			{
-				const auto& cachedTags = getCachedTags();
+				auto presetTags = PresetBrowser::DataBaseHelpers::getTagsFromXml(allFiles[i]);
 
-				for (auto& t : cachedTags)
-				{
-					if (t.hashCode == hash)
-					{
-						matchesTags = t.shown;
-						break;
-					}
-				}
+				matchesTags = true;
+
+				for (auto t : currentlyActiveTags)
+					matchesTags &= presetTags.contains(t.toString());
 			}
 
 			if (matchesWildcard && matchesTags)
@@ -356,24 +383,6 @@ void PresetBrowserColumn::ColumnListModel::updateTags(const StringArray& newSele
 
 	for (auto s : newSelection)
 		currentlyActiveTags.add(Identifier(s));
-
-	
-
-	auto& cachedTags = parent->getMainController()->getUserPresetHandler().getTagDataBase().getCachedTags();
-
-	for (auto& t : cachedTags)
-	{
-		t.shown = true;
-
-		for (auto st : currentlyActiveTags)
-		{
-			if (!t.tags.contains(st))
-			{
-				t.shown = false;
-				break;
-			}
-		}
-	}
 }
 
 void PresetBrowserColumn::ColumnListModel::paintListBoxItem(int rowNumber, Graphics &g, int width, int height, bool rowIsSelected)
@@ -393,11 +402,6 @@ bool PresetBrowserColumn::ColumnListModel::isMouseHover(int rowIndex) const
 	return p.x == index && p.y == rowIndex;
 }
 
-const juce::Array<PresetBrowserColumn::ColumnListModel::CachedTag>& PresetBrowserColumn::ColumnListModel::getCachedTags() const
-{
-	return parent->getMainController()->getUserPresetHandler().getTagDataBase().getCachedTags();
-}
-
 Component* PresetBrowserColumn::ColumnListModel::refreshComponentForRow(int rowNumber, bool /*isRowSelected*/, Component* existingComponentToUpdate)
 {
 	if (existingComponentToUpdate != nullptr)
@@ -474,6 +478,7 @@ void PresetBrowserColumn::ColumnListModel::FavoriteOverlay::buttonClicked(Button
 	auto f = parent.getFileForIndex(index);
 
 	PresetBrowser::DataBaseHelpers::setFavorite(parent.database, f, newValue);
+	parent.parent->getMainController()->getUserPresetHandler().getTagDataBase().setFavorite(f, newValue);
 
 
 	refreshShape();
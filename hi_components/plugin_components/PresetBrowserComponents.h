@@ -265,8 +265,6 @@ public:
 	{
 	public:
 
-		using CachedTag = MainController::UserPresetHandler::TagDataBase::CachedTag;
-
 		class Listener
 		{
 		public:
@@ -292,8 +290,6 @@ public:
 
 		bool isMouseHover(int rowNumber) const;
 
-		const Array<CachedTag>& getCachedTags() const;
-
 		bool isEmpty() const
 		{
 			return empty;
@@ -408,6 +404,13 @@ public:
 	static File getChildDirectory(File& root, int level, int index);
 	void setNewRootDirectory(const File& newRootDirectory);
 
+	/** Rebuilds the list, eg. after the preset index has changed. */
+	void updateContent()
+	{
+		listbox->updateContent();
+		listbox->repaint();
+	}
+
 	void setShowFavoritesOnly(bool shouldShow)
 	{
 		listModel->setShowFavoritesOnly(shouldShow);
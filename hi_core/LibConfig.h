@@ -64,6 +64,21 @@
 #endif
 #endif
 
+/** Set this to a value > 0 to render the sound generators of the root container on additional threads.
+	
+	The child synths of the root container will be distributed across the audio thread and this amount of worker
+	threads and then summed in a deterministic order. Only enable this if your sound generators don't interact with 
+	each other during rendering (eg. through global script variables). Sound generators that other modules depend on 
+	(eg. the GlobalModulatorContainer, synths with an active choke group or synths with a send effect) will always 
+	be rendered on the audio thread.
+
+	This spreads whole sound generators across the threads. The voices of a single sound generator are always
+	rendered on one thread, so a project with one sound generator will not benefit from this setting.
+*/
+#ifndef HISE_NUM_PARALLEL_SYNTH_THREADS
+#define HISE_NUM_PARALLEL_SYNTH_THREADS 0
+#endif
+
 #ifndef HISE_SMOOTH_FIRST_MOD_BUFFER
 #define HISE_SMOOTH_FIRST_MOD_BUFFER 0
 #endif
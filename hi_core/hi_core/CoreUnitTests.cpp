@@ -0,0 +1,421 @@
+/*  ===========================================================================
+*
+*   This file is part of HISE.
+*   Copyright 2016 Christoph Hart
+*
+*   HISE is free software: you can redistribute it and/or modify
+*   it under the terms of the GNU General Public License as published by
+*   the Free Software Foundation, either version 3 of the License, or
+*   (at your option) any later version.
+*
+*   HISE is distributed in the hope that it will be useful,
+*   but WITHOUT ANY WARRANTY; without even the implied warranty of
+*   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*   GNU General Public License for more details.
+*
+*   You should have received a copy of the GNU General Public License
+*   along with HISE.  If not, see <http://www.gnu.org/licenses/>.
+*
+*   Commercial licenses for using HISE in an closed source project are
+*   available on request. Please visit the project's website to get more
+*   information about commercial licensing:
+*
+*   http://www.hise.audio/
+*
+*   HISE is based on the JUCE library,
+*   which also must be licenced for commercial applications:
+*
+*   http://www.juce.com
+*
+*   ===========================================================================
+*/
+
+#include "AppConfig.h"
+
+#if HI_RUN_UNIT_TESTS
+
+#include  "JuceHeader.h"
+
+using namespace hise;
+
+class DrawActionArenaTest : public UnitTest
+{
+public:
+
+	DrawActionArenaTest() :
+		UnitTest("Testing the draw action arena")
+	{}
+
+	struct FillAction : public DrawActions::ActionBase
+	{
+		FillAction(int& numDeleted_, Rectangle<float> area_, Colour c_) :
+			numDeleted(numDeleted_),
+			area(area_),
+			c(c_)
+		{}
+
+		~FillAction() { numDeleted++; }
+
+		void perform(Graphics& g) override
+		{
+			g.setColour(c);
+			g.fillRect(area);
+		}
+
+		int& numDeleted;
+		const Rectangle<float> area;
+		const Colour c;
+	};
+
+	void runTest() override
+	{
+		testArenaObjects();
+		testFrameRecycling();
+		testPathInterning();
+	}
+
+	void testArenaObjects()
+	{
+		beginTest("Testing arena and heap objects");
+
+		int numDeleted = 0;
+
+		DrawActions::ActionArena::Ptr arena = new DrawActions::ActionArena();
+
+		{
+			DrawActions::ActionBase::Ptr heapAction = new FillAction(numDeleted, {}, Colours::red);
+			expectEquals(arena->getReferenceCount(), 1, "heap object references the arena");
+
+			DrawActions::ActionBase::Ptr a1 = new (*arena) FillAction(numDeleted, {}, Colours::red);
+			DrawActions::ActionBase::Ptr a2 = new (*arena) FillAction(numDeleted, {}, Colours::green);
+
+			expectEquals(arena->getReferenceCount(), 3, "arena objects don't reference the arena");
+			expect(arena->getNumBytesUsed() >= 2 * sizeof(FillAction), "arena size mismatch");
+			expectEquals<int>((int)(reinterpret_cast<uint64>(a1.get()) % 16), 0, "arena object isn't aligned");
+			expectEquals<int>((int)(reinterpret_cast<uint64>(a2.get()) % 16), 0, "arena object isn't aligned");
+
+			a1 = nullptr;
+			expectEquals(arena->getReferenceCount(), 2, "deleting doesn't release the arena");
+			expectEquals(numDeleted, 1, "destructor wasn't called");
+		}
+
+		expectEquals(arena->getReferenceCount(), 1, "arena wasn't released");
+		expectEquals(numDeleted, 3, "destructor wasn't called");
+
+		arena->reset();
+		expectEquals<int>((int)arena->getNumBytesUsed(), 0, "reset doesn't rewind the arena");
+
+		beginTest("Testing arena block growth");
+
+		{
+			ReferenceCountedArray<DrawActions::ActionBase> actions;
+
+			// Exceeds the block size so that the arena has to add blocks
+			for (int i = 0; i < 2000; i++)
+				actions.add(new (*arena) FillAction(numDeleted, { (float)i, 0.0f, 1.0f, 1.0f }, Colours::white));
+
+			auto ok = true;
+
+			for (int i = 0; i < actions.size(); i++)
+				ok &= dynamic_cast<FillAction*>(actions[i].get())->area.getX() == (float)i;
+
+			expect(ok, "arena objects were overwritten");
+		}
+
+		expectEquals(arena->getReferenceCount(), 1, "arena wasn't released");
+		arena->reset();
+	}
+
+	void testFrameRecycling()
+	{
+		beginTest("Testing arena recycling between frames");
+
+		int numDeleted = 0;
+		static constexpr int NumActions = 100;
+
+		DrawActions::Handler handler;
+		std::set<DrawActions::ActionArena*> usedArenas;
+
+		auto recordFrame = [&](Colour c)
+		{
+			handler.beginDrawing();
+
+			usedArenas.insert(&handler.getArena());
+
+			for (int i = 0; i < NumActions; i++)
+				handler.addDrawAction(new (handler.getArena()) FillAction(numDeleted, { (float)i, 0.0f, 1.0f, 8.0f }, c));
+
+			handler.flush();
+		};
+
+		size_t firstFrameSize = 0;
+
+		for (int i = 0; i < 16; i++)
+		{
+			recordFrame(Colours::red);
+
+			auto stats = handler.getFrameStatistics();
+
+			if (i == 0)
+				firstFrameSize = stats.numArenaBytes;
+
+			expectEquals(stats.numActions, NumActions, "action count mismatch");
+			expect(stats.numArenaBytes == firstFrameSize, "arena size changes between frames");
+			expectEquals(numDeleted, i * NumActions, "actions of the previous frame weren't deleted");
+		}
+
+		expectEquals((int)usedArenas.size(), 2, "arenas are not recycled");
+
+		beginTest("Testing frames that are kept alive by the renderer");
+
+		// The Iterator holds the actions of the last frame (like a pending paint call)
+		DrawActions::Handler::Iterator it(&handler);
+
+		for (int i = 0; i < 4; i++)
+			recordFrame(Colours::blue);
+
+		expectEquals((int)usedArenas.size(), 3, "kept arena wasn't skipped");
+
+		Image img(Image::ARGB, NumActions, 8, true);
+
+		{
+			Graphics g(img);
+
+			while (auto action = it.getNextAction())
+				action->perform(g);
+		}
+
+		auto ok = true;
+
+		for (int x = 0; x < NumActions; x++)
+			ok &= img.getPixelAt(x, 4) == Colours::red;
+
+		expect(ok, "actions inside a kept arena were overwritten");
+
+		it.actionsInIterator.clear();
+		recordFrame(Colours::green);
+		recordFrame(Colours::green);
+
+		expectEquals((int)usedArenas.size(), 3, "released arena isn't recycled");
+	}
+
+	void testPathInterning()
+	{
+		beginTest("Testing path interning");
+
+		DrawActions::Handler handler;
+
+		Path p1;
+		p1.addEllipse(0.0f, 0.0f, 10.0f, 10.0f);
+
+		Path p2;
+		p2.addRectangle(0.0f, 0.0f, 10.0f, 10.0f);
+
+		auto s1 = handler.internPath(p1);
+		auto s2 = handler.internPath(p2);
+
+		expect(s1 != s2, "different paths are interned as one path");
+		expect(handler.internPath(p1) == s1, "same path isn't reused");
+
+		Path p3(p1);
+		p3.applyTransform(AffineTransform::translation(1.0f, 0.0f));
+
+		expect(handler.internPath(p3) != s1, "moved path is interned as the same path");
+		expect(s1->p == p1, "interned path was changed");
+
+		expectEquals(handler.getNumInternedPaths(), 3, "interned path count mismatch");
+
+		// The paths that are only referenced by the table are released when the frame is flushed
+		s2 = nullptr;
+		handler.beginDrawing();
+		handler.flush();
+
+		expectEquals(handler.getNumInternedPaths(), 1, "unused paths weren't released");
+		expect(handler.internPath(p1) == s1, "used path was released");
+	}
+};
+
+static DrawActionArenaTest drawActionArenaTest;
+
+class PresetIndexTest : public UnitTest
+{
+public:
+
+	using TagDataBase = MainController::UserPresetHandler::TagDataBase;
+
+	PresetIndexTest() :
+		UnitTest("Testing the preset index")
+	{}
+
+	void runTest() override
+	{
+		auto root = File::getSpecialLocation(File::tempDirectory).getNonexistentChildFile("PresetIndexTest", "", false);
+		root.createDirectory();
+
+		auto warm = writePreset(root, "Bank1/Pads/Warm.preset", "Pad;Warm");
+		auto cold = writePreset(root, "Bank1/Pads/Cold.preset", "Pad");
+		auto saw = writePreset(root, "Bank2/Leads/Saw.preset", "");
+
+		{
+			TagDataBase db;
+			db.setRootDirectory(root);
+			db.buildDataBase(true);
+
+			testQueries(db, root, warm, cold, saw);
+			testFavorites(db, root, warm, cold);
+
+			beginTest("Testing incremental updates");
+
+			writePreset(root, "Bank1/Pads/Warm.preset", "Lead;Warm;Bright");
+			auto square = writePreset(root, "Bank2/Leads/Square.preset", "Lead");
+			saw.deleteFile();
+
+			db.buildDataBase(true);
+
+			expectPresets(db, createQuery(root, true), { cold, warm, square }, "rescan");
+			expectPresets(db, createQuery(root, true, { "Lead" }), { warm, square }, "changed tags");
+			expect(db.isFavorite(cold), "favorite survives the rescan");
+
+			writePreset(root, "Bank1/Pads/Cold.preset", "Pad;Lead");
+			db.updatePreset(cold);
+
+			expectPresets(db, createQuery(root, true, { "Lead" }), { cold, warm, square }, "updated preset");
+
+			beginTest("Testing the background thread");
+
+			auto noise = writePreset(root, "Bank2/Leads/Noise.preset", "Lead");
+
+			db.startPolling();
+
+			bool found = false;
+
+			for (int i = 0; i < 100 && !found; i++)
+			{
+				Array<File> result;
+				db.getPresets(createQuery(root, true), result);
+				found = result.contains(noise);
+
+				if (!found)
+					Thread::sleep(50);
+			}
+
+			db.stopPolling();
+
+			expect(found, "new preset is picked up by the background thread");
+		}
+
+		beginTest("Testing the index file");
+
+		Array<File> rootFiles;
+		root.findChildFiles(rootFiles, File::findFiles, false);
+
+		expectEquals(rootFiles.size(), 1, "no temporary files are left");
+		expect(root.getChildFile(".presetIndex").existsAsFile(), "index file exists");
+
+		{
+			TagDataBase db;
+			db.setRootDirectory(root);
+
+			// This uses the index file without scanning the directory
+			Array<File> result;
+			expect(db.getPresets(createQuery(root, true), result), "indexed root");
+			expectEquals(result.size(), 4, "presets from the index file");
+			expectPresets(db, createQuery(root, true, { "Bright" }), { root.getChildFile("Bank1/Pads/Warm.preset") }, "tags from the index file");
+		}
+
+		root.deleteRecursively();
+	}
+
+private:
+
+	void testQueries(TagDataBase& db, const File& root, const File& warm, const File& cold, const File& saw)
+	{
+		beginTest("Testing preset queries");
+
+		auto pads = root.getChildFile("Bank1/Pads");
+
+		expectPresets(db, createQuery(root, true), { cold, warm, saw }, "all presets");
+		expectPresets(db, createQuery(root, false), {}, "no presets in the root");
+		expectPresets(db, createQuery(pads, false), { cold, warm }, "category");
+		expectPresets(db, createQuery(root, true, { "Pad" }), { cold, warm }, "single tag");
+		expectPresets(db, createQuery(root, true, { "Pad", "Warm" }), { warm }, "all tags must match");
+
+		auto q = createQuery(root, true);
+		q.wildcard = "SAW";
+		expectPresets(db, q, { saw }, "wildcard");
+
+		Array<File> result;
+		expect(!db.getPresets(createQuery(root.getSiblingFile("Expansions"), true), result), "not indexed");
+	}
+
+	void testFavorites(TagDataBase& db, const File& root, const File& warm, const File& cold)
+	{
+		beginTest("Testing favorites");
+
+		var favorites(new DynamicObject());
+		PresetBrowser::DataBaseHelpers::setFavorite(favorites, cold, true);
+
+		db.setFavoriteDataBase(root, favorites);
+
+		auto q = createQuery(root, true);
+		q.favoritesOnly = true;
+
+		expect(db.isFavorite(cold), "favorite from database");
+		expectPresets(db, q, { cold }, "favorites only");
+
+		// The index uses a copy of the database
+		PresetBrowser::DataBaseHelpers::setFavorite(favorites, warm, true);
+		expect(!db.isFavorite(warm), "browser database is copied");
+
+		db.setFavorite(warm, true);
+		expectPresets(db, q, { cold, warm }, "favorite added");
+
+		db.setFavorite(warm, false);
+		expectPresets(db, q, { cold }, "favorite removed");
+	}
+
+	static TagDataBase::Query createQuery(const File& root, bool recursive, const StringArray& tags = {})
+	{
+		TagDataBase::Query q;
+		q.root = root;
+		q.recursive = recursive;
+
+		for (const auto& t : tags)
+			q.tags.add(Identifier(t));
+
+		return q;
+	}
+
+	static File writePreset(const File& root, const String& path, const String& tags)
+	{
+		auto f = root.getChildFile(path);
+		f.getParentDirectory().createDirectory();
+
+		XmlElement xml("Preset");
+		xml.setAttribute("Version", "1.0.0");
+
+		if (tags.isNotEmpty())
+			xml.setAttribute("Tags", tags);
+
+		f.replaceWithText(xml.createDocument(""));
+		return f;
+	}
+
+	void expectPresets(const TagDataBase& db, const TagDataBase::Query& q, const Array<File>& expected, const String& message)
+	{
+		Array<File> result;
+
+		expect(db.getPresets(q, result), message + ": indexed root");
+		expectEquals(result.size(), expected.size(), message + ": number of presets");
+
+		if (result.size() == expected.size())
+		{
+			for (int i = 0; i < result.size(); i++)
+				expect(result[i] == expected[i], message + ": " + result[i].getFileName() + " at index " + String(i));
+		}
+	}
+};
+
+static PresetIndexTest presetIndexTest;
+
+#endif
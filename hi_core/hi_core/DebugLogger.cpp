@@ -354,6 +354,25 @@ void DebugLogger::addStreamingFailure(double voiceUptime)
 	addFailure(f);
 }
 
+void DebugLogger::addEventBufferOverflow(HiseEventBuffer& b, const Processor* p)
+{
+	const int numDroppedEvents = b.getNumOverflows();
+
+	if (numDroppedEvents == 0)
+		return;
+
+	b.resetOverflowCounter();
+
+	if (isLogging())
+	{
+		auto location = p != nullptr ? Location::SynthRendering : Location::MainRenderCallback;
+
+		Failure f = Failure(messageIndex++, callbackIndex, location, FailureType::EventBufferOverflow, p, getCurrentTimeStamp(), (double)numDroppedEvents);
+
+		addFailure(f);
+	}
+}
+
 void DebugLogger::logEvents(const HiseEventBuffer& masterBuffer)
 {
 	if (isLogging())
@@ -920,6 +939,7 @@ String DebugLogger::getNameForFailure(FailureType f)
 		RETURN_CASE_STRING_FAILURE(SampleLoadingError);
 		RETURN_CASE_STRING_FAILURE(StreamingFailure);
 		RETURN_CASE_STRING_FAILURE(SoftBypassFailure);
+		RETURN_CASE_STRING_FAILURE(EventBufferOverflow);
         RETURN_CASE_STRING_FAILURE(numFailureTypes);
 	}
 
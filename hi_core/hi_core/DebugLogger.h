@@ -70,6 +70,7 @@ public:
 		SampleLoadingError,
 		StreamingFailure,
 		SoftBypassFailure,
+		EventBufferOverflow, //< an event buffer was full and events were dropped
 		numFailureTypes
 	};
 
@@ -180,6 +181,12 @@ public:
 
 	void addStreamingFailure(double voiceUptime);
 
+	/** Reports the events that the buffer dropped because it was full and resets its overflow counter.
+	
+		Pass in the processor that owns the buffer or nullptr for the master event buffer.
+	*/
+	void addEventBufferOverflow(HiseEventBuffer& b, const Processor* p = nullptr);
+
 	void logEvents(const HiseEventBuffer& masterBuffer);
 
 	void logMessage(const String& errorMessage);
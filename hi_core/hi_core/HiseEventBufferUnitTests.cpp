@@ -61,6 +61,8 @@ public:
 		testMidiBufferCopyMethods();
 		testMidiBufferIterators();
 		testEventBufferMoveOperations();
+		testEventBufferCapacity();
+		testEventBufferBenchmark();
 		testEventHandler();
 		testEventBufferStack();
 		testStartOffset();
@@ -793,6 +795,171 @@ private:
 
 	}
 
+	void testEventBufferCapacity()
+	{
+		beginTest("Testing HiseEventBuffer capacity");
+
+		HiseEventBuffer b;
+
+		expectEquals<int>(b.getCapacity(), HISE_EVENT_BUFFER_SIZE, "Default capacity");
+
+		for (int i = 0; i < HISE_EVENT_BUFFER_SIZE + 10; i++)
+			b.addEvent(generateRandomHiseEvent());
+
+		expectEquals<int>(b.getNumUsed(), HISE_EVENT_BUFFER_SIZE, "Full buffer");
+		expectEquals<int>(b.getNumOverflows(), 10, "Overflow counter");
+
+		b.resetOverflowCounter();
+
+		HiseEventBuffer copy(b);
+
+		b.setCapacity(HiseEventBuffer::getCapacityForBlockSize(1024));
+
+		expectEquals<int>(b.getCapacity(), 1024 * HiseEventBuffer::NumEventsPerSample, "Increased capacity");
+		expect(b == copy, "setCapacity() keeps the events");
+
+		const int numToAdd = b.getCapacity() - b.getNumUsed();
+
+		for (int i = 0; i < numToAdd; i++)
+			b.addEvent(generateRandomHiseEvent());
+
+		expectEquals<int>(b.getNumUsed(), b.getCapacity(), "Full buffer after resize");
+		expectEquals<int>(b.getNumOverflows(), 0, "No overflow after resize");
+		expect(b.timeStampsAreSorted(), "Sorted after resize");
+
+		copy = b;
+
+		expectEquals<int>(copy.getCapacity(), b.getCapacity(), "Assignment increases capacity");
+		expect(copy == b, "Assignment copies all events");
+
+		b.setCapacity(0);
+
+		expectEquals<int>(b.getCapacity(), HISE_EVENT_BUFFER_SIZE, "Minimum capacity");
+		expectEquals<int>(b.getNumUsed(), HISE_EVENT_BUFFER_SIZE, "Shrinking removes events");
+		expect(b.timeStampsAreSorted(), "Sorted after shrinking");
+
+		HiseEventBuffer small;
+
+		small.copyFrom(copy);
+
+		expectEquals<int>(small.getNumOverflows(), copy.getNumUsed() - HISE_EVENT_BUFFER_SIZE, "copyFrom() overflow");
+
+		beginTest("Testing order of events with the same timestamp");
+
+		for (int numEvents : { 100, 3000 })
+		{
+			HiseEventBuffer sorted, appended, first, second;
+
+			for (auto eb : { &sorted, &appended, &first, &second })
+				eb->setCapacity(numEvents);
+
+			for (int i = 0; i < numEvents; i++)
+			{
+				auto e = generateRandomHiseEvent();
+				e.setTimeStamp(r.nextInt(64));
+				e.setEventId((uint16)i);
+
+				sorted.addEvent(e);
+				appended.appendEvent(e);
+
+				if (i % 2 == 0)
+					first.addEvent(e);
+				else
+					second.addEvent(e);
+			}
+
+			appended.sortTimestamps();
+
+			expect(sorted.timeStampsAreSorted(), "addEvent() sorts the events");
+			expect(sorted == appended, "sortTimestamps() is stable with " + String(numEvents) + " events");
+
+			HiseEventBuffer expected;
+			expected.setCapacity(numEvents);
+
+			for (const auto& e : first)
+				expected.addEvent(e);
+
+			for (const auto& e : second)
+				expected.addEvent(e);
+
+			first.addEvents(second);
+
+			expect(first == expected, "addEvents() keeps the order of events with the same timestamp");
+
+			int lastTimestamp = -1;
+			int lastEventId = -1;
+
+			for (const auto& e : sorted)
+			{
+				if (e.getTimeStamp() == lastTimestamp)
+					expect((int)e.getEventId() > lastEventId, "Insertion order of equal timestamps");
+
+				lastTimestamp = e.getTimeStamp();
+				lastEventId = e.getEventId();
+			}
+		}
+	}
+
+	void testEventBufferBenchmark()
+	{
+		beginTest("Benchmarking HiseEventBuffer with dense event streams");
+
+		const int blockSize = 512;
+		const int numEventsPerBlock = 2000;
+		const int numBlocks = 50;
+
+		HiseEventBuffer b;
+		b.setCapacity(HiseEventBuffer::getCapacityForBlockSize(blockSize));
+
+		expect(b.getCapacity() >= numEventsPerBlock, "Capacity for dense event streams");
+
+		Array<HiseEvent> events;
+
+		for (int i = 0; i < numEventsPerBlock; i++)
+		{
+			HiseEvent e(HiseEvent::Type::Controller, (uint8)r.nextInt(128), (uint8)r.nextInt(128), (uint8)r.nextInt(Range<int>(1, 17)));
+			e.setTimeStamp(r.nextInt(blockSize));
+			events.add(e);
+		}
+
+		auto start = Time::getHighResolutionTicks();
+
+		for (int i = 0; i < numBlocks; i++)
+		{
+			b.clear();
+
+			for (const auto& e : events)
+				b.addEvent(e);
+		}
+
+		auto addTime = Time::highResolutionTicksToSeconds(Time::getHighResolutionTicks() - start);
+
+		expectEquals<int>(b.getNumUsed(), numEventsPerBlock, "All events added");
+		expect(b.timeStampsAreSorted(), "addEvent() sorts the events");
+
+		HiseEventBuffer reference(b);
+
+		start = Time::getHighResolutionTicks();
+
+		for (int i = 0; i < numBlocks; i++)
+		{
+			b.clear();
+
+			for (const auto& e : events)
+				b.appendEvent(e);
+
+			b.sortTimestamps();
+		}
+
+		auto sortTime = Time::highResolutionTicksToSeconds(Time::getHighResolutionTicks() - start);
+
+		expect(b == reference, "appendEvent() + sortTimestamps() creates the same order");
+		expectEquals<int>(b.getNumOverflows(), 0, "No overflow");
+
+		logMessage("addEvent():                    " + String(addTime * 1000000.0 / (double)numBlocks, 1) + "us per block with " + String(numEventsPerBlock) + " events");
+		logMessage("appendEvent() + sortTimestamps(): " + String(sortTime * 1000000.0 / (double)numBlocks, 1) + "us per block with " + String(numEventsPerBlock) + " events");
+	}
+
 
 };
 
@@ -867,6 +867,9 @@ void MainController::processBlockCommon(AudioSampleBuffer &buffer, MidiBuffer &m
 
 	jassert(getOriginalBufferSize() >= numSamplesThisBlock);
 
+	if (auto rm = static_cast<scriptnode::routing::GlobalRoutingManager*>(getGlobalRoutingManager()))
+		rm->flushBatchedCables();
+
 #if !FRONTEND_IS_PLUGIN || HISE_ENABLE_MIDI_INPUT_FOR_FX
     
 	keyboardState.processNextMidiBuffer(midiMessages, 0, numSamplesThisBlock, true);
@@ -896,6 +899,8 @@ void MainController::processBlockCommon(AudioSampleBuffer &buffer, MidiBuffer &m
 
 	getDebugLogger().logEvents(masterEventBuffer);
 
+	getDebugLogger().addEventBufferOverflow(masterEventBuffer);
+
 #else
 	ignoreUnused(midiMessages);
 
@@ -1323,6 +1328,8 @@ void MainController::prepareToPlay(double sampleRate_, int samplesPerBlock)
 		processingBufferSize = jmin<int>(processingBufferSize.get(), 1024);
 	}
 
+	masterEventBuffer.setCapacity(HiseEventBuffer::getCapacityForBlockSize(jmax<int>(originalBufferSize, processingBufferSize.get())));
+
 	if ((processingBufferSize.get() % HISE_EVENT_RASTER != 0) && HISE_COMPLAIN_ABOUT_ILLEGAL_BUFFER_SIZE)
 	{
 		sendOverlayMessage(State::CustomErrorMessage, "The buffer size " + String(processingBufferSize.get()) + " is not supported. Use a multiple of " + String(HISE_EVENT_RASTER));
@@ -192,6 +192,9 @@ public:
 		/** returns a pointer to the thread pool that streams the samples from disk. */
 		SampleThreadPool *getGlobalSampleThreadPool() { return samplerLoaderThreadPool; }
 
+		/** returns the worker threads that preload the samples of a sampler in parallel. They are created when this is called for the first time. */
+		ThreadPool* getPreloadThreadPool();
+
 		/** returns a pointer to the global sample pool */
 		ModulatorSamplerSoundPool *getModulatorSamplerSoundPool2() const;
 
@@ -358,6 +361,9 @@ public:
 
 		ScopedPointer<SampleThreadPool> samplerLoaderThreadPool;
 
+		CriticalSection preloadThreadPoolLock;
+		ScopedPointer<ThreadPool> preloadThreadPool;
+
 		bool hddMode = false;
 		bool skipPreloading = false;
 
@@ -761,19 +767,95 @@ public:
 			ValueTree newPreset;
 		};
 
-		struct TagDataBase
+		/** An in-memory index of all user presets below the preset root directory.
+		
+			It stores the path, tags, required expansions, favorite flag and modification time of 
+			every preset so that the preset browser can filter and search without touching the disk.
+			The index is cached in a file in the root directory and while a preset browser is open, 
+			a background thread polls the modification times and only reparses presets that were 
+			added or changed.
+		*/
+		struct TagDataBase: public ChangeBroadcaster,
+							private Thread
 		{
-			struct CachedTag
+			struct CachedPreset
 			{
-				int64 hashCode;
+				File file;
+				int64 modificationTime = 0;
+				int64 fileSize = 0;
+				Array<Identifier> tags;
+				StringArray requiredExpansions;
+				bool favorite = false;
+			};
+
+			/** A filter for getPresets(). */
+			struct Query
+			{
+				/** Only presets inside this directory will be returned. */
+				File root;
+
+				/** If false, only the direct children of root will be returned. */
+				bool recursive = false;
+
+				/** A case insensitive string that must be contained in the full path. */
+				String wildcard;
+
+				/** All of these tags must be set in the preset. */
 				Array<Identifier> tags;
-				bool shown = false;
+
+				bool favoritesOnly = false;
+
+				/** If not null, presets that require expansions that are not available will be skipped. */
+				MainController* expansionFilter = nullptr;
 			};
 
+			TagDataBase();
+			~TagDataBase();
+
 			void setRootDirectory(const File& newRoot);;
 
+			/** Starts the background thread that polls the root directory for changes. 
+			
+				Every call must be matched with a call to stopPolling() (eg. in the constructor
+				and destructor of a preset browser), the thread will be stopped when the last
+				client is gone.
+			*/
+			void startPolling();
+
+			/** Stops the background thread if this was the last client that called startPolling(). */
+			void stopPolling();
+
+			/** Updates the index if it's dirty (or always if force is true). 
+			
+				This only reparses the presets that were changed since the last scan. If the 
+				background thread is currently scanning, this will not wait for it but make it
+				scan again, which will send a change message if the index has changed.
+			*/
 			void buildDataBase(bool force = false);
 
+			/** Writes the presets that match the query into the result array (sorted by their path). 
+			
+				Returns false if the query root is not inside the indexed directory (eg. an expansion),
+				in which case you need to look at the file system yourself.
+			*/
+			bool getPresets(const Query& query, Array<File>& result) const;
+
+			/** Returns true if the preset is a favorite. */
+			bool isFavorite(const File& presetFile) const;
+
+			/** Updates the favorite flag of the preset in the index. */
+			void setFavorite(const File& presetFile, bool isFavorite);
+
+			/** Sets the favorite database of the preset browser (the content of db.json) and updates all favorite flags. 
+			
+				The index keeps a copy of the database so that the browser can change its object
+				without locking. This is ignored if the database doesn't belong to the indexed root directory.
+			*/
+			void setFavoriteDataBase(const File& databaseRoot, const var& newDataBase);
+
+			/** Reparses the given preset. Use this after you've changed the preset file. */
+			void updatePreset(const File& presetFile);
+
 			/** If you want to use the tag system, supply a list of Strings and it will
 			create the tags automatically.
 			*/
@@ -785,20 +867,48 @@ public:
 			/** @internal */
 			const StringArray& getTagList() const { return tagList; }
 
-			const Array<CachedTag>& getCachedTags() const { return cachedTags; }
-			Array<CachedTag>& getCachedTags() { return cachedTags; }
-
 		private:
 
+			static constexpr int PollIntervalMilliseconds = 2000;
+
+			void run() override;
+
+			/** Scans the root directory. Must be called with the scanLock. */
+			void buildInternal();
+
+			/** Returns true if this is called from the background thread and it should stop. */
+			bool scanShouldExit() const;
+
+			CachedPreset createEntry(const File& presetFile, int64 modificationTime, int64 fileSize) const;
+
+			bool matches(const CachedPreset& p, const Query& query) const;
+
+			bool getFavoriteFromDataBase(const File& presetFile) const;
+
+			File getIndexFile() const { return root.getChildFile(".presetIndex"); }
+
+			void loadIndexFile();
+			void saveIndexFile();
+
 			StringArray tagList;
 
 			File root;
 
-			Array<CachedTag> cachedTags;
+			var favoriteDataBase;
 
-			void buildInternal();
+			Array<CachedPreset> cachedPresets;
+
+			/** Locks the root, the entries and the favorite database. */
+			CriticalSection lock;
+
+			/** Serialises the scans of the background thread and buildDataBase(true). */
+			CriticalSection scanLock;
+
+			/** The number of startPolling() calls without a matching stopPolling() call. */
+			int numPollingClients = 0;
 
-			bool dirty = true;
+			std::atomic<bool> dirty = { true };
+			std::atomic<bool> rescanPending = { false };
 		};
 
 		/** A class that will be notified about user preset changes. */
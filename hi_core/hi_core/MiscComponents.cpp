@@ -1034,12 +1034,176 @@ bool DrawActions::Handler::beginBlendLayer(const Identifier& blendMode, float al
 		return false;
 
 	auto bm = (gin::BlendMode)idx;
-	ActionLayer* newLayer = new BlendingLayer(bm, alpha);
+	ActionLayer* newLayer = new (getArena()) BlendingLayer(bm, alpha);
 	addDrawAction(newLayer);
 	layerStack.insert(-1, newLayer);
 	return true;
 }
 
+DrawActions::SharedPath::Ptr DrawActions::Handler::internPath(const Path& p)
+{
+	static constexpr int MaxNumInternedPaths = 256;
+
+	auto b = p.getBounds();
+
+	for (auto ip : internedPaths)
+	{
+		if (ip->p.getBounds() == b && ip->p == p)
+			return ip;
+	}
+
+	SharedPath::Ptr newPath = new SharedPath(p);
+
+	if (internedPaths.size() < MaxNumInternedPaths)
+		internedPaths.add(newPath);
+
+	return newPath;
+}
+
+void DrawActions::Handler::addRenderTime(double milliSeconds)
+{
+	SpinLock::ScopedLockType sl(lock);
+	frameStatistics.renderTime = 0.9 * frameStatistics.renderTime + 0.1 * milliSeconds;
+}
+
+void DrawActions::Handler::updateRecordingStatistics()
+{
+	if (recordingStart > 0.0)
+	{
+		auto delta = Time::getMillisecondCounterHiRes() - recordingStart;
+		frameStatistics.recordingTime = 0.9 * frameStatistics.recordingTime + 0.1 * delta;
+		recordingStart = 0.0;
+	}
+
+	frameStatistics.numActions = numActionsInFrame;
+	frameStatistics.numArenaBytes = currentArena != nullptr ? currentArena->getNumBytesUsed() : 0;
+	numActionsInFrame = 0;
+}
+
+void DrawActions::Handler::recycleArena()
+{
+	static constexpr int MaxNumArenas = 8;
+
+	currentArena = nullptr;
+
+	// The pool holds the only reference if all actions inside the arena are deleted
+	for (auto a : arenas)
+	{
+		if (a->getReferenceCount() == 1)
+		{
+			a->reset();
+			currentArena = a;
+			return;
+		}
+	}
+
+	currentArena = new ActionArena();
+
+	if (arenas.size() < MaxNumArenas)
+		arenas.add(currentArena);
+}
+
+void DrawActions::Handler::releaseUnusedPaths()
+{
+	for (int i = internedPaths.size() - 1; i >= 0; i--)
+	{
+		if (internedPaths.getObjectPointerUnchecked(i)->getReferenceCount() == 1)
+			internedPaths.remove(i);
+	}
+}
+
+String DrawActions::Handler::FrameStatistics::toString() const
+{
+	String s;
+	s << "Recording: " << String(recordingTime, 2) << "ms, ";
+	s << "Rendering: " << String(renderTime, 2) << "ms, ";
+	s << String(numActions) << " actions, ";
+	s << String((int)numArenaBytes) << " bytes";
+	return s;
+}
+
+void* DrawActions::ActionArena::allocate(size_t numBytes)
+{
+	numBytes = (numBytes + 15) & ~(size_t)15;
+
+	auto b = blocks.getLast();
+
+	if (b == nullptr || b->used + numBytes > b->size)
+	{
+		b = blocks.add(new Block());
+		b->size = jmax(BlockSize, numBytes);
+		b->data.malloc(b->size);
+	}
+
+	auto ptr = b->data.get() + b->used;
+	b->used += numBytes;
+	numBytesUsed += numBytes;
+
+	return ptr;
+}
+
+void DrawActions::ActionArena::reset()
+{
+	if (blocks.size() > 1)
+	{
+		// merge the blocks so that the next frame fits into a single block
+		size_t totalSize = 0;
+
+		for (auto b : blocks)
+			totalSize += b->size;
+
+		blocks.clear();
+
+		auto b = blocks.add(new Block());
+		b->size = totalSize;
+		b->data.malloc(totalSize);
+	}
+	else if (auto b = blocks.getFirst())
+	{
+		b->used = 0;
+	}
+
+	numBytesUsed = 0;
+}
+
+void* DrawActions::ArenaObject::operator new(size_t numBytes)
+{
+	auto ptr = static_cast<uint8*>(std::malloc(numBytes + HeaderSize));
+
+	if (ptr == nullptr)
+		throw std::bad_alloc();
+
+	reinterpret_cast<Header*>(ptr)->arena = nullptr;
+	return ptr + HeaderSize;
+}
+
+void* DrawActions::ArenaObject::operator new(size_t numBytes, ActionArena& arena)
+{
+	auto ptr = static_cast<uint8*>(arena.allocate(numBytes + HeaderSize));
+
+	reinterpret_cast<Header*>(ptr)->arena = &arena;
+	arena.incReferenceCount();
+	return ptr + HeaderSize;
+}
+
+void DrawActions::ArenaObject::operator delete(void* p)
+{
+	if (p == nullptr)
+		return;
+
+	auto ptr = static_cast<uint8*>(p) - HeaderSize;
+
+	if (auto arena = reinterpret_cast<Header*>(ptr)->arena)
+		arena->decReferenceCount();
+	else
+		std::free(ptr);
+}
+
+void DrawActions::ArenaObject::operator delete(void* p, ActionArena&)
+{
+	operator delete(p);
+}
+
 juce::Rectangle<int> DrawActions::Handler::getScreenshotBounds(Rectangle<int> shaderBounds) const
 {
 	shaderBounds = shaderBounds.transformedBy(AffineTransform::scale(scaleFactor));
@@ -1080,6 +1244,8 @@ void DrawActions::Handler::Iterator::render(Graphics& g, Component* c)
 	if (handler->recursion)
 		return;
 
+	auto renderStart = Time::getMillisecondCounterHiRes();
+
 	UnblurryGraphics ug(g, *c);
 
 	auto sf = ug.getTotalScaleFactor();
@@ -1148,6 +1314,8 @@ void DrawActions::Handler::Iterator::render(Graphics& g, Component* c)
 		while (auto action = getNextAction())
 			action->perform(g);
 	}
+
+	handler->addRenderTime(Time::getMillisecondCounterHiRes() - renderStart);
 }
 
 DrawActions::NoiseMapManager::NoiseMap::NoiseMap(Rectangle<int> a, bool monochrom_) :
@@ -263,7 +263,77 @@ private:
 
 struct DrawActions
 {
-	class PostActionBase : public ReferenceCountedObject
+	/** A bump allocator that stores the draw actions of a single frame.
+
+		The Handler records each frame into an arena and recycles it as soon as all actions
+		that live inside it are deleted, so repainting a panel doesn't allocate each draw call
+		on the heap.
+	*/
+	class ActionArena : public ReferenceCountedObject
+	{
+	public:
+
+		using Ptr = ReferenceCountedObjectPtr<ActionArena>;
+
+		/** Returns a 16 byte aligned memory chunk. */
+		void* allocate(size_t numBytes);
+
+		/** Rewinds the arena. Only call this when there are no objects left inside the arena. */
+		void reset();
+
+		size_t getNumBytesUsed() const { return numBytesUsed; }
+
+	private:
+
+		static constexpr size_t BlockSize = 16384;
+
+		struct Block
+		{
+			HeapBlock<uint8> data;
+			size_t size = 0;
+			size_t used = 0;
+		};
+
+		OwnedArray<Block> blocks;
+		size_t numBytesUsed = 0;
+	};
+
+	/** A base class for the draw actions that can be created either on the heap or inside an ActionArena.
+
+		Use `new (arena) MyAction()` to create the object inside the arena. Each object keeps its
+		arena alive and will just release the reference when it's deleted.
+	*/
+	struct ArenaObject
+	{
+		static void* operator new(size_t numBytes);
+		static void* operator new(size_t numBytes, ActionArena& arena);
+		static void operator delete(void* p);
+		static void operator delete(void* p, ActionArena& arena);
+
+	private:
+
+		struct Header
+		{
+			ActionArena* arena;
+		};
+
+		static constexpr size_t HeaderSize = 16;
+	};
+
+	/** A path that is shared between the draw actions of subsequent frames. */
+	struct SharedPath : public ReferenceCountedObject
+	{
+		using Ptr = ReferenceCountedObjectPtr<SharedPath>;
+
+		SharedPath(const Path& p_) :
+			p(p_)
+		{}
+
+		const Path p;
+	};
+
+	class PostActionBase : public ReferenceCountedObject,
+						   public ArenaObject
 	{
 	public:
 
@@ -271,7 +341,8 @@ struct DrawActions
 		virtual bool needsStackData() const { return false; }
 	};
 
-	class ActionBase: public ReferenceCountedObject
+	class ActionBase: public ReferenceCountedObject,
+					  public ArenaObject
 	{
 	public:
 
@@ -528,6 +599,24 @@ struct DrawActions
 			Handler* handler;
 		};
 
+		/** The timings of the last frames. The values are smoothed so that they can be displayed in the watch table. */
+		struct FrameStatistics
+		{
+			String toString() const;
+
+			/** The time in milliseconds between beginDrawing() and flush(). */
+			double recordingTime = 0.0;
+
+			/** The time in milliseconds that the Iterator needs to render the actions. */
+			double renderTime = 0.0;
+
+			/** The amount of draw actions of the last frame. */
+			int numActions = 0;
+
+			/** The amount of bytes that the draw actions of the last frame use in the arena. */
+			size_t numArenaBytes = 0;
+		};
+
 		struct Listener
 		{
 			virtual ~Listener() {};
@@ -544,13 +633,14 @@ struct DrawActions
 		void beginDrawing()
 		{
 			currentActions.clear();
+			recordingStart = Time::getMillisecondCounterHiRes();
 		}
 
 		bool beginBlendLayer(const Identifier& blendMode, float alpha);
 
 		void beginLayer(bool drawOnParent)
 		{
-			auto newLayer = new ActionLayer(drawOnParent);
+			auto newLayer = new (getArena()) ActionLayer(drawOnParent);
 
 			addDrawAction(newLayer);
 			layerStack.insert(-1, newLayer);
@@ -568,6 +658,8 @@ struct DrawActions
 
 		void addDrawAction(ActionBase* newDrawAction)
 		{
+			numActionsInFrame++;
+
 			if (layerStack.getLast() != nullptr)
 				layerStack.getLast()->addDrawAction(newDrawAction);
 			else
@@ -582,11 +674,40 @@ struct DrawActions
 				nextActions.swapWith(currentActions);
 				currentActions.clear();
 				layerStack.clear();
+
+				updateRecordingStatistics();
 			}
 
+			recycleArena();
+			releaseUnusedPaths();
+
 			triggerAsyncUpdate();
 		}
 
+		/** Returns the arena that the draw actions of the current frame should be allocated in. */
+		ActionArena& getArena()
+		{
+			if (currentArena == nullptr)
+				recycleArena();
+
+			return *currentArena;
+		}
+
+		/** Returns a shared copy of the given path. If the same path was used in the last frame, it will reuse the existing copy. */
+		SharedPath::Ptr internPath(const Path& p);
+
+		/** Returns the amount of paths that are kept for the next frame. */
+		int getNumInternedPaths() const { return internedPaths.size(); }
+
+		FrameStatistics getFrameStatistics() const
+		{
+			SpinLock::ScopedLockType sl(lock);
+			return frameStatistics;
+		}
+
+		/** @internal Called by the Iterator after the actions were rendered. */
+		void addRenderTime(double milliSeconds);
+
 		void logError(const String& message)
 		{
 			if (errorLogger)
@@ -633,7 +754,24 @@ struct DrawActions
 
 		Array<WeakReference<Listener>> listeners;
 
-		SpinLock lock;
+		/** Must be called with the lock. */
+		void updateRecordingStatistics();
+
+		/** Picks an arena without living draw actions for the next frame. */
+		void recycleArena();
+
+		void releaseUnusedPaths();
+
+		mutable SpinLock lock;
+
+		ActionArena::Ptr currentArena;
+		ReferenceCountedArray<ActionArena> arenas;
+
+		ReferenceCountedArray<SharedPath> internedPaths;
+
+		FrameStatistics frameStatistics;
+		double recordingStart = 0.0;
+		int numActionsInFrame = 0;
 
 		ReferenceCountedArray<ActionLayer> layerStack;
 
@@ -64,6 +64,8 @@ MainController::SampleManager::~SampleManager()
 	internalPreloadJob.signalJobShouldExit();
 	samplerLoaderThreadPool->stopThread(2000);
 
+	preloadThreadPool = nullptr;
+
 	pendingFunctions.clear();
 
 	jassert(pendingFunctions.isEmpty());
@@ -75,6 +77,16 @@ MainController::SampleManager::~SampleManager()
 
 
 
+ThreadPool* MainController::SampleManager::getPreloadThreadPool()
+{
+	ScopedLock sl(preloadThreadPoolLock);
+
+	if (preloadThreadPool == nullptr)
+		preloadThreadPool = new ThreadPool(jlimit(1, HISE_NUM_PRELOAD_THREADS, SystemStats::getNumCpus()));
+
+	return preloadThreadPool;
+}
+
 void MainController::SampleManager::setShouldSkipPreloading(bool skip)
 {
 	skipPreloading = skip;
@@ -32,47 +32,439 @@
 
 namespace hise { using namespace juce;
 
+MainController::UserPresetHandler::TagDataBase::TagDataBase():
+	Thread("Preset Index")
+{
+
+}
+
+MainController::UserPresetHandler::TagDataBase::~TagDataBase()
+{
+	stopThread(PollIntervalMilliseconds);
+}
+
+void MainController::UserPresetHandler::TagDataBase::startPolling()
+{
+	bool shouldStart;
+
+	{
+		ScopedLock sl(lock);
+		shouldStart = ++numPollingClients == 1;
+	}
+
+	if (shouldStart)
+		startThread(3);
+}
+
+void MainController::UserPresetHandler::TagDataBase::stopPolling()
+{
+	bool shouldStop;
+
+	{
+		ScopedLock sl(lock);
+		jassert(numPollingClients > 0);
+		shouldStop = --numPollingClients == 0;
+	}
+
+	if (shouldStop)
+		stopThread(PollIntervalMilliseconds);
+}
+
 void MainController::UserPresetHandler::TagDataBase::buildDataBase(bool force /*= false*/)
 {
 	if (force || dirty)
 	{
-		buildInternal();
+		ScopedTryLock scanSl(scanLock);
+
+		if (scanSl.isLocked())
+		{
+			buildInternal();
+		}
+		else
+		{
+			// Don't wait for the running scan, the background thread scans again and sends a change message
+			dirty = true;
+			rescanPending = true;
+			notify();
+		}
 	}
 }
 
+bool MainController::UserPresetHandler::TagDataBase::scanShouldExit() const
+{
+	return Thread::getCurrentThreadId() == getThreadId() && threadShouldExit();
+}
+
 void MainController::UserPresetHandler::TagDataBase::buildInternal()
 {
-	cachedTags.clear();
+	File rootToScan;
+	HashMap<String, int> existingIndexes;
+	Array<CachedPreset> existingPresets;
 
-	Array<File> allPresets;
+	{
+		ScopedLock sl(lock);
+		rootToScan = root;
+		existingPresets = cachedPresets;
+	}
 
-	root.findChildFiles(allPresets, File::findFiles, true, "*.preset");
+	for (int i = 0; i < existingPresets.size(); i++)
+		existingIndexes.set(existingPresets.getReference(i).file.getFullPathName(), i);
 
-	PresetBrowser::DataBaseHelpers::cleanFileList(nullptr, allPresets);
+	Array<CachedPreset> newPresets;
+	bool changed = false;
 
-	for (auto f : allPresets)
+	if (rootToScan.isDirectory())
 	{
-		auto sa = PresetBrowser::DataBaseHelpers::getTagsFromXml(f);
+		// this only reads the directory entries, the preset files are just parsed if they have changed
+		for (const auto& entry : RangedDirectoryIterator(rootToScan, true, "*.preset", File::findFiles))
+		{
+			if (scanShouldExit())
+				return;
+
+			auto f = entry.getFile();
+
+			if (entry.isHidden() || f.getFileName().startsWith("."))
+				continue;
+
+			auto modificationTime = entry.getModificationTime().toMilliseconds();
+			auto fileSize = entry.getFileSize();
+			auto path = f.getFullPathName();
+
+			if (existingIndexes.contains(path))
+			{
+				const auto& existing = existingPresets.getReference(existingIndexes[path]);
 
-		CachedTag newTag;
-		newTag.hashCode = f.hashCode64();
-		for (auto t : sa)
-			newTag.tags.add(Identifier(t));
+				if (existing.modificationTime == modificationTime && existing.fileSize == fileSize)
+				{
+					newPresets.add(existing);
+					continue;
+				}
+			}
 
-		cachedTags.add(std::move(newTag));
+			newPresets.add(createEntry(f, modificationTime, fileSize));
+			changed = true;
+		}
 	}
 
-	dirty = false;
+	struct Sorter
+	{
+		static int compareElements(const CachedPreset& first, const CachedPreset& second)
+		{
+			return first.file.getFullPathName().compareNatural(second.file.getFullPathName());
+		}
+	} sorter;
+
+	newPresets.sort(sorter);
+
+	changed |= newPresets.size() != existingPresets.size();
+
+	{
+		ScopedLock sl(lock);
+
+		// the root has changed during the scan, the next scan will pick it up
+		if (root != rootToScan)
+			return;
+
+		cachedPresets.swapWith(newPresets);
+		dirty = false;
+	}
+
+	if (changed)
+	{
+		saveIndexFile();
+		sendChangeMessage();
+	}
 }
 
 void MainController::UserPresetHandler::TagDataBase::setRootDirectory(const File& newRoot)
 {
-
-	if (root != newRoot)
 	{
+		ScopedLock sl(lock);
+
+		if (root == newRoot)
+			return;
+
 		root = newRoot;
+		cachedPresets.clear();
 		dirty = true;
 	}
+
+	// The cached index is checked against the modification times with the next scan
+	loadIndexFile();
+
+	notify();
+}
+
+bool MainController::UserPresetHandler::TagDataBase::getPresets(const Query& query, Array<File>& result) const
+{
+	ScopedLock sl(lock);
+
+	if (!(query.root == root || query.root.isAChildOf(root)))
+		return false;
+
+	for (const auto& p : cachedPresets)
+	{
+		if (matches(p, query))
+			result.add(p.file);
+	}
+
+	return true;
+}
+
+bool MainController::UserPresetHandler::TagDataBase::matches(const CachedPreset& p, const Query& query) const
+{
+	if (query.favoritesOnly && !p.favorite)
+		return false;
+
+	if (query.recursive ? !p.file.isAChildOf(query.root) : p.file.getParentDirectory() != query.root)
+		return false;
+
+	if (query.wildcard.isNotEmpty() && !p.file.getFullPathName().containsIgnoreCase(query.wildcard))
+		return false;
+
+	for (const auto& t : query.tags)
+	{
+		if (!p.tags.contains(t))
+			return false;
+	}
+
+	if (query.expansionFilter != nullptr && !p.requiredExpansions.isEmpty())
+	{
+		auto& handler = query.expansionFilter->getExpansionHandler();
+
+		if (handler.isEnabled())
+		{
+			auto missing = p.requiredExpansions;
+
+			for (int i = 0; i < handler.getNumExpansions(); i++)
+				missing.removeString(handler.getExpansion(i)->getProperty(ExpansionIds::Name));
+
+			if (!missing.isEmpty())
+				return false;
+		}
+	}
+
+	return true;
+}
+
+bool MainController::UserPresetHandler::TagDataBase::isFavorite(const File& presetFile) const
+{
+	ScopedLock sl(lock);
+
+	for (const auto& p : cachedPresets)
+	{
+		if (p.file == presetFile)
+			return p.favorite;
+	}
+
+	return false;
+}
+
+void MainController::UserPresetHandler::TagDataBase::setFavorite(const File& presetFile, bool isFavorite)
+{
+	ScopedLock sl(lock);
+
+	PresetBrowser::DataBaseHelpers::setFavorite(favoriteDataBase, presetFile, isFavorite);
+
+	for (auto& p : cachedPresets)
+	{
+		if (p.file == presetFile)
+		{
+			p.favorite = isFavorite;
+			break;
+		}
+	}
+}
+
+void MainController::UserPresetHandler::TagDataBase::setFavoriteDataBase(const File& databaseRoot, const var& newDataBase)
+{
+	ScopedLock sl(lock);
+
+	if (databaseRoot != root)
+		return;
+
+	// The preset browser changes its database without this lock, so we need our own copy
+	favoriteDataBase = newDataBase.clone();
+
+	for (auto& p : cachedPresets)
+		p.favorite = getFavoriteFromDataBase(p.file);
+}
+
+void MainController::UserPresetHandler::TagDataBase::updatePreset(const File& presetFile)
+{
+	auto newEntry = createEntry(presetFile, presetFile.getLastModificationTime().toMilliseconds(), presetFile.getSize());
+
+	ScopedLock sl(lock);
+
+	for (auto& p : cachedPresets)
+	{
+		if (p.file == presetFile)
+		{
+			p = newEntry;
+			return;
+		}
+	}
+
+	// it's a new file, let the next scan add it at the right position
+	dirty = true;
+}
+
+MainController::UserPresetHandler::TagDataBase::CachedPreset MainController::UserPresetHandler::TagDataBase::createEntry(const File& presetFile, int64 modificationTime, int64 fileSize) const
+{
+	CachedPreset p;
+
+	p.file = presetFile;
+	p.modificationTime = modificationTime;
+	p.fileSize = fileSize;
+
+	// Same as getTagsFromXml() & matchesAvailableExpansions(), but it only loads the file once
+	auto content = presetFile.loadFileAsString();
+
+	auto getAttribute = [&content](const String& name)
+	{
+		auto s = name + "=\"";
+
+		if (content.contains(s))
+			return StringArray::fromTokens(content.fromFirstOccurrenceOf(s, false, false).upToFirstOccurrenceOf("\"", false, false), ";", "");
+
+		return StringArray();
+	};
+
+	for (auto t : getAttribute("Tags"))
+	{
+		if (t.isNotEmpty())
+			p.tags.add(Identifier(t));
+	}
+
+	p.requiredExpansions = getAttribute("RequiredExpansions");
+	p.requiredExpansions.removeEmptyStrings(true);
+
+	ScopedLock sl(lock);
+	p.favorite = getFavoriteFromDataBase(presetFile);
+
+	return p;
+}
+
+bool MainController::UserPresetHandler::TagDataBase::getFavoriteFromDataBase(const File& presetFile) const
+{
+	// Same as DataBaseHelpers::isFavorite() without checking the file
+	if (auto data = favoriteDataBase.getDynamicObject())
+	{
+		auto id = PresetBrowser::DataBaseHelpers::getIdForFile(presetFile);
+
+		if (id.isNull())
+			return false;
+
+		if (auto entry = data->getProperty(id).getDynamicObject())
+			return entry->getProperty("Favorite");
+	}
+
+	return false;
+}
+
+void MainController::UserPresetHandler::TagDataBase::run()
+{
+	while (!threadShouldExit())
+	{
+		{
+			ScopedLock sl(scanLock);
+			buildInternal();
+		}
+
+		if (!rescanPending.exchange(false))
+			wait(PollIntervalMilliseconds);
+	}
+}
+
+void MainController::UserPresetHandler::TagDataBase::loadIndexFile()
+{
+	File indexFile;
+
+	{
+		ScopedLock sl(lock);
+		indexFile = getIndexFile();
+	}
+
+	FileInputStream fis(indexFile);
+
+	if (!fis.openedOk())
+		return;
+
+	auto v = ValueTree::readFromStream(fis);
+
+	Array<CachedPreset> loadedPresets;
+
+	ScopedLock sl(lock);
+
+	for (auto c : v)
+	{
+		CachedPreset p;
+		p.file = root.getChildFile(c["File"].toString());
+		p.modificationTime = (int64)c["Modified"];
+		p.fileSize = (int64)c["Size"];
+
+		for (auto t : StringArray::fromTokens(c["Tags"].toString(), ";", ""))
+			p.tags.add(Identifier(t));
+
+		p.requiredExpansions = StringArray::fromTokens(c["RequiredExpansions"].toString(), ";", "");
+		p.requiredExpansions.removeEmptyStrings(true);
+		p.favorite = getFavoriteFromDataBase(p.file);
+
+		loadedPresets.add(std::move(p));
+	}
+
+	cachedPresets.swapWith(loadedPresets);
+
+	// Use the cached index right away, the background thread will check it against the file system
+	dirty = false;
+}
+
+void MainController::UserPresetHandler::TagDataBase::saveIndexFile()
+{
+	ValueTree v("PresetIndex");
+	File indexFile;
+
+	{
+		ScopedLock sl(lock);
+
+		indexFile = getIndexFile();
+
+		for (const auto& p : cachedPresets)
+		{
+			ValueTree c("Preset");
+
+			StringArray tags;
+
+			for (auto t : p.tags)
+				tags.add(t.toString());
+
+			c.setProperty("File", p.file.getRelativePathFrom(root).replaceCharacter('\\', '/'), nullptr);
+			c.setProperty("Modified", p.modificationTime, nullptr);
+			c.setProperty("Size", p.fileSize, nullptr);
+			c.setProperty("Tags", tags.joinIntoString(";"), nullptr);
+			c.setProperty("RequiredExpansions", p.requiredExpansions.joinIntoString(";"), nullptr);
+
+			v.addChild(c, -1, nullptr);
+		}
+	}
+
+	// Write into a temporary file so that a crash doesn't leave a corrupt index behind
+	TemporaryFile tempFile(indexFile);
+
+	{
+		FileOutputStream fos(tempFile.getFile());
+
+		if (!fos.openedOk())
+			return;
+
+		v.writeToStream(fos);
+		fos.flush();
+
+		if (fos.getStatus().failed())
+			return;
+	}
+
+	tempFile.overwriteTargetFileWithTemporary();
 }
 
 struct MainController::UserPresetHandler::CustomAutomationData::CableConnection: 
@@ -149,7 +541,7 @@ struct MainController::UserPresetHandler::CustomAutomationData::CableConnection:
 	float getLastValue() const final override
 	{
 		if (cable != nullptr)
-			return (float)static_cast<scriptnode::routing::GlobalRoutingManager::Cable*>(cable.get())->lastValue;
+			return (float)static_cast<scriptnode::routing::GlobalRoutingManager::Cable*>(cable.get())->getLastValue();
 
 		return 0.0f;
 	}
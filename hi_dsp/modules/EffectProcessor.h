@@ -99,6 +99,9 @@ public:
 
 	/** Overwrite this method if the effect has a tail (produces sound if no input is active */
 	virtual bool hasTail() const = 0;
+
+	/** Override this and return false if the effect writes into another module, so that its synth must be rendered on the audio thread (see HISE_NUM_PARALLEL_SYNTH_THREADS). */
+	virtual bool canBeRenderedInParallel() const { return true; }
 	
 	/** Checks if the effect is tailing off. This simply returns the calculated value, but the EffectChain overwrites this. */
 	bool isTailingOff() const {	return isTailing; };
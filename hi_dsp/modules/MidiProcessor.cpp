@@ -633,7 +633,8 @@ ProcessorEditorBody *MidiProcessorChain::createEditor(ProcessorEditor *parentEdi
 
 void MidiProcessorChain::addArtificialEvent(const HiseEvent& m)
 {
-	artificialEvents.addEvent(m);
+	// The artificial events will be sorted once in renderNextHiseEventBuffer()
+	artificialEvents.appendEvent(m);
 }
 
 bool MidiProcessorChain::setArtificialTimestamp(uint16 eventId, int newTimestamp)
@@ -697,6 +698,8 @@ void MidiProcessorChain::renderNextHiseEventBuffer(HiseEventBuffer &buffer, int
 	buffer.moveEventsAbove(artificialEvents, numSamples);
 	artificialEvents.subtractFromTimeStamps(numSamples);
 
+	getMainController()->getDebugLogger().addEventBufferOverflow(artificialEvents, this);
+
 	logEvents(buffer, false);
 }
 
@@ -251,6 +251,9 @@ public:
 	{
 		Processor::prepareToPlay(sampleRate, samplesPerBlock);
 
+		futureEventBuffer.setCapacity(HiseEventBuffer::getCapacityForBlockSize(samplesPerBlock));
+		artificialEvents.setCapacity(HiseEventBuffer::getCapacityForBlockSize(samplesPerBlock));
+
 		for (auto p : processors)
 			p->prepareToPlay(sampleRate, samplesPerBlock);
 	}
@@ -64,6 +64,7 @@ vuValue(0.0f),
 lastStartedVoice(nullptr),
 group(nullptr),
 voiceLimit(-1),
+internalVoiceLimit(-1),
 iconColour(Colours::transparentBlack),
 clockSpeed(ClockSpeed::Inactive),
 lastClockCounter(0),
@@ -339,6 +340,8 @@ void ModulatorSynth::processHiseEventBuffer(const HiseEventBuffer &inputBuffer,
 	midiProcessorChain->renderNextHiseEventBuffer(eventBuffer, numSamples);
 
 	eventBuffer.alignEventsToRaster<HISE_EVENT_RASTER>(numSamples);
+
+	getMainController()->getDebugLogger().addEventBufferOverflow(eventBuffer, this);
 }
 
 void ModulatorSynth::addProcessorsWhenEmpty()
@@ -815,6 +818,8 @@ void ModulatorSynth::prepareToPlay(double newSampleRate, int samplesPerBlock)
 		ProcessorHelpers::increaseBufferIfNeeded(pitchBuffer, samplesPerBlock);
 		ProcessorHelpers::increaseBufferIfNeeded(gainBuffer, samplesPerBlock);
 		ProcessorHelpers::increaseBufferIfNeeded(internalBuffer, samplesPerBlock);
+
+		eventBuffer.setCapacity(HiseEventBuffer::getCapacityForBlockSize(samplesPerBlock));
 		
 		for(int i = 0; i < getNumVoices(); i++)
 		{
@@ -990,11 +995,7 @@ int ModulatorSynth::collectSoundsToBeStarted(const HiseEvent &m)
 
 	soundsToBeStarted.clearQuick();
 
-	if (soundCollector != nullptr)
-	{
-		soundCollector->collectSounds(m, soundsToBeStarted);
-	}
-	else
+	if (soundCollector == nullptr || !soundCollector->collectSounds(m, soundsToBeStarted))
 	{
 		for (auto s : sounds)
 		{
@@ -1009,6 +1010,35 @@ int ModulatorSynth::collectSoundsToBeStarted(const HiseEvent &m)
 }
 
 
+void ModulatorSynth::SoundLookupIndex::addSound(ModulatorSynthSound* s, int lowKey, int highKey, int lowVelocity, int highVelocity)
+{
+	sounds.add(s);
+
+	lowKey = jlimit(0, 127, lowKey);
+	highKey = jlimit(0, 127, highKey);
+
+	const int bucketSize = 128 / NumVelocityBuckets;
+	const int lowBucket = jlimit(0, NumVelocityBuckets - 1, lowVelocity / bucketSize);
+	const int highBucket = jlimit(0, NumVelocityBuckets - 1, highVelocity / bucketSize);
+
+	for (int k = lowKey; k <= highKey; k++)
+	{
+		for (int b = lowBucket; b <= highBucket; b++)
+			slots[k * NumVelocityBuckets + b].add(s);
+	}
+}
+
+const Array<ModulatorSynthSound*>& ModulatorSynth::SoundLookupIndex::getSounds(int noteNumber, int velocity) const noexcept
+{
+	static const Array<ModulatorSynthSound*> empty;
+
+	if (!isPositiveAndBelow(noteNumber, 128))
+		return empty;
+
+	const int bucket = jlimit(0, NumVelocityBuckets - 1, velocity / (128 / NumVelocityBuckets));
+	return slots[noteNumber * NumVelocityBuckets + bucket];
+}
+
 bool ModulatorSynth::handleVoiceLimit(int numSoundsToBeStarted)
 {
 	auto numFreeVoices = getNumFreeVoices();
@@ -1697,6 +1727,9 @@ void ModulatorSynth::setVoiceLimit(int newVoiceLimit)
 	// The voice limit must be smaller than the total amount of voices!
 	//jassert(voices.size() == 0 || newVoiceLimit <= voices.size());
 
+	const auto prevVoiceLimit = voiceLimit;
+	const auto prevInternalVoiceLimit = internalVoiceLimit;
+
 	voiceLimit = jlimit<int>(2, NUM_POLYPHONIC_VOICES, newVoiceLimit);
 
 	// If the voice amount is less tha
@@ -1704,6 +1737,51 @@ void ModulatorSynth::setVoiceLimit(int newVoiceLimit)
 		internalVoiceLimit = jmax<int>(8, (int)(getMainController()->getVoiceAmountMultiplier() * (float)voiceLimit));
 	else
 		internalVoiceLimit = voiceLimit;
+
+#if HISE_USE_COMPACT_POLY_DATA
+	// The scriptnode networks in this synth allocate their PolyData voice slots
+	// from the voice limit, so they need to be prepared again.
+	const bool limitChanged = voiceLimit != prevVoiceLimit || internalVoiceLimit != prevInternalVoiceLimit;
+
+	if (limitChanged && prevVoiceLimit != -1 && getSampleRate() > 0.0)
+	{
+		auto f = [](Processor* p)
+		{
+			p->prepareToPlay(p->getSampleRate(), p->getLargestBlockSize());
+			return SafeFunctionCall::OK;
+		};
+
+		getMainController()->getKillStateHandler().killVoicesAndCall(this, f, MainController::KillStateHandler::TargetThread::SampleLoadingThread);
+	}
+#else
+	ignoreUnused(prevVoiceLimit, prevInternalVoiceLimit);
+#endif
+}
+
+bool ModulatorSynth::canBeRenderedInParallel() const
+{
+	const Chain::Handler* h = midiProcessorChain->getHandler();
+
+	for (int i = 0; i < h->getNumProcessors(); i++)
+	{
+		// A choke message kills the voices of the other synths
+		if (auto cl = dynamic_cast<const EventIdHandler::ChokeListener*>(h->getProcessor(i)))
+		{
+			if (cl->getChokeGroup() != 0)
+				return false;
+		}
+	}
+
+	const Chain::Handler* fxHandler = effectChain->getHandler();
+
+	for (int i = 0; i < fxHandler->getNumProcessors(); i++)
+	{
+		// eg. a send effect that adds its signal to a send container
+		if (!static_cast<const EffectProcessor*>(fxHandler->getProcessor(i))->canBeRenderedInParallel())
+			return false;
+	}
+
+	return true;
 }
 
 void ModulatorSynth::setKillFadeOutTime(double fadeTimeMilliSeconds)
@@ -270,6 +270,13 @@ public:
 
 	void setKillFadeOutTime(double fadeTimeSeconds);
 
+	/** Override this and return false if the synth must not be rendered in parallel to its siblings (eg. because other synths depend on it). 
+	
+		The default implementation returns false if a MIDI processor sends choke messages to other synths
+		or if an effect can't be rendered in parallel (eg. a send effect).
+	*/
+	virtual bool canBeRenderedInParallel() const;
+
 		/** Checks if the message fits the sound, but can be overriden to implement other group start logic. */
 	virtual bool soundCanBePlayed(ModulatorSynthSound *sound, int midiChannel, int midiNoteNumber, float velocity);
 
@@ -285,7 +292,34 @@ public:
 
 		virtual ~SoundCollectorBase() {};
 
-		virtual void collectSounds(const HiseEvent& m, UnorderedStack<ModulatorSynthSound*>& soundsToBeStarted) = 0;
+		/** Fill the soundsToBeStarted array and return true or return false if the default search should be used. */
+		virtual bool collectSounds(const HiseEvent& m, UnorderedStack<ModulatorSynthSound*>& soundsToBeStarted) = 0;
+	};
+
+	/** A lookup table that sorts the sounds by their key and velocity range.
+	
+		This can be used by a SoundCollectorBase to only check the sounds that are mapped to the
+		note number and velocity range of the note on message instead of iterating over all sounds.
+		It holds a reference to every sound, so make sure you build and swap it outside the audio thread.
+	*/
+	class SoundLookupIndex
+	{
+	public:
+
+		static constexpr int NumVelocityBuckets = 8;
+
+		/** Adds the sound to every slot within the given key and velocity ranges (inclusive). */
+		void addSound(ModulatorSynthSound* s, int lowKey, int highKey, int lowVelocity, int highVelocity);
+
+		/** Returns all sounds that are mapped to the key and the velocity bucket of the given velocity (0-127). */
+		const Array<ModulatorSynthSound*>& getSounds(int noteNumber, int velocity) const noexcept;
+
+		int getNumSounds() const noexcept { return sounds.size(); }
+
+	private:
+
+		ReferenceCountedArray<ModulatorSynthSound> sounds;
+		Array<ModulatorSynthSound*> slots[128 * NumVelocityBuckets];
 	};
 
 	/** This method should go through all sounds that are playable and fill the soundsToBeStarted array. */
@@ -70,6 +70,8 @@ ModulatorSynthChain::ModulatorSynthChain(MainController *mc, const String &id, i
 
 ModulatorSynthChain::~ModulatorSynthChain()
 {
+	parallelRenderer = nullptr;
+
 	modChains.clear();
 
 	getHandler()->clear();
@@ -120,6 +122,225 @@ void ModulatorSynthChain::prepareToPlay(double newSampleRate, int samplesPerBloc
 
 	for (auto s: synths)
 		s->prepareToPlay(newSampleRate, samplesPerBlock);
+
+	if (samplesPerBlock > 0 && getMainController()->getMainSynthChain() == this)
+	{
+		if (numParallelRenderThreads == 0)
+			parallelRenderer = nullptr;
+		else
+		{
+			if (parallelRenderer == nullptr || parallelRenderer->getNumWorkerThreads() != numParallelRenderThreads)
+				parallelRenderer = new ParallelRenderer(*this, numParallelRenderThreads);
+
+			parallelRenderer->prepareToPlay(samplesPerBlock);
+		}
+	}
+}
+
+bool ModulatorSynthChain::canBeRenderedInParallel() const
+{
+	if (!ModulatorSynth::canBeRenderedInParallel())
+		return false;
+
+	for (auto s : synths)
+	{
+		if (!s->canBeRenderedInParallel())
+			return false;
+	}
+
+	return true;
+}
+
+ModulatorSynthChain::ParallelRenderer::ParallelRenderer(ModulatorSynthChain& parent_, int numWorkerThreads) :
+	parent(parent_)
+{
+	for (auto& state : jobStates)
+		state.store(Idle);
+
+	for (int i = 0; i < numWorkerThreads; i++)
+		workers.add(new Worker(*this, i + 1));
+}
+
+ModulatorSynthChain::ParallelRenderer::~ParallelRenderer()
+{
+	workers.clear();
+}
+
+void ModulatorSynthChain::ParallelRenderer::prepareToPlay(int samplesPerBlock)
+{
+	blockSize = samplesPerBlock;
+
+	while (synthBuffers.size() < parent.synths.size())
+		synthBuffers.add(new AudioSampleBuffer());
+
+	for (auto b : synthBuffers)
+		b->setSize(NUM_MAX_CHANNELS, samplesPerBlock);
+}
+
+void ModulatorSynthChain::ParallelRenderer::renderChildSynths(AudioSampleBuffer& buffer, const HiseEventBuffer& eventBuffer)
+{
+	auto& synths = parent.synths;
+
+	// The buffers are not prepared for this block size or synth amount
+	if (buffer.getNumSamples() > blockSize || 
+		buffer.getNumChannels() > NUM_MAX_CHANNELS ||
+		synths.size() > synthBuffers.size())
+	{
+		for (auto s : synths)
+		{
+			if (!s->isSoftBypassed())
+				s->renderNextBlockWithModulators(buffer, eventBuffer);
+		}
+
+		return;
+	}
+
+	int i = 0;
+
+	while (i < synths.size())
+	{
+		auto s = synths[i];
+
+		if (s->isSoftBypassed())
+		{
+			i++;
+			continue;
+		}
+
+		if (!s->canBeRenderedInParallel())
+		{
+			// Render it in the original order so that the synths after it can use its output
+			s->renderNextBlockWithModulators(buffer, eventBuffer);
+			i++;
+			continue;
+		}
+
+		int end = i + 1;
+
+		while (end < synths.size() && (synths[end]->isSoftBypassed() || synths[end]->canBeRenderedInParallel()))
+			end++;
+
+		renderRange(i, end, buffer, eventBuffer);
+
+		i = end;
+	}
+}
+
+void ModulatorSynthChain::ParallelRenderer::renderRange(int startIndex, int endIndex, AudioSampleBuffer& buffer, const HiseEventBuffer& eventBuffer)
+{
+	int synthIndexes[MaxNumJobs];
+	int numJobs = 0;
+
+	for (int i = startIndex; i < endIndex; i++)
+	{
+		if (parent.synths[i]->isSoftBypassed())
+			continue;
+
+		synthIndexes[numJobs++] = i;
+
+		if (numJobs == MaxNumJobs)
+		{
+			renderBatch(synthIndexes, numJobs, buffer, eventBuffer);
+			numJobs = 0;
+		}
+	}
+
+	renderBatch(synthIndexes, numJobs, buffer, eventBuffer);
+}
+
+void ModulatorSynthChain::ParallelRenderer::renderBatch(const int* synthIndexes, int numJobsToRender, AudioSampleBuffer& buffer, const HiseEventBuffer& eventBuffer)
+{
+	if (numJobsToRender < 2)
+	{
+		for (int i = 0; i < numJobsToRender; i++)
+			parent.synths[synthIndexes[i]]->renderNextBlockWithModulators(buffer, eventBuffer);
+
+		return;
+	}
+
+	currentNumSamples = buffer.getNumSamples();
+	currentNumChannels = buffer.getNumChannels();
+	currentEvents = &eventBuffer;
+
+	for (int i = 0; i < numJobsToRender; i++)
+	{
+		jobSynthIndexes[i] = synthIndexes[i];
+		jobStates[i].store(Pending, std::memory_order_release);
+	}
+
+	const int numWorkersToWake = jmin(numJobsToRender - 1, workers.size());
+
+	for (int i = 0; i < numWorkersToWake; i++)
+		workers[i]->notify();
+
+	// Render everything that the workers haven't picked up yet
+	renderPendingJobs();
+
+	// The remaining jobs are being rendered by a worker right now
+	for (int i = 0; i < numJobsToRender; i++)
+	{
+		while (jobStates[i].load(std::memory_order_acquire) != Finished)
+			;
+	}
+
+	// Add the synth buffers in the original order so that the result matches the serial rendering
+	for (int i = 0; i < numJobsToRender; i++)
+	{
+		auto synthBuffer = synthBuffers[jobSynthIndexes[i]];
+
+		for (int c = 0; c < currentNumChannels; c++)
+			buffer.addFrom(c, 0, *synthBuffer, c, 0, currentNumSamples);
+
+		jobStates[i].store(Idle, std::memory_order_relaxed);
+	}
+
+	currentEvents = nullptr;
+}
+
+void ModulatorSynthChain::ParallelRenderer::renderPendingJobs()
+{
+	for (int i = 0; i < MaxNumJobs; i++)
+	{
+		int expected = Pending;
+
+		if (!jobStates[i].compare_exchange_strong(expected, Claimed, std::memory_order_acquire))
+			continue;
+
+		auto synthIndex = jobSynthIndexes[i];
+
+		AudioSampleBuffer synthBuffer(synthBuffers[synthIndex]->getArrayOfWritePointers(), currentNumChannels, currentNumSamples);
+		synthBuffer.clear();
+
+		parent.synths[synthIndex]->renderNextBlockWithModulators(synthBuffer, *currentEvents);
+
+		jobStates[i].store(Finished, std::memory_order_release);
+	}
+}
+
+ModulatorSynthChain::ParallelRenderer::Worker::Worker(ParallelRenderer& parent_, int workerIndex) :
+	Thread("Synth Render Thread " + String(workerIndex)),
+	parent(parent_)
+{
+	startThread(10);
+}
+
+ModulatorSynthChain::ParallelRenderer::Worker::~Worker()
+{
+	stopThread(1000);
+}
+
+void ModulatorSynthChain::ParallelRenderer::Worker::run()
+{
+	// The synths will check that they are rendered on the audio thread
+	parent.parent.getMainController()->getKillStateHandler().addThreadIdToAudioThreadList();
+
+	while (!threadShouldExit())
+	{
+		wait(-1);
+
+		// A worker that wakes up too late finds no pending job and goes back to sleep
+		parent.renderPendingJobs();
+	}
 }
 
 void ModulatorSynthChain::numSourceChannelsChanged()
@@ -263,11 +484,16 @@ void ModulatorSynthChain::renderNextBlockWithModulators(AudioSampleBuffer &buffe
 #endif
 
 	// Process the Synths and add store their output in the internal buffer
-	for (int i = 0; i < synths.size(); i++)
-    {
-        if (!synths[i]->isSoftBypassed())
-            synths[i]->renderNextBlockWithModulators(internalBuffer, eventBuffer);
-    }
+	if (parallelRenderer != nullptr)
+		parallelRenderer->renderChildSynths(internalBuffer, eventBuffer);
+	else
+	{
+		for (int i = 0; i < synths.size(); i++)
+		{
+			if (!synths[i]->isSoftBypassed())
+				synths[i]->renderNextBlockWithModulators(internalBuffer, eventBuffer);
+		}
+	}
 
 	HiseEventBuffer::Iterator eventIterator(eventBuffer);
 
@@ -553,6 +779,9 @@ void ModulatorSynthChain::ModulatorSynthChainHandler::add(Processor *newProcesso
 		LOCK_PROCESSING_CHAIN(synth);
 		ms->setIsOnAir(synth->isOnAir());
 		synth->synths.insert(index, ms);
+
+		if (synth->parallelRenderer != nullptr)
+			synth->parallelRenderer->prepareToPlay(bs);
 	}
 
 	notifyListeners(Listener::ProcessorAdded, newProcessor);
@@ -177,6 +177,15 @@ public:
 
 	int getVoiceAmount() const {return numVoices;};
 
+	/** Returns false if one of the child synths can't be rendered in parallel. */
+	bool canBeRenderedInParallel() const override;
+
+	/** Overrides the amount of worker threads set by HISE_NUM_PARALLEL_SYNTH_THREADS. 
+	
+		This will be applied at the next call to prepareToPlay() of the root container.
+	*/
+	void setNumParallelRenderThreads(int numWorkerThreads) { numParallelRenderThreads = jmax(0, numWorkerThreads); }
+
 	int getNumActiveVoices() const override;
 
 	void killAllVoices() override;
@@ -231,6 +240,76 @@ public:
 
 private:
 
+	/** Renders the child synths of the root container on multiple threads (see HISE_NUM_PARALLEL_SYNTH_THREADS). 
+	
+		Every child synth renders into its own buffer and the buffers are added in the original order 
+		of the synths, so the result is bit-identical to the serial rendering.
+
+		Each synth is a job that the audio thread and the workers claim with an atomic compare-and-swap.
+		The audio thread renders every job that no worker has claimed yet, so it never waits for a worker
+		to wake up. It only waits for the jobs that a worker is rendering at that moment.
+	*/
+	class ParallelRenderer
+	{
+	public:
+
+		ParallelRenderer(ModulatorSynthChain& parent_, int numWorkerThreads);
+		~ParallelRenderer();
+
+		/** Allocates a buffer for each child synth. Call this whenever a synth is added (with the processing lock). */
+		void prepareToPlay(int samplesPerBlock);
+
+		int getNumWorkerThreads() const { return workers.size(); }
+
+		/** Renders all child synths and adds their output to the buffer. */
+		void renderChildSynths(AudioSampleBuffer& buffer, const HiseEventBuffer& eventBuffer);
+
+	private:
+
+		struct Worker : public Thread
+		{
+			Worker(ParallelRenderer& parent_, int workerIndex);
+			~Worker();
+
+			void run() override;
+
+			ParallelRenderer& parent;
+		};
+
+		enum JobState
+		{
+			Idle,
+			Pending,
+			Claimed,
+			Finished
+		};
+
+		/** The maximum amount of synths that are rendered in one batch. Longer ranges are split into several batches. */
+		static constexpr int MaxNumJobs = 64;
+
+		void renderRange(int startIndex, int endIndex, AudioSampleBuffer& buffer, const HiseEventBuffer& eventBuffer);
+		void renderBatch(const int* synthIndexes, int numJobsToRender, AudioSampleBuffer& buffer, const HiseEventBuffer& eventBuffer);
+
+		/** Claims and renders all pending jobs. This is called by the audio thread and the workers. */
+		void renderPendingJobs();
+
+		ModulatorSynthChain& parent;
+
+		// The job data for the current batch. It is written before the jobs are set to Pending.
+		int currentNumSamples = 0;
+		int currentNumChannels = 0;
+		const HiseEventBuffer* currentEvents = nullptr;
+		int jobSynthIndexes[MaxNumJobs];
+		std::atomic<int> jobStates[MaxNumJobs];
+
+		int blockSize = 0;
+		OwnedArray<AudioSampleBuffer> synthBuffers;
+		OwnedArray<Worker> workers;
+	};
+
+	int numParallelRenderThreads = HISE_NUM_PARALLEL_SYNTH_THREADS;
+	ScopedPointer<ParallelRenderer> parallelRenderer;
+
 	HiseEvent::ChannelFilterData activeChannels;
 	ModulatorSynthChainHandler handler;
 	int numVoices;
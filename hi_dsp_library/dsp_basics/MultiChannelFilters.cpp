@@ -250,9 +250,27 @@ void MultiChannelFilter<FilterSubType>::clearCoefficients()
 	dirty = true;
 }
 
+template <class FilterSubType>
+bool MultiChannelFilter<FilterSubType>::isConstantSinceLastUpdate(double freqMod, double bipolarDelta, double gainMod, double qMod) noexcept
+{
+	const double input[numLastInputs] = { frequency.getCurrentValue(), q.getCurrentValue(), gain.getCurrentValue(), 
+										  freqMod, bipolarDelta, gainMod, qMod };
+
+	auto isSmoothing = frequency.isSmoothing() || q.isSmoothing() || gain.isSmoothing();
+
+	if (!dirty && !isSmoothing && std::equal(input, input + numLastInputs, lastInput))
+		return true;
+
+	std::copy(input, input + numLastInputs, lastInput);
+	return false;
+}
+
 template <class FilterSubType>
 void MultiChannelFilter<FilterSubType>::updateEvery64Frame()
 {
+	if (isConstantSinceLastUpdate(1.0, 0.0, 1.0, 1.0))
+		return;
+
 	auto thisFreq = FilterLimits::limitFrequency(frequency.getNextValue());
 	auto thisGain = gain.getNextValue();
 	auto thisQ = FilterLimits::limitQ(q.getNextValue());
@@ -271,6 +289,10 @@ void MultiChannelFilter<FilterSubType>::updateEvery64Frame()
 template <class FilterSubType>
 void MultiChannelFilter<FilterSubType>::update(FilterHelpers::RenderData& renderData)
 {
+	// Skip the smoothing and limiting if the coefficients are constant for this block
+	if (isConstantSinceLastUpdate(renderData.freqModValue, renderData.bipolarDelta, renderData.gainModValue, renderData.qModValue))
+		return;
+
 	auto f = frequency.getNextValue() * renderData.freqModValue;
 	auto bp = renderData.bipolarDelta;
 
@@ -614,6 +636,118 @@ void RingmodFilterSubType::processFrame(float* d, int numChannels)
 
 DEFINE_MULTI_CHANNEL_FILTER(RingmodFilterSubType);
 
+/** Processes up to four channels of a block side by side in the lanes of a SSE register.
+
+	The recursive filters are limited by the latency of their feedback path, so running the
+	channels in parallel is almost as fast as processing a single channel.
+
+	The kernel needs these methods:
+
+		void load(int firstChannel, int numChannels);  // loads the state into the lanes
+		__m128 tick(__m128 input);					// processes one frame
+		void store(int firstChannel, int numChannels); // writes the state back
+*/
+struct InterleavedChannelProcessor
+{
+	static constexpr int NumLanes = 4;
+
+	static __m128 loadLanes(const float* data, int numChannels)
+	{
+		alignas(16) float lanes[NumLanes] = { 0.0f, 0.0f, 0.0f, 0.0f };
+
+		for (int i = 0; i < numChannels; i++)
+			lanes[i] = data[i];
+
+		return _mm_load_ps(lanes);
+	}
+
+	static void storeLanes(float* data, __m128 v, int numChannels)
+	{
+		alignas(16) float lanes[NumLanes];
+		_mm_store_ps(lanes, v);
+
+		for (int i = 0; i < numChannels; i++)
+			data[i] = lanes[i];
+	}
+
+	template <typename KernelType> static void process(const KernelType& k, AudioSampleBuffer& b, int startSample, int numSamples)
+	{
+		auto numChannels = b.getNumChannels();
+
+		for (int firstChannel = 0; firstChannel < numChannels; firstChannel += NumLanes)
+		{
+			auto numInGroup = jmin(NumLanes, numChannels - firstChannel);
+			float* channels[NumLanes];
+
+			for (int i = 0; i < numInGroup; i++)
+				channels[i] = b.getWritePointer(firstChannel + i, startSample);
+
+			// Work on a local copy so that the compiler can keep the state in registers
+			// (the SSE types may alias the float pointers of the buffer)
+			KernelType groupKernel(k);
+
+			groupKernel.load(firstChannel, numInGroup);
+
+			switch (numInGroup)
+			{
+			case 1: processGroup<1>(groupKernel, channels, numSamples); break;
+			case 2: processGroup<2>(groupKernel, channels, numSamples); break;
+			case 3: processGroup<3>(groupKernel, channels, numSamples); break;
+			case 4: processGroup<4>(groupKernel, channels, numSamples); break;
+			default: jassertfalse; break;
+			}
+
+			groupKernel.store(firstChannel, numInGroup);
+		}
+	}
+
+private:
+
+	template <int Lane> static float getLane(__m128 v)
+	{
+		return _mm_cvtss_f32(_mm_shuffle_ps(v, v, _MM_SHUFFLE(Lane, Lane, Lane, Lane)));
+	}
+
+	// Builds the frame in registers (going through memory would stall the store forwarding)
+	template <int NumChannels> static __m128 loadFrame(float** channels, int i)
+	{
+		auto l0 = _mm_load_ss(channels[0] + i);
+
+		if (NumChannels == 1)
+			return l0;
+
+		auto l01 = _mm_unpacklo_ps(l0, _mm_load_ss(channels[1] + i));
+
+		if (NumChannels == 2)
+			return l01;
+
+		auto l2 = _mm_load_ss(channels[NumChannels > 2 ? 2 : 0] + i);
+		auto l3 = NumChannels == 4 ? _mm_load_ss(channels[NumChannels > 3 ? 3 : 0] + i) : _mm_setzero_ps();
+
+		return _mm_movelh_ps(l01, _mm_unpacklo_ps(l2, l3));
+	}
+
+	template <int NumChannels> static void storeFrame(float** channels, int i, __m128 v)
+	{
+		_mm_store_ss(channels[0] + i, v);
+
+		if (NumChannels > 1)
+			channels[NumChannels > 1 ? 1 : 0][i] = getLane<1>(v);
+
+		if (NumChannels > 2)
+			channels[NumChannels > 2 ? 2 : 0][i] = getLane<2>(v);
+
+		if (NumChannels > 3)
+			channels[NumChannels > 3 ? 3 : 0][i] = getLane<3>(v);
+	}
+
+	template <int NumChannels, typename KernelType> static void processGroup(KernelType& k, float** channels, int numSamples)
+	{
+		for (int i = 0; i < numSamples; i++)
+			storeFrame<NumChannels>(channels, i, k.tick(loadFrame<NumChannels>(channels, i)));
+	}
+};
+
 hise::FilterHelpers::FilterSubType StaticBiquadSubType::getFilterType()
 {
 	return FilterHelpers::FilterSubType::StaticBiquadSubType;
@@ -649,10 +783,6 @@ void StaticBiquadSubType::updateCoefficients(double sampleRate, double frequency
 	default:							jassertfalse; break;
 	}
 
-	for (int i = 0; i < numChannels; i++)
-	{
-		filters[i].setCoefficients(currentCoefficients);
-	}
 }
 
 void StaticBiquadSubType::setType(int newType)
@@ -667,26 +797,77 @@ void StaticBiquadSubType::reset(int numNewChannels)
 
 	for (int i = 0; i < numChannels; i++)
 	{
-		filters[i].reset();
+		v1[i] = 0.0f;
+		v2[i] = 0.0f;
 	}
 }
 
-void StaticBiquadSubType::processSamples(AudioSampleBuffer& b, int startSample, int numSamples)
+struct BiquadKernel
 {
-	int channelAmount = b.getNumChannels();
+	using Helpers = InterleavedChannelProcessor;
+
+	BiquadKernel(const IIRCoefficients& c, float* v1State, float* v2State) :
+		c0(_mm_set1_ps(c.coefficients[0])),
+		c1(_mm_set1_ps(c.coefficients[1])),
+		c2(_mm_set1_ps(c.coefficients[2])),
+		c3(_mm_set1_ps(c.coefficients[3])),
+		c4(_mm_set1_ps(c.coefficients[4])),
+		v1Data(v1State),
+		v2Data(v2State)
+	{}
 
-	for (int i = 0; i < channelAmount; i++)
+	void load(int firstChannel, int numChannels)
 	{
-		float* d = b.getWritePointer(i, startSample);
-		filters[i].processSamples(d, numSamples);
+		v1 = Helpers::loadLanes(v1Data + firstChannel, numChannels);
+		v2 = Helpers::loadLanes(v2Data + firstChannel, numChannels);
 	}
+
+	__m128 tick(__m128 in)
+	{
+		auto out = _mm_add_ps(_mm_mul_ps(c0, in), v1);
+		v1 = _mm_add_ps(_mm_sub_ps(_mm_mul_ps(c1, in), _mm_mul_ps(c3, out)), v2);
+		v2 = _mm_sub_ps(_mm_mul_ps(c2, in), _mm_mul_ps(c4, out));
+		return out;
+	}
+
+	void store(int firstChannel, int numChannels)
+	{
+		Helpers::storeLanes(v1Data + firstChannel, v1, numChannels);
+		Helpers::storeLanes(v2Data + firstChannel, v2, numChannels);
+
+		for (int i = 0; i < numChannels; i++)
+		{
+			JUCE_SNAP_TO_ZERO(v1Data[firstChannel + i]);
+			JUCE_SNAP_TO_ZERO(v2Data[firstChannel + i]);
+		}
+	}
+
+	__m128 c0, c1, c2, c3, c4;
+	__m128 v1, v2;
+	float* v1Data;
+	float* v2Data;
+};
+
+void StaticBiquadSubType::processSamples(AudioSampleBuffer& b, int startSample, int numSamples)
+{
+	BiquadKernel k(currentCoefficients, v1, v2);
+	InterleavedChannelProcessor::process(k, b, startSample, numSamples);
 }
 
 void StaticBiquadSubType::processFrame(float* d, int channels)
 {
+	auto c = currentCoefficients.coefficients;
+
 	for (int i = 0; i < channels; i++)
 	{
-		d[i] = filters[i].processSingleSampleRaw(d[i]);
+		auto in = d[i];
+		auto out = c[0] * in + v1[i];
+
+		JUCE_SNAP_TO_ZERO(out);
+
+		v1[i] = c[1] * in - c[3] * out + v2[i];
+		v2[i] = c[2] * in - c[4] * out;
+		d[i] = out;
 	}
 }
 
@@ -943,117 +1124,136 @@ void StateVariableFilterSubType::updateCoefficients(double sampleRate, double fr
 	}
 }
 
-void StateVariableFilterSubType::processSamples(AudioSampleBuffer& buffer, int startSample, int numSamples)
+template <int FilterType> struct StateVariableKernel
 {
-	auto numChannels = buffer.getNumChannels();
+	using Helpers = InterleavedChannelProcessor;
 
-	switch (type)
+	StateVariableKernel(float* v0zState, float* z1State, float* v2State, float g1_, float g2_, float g3_, float g4_, float k_) :
+		g1(_mm_set1_ps(g1_)),
+		g2(_mm_set1_ps(g2_)),
+		g3(_mm_set1_ps(g3_)),
+		g4(_mm_set1_ps(g4_)),
+		k(_mm_set1_ps(k_)),
+		two(_mm_set1_ps(2.0f)),
+		v0zData(v0zState),
+		z1Data(z1State),
+		v2Data(v2State)
+	{}
+
+	void load(int firstChannel, int numChannels)
 	{
-	case LP:
+		v0z = Helpers::loadLanes(v0zData + firstChannel, numChannels);
+		z1 = Helpers::loadLanes(z1Data + firstChannel, numChannels);
+		v2 = Helpers::loadLanes(v2Data + firstChannel, numChannels);
+	}
+
+	__m128 tick(__m128 v0)
 	{
-		for (int c = 0; c < numChannels; c++)
-		{
-			float* d = buffer.getWritePointer(c, startSample);
+		auto v1z = z1;
+		auto v3 = _mm_sub_ps(_mm_add_ps(v0, v0z), _mm_mul_ps(two, v2));
+		z1 = _mm_add_ps(z1, _mm_sub_ps(_mm_mul_ps(g1, v3), _mm_mul_ps(g2, v1z)));
+		v2 = _mm_add_ps(v2, _mm_add_ps(_mm_mul_ps(g3, v3), _mm_mul_ps(g4, v1z)));
+		v0z = v0;
 
-			for (int i = 0; i < numSamples; i++)
-			{
-				float v0 = d[i];
-				float v1z = z1_A[c];
-				float v2z = v2[c];
-				float v3 = v0 + v0z[c] - 2.0f * v2z;
-				z1_A[c] += g1 * v3 - g2 * v1z;
-				v2[c] += g3 * v3 + g4 * v1z;
-				v0z[c] = v0;
-				d[i] = v2[c];
-			}
+		switch (FilterType)
+		{
+		case StateVariableFilterSubType::LP:	return v2;
+		case StateVariableFilterSubType::BP:	return z1;
+		case StateVariableFilterSubType::HP:	return _mm_sub_ps(_mm_sub_ps(v0, _mm_mul_ps(k, z1)), v2);
+		case StateVariableFilterSubType::NOTCH: return _mm_sub_ps(v0, _mm_mul_ps(k, z1));
+		default:								return v0;
 		}
-
-		break;
 	}
-	case BP:
+
+	void store(int firstChannel, int numChannels)
 	{
-		for (int c = 0; c < numChannels; c++)
-		{
-			float* d = buffer.getWritePointer(c, startSample);
+		Helpers::storeLanes(v0zData + firstChannel, v0z, numChannels);
+		Helpers::storeLanes(z1Data + firstChannel, z1, numChannels);
+		Helpers::storeLanes(v2Data + firstChannel, v2, numChannels);
+	}
 
-			for (int i = 0; i < numSamples; i++)
-			{
-				float v0 = d[i];
-				float v1z = z1_A[c];
-				float v2z = v2[c];
-				float v3 = v0 + v0z[c] - 2.0f * v2z;
-				z1_A[c] += g1 * v3 - g2 * v1z;
-				v2[c] += g3 * v3 + g4 * v1z;
-				v0z[c] = v0;
-				d[i] = z1_A[c];
-			}
-		}
+	__m128 g1, g2, g3, g4, k, two;
+	__m128 v0z, z1, v2;
+	float* v0zData;
+	float* z1Data;
+	float* v2Data;
+};
 
-		break;
+struct StateVariableAllpassKernel
+{
+	using Helpers = InterleavedChannelProcessor;
+
+	StateVariableAllpassKernel(float* z1State, float* v2State, float x1_, float x2_, float gCoeff_, float RCoeff_) :
+		x1(_mm_set1_ps(x1_)),
+		x2(_mm_set1_ps(x2_)),
+		g(_mm_set1_ps(gCoeff_)),
+		r4(_mm_set1_ps(4.0f * RCoeff_)),
+		z1Data(z1State),
+		v2Data(v2State)
+	{}
+
+	void load(int firstChannel, int numChannels)
+	{
+		z1 = Helpers::loadLanes(z1Data + firstChannel, numChannels);
+		v2 = Helpers::loadLanes(v2Data + firstChannel, numChannels);
 	}
 
-	case HP:
+	__m128 tick(__m128 input)
 	{
-		for (int c = 0; c < numChannels; c++)
-		{
-			float* d = buffer.getWritePointer(c, startSample);
+		auto hp = _mm_div_ps(_mm_sub_ps(_mm_sub_ps(input, _mm_mul_ps(x1, z1)), v2), x2);
+		auto bp = _mm_add_ps(_mm_mul_ps(hp, g), z1);
+		auto lp = _mm_add_ps(_mm_mul_ps(bp, g), v2);
 
-			for (int i = 0; i < numSamples; i++)
-			{
-				float v0 = d[i];
-				float v1z = z1_A[c];
-				float v2z = v2[c];
-				float v3 = v0 + v0z[c] - 2.0f * v2z;
-				z1_A[c] += g1 * v3 - g2 * v1z;
-				v2[c] += g3 * v3 + g4 * v1z;
-				v0z[c] = v0;
-				d[i] = v0 - k * z1_A[c] - v2[c];
-			}
-		}
+		z1 = _mm_add_ps(_mm_mul_ps(g, hp), bp);
+		v2 = _mm_add_ps(_mm_mul_ps(g, bp), lp);
 
-		break;
+		return _mm_sub_ps(input, _mm_mul_ps(r4, bp));
 	}
-	case FilterType::ALLPASS:
-	{
-		for (int c = 0; c < numChannels; c++)
-		{
-			float* d = buffer.getWritePointer(c, startSample);
 
-			for (int i = 0; i < numSamples; ++i)
-			{
-				const float input = d[i];
-				const float HP = (input - x1 * z1_A[c] - v2[c]) / x2;
-				const float BP = HP * gCoeff + z1_A[c];
-				const float LP = BP * gCoeff + v2[c];
+	void store(int firstChannel, int numChannels)
+	{
+		Helpers::storeLanes(z1Data + firstChannel, z1, numChannels);
+		Helpers::storeLanes(v2Data + firstChannel, v2, numChannels);
+	}
 
-				z1_A[c] = gCoeff * HP + BP;
-				v2[c] = gCoeff * BP + LP;
+	__m128 x1, x2, g, r4;
+	__m128 z1, v2;
+	float* z1Data;
+	float* v2Data;
+};
 
-				const float AP = input - (4.0f * RCoeff * BP);
-				d[i] = AP;
-			}
-		}
+void StateVariableFilterSubType::processSamples(AudioSampleBuffer& buffer, int startSample, int numSamples)
+{
+	switch (type)
+	{
+	case LP:
+	{
+		StateVariableKernel<LP> kernel(v0z, z1_A, v2, g1, g2, g3, g4, k);
+		InterleavedChannelProcessor::process(kernel, buffer, startSample, numSamples);
+		break;
+	}
+	case HP:
+	{
+		StateVariableKernel<HP> kernel(v0z, z1_A, v2, g1, g2, g3, g4, k);
+		InterleavedChannelProcessor::process(kernel, buffer, startSample, numSamples);
+		break;
+	}
+	case BP:
+	{
+		StateVariableKernel<BP> kernel(v0z, z1_A, v2, g1, g2, g3, g4, k);
+		InterleavedChannelProcessor::process(kernel, buffer, startSample, numSamples);
 		break;
 	}
 	case NOTCH:
 	{
-		for (int c = 0; c < numChannels; c++)
-		{
-			float* d = buffer.getWritePointer(c, startSample);
-
-			for (int i = 0; i < numSamples; i++)
-			{
-				float v0 = d[i];
-				float v1z = z1_A[c];
-				float v2z = v2[c];
-				float v3 = v0 + v0z[c] - 2.0f * v2z;
-				z1_A[c] += g1 * v3 - g2 * v1z;
-				v2[c] += g3 * v3 + g4 * v1z;
-				v0z[c] = v0;
-				d[i] = v0 - k * z1_A[c];
-			}
-		}
-
+		StateVariableKernel<NOTCH> kernel(v0z, z1_A, v2, g1, g2, g3, g4, k);
+		InterleavedChannelProcessor::process(kernel, buffer, startSample, numSamples);
+		break;
+	}
+	case ALLPASS:
+	{
+		StateVariableAllpassKernel kernel(z1_A, v2, x1, x2, gCoeff, RCoeff);
+		InterleavedChannelProcessor::process(kernel, buffer, startSample, numSamples);
 		break;
 	}
 	default:
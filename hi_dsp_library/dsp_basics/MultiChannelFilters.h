@@ -168,6 +168,10 @@ private:
 	void updateEvery64Frame();
 	void update(FilterHelpers::RenderData& renderData);
 
+	/** Returns true if the coefficients can't have changed since the last update. This
+	    stores the given input so it must only be called once per update. */
+	bool isConstantSinceLastUpdate(double freqMod, double bipolarDelta, double gainMod, double qMod) noexcept;
+
 	bool dirty = false;
 
 	double smoothingTimeSeconds = 0.03;
@@ -184,6 +188,20 @@ private:
 	double targetQ = 1.0;
 	double targetGain = 1.0;
 
+	enum LastInputIndex
+	{
+		SmoothedFreq,
+		SmoothedQ,
+		SmoothedGain,
+		FreqMod,
+		BipolarDelta,
+		GainMod,
+		QMod,
+		numLastInputs
+	};
+
+	double lastInput[numLastInputs] = { 0.0 };
+
 	int frameCounter = 0;
 	int type = -1;
 	int numChannels = 2;
@@ -423,8 +441,13 @@ private:
 
 	int numChannels = NUM_MAX_CHANNELS;
 
-	IIRCoefficients currentCoefficients;
-	IIRFilter filters[NUM_MAX_CHANNELS];
+	// Starts as a pass-through until the first coefficient calculation
+	IIRCoefficients currentCoefficients = IIRCoefficients(1.0, 0.0, 0.0, 1.0, 0.0, 0.0);
+
+	// The transposed direct form II state of each channel
+	float v1[NUM_MAX_CHANNELS] = { 0.0f };
+	float v2[NUM_MAX_CHANNELS] = { 0.0f };
+
 	FilterType biquadType;
 };
 
@@ -431,6 +431,111 @@ float ahdsr_base::state_base::tick()
 	return state->current_value;
 }
 
+void ahdsr_base::state_base::tickBlock(float* data, int numSamples)
+{
+	while (numSamples > 0)
+	{
+		const float thisSustain = envelope->sustain * modValues[3];
+		int numDone = 0;
+
+		active = current_state != state_base::IDLE;
+
+		switch (current_state)
+		{
+		case state_base::IDLE:
+		{
+			FloatSanitizers::sanitizeFloatNumber(current_value);
+			FloatVectorOperations::fill(data, current_value, numSamples);
+			numDone = numSamples;
+			break;
+		}
+		case state_base::ATTACK:
+		{
+			if (envelope->attack != 0.0f)
+			{
+				const float targetLevel = attackLevel > thisSustain ? attackLevel : thisSustain;
+				numDone = renderExponentialSegment(data, numSamples, attackBase, attackCoef, [targetLevel](float v) { return v >= targetLevel; });
+			}
+
+			break;
+		}
+		case state_base::HOLD:
+		{
+			// tick() leaves the hold state when the counter reaches the hold time
+			const int numHoldSamples = (int)std::ceil(envelope->holdTimeSamples) - holdCounter - 1;
+			numDone = jlimit(0, numSamples, numHoldSamples);
+
+			if (numDone > 0)
+			{
+				current_value = attackLevel;
+				holdCounter += numDone;
+				FloatVectorOperations::fill(data, current_value, numDone);
+			}
+
+			break;
+		}
+		case state_base::DECAY:
+		{
+			if (envelope->decay != 0.0f)
+				numDone = renderExponentialSegment(data, numSamples, decayBase, decayCoef, [thisSustain](float v) { return (v - thisSustain) < 0.001f; });
+
+			break;
+		}
+		case state_base::SUSTAIN:
+		{
+			current_value = thisSustain;
+			FloatSanitizers::sanitizeFloatNumber(current_value);
+			FloatVectorOperations::fill(data, current_value, numSamples);
+			numDone = numSamples;
+			break;
+		}
+		case state_base::RELEASE:
+		{
+			if (envelope->release != 0.0f)
+				numDone = renderExponentialSegment(data, numSamples, releaseBase, releaseCoef, [](float v) { return v <= 0.001f; });
+
+			break;
+		}
+		case state_base::RETRIGGER:
+			break;
+		}
+
+		// Step through the segment boundary (or the remainder of the block) with the state machine
+		if (numDone == 0)
+		{
+			*data = tick();
+			numDone = 1;
+		}
+
+		data += numDone;
+		numSamples -= numDone;
+	}
+}
+
+template <typename CrossedFunction> int ahdsr_base::state_base::renderExponentialSegment(float* data, int numSamples, float base, float coef, const CrossedFunction& hasCrossed)
+{
+	// This uses the same recurrence, boundary check and sanitizing as tick(), so the values 
+	// and the sample where the segment ends are identical. The sample that crosses the 
+	// boundary is not rendered here, tick() will calculate it and change the state.
+	float v = current_value;
+	int numDone = 0;
+
+	for (; numDone < numSamples; numDone++)
+	{
+		float next = base + v * coef;
+
+		if (hasCrossed(next))
+			break;
+
+		FloatSanitizers::sanitizeFloatNumber(next);
+		data[numDone] = next;
+		v = next;
+	}
+
+	current_value = v;
+	return numDone;
+}
+
 static float ratioOrZero(double nom, double denom) { return denom != 0.0 ? nom / denom : 0.0; }
 
 float ahdsr_base::state_base::getUIPosition(double deltaMs)
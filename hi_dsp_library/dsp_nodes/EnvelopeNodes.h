@@ -246,6 +246,14 @@ struct ahdsr_base: public mothernode,
 
 		float tick();
 
+		/** Renders the next numSamples values of the envelope into data.
+
+			The attack, hold, decay and release segments are rendered in a tight loop without 
+			the state dispatch of tick(), which is only called for the sample that crosses a segment 
+			boundary. The segments use the same recurrence and boundary checks as tick(), so the 
+			result is the same as calling tick() for every sample. */
+		void tickBlock(float* data, int numSamples);
+
 		float getUIPosition(double delta);
 
 		void refreshAttackTime();
@@ -289,6 +297,10 @@ struct ahdsr_base: public mothernode,
 		bool active = false;
 
 		EnvelopeState current_state;
+
+	private:
+
+		template <typename CrossedFunction> int renderExponentialSegment(float* data, int numSamples, float base, float coef, const CrossedFunction& hasCrossed);
 	};
 
 	void calculateCoefficients(float timeInMilliSeconds, float base, float maximum, float &stateBase, float &stateCoeff) const;
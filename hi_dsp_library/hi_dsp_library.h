@@ -81,6 +81,14 @@ Set this to 1 if you want to embed the libraries created with this module into y
 #define IS_STATIC_DSP_LIBRARY 1
 #endif
 
+/** Config: HISE_USE_COMPACT_POLY_DATA
+
+Set this to 1 if the PolyData containers of polyphonic nodes should only allocate the voice states for the voice limit of the sound generator instead of NUM_POLYPHONIC_VOICES elements.
+*/
+#ifndef HISE_USE_COMPACT_POLY_DATA
+#define HISE_USE_COMPACT_POLY_DATA 0
+#endif
+
 
 /** TODO List for scripnode rework:
 
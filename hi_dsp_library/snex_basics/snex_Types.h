@@ -543,8 +543,27 @@ struct PolyHandler
 		// This byte structure is needed by the JIT compilation, so if the atomic
 		// wrappers add any overhead on a platform, this will fail compilation
 		static_assert(offsetof(PolyHandler, enabled) == 12, "misaligned poly handler");
+
+		releaseAllVoiceSlots();
 	}
 
+	/** The memory that is used by the PolyData containers that were prepared with this handler. */
+	struct MemoryStatistics
+	{
+		bool operator==(const MemoryStatistics& other) const
+		{
+			return numBytesUsed == other.numBytesUsed && numBytesUncompacted == other.numBytesUncompacted;
+		}
+
+		bool operator!=(const MemoryStatistics& other) const { return !(*this == other); }
+
+		/** The bytes that are allocated for the voice states. */
+		size_t numBytesUsed = 0;
+
+		/** The bytes that the voice states would need with NumVoices slots per container. */
+		size_t numBytesUncompacted = 0;
+	};
+
 	/** Call this whenever you change something from the UI. It will make sure that
 	    the poly handler iteration will go through all voices as long as it's active.
 
@@ -692,6 +711,125 @@ struct PolyHandler
 
 	DllBoundaryTempoSyncer* getTempoSyncer() { return tempoSyncer; }
 
+	/** Sets the amount of voices that can be rendered at the same time.
+
+		If HISE_USE_COMPACT_POLY_DATA is enabled, the PolyData containers will only allocate
+		this amount of voice states, so you need to call this before preparing the nodes.
+		With a limit below NUM_POLYPHONIC_VOICES, every voice must acquire a slot with
+		allocateVoiceSlot() when it starts and give it back with releaseVoiceSlot().
+	*/
+	void setVoiceLimit(int newVoiceLimit)
+	{
+		voiceLimit = jlimit(1, NUM_POLYPHONIC_VOICES, newVoiceLimit);
+		releaseAllVoiceSlots();
+	}
+
+	int getVoiceLimit() const { return voiceLimit; }
+
+	/** Returns true if the voices are mapped to a limited amount of slots. Otherwise the voice index is used as slot. */
+	bool isUsingVoiceSlots() const { return enabled != 0 && voiceLimit < NUM_POLYPHONIC_VOICES; }
+
+	/** Acquires the lowest free slot for the given voice. Call this when the voice starts.
+
+		If all slots are used by other voices, it will return false and the owner of the
+		handler must not render the voice (or kill it). Without a voice limit, this always succeeds.
+	*/
+	bool allocateVoiceSlot(int voiceIndexToAllocate)
+	{
+		if (!isUsingVoiceSlots())
+			return true;
+
+		if (!isPositiveAndBelow(voiceIndexToAllocate, NUM_POLYPHONIC_VOICES))
+			return false;
+
+		if (voiceSlots[voiceIndexToAllocate] != -1)
+			return true;
+
+		for (int i = 0; i < voiceLimit; i++)
+		{
+			if (slotVoices[i] == -1)
+			{
+				slotVoices[i] = (int16)voiceIndexToAllocate;
+				voiceSlots[voiceIndexToAllocate] = (int16)i;
+				return true;
+			}
+		}
+
+		return false;
+	}
+
+	/** Returns true if the voice has acquired a slot (or if the handler doesn't use a voice limit). */
+	bool hasVoiceSlot(int voiceIndexToCheck) const
+	{
+		if (!isUsingVoiceSlots())
+			return true;
+
+		return isPositiveAndBelow(voiceIndexToCheck, NUM_POLYPHONIC_VOICES) && voiceSlots[voiceIndexToCheck] != -1;
+	}
+
+	/** Returns the storage slot for the voice that is currently rendered (or -1 outside the voice rendering).
+
+		Without a voice limit this is the voice index. Otherwise it's the slot that the voice acquired
+		with allocateVoiceSlot(). A voice without a slot (eg. because a node has reset the voice in
+		the current block) will get the scratch slot at the index of the voice limit, so it can't
+		overwrite the state of another voice.
+	*/
+	int getVoiceSlotIndex() const
+	{
+		auto v = getVoiceIndex();
+
+		if (v == -1 || !isUsingVoiceSlots())
+			return v;
+
+		auto slot = (int)voiceSlots[v];
+		return slot != -1 ? slot : voiceLimit;
+	}
+
+	/** Returns the voice index that uses the given slot (or -1 if the slot is free). */
+	int getVoiceIndexForSlot(int slotIndex) const
+	{
+		if (!isUsingVoiceSlots())
+			return slotIndex;
+
+		if (isPositiveAndBelow(slotIndex, voiceLimit))
+			return slotVoices[slotIndex];
+
+		return -1;
+	}
+
+	/** Frees the slot of the given voice. Call this when the voice was reset. */
+	void releaseVoiceSlot(int voiceIndexToRelease)
+	{
+		if (isPositiveAndBelow(voiceIndexToRelease, NUM_POLYPHONIC_VOICES))
+		{
+			auto slot = voiceSlots[voiceIndexToRelease];
+
+			if (slot != -1)
+			{
+				slotVoices[slot] = -1;
+				voiceSlots[voiceIndexToRelease] = -1;
+			}
+		}
+	}
+
+	void releaseAllVoiceSlots()
+	{
+		std::fill(voiceSlots, voiceSlots + NUM_POLYPHONIC_VOICES, (int16)-1);
+		std::fill(slotVoices, slotVoices + NUM_POLYPHONIC_VOICES, (int16)-1);
+	}
+
+	/** @internal Called by the PolyData containers in their prepare() method. */
+	void addPolyDataMemory(size_t numBytesUsed, size_t numBytesUncompacted)
+	{
+		memoryStatistics.numBytesUsed += numBytesUsed;
+		memoryStatistics.numBytesUncompacted += numBytesUncompacted;
+	}
+
+	/** Clears the memory statistics. Call this before preparing the nodes. */
+	void resetMemoryStatistics() { memoryStatistics = {}; }
+
+	MemoryStatistics getMemoryStatistics() const { return memoryStatistics; }
+
 private:
 
 	std::atomic<void*> currentAllThread = { nullptr }; // 0 byte offset
@@ -699,6 +837,11 @@ private:
 	int enabled;									   // 12 byte offset
 	WeakReference<VoiceResetter> vr = nullptr;		   // 16 byte offset
 	DllBoundaryTempoSyncer* tempoSyncer = nullptr;
+
+	int voiceLimit = NUM_POLYPHONIC_VOICES;
+	int16 voiceSlots[NUM_POLYPHONIC_VOICES];
+	int16 slotVoices[NUM_POLYPHONIC_VOICES];
+	MemoryStatistics memoryStatistics;
 };
 
 
@@ -771,6 +914,221 @@ struct PrepareSpecs
 
 
 
+/** The PolyData container that is used if HISE_USE_COMPACT_POLY_DATA is enabled.
+
+	It allocates the voice states in the prepare() call for the voice limit of the PolyHandler
+	(plus one scratch slot) instead of NumVoices elements. The voices are mapped to the slot that
+	they acquired with PolyHandler::allocateVoiceSlot() when they started, so the states of the
+	active voices are stored next to each other. If the PolyHandler has no voice limit, the voice
+	index is used as slot and it will allocate NumVoices elements.
+*/
+template <typename T, int NumVoices> struct CompactPolyData
+{
+	CompactPolyData(T initValue)
+	{
+		setAll(std::move(initValue));
+	}
+
+	CompactPolyData(const CompactPolyData& other)
+	{
+		*this = other;
+	}
+
+	CompactPolyData& operator=(const CompactPolyData& other)
+	{
+		voicePtr = other.voicePtr;
+		lastVoiceIndex = other.lastVoiceIndex;
+		monoData = other.monoData;
+
+		if (numElements != other.numElements)
+			allocate(other.numElements);
+
+		if (elements != &monoData)
+		{
+			for (int i = 0; i < numElements; i++)
+				elements[i] = other.elements[i];
+		}
+
+		return *this;
+	}
+
+	CompactPolyData()
+	{
+		if(std::is_arithmetic<T>::value)
+			memset(&monoData, 0, sizeof(T));
+	}
+
+	/** Call this method with a PrepareSpecs objet and it will setup the handling of
+	    the polyphony. 
+		
+		It will allocate one state for each voice of the voice limit of the PolyHandler
+		(plus the scratch slot for voices that have no slot).
+	*/
+	void prepare(const PrepareSpecs& sp)
+	{
+		jassert(!isPolyphonic() || sp.voiceIndex != nullptr);
+		jassert(isPowerOfTwo(NumVoices));
+		voicePtr = sp.voiceIndex;
+
+		if constexpr (isPolyphonic())
+		{
+			auto numRequired = 1;
+
+			if (voicePtr != nullptr && voicePtr->isUsingVoiceSlots())
+				numRequired = jmin(NumVoices, voicePtr->getVoiceLimit()) + 1;
+			else if (voicePtr != nullptr && voicePtr->isEnabled())
+				numRequired = NumVoices;
+
+			if (numRequired != numElements)
+				allocate(numRequired);
+
+			if (voicePtr != nullptr)
+				voicePtr->addPolyDataMemory(sizeof(T) * (size_t)numElements, sizeof(T) * (size_t)NumVoices);
+		}
+	}
+
+	void setAll(T&& value)
+	{
+		if (!isPolyphonic() || voicePtr == nullptr)
+		{
+			*elements = std::move(value);
+		}
+		else
+		{
+			for (auto& d : *this)
+				d = std::move(value);
+		}
+	}
+
+	/** If you know that you're inside a rendering context, you can
+	    use this function instead of the for-loop syntax. Be aware that
+		the performance will be the same, it's just a bit less to type. 
+	*/
+	T& get() const
+	{
+		jassert(isMonophonicOrInsideVoiceRendering());
+		return *begin();
+	}
+
+	/** Allows range-based for loops to work inside the voice context. */
+	T* begin() const
+	{
+		if constexpr (isPolyphonic())
+		{
+			lastVoiceIndex = voicePtr != nullptr ? voicePtr->getVoiceSlotIndex() : -1;
+			auto startOffset = jlimit(0, numElements - 1, lastVoiceIndex);
+			return elements + startOffset;
+		}
+		else
+			return const_cast<T*>(&monoData);
+	}
+
+	T* end() const
+	{
+		if constexpr (isPolyphonic())
+		{
+			auto numToIterate = lastVoiceIndex == -1 ? numElements : 1;
+			auto startOffset = jlimit(0, numElements - 1, lastVoiceIndex);
+			return elements + startOffset + numToIterate;
+		}
+		else
+		{
+			return const_cast<T*>(&monoData) + 1;
+		}
+	}
+
+	/** Just used during development. */
+	String getVoiceIndexForDebugging() const
+	{
+#if JUCE_DEBUG
+		String s;
+		s << "VoiceIndex: ";
+		s << (voicePtr != nullptr ? String(voicePtr->getVoiceIndex()) : "inactive");
+		return s;
+#else
+		return {};
+#endif
+	}
+
+	bool isFirst() const
+	{
+		if constexpr (!isPolyphonic())
+			return true;
+
+		return begin() == &getFirst();
+	}
+
+	/** Returns a reference to the first data. This can be used for UI purposes. */
+	const T& getFirst() const
+	{
+		return *elements;
+	}
+
+	int getVoiceIndexForData(const T& d) const
+	{
+		auto slot = jlimit(0, numElements - 1, (int)(&d - elements));
+
+		if (voicePtr != nullptr)
+			return jmax(0, voicePtr->getVoiceIndexForSlot(slot));
+
+		return slot;
+	}
+
+	bool isMonophonicOrInsideVoiceRendering() const
+	{
+		if (!isPolyphonic() || voicePtr == nullptr)
+			return true;
+
+		return isVoiceRenderingActive();
+	}
+
+private:
+
+	static constexpr bool isPolyphonic() { return NumVoices > 1; }
+
+	bool isVoiceRenderingActive() const
+	{
+		return isPolyphonic() &&
+			voicePtr != nullptr && voicePtr->getVoiceIndex() != -1;
+	}
+
+	/** Reallocates the voice states. The first state will be kept, the others will be default constructed. */
+	void allocate(int numToAllocate)
+	{
+		if (numToAllocate <= 1)
+		{
+			if (elements != &monoData)
+			{
+				if constexpr (std::is_move_assignable<T>::value)
+					monoData = std::move(*elements);
+			}
+
+			heapData.reset();
+			elements = &monoData;
+			numElements = 1;
+		}
+		else
+		{
+			std::unique_ptr<T[]> newData(new T[numToAllocate]());
+
+			if constexpr (std::is_move_assignable<T>::value)
+				newData[0] = std::move(*elements);
+
+			heapData = std::move(newData);
+			elements = heapData.get();
+			numElements = numToAllocate;
+		}
+	}
+
+	PolyHandler* voicePtr = nullptr;
+	mutable int lastVoiceIndex = -1;
+	int numElements = 1;
+
+	T* elements = &monoData;
+	std::unique_ptr<T[]> heapData;
+	T monoData;
+};
+
 /** A data structure that handles polyphonic voice data.
     @ingroup snex_containers
 
@@ -857,7 +1215,13 @@ struct PrepareSpecs
      // integer variable so there is absolutely no CPU overhead!
      using mono_class = my_class<1>;
     @endcode
+
+	If HISE_USE_COMPACT_POLY_DATA is enabled, this will be the CompactPolyData container, which
+	only allocates the voice states for the voice limit of its PolyHandler.
 */
+#if HISE_USE_COMPACT_POLY_DATA
+template <typename T, int NumVoices> using PolyData = CompactPolyData<T, NumVoices>;
+#else
 template <typename T, int NumVoices> struct PolyData
 {
 	PolyData(T initValue)
@@ -904,6 +1268,9 @@ template <typename T, int NumVoices> struct PolyData
 		jassert(!isPolyphonic() || sp.voiceIndex != nullptr);
 		jassert(isPowerOfTwo(NumVoices));
 		voicePtr = sp.voiceIndex;
+
+		if (isPolyphonic() && voicePtr != nullptr)
+			voicePtr->addPolyDataMemory(sizeof(data), sizeof(data));
 	}
 
 	void setAll(T&& value)
@@ -1046,6 +1413,7 @@ private:
 
 	T data[NumVoices];
 };
+#endif
 
 }
 
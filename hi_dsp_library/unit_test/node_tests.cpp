@@ -0,0 +1,185 @@
+/*  ===========================================================================
+*
+*   This file is part of HISE.
+*   Copyright 2016 Christoph Hart
+*
+*   HISE is free software: you can redistribute it and/or modify
+*   it under the terms of the GNU General Public License as published by
+*   the Free Software Foundation, either version 3 of the License, or
+*   (at your option) any later version.
+*
+*   HISE is distributed in the hope that it will be useful,
+*   but WITHOUT ANY WARRANTY; without even the implied warranty of
+*   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*   GNU General Public License for more details.
+*
+*   You should have received a copy of the GNU General Public License
+*   along with HISE.  If not, see <http://www.gnu.org/licenses/>.
+*
+*   Commercial licenses for using HISE in an closed source project are
+*   available on request. Please visit the project's website to get more
+*   information about commercial licencing:
+*
+*   http://www.hartinstruments.net/hise/
+*
+*   HISE is based on the JUCE library,
+*   which also must be licenced for commercial applications:
+*
+*   http://www.juce.com
+*
+*   ===========================================================================
+*/
+
+namespace hise
+{
+
+namespace tests
+{
+
+using namespace juce;
+using namespace scriptnode;
+
+class AhdsrBlockRenderingTest : public UnitTest
+{
+public:
+
+	using Envelope = scriptnode::envelope::pimpl::ahdsr_base;
+	using State = Envelope::state_base;
+
+	static constexpr int BlockSize = 512;
+	static constexpr int NumSamples = 44100 * 2;
+	static constexpr int ReleaseSample = BlockSize * 80;
+
+	AhdsrBlockRenderingTest() :
+		UnitTest("Testing AHDSR block rendering")
+	{}
+
+	void runTest() override
+	{
+		testCurve(0.0f, 0.0f, 50.0f, 20.0f, 200.0f, 0.5f, 300.0f);
+		testCurve(0.5f, 0.5f, 300.0f, 0.0f, 1000.0f, 0.2f, 2000.0f);
+		testCurve(1.0f, 1.0f, 5.0f, 100.0f, 20.0f, 0.0f, 10.0f);
+		testCurve(0.2f, 0.8f, 0.0f, 0.0f, 1.0f, 1.0f, 1.0f);
+
+		benchmark();
+	}
+
+private:
+
+	void setup(Envelope& env, float attackCurve, float decayCurve, float attack, float hold, float decay, float sustain, float release)
+	{
+		env.setBaseSampleRate(44100.0);
+		env.attackLevel = Decibels::decibelsToGain(-1.0f);
+		env.setAttackCurve(attackCurve);
+		env.setDecayCurve(decayCurve);
+		env.setSustainLevel(sustain);
+		env.setAttackRate(attack);
+		env.setHoldTime(hold);
+		env.setDecayRate(decay);
+		env.setReleaseRate(release);
+	}
+
+	static void startVoice(State& s, const Envelope& env)
+	{
+		s.envelope = &env;
+		s.attackLevel = env.attackLevel;
+		s.setAttackRate(env.attack);
+		s.setDecayRate(env.decay);
+		s.setReleaseRate(env.release);
+		s.current_state = State::ATTACK;
+		s.current_value = 0.0f;
+		s.holdCounter = 0;
+	}
+
+	static void render(State& s, bool useBlock, float* data, int numSamples)
+	{
+		for (int i = 0; i < numSamples; i += BlockSize)
+		{
+			if (i == ReleaseSample)
+				s.current_state = State::RELEASE;
+
+			auto numThisTime = jmin(BlockSize, numSamples - i);
+
+			if (useBlock)
+				s.tickBlock(data + i, numThisTime);
+			else
+			{
+				for (int j = 0; j < numThisTime; j++)
+					data[i + j] = s.tick();
+			}
+		}
+	}
+
+	void testCurve(float attackCurve, float decayCurve, float attack, float hold, float decay, float sustain, float release)
+	{
+		String name;
+		name << "Testing curve " << String(attackCurve, 1) << "/" << String(decayCurve, 1);
+		name << " with times " << String(attack) << ", " << String(hold) << ", " << String(decay) << ", " << String(release);
+		beginTest(name);
+
+		Envelope env;
+		setup(env, attackCurve, decayCurve, attack, hold, decay, sustain, release);
+
+		State expectedState, actualState;
+		startVoice(expectedState, env);
+		startVoice(actualState, env);
+
+		HeapBlock<float> expected, actual;
+		expected.calloc(NumSamples);
+		actual.calloc(NumSamples);
+
+		render(expectedState, false, expected, NumSamples);
+		render(actualState, true, actual, NumSamples);
+
+		float maxError = 0.0f;
+
+		for (int i = 0; i < NumSamples; i++)
+			maxError = jmax(maxError, std::abs(expected[i] - actual[i]));
+
+		// tickBlock() uses the same recurrence, so only a contracted multiply-add may round differently
+		expect(maxError < 1e-6f, "deviation to per-sample rendering: " + String(maxError));
+		expectEquals((int)actualState.current_state, (int)expectedState.current_state, "end state");
+	}
+
+	void benchmark()
+	{
+		beginTest("Benchmarking AHDSR block rendering");
+
+		Envelope env;
+		setup(env, 0.5f, 0.5f, 200.0f, 50.0f, 500.0f, 0.5f, 800.0f);
+
+		HeapBlock<float> data;
+		data.calloc(NumSamples);
+
+		// The time that is available for rendering the samples in realtime
+		const double renderTime = (double)NumSamples / 44100.0;
+		const int numRuns = 20;
+
+		for (auto useBlock : { false, true })
+		{
+			State s;
+			auto start = Time::getMillisecondCounterHiRes();
+
+			for (int i = 0; i < numRuns; i++)
+			{
+				startVoice(s, env);
+				render(s, useBlock, data, NumSamples);
+			}
+
+			auto seconds = (Time::getMillisecondCounterHiRes() - start) * 0.001 / (double)numRuns;
+
+			String m;
+			m << (useBlock ? "Block rendering: " : "Per-sample rendering: ");
+			m << String(roundToInt(renderTime / seconds)) << " envelopes / core";
+
+			logMessage(m);
+		}
+	}
+};
+
+static AhdsrBlockRenderingTest ahdsrBlockRenderingTest;
+
+
+}
+
+}
@@ -289,10 +289,138 @@ struct WrapperTests : public UnitTest
 
 	
 
+	void testPolyData()
+	{
+		beginTest("Testing compact PolyData voice slots");
+
+		static_assert(std::is_same<PolyData<float, NUM_POLYPHONIC_VOICES>, CompactPolyData<float, NUM_POLYPHONIC_VOICES>>::value == (HISE_USE_COMPACT_POLY_DATA != 0), "PolyData doesn't match HISE_USE_COMPACT_POLY_DATA");
+
+		PolyHandler ph(true);
+		ph.setVoiceLimit(4);
+
+		PrepareSpecs ps;
+		ps.sampleRate = 44100.0;
+		ps.blockSize = 512;
+		ps.numChannels = 2;
+		ps.voiceIndex = &ph;
+
+		CompactPolyData<float, NUM_POLYPHONIC_VOICES> data;
+		data.prepare(ps);
+
+		auto m = ph.getMemoryStatistics();
+
+		logMessage("PolyData memory: " + String((int)m.numBytesUsed) + " bytes (" + String((int)m.numBytesUncompacted) + " bytes without compaction)");
+
+		expect(m.numBytesUncompacted == sizeof(float) * NUM_POLYPHONIC_VOICES, "uncompacted size mismatch");
+		expect(m.numBytesUsed == sizeof(float) * 5, "compacted size mismatch");
+
+		auto setValue = [&](int voiceIndex, float v)
+		{
+			PolyHandler::ScopedVoiceSetter svs(ph, voiceIndex);
+			data.get() = v;
+			return ph.getVoiceSlotIndex();
+		};
+
+		auto getValue = [&](int voiceIndex)
+		{
+			PolyHandler::ScopedVoiceSetter svs(ph, voiceIndex);
+			return data.get();
+		};
+
+		expect(ph.allocateVoiceSlot(100), "first voice didn't get a slot");
+		expect(ph.allocateVoiceSlot(7), "second voice didn't get a slot");
+		expect(ph.allocateVoiceSlot(35), "third voice didn't get a slot");
+		expect(ph.allocateVoiceSlot(35), "allocating the same voice twice failed");
+
+		expectEquals(setValue(100, 1.0f), 0, "first voice doesn't use first slot");
+		expectEquals(setValue(7, 2.0f), 1, "second voice doesn't use second slot");
+		expectEquals(setValue(35, 3.0f), 2, "third voice doesn't use third slot");
+
+		expectEquals(getValue(100), 1.0f, "value mismatch for first voice");
+		expectEquals(getValue(7), 2.0f, "value mismatch for second voice");
+		expectEquals(getValue(35), 3.0f, "value mismatch for third voice");
+
+		ph.releaseVoiceSlot(7);
+		expectEquals(ph.getVoiceIndexForSlot(1), -1, "slot wasn't released");
+		expect(!ph.hasVoiceSlot(7), "released voice still has a slot");
+		expect(ph.allocateVoiceSlot(12), "released slot wasn't reused");
+		expectEquals(setValue(12, 4.0f), 1, "released slot wasn't reused");
+		expectEquals(getValue(35), 3.0f, "value of other voice was changed");
+
+		expect(ph.allocateVoiceSlot(13), "fourth voice didn't get the last slot");
+		expectEquals(setValue(13, 5.0f), 3, "fourth voice doesn't use last slot");
+
+		// Every voice above the limit must fail to start instead of sharing a slot
+		for (int i = 0; i < 8; i++)
+		{
+			auto v = 20 + i;
+			expect(!ph.allocateVoiceSlot(v), "voice above the limit got a slot");
+			expect(!ph.hasVoiceSlot(v), "voice above the limit has a slot");
+
+			// A voice without a slot must not touch the states of the active voices
+			expectEquals(setValue(v, -1.0f), 4, "voice without slot doesn't use the scratch slot");
+		}
+
+		expectEquals(getValue(100), 1.0f, "value of first voice was changed by voice above the limit");
+		expectEquals(getValue(12), 4.0f, "value of second voice was changed by voice above the limit");
+		expectEquals(getValue(35), 3.0f, "value of third voice was changed by voice above the limit");
+		expectEquals(getValue(13), 5.0f, "value of fourth voice was changed by voice above the limit");
+
+		float sum = 0.0f;
+
+		for (int i = 0; i < 4; i++)
+		{
+			PolyHandler::ScopedVoiceSetter svs(ph, ph.getVoiceIndexForSlot(i));
+
+			for (auto& v : data)
+				sum += v;
+		}
+
+		expectEquals(sum, 1.0f + 4.0f + 3.0f + 5.0f, "voice iteration mismatch");
+
+		ph.releaseVoiceSlot(35);
+		expect(ph.allocateVoiceSlot(20), "voice didn't get the slot of a released voice");
+		expectEquals(ph.getVoiceIndexForSlot(2), 20, "voice didn't get the lowest free slot");
+
+		ph.releaseAllVoiceSlots();
+
+		for (int i = 0; i < 4; i++)
+			expectEquals(ph.getVoiceIndexForSlot(i), -1, "slot wasn't released");
+
+		beginTest("Testing compact PolyData without voice limit");
+
+		PolyHandler unlimited(true);
+		unlimited.resetMemoryStatistics();
+
+		ps.voiceIndex = &unlimited;
+
+		CompactPolyData<float, NUM_POLYPHONIC_VOICES> unlimitedData;
+		unlimitedData.prepare(ps);
+
+		expect(!unlimited.isUsingVoiceSlots(), "handler without limit uses voice slots");
+		expect(unlimited.getMemoryStatistics().numBytesUsed == sizeof(float) * NUM_POLYPHONIC_VOICES, "size mismatch without voice limit");
+
+		for (int i = 0; i < NUM_POLYPHONIC_VOICES; i++)
+		{
+			expect(unlimited.allocateVoiceSlot(i), "voice allocation without limit failed");
+
+			PolyHandler::ScopedVoiceSetter svs(unlimited, i);
+			expectEquals(unlimited.getVoiceSlotIndex(), i, "voice index isn't used as slot");
+			unlimitedData.get() = (float)i;
+		}
+
+		for (int i = 0; i < NUM_POLYPHONIC_VOICES; i++)
+		{
+			PolyHandler::ScopedVoiceSetter svs(unlimited, i);
+			expectEquals(unlimitedData.get(), (float)i, "value mismatch without voice limit");
+		}
+	}
+
 	void runTest() override
 	{
 		
 		testOpaqueNodes();
+		testPolyData();
 
 		//testBypassWrappers();
 		
@@ -118,6 +118,14 @@ If enabled, then the unit test suite will be compiled and added to all unit test
 #define HLAC_INCLUDE_TEST_SUITE 0
 #endif
 
+#if !HI_ENABLE_LEGACY_CPU_SUPPORT
+#if JUCE_ARM
+#include "../hi_tools/hi_tools/sse2neon.h"
+#elif JUCE_INTEL
+#include <immintrin.h>
+#endif
+#endif
+
 
 #include "hlac/BitCompressors.h"
 #include "hlac/CompressionHelpers.h"
@@ -148,6 +148,434 @@ void unpackArrayOfInt16(int16* d, int /*numValues*/, uint8 bitDepth)
 }
 
 
+#if HI_ENABLE_LEGACY_CPU_SUPPORT || !(JUCE_INTEL || JUCE_ARM)
+#define HLAC_SIMD_DECOMPRESSION 0
+#else
+#define HLAC_SIMD_DECOMPRESSION 1
+#endif
+
+// GCC and clang need the target attribute in order to use intrinsics beyond the compiler flags.
+#if HLAC_SIMD_DECOMPRESSION && JUCE_INTEL && (JUCE_GCC || JUCE_CLANG)
+#define HLAC_TARGET(x) __attribute__((target(x)))
+#else
+#define HLAC_TARGET(x)
+#endif
+
+/** Contains the SIMD kernels for the decompress() methods.
+
+	Every kernel decompresses as many full blocks as it can without reading past the compressed data
+	and returns the number of decompressed values. The remaining values are processed by the scalar code.
+*/
+namespace SimdDecompression
+{
+
+std::atomic<int>& getCurrentInstructionSet()
+{
+	static std::atomic<int> instructionSet((int)BitCompressors::getBestSupportedInstructionSet());
+	return instructionSet;
+}
+
+struct OneBitKernel;
+struct TwoBitKernel;
+struct FourBitKernel;
+struct EightBitKernel;
+template <int BitDepth> struct PackedKernel;
+
+/** Runs the best available kernel and advances the pointers past the decompressed values. */
+template <class Kernel> void decompressBlocks(int16*& destination, const uint8*& data, int& numValues)
+{
+#if HLAC_SIMD_DECOMPRESSION
+	const auto instructionSet = BitCompressors::getInstructionSet();
+
+	if (instructionSet == BitCompressors::InstructionSet::Scalar)
+		return;
+
+	int numDone = 0;
+
+#if JUCE_INTEL
+	if (instructionSet == BitCompressors::InstructionSet::AVX2)
+		numDone = Kernel::processAVX2(destination, data, numValues);
+#endif
+
+	numDone += Kernel::processSSE41(destination + numDone, data + Kernel::getNumBytes(numDone), numValues - numDone);
+
+	destination += numDone;
+	data += Kernel::getNumBytes(numDone);
+	numValues -= numDone;
+#else
+	ignoreUnused(destination, data, numValues);
+#endif
+}
+
+#if HLAC_SIMD_DECOMPRESSION
+
+/** Converts the sign / magnitude representation of the 2 and 4 bit compressors. */
+HLAC_TARGET("sse4.1") static inline __m128i applySign(__m128i value, __m128i signMask)
+{
+	const auto sign = _mm_cmpeq_epi16(_mm_and_si128(value, signMask), signMask);
+	const auto magnitude = _mm_andnot_si128(signMask, value);
+	return _mm_sub_epi16(_mm_xor_si128(magnitude, sign), sign);
+}
+
+struct OneBitKernel
+{
+	static int getNumBytes(int numValues) { return numValues / 8; }
+
+	HLAC_TARGET("sse4.1") static int processSSE41(int16* destination, const uint8* data, int numValues)
+	{
+		const auto bits = _mm_setr_epi16(1, 2, 4, 8, 16, 32, 64, 128);
+		const auto one = _mm_set1_epi16(1);
+
+		int numDone = 0;
+
+		for (; numDone + 8 <= numValues; numDone += 8)
+		{
+			const auto v = _mm_and_si128(_mm_set1_epi16(*data++), bits);
+			_mm_storeu_si128((__m128i*)(destination + numDone), _mm_min_epu16(v, one));
+		}
+
+		return numDone;
+	}
+
+#if JUCE_INTEL
+	HLAC_TARGET("avx2") static int processAVX2(int16* destination, const uint8* data, int numValues)
+	{
+		const auto bits = _mm256_setr_epi16(1, 2, 4, 8, 16, 32, 64, 128, 
+											256, 512, 1024, 2048, 4096, 8192, 16384, (int16)0x8000);
+		const auto one = _mm256_set1_epi16(1);
+
+		int numDone = 0;
+
+		for (; numDone + 16 <= numValues; numDone += 16)
+		{
+			const auto twoBytes = (int16)(data[0] | (data[1] << 8));
+			const auto v = _mm256_and_si256(_mm256_set1_epi16(twoBytes), bits);
+			_mm256_storeu_si256((__m256i*)(destination + numDone), _mm256_min_epu16(v, one));
+			data += 2;
+		}
+
+		return numDone;
+	}
+#endif
+};
+
+struct TwoBitKernel
+{
+	static int getNumBytes(int numValues) { return numValues / 4; }
+
+	HLAC_TARGET("sse4.1") static int processSSE41(int16* destination, const uint8* data, int numValues)
+	{
+		// Every value uses the lower bit for the magnitude and the upper bit for the sign
+		const auto valueBits = _mm_setr_epi16(1, 4, 16, 64, 256, 1024, 4096, 16384);
+		const auto signBits = _mm_slli_epi16(valueBits, 1);
+		const auto one = _mm_set1_epi16(1);
+
+		int numDone = 0;
+
+		for (; numDone + 8 <= numValues; numDone += 8)
+		{
+			const auto twoBytes = _mm_set1_epi16((int16)(data[0] | (data[1] << 8)));
+			const auto v = _mm_min_epu16(_mm_and_si128(twoBytes, valueBits), one);
+			const auto sign = _mm_cmpeq_epi16(_mm_and_si128(twoBytes, signBits), signBits);
+
+			_mm_storeu_si128((__m128i*)(destination + numDone), _mm_sub_epi16(_mm_xor_si128(v, sign), sign));
+			data += 2;
+		}
+
+		return numDone;
+	}
+
+#if JUCE_INTEL
+	HLAC_TARGET("avx2") static int processAVX2(int16* destination, const uint8* data, int numValues)
+	{
+		const auto valueBits = _mm256_setr_epi16(1, 4, 16, 64, 256, 1024, 4096, 16384,
+												 1, 4, 16, 64, 256, 1024, 4096, 16384);
+		const auto signBits = _mm256_slli_epi16(valueBits, 1);
+		const auto one = _mm256_set1_epi16(1);
+
+		int numDone = 0;
+
+		for (; numDone + 16 <= numValues; numDone += 16)
+		{
+			const auto lo = _mm_set1_epi16((int16)(data[0] | (data[1] << 8)));
+			const auto hi = _mm_set1_epi16((int16)(data[2] | (data[3] << 8)));
+			const auto fourBytes = _mm256_inserti128_si256(_mm256_castsi128_si256(lo), hi, 1);
+
+			const auto v = _mm256_min_epu16(_mm256_and_si256(fourBytes, valueBits), one);
+			const auto sign = _mm256_cmpeq_epi16(_mm256_and_si256(fourBytes, signBits), signBits);
+
+			_mm256_storeu_si256((__m256i*)(destination + numDone), _mm256_sub_epi16(_mm256_xor_si256(v, sign), sign));
+			data += 4;
+		}
+
+		return numDone;
+	}
+#endif
+};
+
+struct FourBitKernel
+{
+	static int getNumBytes(int numValues) { return numValues / 2; }
+
+	/** Spreads 8 bytes into 16 nibbles in the order of the scalar decompression (lower nibble first). */
+	HLAC_TARGET("sse4.1") static inline void getNibbles(const uint8* data, __m128i& first, __m128i& second)
+	{
+		const auto bytes = _mm_cvtepu8_epi16(_mm_loadl_epi64((const __m128i*)data));
+		const auto lo = _mm_and_si128(bytes, _mm_set1_epi16(0x0F));
+		const auto hi = _mm_srli_epi16(bytes, 4);
+
+		first = _mm_unpacklo_epi16(lo, hi);
+		second = _mm_unpackhi_epi16(lo, hi);
+	}
+
+	HLAC_TARGET("sse4.1") static int processSSE41(int16* destination, const uint8* data, int numValues)
+	{
+		const auto signMask = _mm_set1_epi16(0b1000);
+
+		int numDone = 0;
+
+		for (; numDone + 16 <= numValues; numDone += 16)
+		{
+			__m128i first, second;
+			getNibbles(data, first, second);
+
+			_mm_storeu_si128((__m128i*)(destination + numDone), applySign(first, signMask));
+			_mm_storeu_si128((__m128i*)(destination + numDone + 8), applySign(second, signMask));
+			data += 8;
+		}
+
+		return numDone;
+	}
+
+#if JUCE_INTEL
+	HLAC_TARGET("avx2") static int processAVX2(int16* destination, const uint8* data, int numValues)
+	{
+		const auto signMask = _mm256_set1_epi16(0b1000);
+
+		int numDone = 0;
+
+		for (; numDone + 16 <= numValues; numDone += 16)
+		{
+			__m128i first, second;
+			getNibbles(data, first, second);
+
+			const auto n = _mm256_inserti128_si256(_mm256_castsi128_si256(first), second, 1);
+			const auto sign = _mm256_cmpeq_epi16(_mm256_and_si256(n, signMask), signMask);
+			const auto magnitude = _mm256_andnot_si256(signMask, n);
+
+			_mm256_storeu_si256((__m256i*)(destination + numDone), _mm256_sub_epi16(_mm256_xor_si256(magnitude, sign), sign));
+			data += 8;
+		}
+
+		return numDone;
+	}
+#endif
+};
+
+struct EightBitKernel
+{
+	static int getNumBytes(int numValues) { return numValues; }
+
+	HLAC_TARGET("sse4.1") static int processSSE41(int16* destination, const uint8* data, int numValues)
+	{
+		int numDone = 0;
+
+		for (; numDone + 8 <= numValues; numDone += 8)
+		{
+			const auto v = _mm_cvtepi8_epi16(_mm_loadl_epi64((const __m128i*)(data + numDone)));
+			_mm_storeu_si128((__m128i*)(destination + numDone), v);
+		}
+
+		return numDone;
+	}
+
+#if JUCE_INTEL
+	HLAC_TARGET("avx2") static int processAVX2(int16* destination, const uint8* data, int numValues)
+	{
+		int numDone = 0;
+
+		for (; numDone + 16 <= numValues; numDone += 16)
+		{
+			const auto v = _mm256_cvtepi8_epi16(_mm_loadu_si128((const __m128i*)(data + numDone)));
+			_mm256_storeu_si256((__m256i*)(destination + numDone), v);
+		}
+
+		return numDone;
+	}
+#endif
+};
+
+/** The kernel for the 6, 10, 12 and 14 bit compressors.
+
+	These compressors write blocks of 8 values MSB-first into 16 bit words (the 12 bit compressor uses 
+	blocks of 4 values, but two of them have the same layout). The kernel shuffles the two words that 
+	contain each value into a 32 bit lane, shifts the value to the top and then down to the LSB.
+*/
+template <int BitDepth> struct PackedKernel
+{
+	// 8 values * BitDepth bits / 8 bits
+	static constexpr int NumBytesPerBlock = BitDepth;
+
+	static int getNumBytes(int numValues) { return (numValues / 8) * NumBytesPerBlock; }
+
+	struct Layout
+	{
+		Layout()
+		{
+			for (int i = 0; i < 8; i++)
+			{
+				const int bitPosition = i * BitDepth;
+				const int wordIndex = bitPosition / 16;
+				const int offset = bitPosition % 16;
+				const bool needsNextWord = (offset + BitDepth) > 16;
+
+				// The lane is (word[i] << 16 | word[i+1]) in little endian byte order
+				shuffleMask[i * 4 + 0] = needsNextWord ? (int8)(2 * wordIndex + 2) : (int8)0x80;
+				shuffleMask[i * 4 + 1] = needsNextWord ? (int8)(2 * wordIndex + 3) : (int8)0x80;
+				shuffleMask[i * 4 + 2] = (int8)(2 * wordIndex);
+				shuffleMask[i * 4 + 3] = (int8)(2 * wordIndex + 1);
+
+				shiftAmounts[i] = offset;
+				multipliers[i] = 1 << offset;
+			}
+		}
+
+		alignas(32) int8 shuffleMask[32];
+		alignas(32) int32 shiftAmounts[8];
+		alignas(32) int32 multipliers[8];
+	};
+
+	static const Layout& getLayout()
+	{
+		static const Layout layout;
+		return layout;
+	}
+
+	HLAC_TARGET("sse4.1") static int processSSE41(int16* destination, const uint8* data, int numValues)
+	{
+		const auto& layout = getLayout();
+
+		const auto firstMask = _mm_load_si128((const __m128i*)layout.shuffleMask);
+		const auto secondMask = _mm_load_si128((const __m128i*)(layout.shuffleMask + 16));
+
+		// SSE4.1 has no variable shift, so the left shift is a multiplication
+		const auto firstMultiplier = _mm_load_si128((const __m128i*)layout.multipliers);
+		const auto secondMultiplier = _mm_load_si128((const __m128i*)(layout.multipliers + 4));
+		const auto sub = _mm_set1_epi16((int16)getBitMask(BitDepth));
+
+		int numBlocks = numValues / 8;
+		int numDone = 0;
+
+		// The 16 byte load must not read past the last block
+		while (numBlocks * NumBytesPerBlock >= 16)
+		{
+			const auto block = _mm_loadu_si128((const __m128i*)data);
+
+			auto first = _mm_mullo_epi32(_mm_shuffle_epi8(block, firstMask), firstMultiplier);
+			auto second = _mm_mullo_epi32(_mm_shuffle_epi8(block, secondMask), secondMultiplier);
+
+			first = _mm_srli_epi32(first, 32 - BitDepth);
+			second = _mm_srli_epi32(second, 32 - BitDepth);
+
+			const auto v = _mm_sub_epi16(_mm_packus_epi32(first, second), sub);
+			_mm_storeu_si128((__m128i*)(destination + numDone), v);
+
+			data += NumBytesPerBlock;
+			numDone += 8;
+			--numBlocks;
+		}
+
+		return numDone;
+	}
+
+#if JUCE_INTEL
+	HLAC_TARGET("avx2") static int processAVX2(int16* destination, const uint8* data, int numValues)
+	{
+		const auto& layout = getLayout();
+
+		const auto mask = _mm256_load_si256((const __m256i*)layout.shuffleMask);
+		const auto shift = _mm256_load_si256((const __m256i*)layout.shiftAmounts);
+		const auto sub = _mm256_set1_epi16((int16)getBitMask(BitDepth));
+
+		int numBlocks = numValues / 8;
+		int numDone = 0;
+
+		while (numBlocks >= 2 && (numBlocks - 1) * NumBytesPerBlock >= 16)
+		{
+			// The shuffle works per 128 bit lane, so both lanes need the entire block
+			const auto firstBlock = _mm256_broadcastsi128_si256(_mm_loadu_si128((const __m128i*)data));
+			const auto secondBlock = _mm256_broadcastsi128_si256(_mm_loadu_si128((const __m128i*)(data + NumBytesPerBlock)));
+
+			auto first = _mm256_sllv_epi32(_mm256_shuffle_epi8(firstBlock, mask), shift);
+			auto second = _mm256_sllv_epi32(_mm256_shuffle_epi8(secondBlock, mask), shift);
+
+			first = _mm256_srli_epi32(first, 32 - BitDepth);
+			second = _mm256_srli_epi32(second, 32 - BitDepth);
+
+			// packus interleaves the 128 bit lanes, so we need to restore the order
+			auto v = _mm256_permute4x64_epi64(_mm256_packus_epi32(first, second), _MM_SHUFFLE(3, 1, 2, 0));
+			v = _mm256_sub_epi16(v, sub);
+
+			_mm256_storeu_si256((__m256i*)(destination + numDone), v);
+
+			data += 2 * NumBytesPerBlock;
+			numDone += 16;
+			numBlocks -= 2;
+		}
+
+		return numDone;
+	}
+#endif
+};
+
+#endif
+
+} // namespace SimdDecompression
+
+BitCompressors::InstructionSet BitCompressors::getBestSupportedInstructionSet()
+{
+#if !HLAC_SIMD_DECOMPRESSION
+	return InstructionSet::Scalar;
+#elif JUCE_ARM
+	return InstructionSet::SSE41;
+#else
+	if (SystemStats::hasAVX2())
+		return InstructionSet::AVX2;
+
+	if (SystemStats::hasSSE41())
+		return InstructionSet::SSE41;
+
+	return InstructionSet::Scalar;
+#endif
+}
+
+BitCompressors::InstructionSet BitCompressors::getInstructionSet()
+{
+	return (InstructionSet)SimdDecompression::getCurrentInstructionSet().load(std::memory_order_relaxed);
+}
+
+void BitCompressors::setInstructionSet(InstructionSet newInstructionSet)
+{
+	auto s = jmin((int)newInstructionSet, (int)getBestSupportedInstructionSet());
+	SimdDecompression::getCurrentInstructionSet().store(s);
+}
+
+String BitCompressors::getInstructionSetName(InstructionSet s)
+{
+	switch (s)
+	{
+	case InstructionSet::Scalar: return "Scalar";
+#if JUCE_ARM
+	case InstructionSet::SSE41:	 return "NEON";
+#else
+	case InstructionSet::SSE41:	 return "SSE4.1";
+#endif
+	case InstructionSet::AVX2:	 return "AVX2";
+	default:					 return {};
+	}
+}
+
+
 int BitCompressors::ZeroBit::getAllowedBitRange() const
 {
 	return 0;
@@ -223,6 +651,8 @@ bool BitCompressors::OneBit::compress(uint8* destination, const int16* data, int
 
 bool BitCompressors::OneBit::decompress(int16* destination, const uint8* data, int numValuesToDecompress)
 {
+	SimdDecompression::decompressBlocks<SimdDecompression::OneBitKernel>(destination, data, numValuesToDecompress);
+
 	const uint8 masks[8] = { 0b00000001, 0b00000010, 0b00000100, 0b00001000,
 		0b00010000, 0b00100000, 0b01000000, 0b10000000 };
 
@@ -318,6 +748,8 @@ bool BitCompressors::TwoBit::compress(uint8* destination, const int16* data, int
 
 bool BitCompressors::TwoBit::decompress(int16* destination, const uint8* data, int numValuesToDecompress)
 {
+	SimdDecompression::decompressBlocks<SimdDecompression::TwoBitKernel>(destination, data, numValuesToDecompress);
+
 	const uint8 signMasks[4] =  { 0b00000010, 0b00001000, 0b00100000, 0b10000000 };
 	const uint8 valueMasks[4] = { 0b00000001, 0b00000100, 0b00010000, 0b01000000 };
 
@@ -431,6 +863,8 @@ bool BitCompressors::FourBit::compress(uint8* destination, const int16* data, in
 
 bool BitCompressors::FourBit::decompress(int16* destination, const uint8* data, int numValuesToDecompress)
 {
+	SimdDecompression::decompressBlocks<SimdDecompression::FourBitKernel>(destination, data, numValuesToDecompress);
+
 	
 
 	const uint8 signMasks[2] =  { 0b00001000, 0b10000000 };
@@ -543,6 +977,8 @@ bool BitCompressors::SixBit::compress(uint8* destination, const int16* data, int
 
 bool BitCompressors::SixBit::decompress(int16* destination, const uint8* data, int numValuesToDecompress)
 {
+	SimdDecompression::decompressBlocks<SimdDecompression::PackedKernel<6>>(destination, data, numValuesToDecompress);
+
 #if JUCE_IOS
 	while (numValuesToDecompress >= 8)
 	{
@@ -703,6 +1139,8 @@ bool BitCompressors::EightBit::compress(uint8* destination, const int16* data, i
 
 bool BitCompressors::EightBit::decompress(int16* destination, const uint8* data, int numValuesToDecompress)
 {
+	SimdDecompression::decompressBlocks<SimdDecompression::EightBitKernel>(destination, data, numValuesToDecompress);
+
     while (--numValuesToDecompress >= 0)
 	{
 		const int8 value = *reinterpret_cast<const int8*>(data++);
@@ -790,6 +1228,8 @@ bool BitCompressors::TenBit::compress(uint8* destination, const int16* data, int
 
 bool BitCompressors::TenBit::decompress(int16* destination, const uint8* data, int numValuesToDecompress)
 {
+	SimdDecompression::decompressBlocks<SimdDecompression::PackedKernel<10>>(destination, data, numValuesToDecompress);
+
 	while (numValuesToDecompress >= 8)
 	{
 		decompress10Bit(reinterpret_cast<uint16*>(destination), (void*)data);
@@ -884,6 +1324,8 @@ bool BitCompressors::TwelveBit::decompress(int16* destination, const uint8* data
 
 #else
 
+	SimdDecompression::decompressBlocks<SimdDecompression::PackedKernel<12>>(destination, data, numValuesToDecompress);
+
 	int16* dst = destination;
 
 	while (numValuesToDecompress >= 4)
@@ -1002,6 +1444,8 @@ bool BitCompressors::FourteenBit::compress(uint8* destination, const int16* data
 
 bool BitCompressors::FourteenBit::decompress(int16* destination, const uint8* data, int numValuesToDecompress)
 {
+	SimdDecompression::decompressBlocks<SimdDecompression::PackedKernel<14>>(destination, data, numValuesToDecompress);
+
 	while (numValuesToDecompress >= 8)
 	{
 		decompress14Bit(destination, data);
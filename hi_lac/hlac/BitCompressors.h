@@ -104,6 +104,33 @@ struct BitCompressors
 
 	static uint8 getMinBitDepthForData(const int16* data, int numValues, int8 expectedBitDepth = -1);
 
+	/** The instruction set that is used by the decompress() methods.
+
+		The best instruction set is detected once at runtime. On ARM the SSE kernels
+		are translated to NEON instructions using sse2neon.
+	*/
+	enum class InstructionSet
+	{
+		Scalar = 0,
+		SSE41,
+		AVX2,
+		numInstructionSets
+	};
+
+	/** Returns the instruction set that is currently used for decompression. */
+	static InstructionSet getInstructionSet();
+
+	/** Returns the best instruction set that is supported by this CPU. */
+	static InstructionSet getBestSupportedInstructionSet();
+
+	/** Overrides the automatic detection. If the CPU does not support the given instruction set, it will use the best one available.
+
+		This is mainly used by the unit tests to compare the implementations.
+	*/
+	static void setInstructionSet(InstructionSet newInstructionSet);
+
+	static String getInstructionSetName(InstructionSet s);
+
 
 	struct ZeroBit : public Base
 	{
@@ -1123,6 +1123,11 @@ uint32 CompressionHelpers::Misc::createChecksum()
 	r.setSeedRandomly();
 	r.setSeedRandomly();
 
+	return createChecksum(r);
+}
+
+uint32 CompressionHelpers::Misc::createChecksum(Random& r)
+{
 	uint16 randomNumber = (uint16)r.nextInt(Range<int>(2, UINT16_MAX));
 
 	uint8* d = reinterpret_cast<uint8*>(&randomNumber);
@@ -1173,11 +1178,315 @@ var HlacArchiver::readMetadataFromArchive(const File& sourceFile)
 	return var();
 }
 
-bool HlacArchiver::extractSampleData(const DecompressData& data)
+struct HlacArchiver::ExtractionJob : public ThreadPoolJob
 {
-	jassert(listener != nullptr);
-	jassert(thread != nullptr);
+	struct Segment
+	{
+		File file;
+		int64 start = 0;
+		int64 length = 0;
+	};
+
+	/** Reads the FLAC data of a monolith directly from the archive parts it was split into. */
+	class SegmentedInputStream : public InputStream
+	{
+	public:
+
+		SegmentedInputStream(const Array<Segment>& segmentsToUse, std::atomic<int64>& bytesReadCounter) :
+			segments(segmentsToUse),
+			counter(bytesReadCounter)
+		{
+			for (const auto& s : segments)
+				totalLength += s.length;
+		}
+
+		int64 getTotalLength() override { return totalLength; }
+
+		bool isExhausted() override { return position >= totalLength; }
+
+		int64 getPosition() override { return position; }
+
+		bool setPosition(int64 newPosition) override
+		{
+			position = jlimit<int64>(0, totalLength, newPosition);
+			return true;
+		}
+
+		int read(void* destBuffer, int maxBytesToRead) override
+		{
+			auto d = static_cast<char*>(destBuffer);
+			int numRead = 0;
+
+			while (numRead < maxBytesToRead && position < totalLength)
+			{
+				int64 segmentOffset = 0;
+				int index = 0;
+
+				while (segmentOffset + segments.getReference(index).length <= position)
+					segmentOffset += segments.getReference(index++).length;
+
+				const auto& s = segments.getReference(index);
+
+				if (index != currentIndex)
+				{
+					currentStream = new FileInputStream(s.file);
+					currentIndex = index;
+
+					if (currentStream->failedToOpen())
+						break;
+				}
+
+				currentStream->setPosition(s.start + position - segmentOffset);
+
+				const int numThisTime = (int)jmin<int64>(maxBytesToRead - numRead, segmentOffset + s.length - position);
+				const int numReadThisTime = currentStream->read(d + numRead, numThisTime);
+
+				if (numReadThisTime <= 0)
+					break;
+
+				numRead += numReadThisTime;
+				position += numReadThisTime;
+			}
+
+			if (position > highestPosition)
+			{
+				counter += position - highestPosition;
+				highestPosition = position;
+			}
+
+			return numRead;
+		}
+
+	private:
+
+		Array<Segment> segments;
+		ScopedPointer<FileInputStream> currentStream;
+		int currentIndex = -1;
+
+		int64 totalLength = 0;
+		int64 position = 0;
+		int64 highestPosition = 0;
+		std::atomic<int64>& counter;
+	};
+
+	/** The state shared by all jobs of an extraction. */
+	struct Context
+	{
+		Context(HlacArchiver& parent_, const DecompressData& data_, int64 memoryBudget_) :
+			parent(parent_),
+			data(data_),
+			memoryBudget(memoryBudget_)
+		{}
+
+		bool shouldAbort() const { return failed || parent.shouldExit(); }
+
+		void logStatus(const String& m)
+		{
+			ScopedLock sl(listenerLock);
+
+			if (parent.listener != nullptr)
+				parent.listener->logStatusMessage(m);
+		}
+
+		void logVerbose(const String& m)
+		{
+			ScopedLock sl(listenerLock);
+
+			if (parent.listener != nullptr)
+				parent.listener->logVerboseMessage(m);
+		}
+
+		void logError(const String& m)
+		{
+			failed = true;
+
+			ScopedLock sl(listenerLock);
+
+			if (parent.listener != nullptr)
+				parent.listener->criticalErrorOccured(m);
+		}
+
+		/** Blocks until the given amount fits into the budget. A single job is always allowed to run. */
+		bool acquireMemory(int64 numBytes)
+		{
+			while (!shouldAbort())
+			{
+				{
+					ScopedLock sl(memoryLock);
+
+					if (memoryInUse == 0 || memoryInUse + numBytes <= memoryBudget)
+					{
+						memoryInUse += numBytes;
+						return true;
+					}
+				}
+
+				memoryReleased.wait(50);
+			}
+
+			return false;
+		}
+
+		void releaseMemory(int64 numBytes)
+		{
+			{
+				ScopedLock sl(memoryLock);
+				memoryInUse -= numBytes;
+			}
+
+			memoryReleased.signal();
+		}
+
+		HlacArchiver& parent;
+		const DecompressData& data;
+
+		CriticalSection listenerLock;
+
+		CriticalSection memoryLock;
+		WaitableEvent memoryReleased;
+		const int64 memoryBudget;
+		int64 memoryInUse = 0;
+
+		std::atomic<bool> failed { false };
+	};
+
+	ExtractionJob(const String& name_, const File& targetFile_) :
+		ThreadPoolJob("Extracting " + name_),
+		name(name_),
+		targetFile(targetFile_)
+	{}
+
+	JobStatus runJob() override
+	{
+		jassert(context != nullptr);
+
+		started = true;
+		extract();
+		bytesRead = totalBytes;
+		finished = true;
+
+		return jobHasFinished;
+	}
+
+	void addSegment(const File& f, int64 start, int64 length)
+	{
+		segments.add({ f, start, length });
+		totalBytes += length;
+	}
+
+	double getProgress() const
+	{
+		return totalBytes > 0 ? (double)bytesRead.load() / (double)totalBytes : 1.0;
+	}
+
+	const String name;
+	const File targetFile;
+
+	Context* context = nullptr;
+
+	Array<Segment> segments;
+	int64 totalBytes = 0;
+	std::atomic<int64> bytesRead { 0 };
+
+	std::atomic<bool> started { false };
+	std::atomic<bool> finished { false };
+
+private:
+
+	bool shouldAbort() const { return shouldExit() || context->shouldAbort(); }
+
+	bool extract()
+	{
+		context->logStatus("Extracting " + name);
+
+		FlacAudioFormat flacFormat;
+		ScopedPointer<AudioFormatReader> flacReader = flacFormat.createReaderFor(new SegmentedInputStream(segments, bytesRead), true);
+
+		if (flacReader == nullptr)
+		{
+			context->logError("Can't read the compressed data of " + name);
+			return false;
+		}
+
+		context->logVerbose("  Reading Monolith " + name + ": " + String(flacReader->sampleRate, 1) + " Hz, " +
+			String(flacReader->numChannels) + " channels, " + String(flacReader->lengthInSamples) + " samples");
+
+		if (context->data.debugLogMode)
+			return true;
+
+		// Matches the size estimate of HiseLosslessAudioFormatWriter::preallocateMemory()
+		const int64 memoryNeeded = flacReader->lengthInSamples * (int64)flacReader->numChannels * 2 * 2 / 3;
+
+		if (!context->acquireMemory(memoryNeeded))
+			return false;
+
+		const bool ok = decode(*flacReader);
+
+		context->releaseMemory(memoryNeeded);
+
+		return ok;
+	}
+
+	bool decode(AudioFormatReader& flacReader)
+	{
+		hlac::HiseLosslessAudioFormat hlacFormat;
+		StringPairArray metadata;
+
+		ScopedPointer<AudioFormatWriter> writer = hlacFormat.createWriterFor(new FileOutputStream(targetFile), flacReader.sampleRate, flacReader.numChannels, 5, metadata, 5);
+
+		auto hlacWriter = dynamic_cast<HiseLosslessAudioFormatWriter*>(writer.get());
+
+		if (hlacWriter == nullptr)
+		{
+			context->logError("Can't create " + targetFile.getFileName());
+			return false;
+		}
+
+		auto options = hlac::HlacEncoder::CompressorOptions::getPreset(hlac::HlacEncoder::CompressorOptions::Presets::Diff);
+
+		options.applyDithering = false;
+		options.normalisationMode = context->data.supportFullDynamics ? 2 : 0;
+
+		hlacWriter->preallocateMemory(flacReader.lengthInSamples, flacReader.numChannels);
+		hlacWriter->setOptions(options);
+
+		const int bufferSize = 8192 * 32;
+
+		AudioSampleBuffer tempBuffer(flacReader.numChannels, bufferSize);
 
+		for (int64 readerOffset = 0; readerOffset < flacReader.lengthInSamples; readerOffset += bufferSize)
+		{
+			if (shouldAbort())
+				return false;
+
+			const int numToRead = jmin<int>(bufferSize, (int)(flacReader.lengthInSamples - readerOffset));
+
+			flacReader.read(&tempBuffer, 0, numToRead, readerOffset, true, true);
+
+			if (!writer->writeFromAudioSampleBuffer(tempBuffer, 0, numToRead))
+			{
+				context->logError("File write error for " + targetFile.getFileName());
+				return false;
+			}
+		}
+
+		if (shouldAbort())
+			return false;
+
+		if (!writer->flush())
+		{
+			context->logError("File write error: Flushing file " + targetFile.getFileName());
+			return false;
+		}
+
+		return true;
+	}
+
+	JUCE_DECLARE_NON_COPYABLE(ExtractionJob);
+};
+
+bool HlacArchiver::extractSampleData(const DecompressData& data)
+{
 	auto sourceFile = data.sourceFile;
 	auto targetDirectory = data.targetDirectory;
 	auto option = data.option;
@@ -1192,16 +1501,8 @@ bool HlacArchiver::extractSampleData(const DecompressData& data)
 		}
 	}
 
-	Array<File> parts;
-
-	sourceFile.getParentDirectory().findChildFiles(parts, File::findFiles, false, sourceFile.getFileNameWithoutExtension() + ".*");
-
-	const int numParts = parts.size();
-
-	ScopedPointer<FileInputStream> fis = new FileInputStream(sourceFile);
-
-	FlacAudioFormat flacFormat;
-	hlac::HiseLosslessAudioFormat hlacFormat;
+	File currentPart = sourceFile;
+	ScopedPointer<FileInputStream> fis = new FileInputStream(currentPart);
 
 	CHECK_FLAG(Flag::BeginMetadata);
 	auto metadataString = fis->readString();
@@ -1209,8 +1510,6 @@ bool HlacArchiver::extractSampleData(const DecompressData& data)
 
 	VERBOSE_LOG(metadataString);
 
-	StringPairArray metadata;
-
 	int partIndex = 1;
 
 	currentFlag = readFlag(fis);
@@ -1229,30 +1528,25 @@ bool HlacArchiver::extractSampleData(const DecompressData& data)
 		currentFlag = readFlag(fis);
 	}
 
+	// Collect the location of every monolith first, the FLAC data is then
+	// read directly from the archive by the extraction jobs.
+
+	STATUS_LOG("Reading archive index");
+
+	OwnedArray<ExtractionJob> jobs;
+
 	while (currentFlag == Flag::BeginName)
 	{
 		auto name = fis->readString();
 		CHECK_FLAG(Flag::EndName);
 
-		VERBOSE_LOG("  Reading Monolith " + name);
-		STATUS_LOG("Extracting " + name);
-		
-		*data.partProgress = (double)fis->getPosition() / (double)fis->getTotalLength();
-
-		const double totalProgress = (double)(partIndex - 1) / (double)numParts;
-
-		const double totalPartProgress = *data.partProgress / (double)numParts;
-
-		*data.totalProgress = totalProgress + totalPartProgress;
-
 		CHECK_FLAG(Flag::BeginTime);
 		auto archiveTime = Time::fromISO8601(fis->readString());
 		CHECK_FLAG(Flag::EndTime);
 
-		if (thread->threadShouldExit())
+		if (shouldExit())
 			return false;
 
-		
 		File targetHlacFile = targetDirectory.getChildFile(name);
 
 		bool overwriteThisFile = true;
@@ -1275,190 +1569,137 @@ bool HlacArchiver::extractSampleData(const DecompressData& data)
 				targetHlacFile.deleteFile();
 			else
 				overwriteThisFile = false;
-				
 		}
 
-		if (thread->threadShouldExit())
-			return false;
+		VERBOSE_LOG((overwriteThisFile ? "  Overwriting File " : "  Skipping File ") + name);
 
-		if (overwriteThisFile || data.debugLogMode)
-		{
-			VERBOSE_LOG("  Overwriting File ");
+		ScopedPointer<ExtractionJob> job = new ExtractionJob(name, targetHlacFile);
+
+		CHECK_FLAG(Flag::BeginMonolithLength);
+		auto numBytes = fis->readInt64();
+		CHECK_FLAG(Flag::EndMonolithLength);
 
-			bool ok = true;
+		CHECK_FLAG(Flag::BeginMonolith);
+		job->addSegment(currentPart, fis->getPosition(), numBytes);
+		fis->setPosition(fis->getPosition() + numBytes);
 
-			File tmpFlacFile = targetHlacFile.getSiblingFile("TmpFlac.flac").getNonexistentSibling();
+		currentFlag = readFlag(fis);
 
-			if (tmpFlacFile.existsAsFile())
-				tmpFlacFile.deleteFile();
+		while (currentFlag == Flag::SplitMonolith)
+		{
+			partIndex++;
 
-			ScopedPointer<FileOutputStream> flacTempWriteStream = new FileOutputStream(tmpFlacFile);
+			currentPart = getPartFile(sourceFile, partIndex);
+			fis = nullptr;
+			fis = new FileInputStream(currentPart);
 
 			CHECK_FLAG(Flag::BeginMonolithLength);
-			auto bytesToRead = fis->readInt64();
+			numBytes = fis->readInt64();
 			CHECK_FLAG(Flag::EndMonolithLength);
 
-			STATUS_LOG("Creating temp file");
-
-			CHECK_FLAG(Flag::BeginMonolith);
-
-			flacTempWriteStream->writeFromInputStream(*fis, bytesToRead);
+			CHECK_FLAG(Flag::ResumeMonolith);
+			job->addSegment(currentPart, fis->getPosition(), numBytes);
+			fis->setPosition(fis->getPosition() + numBytes);
 
 			currentFlag = readFlag(fis);
+		}
 
-			while (currentFlag == Flag::SplitMonolith)
-			{
-				partIndex++;
-
-				fis = nullptr;
-
-				fis = new FileInputStream(getPartFile(sourceFile, partIndex));
-
-				CHECK_FLAG(Flag::BeginMonolithLength);
-				bytesToRead = fis->readInt64();
-				CHECK_FLAG(Flag::EndMonolithLength);
-
-				CHECK_FLAG(Flag::ResumeMonolith);
-
-				flacTempWriteStream->writeFromInputStream(*fis, bytesToRead);
-
-				currentFlag = readFlag(fis);
-			}
-
-			if (thread->threadShouldExit())
-				return false;
-
-			jassert(currentFlag == Flag::EndMonolith);
-
-			flacTempWriteStream->flush();
-			flacTempWriteStream = nullptr;
-
-			FileInputStream* flacTempInputStream = new FileInputStream(tmpFlacFile);
-
-			jassert(flacTempInputStream->openedOk());
-
-			ScopedPointer<AudioFormatReader> flacReader = flacFormat.createReaderFor(flacTempInputStream, true);
+		jassert(currentFlag == Flag::EndMonolith);
+		currentFlag = readFlag(fis);
 
-			if (flacReader == nullptr)
-				return false;
+		if (overwriteThisFile || data.debugLogMode)
+			jobs.add(job.release());
+	}
 
-			VERBOSE_LOG("    Samplerate: " + String(flacReader->sampleRate, 1));
-			VERBOSE_LOG("    Channels: " + String(flacReader->numChannels));
-			VERBOSE_LOG("    Length: " + String(flacReader->lengthInSamples));
+	jassert(currentFlag == Flag::EndOfArchive);
 
-			FileOutputStream* monolithOutputStream; 
-			ScopedPointer<AudioFormatWriter> writer;
+	fis = nullptr;
 
-			if (!data.debugLogMode)
-			{
-				if (targetHlacFile.existsAsFile())
-					targetHlacFile.create();
+	return runExtractionJobs(data, jobs);
+}
 
-				monolithOutputStream = new FileOutputStream(targetHlacFile);
-				writer = hlacFormat.createWriterFor(monolithOutputStream, flacReader->sampleRate, flacReader->numChannels, 5, metadata, 5);
-			}
+bool HlacArchiver::runExtractionJobs(const DecompressData& data, OwnedArray<ExtractionJob>& jobs)
+{
+	if (jobs.isEmpty())
+		return true;
 
-			STATUS_LOG("Decompressing " + name);
+	int64 memoryBudget = data.memoryBudget;
 
-			const int bufferSize = 8192 * 32;
+	if (memoryBudget <= 0)
+	{
+		const int64 mb = 1024 * 1024;
+		memoryBudget = jlimit<int64>(256 * mb, 4096 * mb, (int64)SystemStats::getMemorySizeInMegabytes() * mb / 4);
+	}
 
-			hlac::HlacEncoder::CompressorOptions options = hlac::HlacEncoder::CompressorOptions::getPreset(hlac::HlacEncoder::CompressorOptions::Presets::Diff);
+	ExtractionJob::Context context(*this, data, memoryBudget);
 
-			if (thread->threadShouldExit())
-				return false;
+	int numThreads = data.numThreads > 0 ? data.numThreads : jlimit(1, 4, SystemStats::getNumCpus() - 1);
+	numThreads = jmin(numThreads, jobs.size());
 
-			options.applyDithering = false;
-			options.normalisationMode = data.supportFullDynamics ? 2 : 0;
+	VERBOSE_LOG("  Extracting " + String(jobs.size()) + " monoliths using " + String(numThreads) + " threads");
 
-			//dynamic_cast<HiseLosslessAudioFormatWriter*>(writer.get())->setTemporaryBufferType(true);
+	int64 totalBytes = 0;
 
-			dynamic_cast<HiseLosslessAudioFormatWriter*>(writer.get())->preallocateMemory(flacReader->lengthInSamples, flacReader->numChannels);
+	for (auto j : jobs)
+	{
+		j->context = &context;
+		totalBytes += j->totalBytes;
+	}
 
-			if(!data.debugLogMode)
-				dynamic_cast<HiseLosslessAudioFormatWriter*>(writer.get())->setOptions(options);
+	ThreadPool pool(numThreads);
 
-			AudioSampleBuffer tempBuffer(flacReader->numChannels, data.debugLogMode ? 0 : bufferSize);
+	for (auto j : jobs)
+		pool.addJob(j, false);
 
-			for (int64 readerOffset = 0; readerOffset < flacReader->lengthInSamples; readerOffset += bufferSize)
-			{
-				if (thread->threadShouldExit())
-					return false;
+	while (pool.getNumJobs() > 0)
+	{
+		if (shouldExit() || context.failed)
+		{
+			context.failed = true;
 
-				const int numToRead = jmin<int>(bufferSize, (int)(flacReader->lengthInSamples - readerOffset));
+			// The jobs point to the context on this stack frame, so wait until every running job has returned
+			pool.removeAllJobs(true, -1);
+			return false;
+		}
 
-				if (!data.debugLogMode)
-				{
-					flacReader->read(&tempBuffer, 0, numToRead, readerOffset, true, true);
-					ok = writer->writeFromAudioSampleBuffer(tempBuffer, 0, numToRead);
-					if (!ok)
-					{
-						listener->criticalErrorOccured("File write error for " + targetHlacFile.getFileName());
-						return false;
-					}
-				}
+		int64 bytesDone = 0;
+		double currentProgress = 0.0;
+		bool currentFound = false;
 
-				*data.progress = (double)readerOffset / (double)flacReader->lengthInSamples;
-			}
+		for (auto j : jobs)
+		{
+			bytesDone += j->bytesRead.load();
 
-			
-			if (!data.debugLogMode)
+			if (!currentFound && j->started && !j->finished)
 			{
-				ok = writer->flush();
-				if (!ok)
-				{
-					listener->criticalErrorOccured("File write error: Flushing file " + targetHlacFile.getFileName());
-					return false;
-				}
-
-				if (thread->threadShouldExit())
-					return false;
-
-				writer = nullptr;
+				currentProgress = j->getProgress();
+				currentFound = true;
 			}
-
-			flacReader = nullptr;
-			tmpFlacFile.deleteFile();
-			currentFlag = readFlag(fis);
 		}
-		else
-		{
-			VERBOSE_LOG("  Skipping File ");
-
-			CHECK_FLAG(Flag::BeginMonolithLength);
-			auto bytesToSkip = fis->readInt64();
-			CHECK_FLAG(Flag::EndMonolithLength);
 
-			CHECK_FLAG(Flag::BeginMonolith);
-			fis->skipNextBytes(bytesToSkip);
-			currentFlag = readFlag(fis);
-
-			while (currentFlag == Flag::SplitMonolith)
-			{
-				partIndex++;
+		const double totalProgress = totalBytes > 0 ? (double)bytesDone / (double)totalBytes : 1.0;
 
-				fis = nullptr;
-				fis = new FileInputStream(getPartFile(sourceFile, partIndex));
+		if (data.progress != nullptr)
+			*data.progress = currentProgress;
 
-				CHECK_FLAG(Flag::BeginMonolithLength);
-				bytesToSkip = fis->readInt64();
-				CHECK_FLAG(Flag::EndMonolithLength);
+		if (data.partProgress != nullptr)
+			*data.partProgress = totalProgress;
 
-				if (thread->threadShouldExit())
-					return false;
+		if (data.totalProgress != nullptr)
+			*data.totalProgress = totalProgress;
 
-				CHECK_FLAG(Flag::ResumeMonolith);
-				fis->skipNextBytes(bytesToSkip);
+		Thread::sleep(30);
+	}
 
-				currentFlag = readFlag(fis);
-			}
+	if (context.failed)
+		return false;
 
-			jassert(currentFlag == Flag::EndMonolith);
-			currentFlag = readFlag(fis);
-		}
+	for (auto p : { data.progress, data.partProgress, data.totalProgress })
+	{
+		if (p != nullptr)
+			*p = 1.0;
 	}
 
-	jassert(currentFlag == Flag::EndOfArchive);
-
 	return true;
 }
 
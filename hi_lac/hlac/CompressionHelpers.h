@@ -296,6 +296,8 @@ struct CompressionHelpers
 
 		static uint32 createChecksum();
 
+		static uint32 createChecksum(Random& r);
+
 		static bool validateChecksum(uint32 data);
 	};
 
@@ -406,6 +408,11 @@ struct HlacArchiver
 		double* totalProgress = nullptr;
 		bool debugLogMode = false;
 
+		/** The number of monoliths that are decoded concurrently. -1 picks a value based on the CPU count. */
+		int numThreads = -1;
+
+		/** The amount of memory the encoders may claim at once. 0 uses a quarter of the system memory. */
+		int64 memoryBudget = 0;
 	};
 
 	HlacArchiver(Thread* threadToUse) :
@@ -423,7 +430,11 @@ struct HlacArchiver
 		virtual void criticalErrorOccured(const String& message) = 0;
 	};
 
-	/** Extracts the compressed data from the given file. */
+	/** Extracts the compressed data from the given file.
+
+		The FLAC data of each monolith is streamed directly from the archive (and its part files)
+		into a HLAC writer, and multiple monoliths are processed concurrently on a worker pool.
+	*/
 	bool extractSampleData(const DecompressData& data);
 
 	/** Compressed the given data using the supplied Thread. */
@@ -433,6 +444,7 @@ struct HlacArchiver
 
 	var readMetadataFromArchive(const File& archiveFile);
 
+	/** Sets a listener for the log messages and errors. This is optional for the extraction. */
 	void setListener(Listener* l)
 	{
 		listener = l;
@@ -440,6 +452,12 @@ struct HlacArchiver
 
 private:
 
+	struct ExtractionJob;
+
+	bool shouldExit() const { return thread != nullptr && thread->threadShouldExit(); }
+
+	bool runExtractionJobs(const DecompressData& data, OwnedArray<ExtractionJob>& jobs);
+
 	FileInputStream* writeTempFile(AudioFormatReader* reader, int bitDepth=16);
 
 	Listener* listener = nullptr;
@@ -472,6 +472,18 @@ void HlacMemoryMappedAudioFormatReader::setTargetAudioDataType(AudioDataConverte
 	internalReader.setTargetAudioDataType(dataType);
 }
 
+const int16* HlacMemoryMappedAudioFormatReader::getMappedMonolithData(Range<int64> samplesToGet) const
+{
+#if JUCE_LITTLE_ENDIAN
+	if (isMonolith && map != nullptr && mappedSection.contains(samplesToGet))
+		return static_cast<const int16*>(sampleToPointer(samplesToGet.getStart()));
+#else
+	ignoreUnused(samplesToGet);
+#endif
+
+	return nullptr;
+}
+
 void HlacMemoryMappedAudioFormatReader::copySampleData(int* const* destSamples, int startOffsetInDestBuffer, int numDestChannels, const void* sourceData, int numChannels, int numSamples) noexcept
 {
 	jassert(numDestChannels == numDestChannels);
@@ -549,6 +561,8 @@ bool HlacSubSectionReader::readSamples(int** destSamples, int numDestChannels, i
 	clearSamplesBeyondAvailableLength(destSamples, numDestChannels, startOffsetInDestBuffer,
 		startSampleInFile, numSamples, length);
 
+	ScopedLock sl(internalReader->readLock);
+
 	if(memoryReader != nullptr)
 		return memoryReader->readSamples(destSamples, numDestChannels, startOffsetInDestBuffer, startSampleInFile + start, numSamples);
 	else
@@ -560,6 +574,8 @@ void HlacSubSectionReader::readMaxLevels(int64 startSampleInFile, int64 numSampl
 	startSampleInFile = jmax((int64)0, startSampleInFile);
 	numSamples = jmax((int64)0, jmin(numSamples, length - startSampleInFile));
 
+	ScopedLock sl(internalReader->readLock);
+
 	if(memoryReader != nullptr)
 		memoryReader->readMaxLevels(startSampleInFile + start, numSamples, results, numChannelsToRead);
 	else
@@ -572,15 +588,18 @@ void HlacSubSectionReader::readIntoFixedBuffer(HiseSampleBuffer& buffer, int sta
 	{
 		if (memoryReader != nullptr)
 		{
+			// This only copies from the mapped memory, so it doesn't need the lock
 			memoryReader->copyFromMonolith(buffer, startSample, buffer.getNumChannels(), start + readerStartSample, numChannels, numSamples);
 		}
 		else
 		{
+			ScopedLock sl(internalReader->readLock);
 			normalReader->copyFromMonolith(buffer, startSample, buffer.getNumChannels(), start + readerStartSample, numChannels, numSamples);
 		}
 	}
 	else
 	{
+		ScopedLock sl(internalReader->readLock);
 		internalReader->fixedBufferRead(buffer, numChannels, startSample, start + readerStartSample, numSamples);
 
 		if (buffer.getNumChannels() == 1 || numChannels == 1)
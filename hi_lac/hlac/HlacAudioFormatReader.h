@@ -128,6 +128,15 @@ private:
 
 	bool useHeaderOffsetWhenSeeking = true;
 
+	/** The decoder and the stream keep their state between reads, so every HlacSubSectionReader
+	*	of a monolith has to lock this before it reads from the shared reader. 
+	*
+	*	There is only one lock per monolith, so the streaming threads of the SampleThreadPool 
+	*	(see HISE_NUM_STREAMING_THREADS) can't read samples of the same monolith at the same time. Their reads are serialised and only
+	*	reads from different monoliths (or from memory mapped ones) run in parallel.
+	*/
+	CriticalSection readLock;
+
 };
 
 class HiseLosslessAudioFormatReader : public AudioFormatReader
@@ -188,6 +197,12 @@ public:
 
 	void setTargetAudioDataType(AudioDataConverters::DataFormat dataType);
 
+	/** Returns a pointer to the mapped 16 bit data of an uncompressed monolith (the channels are interleaved).
+	*
+	*	This returns nullptr if the file is compressed or if the given range is not mapped.
+	*/
+	const int16* getMappedMonolithData(Range<int64> samplesToGet) const;
+
 private:
 	
 	friend class HlacSubSectionReader;
@@ -55,7 +55,7 @@ HiseLosslessAudioFormatWriter::~HiseLosslessAudioFormatWriter()
 
 bool HiseLosslessAudioFormatWriter::flush()
 {
-	if (tempWasFlushed)
+	if (tempWasFlushed || output == nullptr)
 		return true;
 
 	if (!writeHeader())
@@ -193,6 +193,42 @@ int64 HiseLosslessAudioFormatWriter::getNumBytesWritten() const
 	return numBytesWritten;
 }
 
+void HiseLosslessAudioFormatWriter::setThreadPool(ThreadPool* pool)
+{
+	encoder.setThreadPool(pool);
+}
+
+bool HiseLosslessAudioFormatWriter::appendEncodedData(HiseLosslessAudioFormatWriter& other)
+{
+	jassert(other.output == nullptr);
+	jassert(other.options.useCompression == options.useCompression);
+
+	auto otherData = dynamic_cast<MemoryOutputStream*>(other.tempOutputStream.get());
+
+	if (otherData == nullptr)
+	{
+		jassertfalse;
+		return false;
+	}
+
+	tempWasFlushed = false;
+
+	bool ok;
+
+	if (options.useCompression)
+		ok = encoder.appendEncodedData(other.encoder, otherData->getData(), otherData->getDataSize(), other.blockOffsets, *tempOutputStream, blockOffsets);
+	else
+		ok = tempOutputStream->write(otherData->getData(), otherData->getDataSize());
+
+	numBytesWritten = tempOutputStream->getPosition();
+
+	// The other writer has no output stream, so there's nothing to flush
+	other.tempWasFlushed = true;
+	other.deleteTemp();
+
+	return ok;
+}
+
 bool HiseLosslessAudioFormatWriter::writeHeader()
 {
 	if (options.useCompression)
@@ -71,6 +71,17 @@ public:
 	/** Returns the number of written bytes for this reader. */
 	int64 getNumBytesWritten() const;
 
+	/** Encodes the blocks of each write call on the given thread pool. The output will be the same. */
+	void setThreadPool(ThreadPool* pool);
+
+	/** Moves the encoded data of another writer to the end of this writer.
+
+		You can use this to encode multiple files in parallel using one writer per file and append
+		them to the monolith in their original order. The other writer must use the same options and 
+		the memory buffer and must have been created without an output stream.
+	*/
+	bool appendEncodedData(HiseLosslessAudioFormatWriter& other);
+
 private:
 
 	bool writeHeader();
@@ -32,6 +32,28 @@
 
 namespace hlac { using namespace juce; 
 
+struct HlacEncoder::BlockEncodingJob : public ThreadPoolJob
+{
+	BlockEncodingJob(CompressorOptions& options, float* channelData_) :
+		ThreadPoolJob("HLAC Block Encoding"),
+		channelData(channelData_)
+	{
+		encoder.setOptions(options);
+	}
+
+	JobStatus runJob() override
+	{
+		AudioSampleBuffer block(&channelData, 1, COMPRESSION_BLOCK_SIZE);
+		result = encoder.createEncodedBlock(block);
+
+		return jobHasFinished;
+	}
+
+	HlacEncoder encoder;
+	float* channelData;
+	EncodedBlock result;
+};
+
 void HlacEncoder::compress(AudioSampleBuffer& source, OutputStream& output, uint32* blockOffsetData)
 {
 	bool compressStereo = source.getNumChannels() == 2;
@@ -45,7 +67,13 @@ void HlacEncoder::compress(AudioSampleBuffer& source, OutputStream& output, uint
 	else
 		currentNormaliseBitShiftAmount = 0;
 
-	if (source.getNumSamples() == COMPRESSION_BLOCK_SIZE)
+	blockOffset = 0;
+
+	if (threadPool != nullptr && source.getNumSamples() >= COMPRESSION_BLOCK_SIZE)
+	{
+		encodeFullBlocksInParallel(source, output, blockOffsetData);
+	}
+	else if (source.getNumSamples() == COMPRESSION_BLOCK_SIZE)
 	{
 		blockOffsetData[blockIndex] = numBytesWritten;
 		++blockIndex;
@@ -64,8 +92,7 @@ void HlacEncoder::compress(AudioSampleBuffer& source, OutputStream& output, uint
 		return;
 	}
 
-	blockOffset = 0;
-	int32 numSamplesRemaining = source.getNumSamples();
+	int32 numSamplesRemaining = source.getNumSamples() - blockOffset;
 
 	while (numSamplesRemaining >= COMPRESSION_BLOCK_SIZE)
 	{
@@ -119,6 +146,56 @@ void HlacEncoder::compress(AudioSampleBuffer& source, OutputStream& output, uint
 	
 }
 
+void HlacEncoder::encodeFullBlocksInParallel(AudioSampleBuffer& source, OutputStream& output, uint32* blockOffsetData)
+{
+	const int numChannels = source.getNumChannels() == 2 ? 2 : 1;
+	const int numFullBlocks = source.getNumSamples() / COMPRESSION_BLOCK_SIZE;
+
+	OwnedArray<BlockEncodingJob> jobs;
+	jobs.ensureStorageAllocated(numFullBlocks * numChannels);
+
+	for (int i = 0; i < numFullBlocks; i++)
+	{
+		for (int c = 0; c < numChannels; c++)
+		{
+			auto job = jobs.add(new BlockEncodingJob(options, source.getWritePointer(c, i * COMPRESSION_BLOCK_SIZE)));
+			threadPool->addJob(job, false);
+		}
+	}
+
+	// Write the blocks in their original order so that the output is the same as with serial encoding
+	for (int i = 0; i < jobs.size(); i++)
+	{
+		auto job = jobs[i];
+
+		threadPool->waitForJobToFinish(job, -1);
+
+		if (i % numChannels == 0)
+		{
+			blockOffsetData[blockIndex] = numBytesWritten;
+			++blockIndex;
+		}
+
+		writeEncodedBlock(job->result, output);
+	}
+
+	blockOffset = numFullBlocks * COMPRESSION_BLOCK_SIZE;
+}
+
+bool HlacEncoder::appendEncodedData(const HlacEncoder& other, const void* encodedData, size_t numBytes, const uint32* otherBlockOffsets, OutputStream& output, uint32* blockOffsetData)
+{
+	jassert(numBytes == other.numBytesWritten);
+
+	for (uint32 i = 0; i < other.blockIndex; i++)
+		blockOffsetData[blockIndex + i] = numBytesWritten + otherBlockOffsets[i];
+
+	blockIndex += other.blockIndex;
+	numBytesWritten += (uint32)numBytes;
+	numBytesUncompressed += other.numBytesUncompressed;
+
+	return output.write(encodedData, numBytes);
+}
+
 void HlacEncoder::reset()
 {
 	indexInBlock = 0;
@@ -134,6 +211,7 @@ void HlacEncoder::reset()
 	bitRateForCurrentCycle = 0;
 	firstCycleLength = -1;
 	ratio = 0.0f;
+	checksumGenerator.setSeedRandomly();
 }
 
 
@@ -152,34 +230,52 @@ float HlacEncoder::getCompressionRatio() const
 
 bool HlacEncoder::encodeBlock(AudioSampleBuffer& block, OutputStream& output)
 {
-	auto block16 = CompressionHelpers::AudioBufferInt16(block, 0, options.normalisationMode, options.normalisationThreshold);
-
-	if (!normaliseBlockAndAddHeader(block16, output))
-		return false;
-
-	return encodeBlock(block16, output);
+	return writeEncodedBlock(createEncodedBlock(block), output);
 }
 
-bool HlacEncoder::encodeBlock(CompressionHelpers::AudioBufferInt16& block16, OutputStream& output)
+HlacEncoder::EncodedBlock HlacEncoder::createEncodedBlock(AudioSampleBuffer& block)
 {
-	auto compressedBlock = createCompressedBlock(block16);
-	auto thisBlockSize = compressedBlock.getSize();
+	EncodedBlock encodedBlock;
 
-	writeChecksumBytesForBlock(output);
-	
-	if (thisBlockSize > 2 * COMPRESSION_BLOCK_SIZE)
+	auto block16 = CompressionHelpers::AudioBufferInt16(block, 0, options.normalisationMode, options.normalisationThreshold);
+
+#if HLAC_VERSION > 2
 	{
-		writeCycleHeader(true, 16, COMPRESSION_BLOCK_SIZE, output);
+		MemoryOutputStream headerStream(encodedBlock.normalisationHeader, false);
+		block16.getMap().writeNormalisationHeader(headerStream);
+	}
+#endif
 
-		numBytesWritten += sizeof(int16)*COMPRESSION_BLOCK_SIZE + 3;
+	auto compressedBlock = createCompressedBlock(block16);
+
+	if (compressedBlock.getSize() > 2 * COMPRESSION_BLOCK_SIZE)
+	{
+		MemoryOutputStream dataStream(encodedBlock.data, false);
 
-		return output.write(block16.getReadPointer(), sizeof(int16) * COMPRESSION_BLOCK_SIZE);
+		writeCycleHeader(true, 16, COMPRESSION_BLOCK_SIZE, dataStream);
+		dataStream.write(block16.getReadPointer(), sizeof(int16) * COMPRESSION_BLOCK_SIZE);
 	}
 	else
 	{
-		numBytesWritten += (uint32)compressedBlock.getSize();
-		return output.write(compressedBlock.getData(), compressedBlock.getSize());
+		encodedBlock.data = std::move(compressedBlock);
 	}
+
+	return encodedBlock;
+}
+
+bool HlacEncoder::writeEncodedBlock(const EncodedBlock& block, OutputStream& output)
+{
+	// The normalisation header is counted with 4 bytes for the block offsets
+	numBytesWritten += 4;
+	numBytesUncompressed += COMPRESSION_BLOCK_SIZE * 2;
+
+	if (!output.write(block.normalisationHeader.getData(), block.normalisationHeader.getSize()))
+		return false;
+
+	writeChecksumBytesForBlock(output);
+
+	numBytesWritten += (uint32)block.data.getSize();
+	return output.write(block.data.getData(), block.data.getSize());
 }
 
 
@@ -201,8 +297,6 @@ MemoryBlock HlacEncoder::createCompressedBlock(CompressionHelpers::AudioBufferIn
 	firstCycleLength = -1;
 	
 	auto maxBitDepth = CompressionHelpers::getPossibleBitReductionAmount(block16);
-	
-	numBytesUncompressed += COMPRESSION_BLOCK_SIZE * 2;
 
 	if (maxBitDepth <= options.bitRateForWholeBlock)
 	{
@@ -335,7 +429,7 @@ uint8 HlacEncoder::getBitReductionAmountForMSEncoding(AudioSampleBuffer& block)
 bool HlacEncoder::writeChecksumBytesForBlock(OutputStream& output)
 {
 	
-	auto checkSum = CompressionHelpers::Misc::createChecksum();
+	auto checkSum = CompressionHelpers::Misc::createChecksum(checksumGenerator);
 
 	if (!output.writeInt((int)checkSum))
 		return false;
@@ -445,7 +539,7 @@ bool HlacEncoder::encodeDiff(CompressionHelpers::AudioBufferInt16& cycle, Output
 	if (numBytesForFull > 0)
 	{
 		MemoryBlock mbFull;
-		mbFull.setSize(numBytesForFull);
+		mbFull.setSize(numBytesForFull, true);
 		compressorFull->compress((uint8*)mbFull.getData(), packedBuffer.getReadPointer(), numFullValues);
 
 		if (!output.write(mbFull.getData(), numBytesForFull))
@@ -457,7 +551,7 @@ bool HlacEncoder::encodeDiff(CompressionHelpers::AudioBufferInt16& cycle, Output
 	if (numBytesForError > 0)
 	{
 		MemoryBlock mbError;
-		mbError.setSize(numBytesForError);
+		mbError.setSize(numBytesForError, true);
 		compressorError->compress((uint8*)mbError.getData(), packedErrorBuffer.getReadPointer(), numErrorValues);
 
 		
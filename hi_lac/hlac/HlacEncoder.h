@@ -129,9 +129,32 @@ public:
 
 
 	void compress(AudioSampleBuffer& source, OutputStream& output, uint32* blockOffsetData);
+
+	/** Appends the data of another encoder that was compressed into a separate stream.
+
+		This can be used to encode multiple files in parallel and join them in their original order.
+		The block offsets of the other encoder are moved by the amount of bytes written so far.
+	*/
+	bool appendEncodedData(const HlacEncoder& other, const void* encodedData, size_t numBytes, const uint32* otherBlockOffsets, OutputStream& output, uint32* blockOffsetData);
 	
 	void reset();
 
+	/** Encodes the full blocks of each compress() call on the given thread pool.
+
+		The blocks are independent from each other, so they are compressed in parallel and written
+		in their original order. Pass in nullptr to encode on the calling thread (the default).
+	*/
+	void setThreadPool(ThreadPool* newThreadPool)
+	{
+		threadPool = newThreadPool;
+	}
+
+	/** Sets the seed for the random block checksums. Use this if you need to compare the output byte by byte. */
+	void setChecksumSeed(int64 seed)
+	{
+		checksumGenerator.setSeed(seed);
+	}
+
 	void setOptions(CompressorOptions& newOptions)
 	{
 		options = newOptions;
@@ -143,9 +166,22 @@ public:
 
 private:
 
-	bool encodeBlock(AudioSampleBuffer& block, OutputStream& output);
+	struct BlockEncodingJob;
 
-	bool encodeBlock(CompressionHelpers::AudioBufferInt16& block, OutputStream& output);
+	/** The data of a single encoded block without the checksum. */
+	struct EncodedBlock
+	{
+		MemoryBlock normalisationHeader;
+		MemoryBlock data;
+	};
+
+	void encodeFullBlocksInParallel(AudioSampleBuffer& source, OutputStream& output, uint32* blockOffsetData);
+
+	EncodedBlock createEncodedBlock(AudioSampleBuffer& block);
+
+	bool writeEncodedBlock(const EncodedBlock& block, OutputStream& output);
+
+	bool encodeBlock(AudioSampleBuffer& block, OutputStream& output);
 
 	bool normaliseBlockAndAddHeader(CompressionHelpers::AudioBufferInt16& block16, OutputStream& output);
 
@@ -207,6 +243,10 @@ private:
 	uint64 readIndex = 0;
 
 	double decompressionSpeed = 0.0;
+
+	Random checksumGenerator;
+
+	ThreadPool* threadPool = nullptr;
 };
 
 } // namespace hlac
@@ -52,6 +52,51 @@ HiseSampleBuffer::HiseSampleBuffer(HiseSampleBuffer& otherBuffer, int offset)
 	}
 }
 
+hlac::HiseSampleBuffer HiseSampleBuffer::createReadOnlyView(const int16* data, int numChannels, int numSamples)
+{
+	jassert(isPositiveAndBelow(numChannels, 3));
+
+	HiseSampleBuffer b;
+
+	b.isFloat = false;
+	b.numChannels = numChannels;
+	b.size = numSamples;
+	b.useOneMap = numChannels == 1;
+	b.readOnlyView = true;
+	b.interleaved = numChannels == 2;
+	b.leftIntBuffer = FixedSampleBuffer(data, numSamples);
+
+	// Read one byte of every page so that the page faults happen here and not on the audio thread
+	static constexpr size_t PageSize = 4096;
+
+	auto bytes = reinterpret_cast<const char*>(data);
+	const auto numBytes = sizeof(int16) * (size_t)numChannels * (size_t)numSamples;
+
+	volatile char lastByte = 0;
+
+	for (size_t i = 0; i < numBytes; i += PageSize)
+		lastByte = bytes[i];
+
+	if (numBytes > 0)
+		lastByte = bytes[numBytes - 1];
+
+	ignoreUnused(lastByte);
+
+	return b;
+}
+
+void HiseSampleBuffer::copyReadOnlyViewIntoOwnedData()
+{
+	if (!readOnlyView)
+		return;
+
+	HiseSampleBuffer ownedData(false, numChannels, size);
+	ownedData.allocateNormalisationTables(getNormaliseMap(0).getOffset());
+
+	copy(ownedData, *this, 0, 0, size);
+
+	*this = std::move(ownedData);
+}
 
 void HiseSampleBuffer::reverse(int startSample, int numSamples)
 {
@@ -356,6 +401,24 @@ void HiseSampleBuffer::copy(HiseSampleBuffer& dst, const HiseSampleBuffer& sourc
 					memcpy(dst.getWritePointer(1, startSampleDst), source.getReadPointer(0, startSampleSource), byteToCopy);
 			}
 		}
+		else if (source.isInterleaved())
+		{
+			// The source is a view to an uncompressed monolith with interleaved channels
+			using SourceType = AudioData::Pointer<AudioData::Int16, AudioData::LittleEndian, AudioData::Interleaved, AudioData::Const>;
+			using DestType = AudioData::Pointer<AudioData::Int16, AudioData::NativeEndian, AudioData::NonInterleaved, AudioData::NonConst>;
+
+			auto sourceData = source.leftIntBuffer.getReadPointer(0) + startSampleSource * source.numChannels;
+
+			for (int c = 0; c < dst.getNumChannels(); c++)
+			{
+				SourceType src(sourceData + jmin(c, source.numChannels - 1), source.numChannels);
+				DestType d(dst.getWritePointer(c, startSampleDst));
+
+				d.convertSamples(src, numSamples);
+			}
+
+			dst.normaliser.clear({ startSampleDst, startSampleDst + numSamples });
+		}
 		else
 		{
 			auto byteToCopy = sizeof(int16) * numSamples;
@@ -464,6 +527,9 @@ const void* HiseSampleBuffer::getReadPointer(int channel, int startSample/*=0*/)
 	}
 	else
 	{
+		// You can't access the channels of interleaved data directly, use copy() instead
+		jassert(!interleaved);
+
 		if (channel == 0 || numChannels == 1 || useOneMap)
 			return leftIntBuffer.getReadPointer(startSample);
 		else if (channel == 1 && hasSecondChannel())
@@ -233,7 +233,9 @@ public:
 		rightIntBuffer(std::move(otherBuffer.rightIntBuffer)),
 		numChannels(otherBuffer.numChannels),
 		size(otherBuffer.size),
-		useOneMap(otherBuffer.useOneMap)
+		useOneMap(otherBuffer.useOneMap),
+		readOnlyView(otherBuffer.readOnlyView),
+		interleaved(otherBuffer.interleaved)
 	{};
 
 	/** Creates an HiseSampleBuffer from an array of data pointers. */
@@ -257,10 +259,29 @@ public:
 		numChannels = other.numChannels;
 		size = other.size;
 		useOneMap = other.useOneMap;
+		readOnlyView = other.readOnlyView;
+		interleaved = other.interleaved;
 
 		return *this;
 	}
 
+	/** Creates a read only buffer that uses existing 16 bit data (eg. a memory mapped monolith) without copying it.
+	*
+	*	The data must outlive the buffer. If there are two channels, the data is expected to be interleaved and you can't
+	*	access the channels with getReadPointer(), but you can use copy() to deinterleave it into another buffer.
+	*	This reads every memory page of the data once, so call it on a background thread.
+	*/
+	static HiseSampleBuffer createReadOnlyView(const int16* data, int numChannels, int numSamples);
+
+	/** Checks whether this buffer uses external data that can't be changed. */
+	bool isReadOnlyView() const noexcept { return readOnlyView; }
+
+	/** Checks whether the channels of this buffer are interleaved (which is only the case for read only views). */
+	bool isInterleaved() const noexcept { return interleaved; }
+
+	/** Allocates memory and copies the data of a read only view so that it can be modified. Does nothing for normal buffers. */
+	void copyReadOnlyViewIntoOwnedData();
+
 	HiseSampleBuffer(HiseSampleBuffer& otherBuffer, int offset);
 
 	HiseSampleBuffer(FixedSampleBuffer&& intBuffer) :
@@ -361,6 +382,9 @@ private:
 
 	bool isFloat = false;
 
+	bool readOnlyView = false;
+	bool interleaved = false;
+
 	AudioSampleBuffer floatBuffer;
 
 	FixedSampleBuffer leftIntBuffer;
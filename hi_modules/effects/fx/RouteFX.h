@@ -116,6 +116,9 @@ struct SendContainer : public ModulatorSynth
 		prepareToPlay(getSampleRate(), getLargestBlockSize());
 	}
 
+	/** The send signals must be added before this is rendered. */
+	bool canBeRenderedInParallel() const override { return false; }
+
 	float getAttribute(int) const override { return 1.0f; };
 	void setInternalAttribute(int, float) override {};
 
@@ -311,6 +314,9 @@ struct SendEffect : public MasterEffectProcessor
 
 	bool hasTail() const override { return false; };
 
+	/** The signal is added to the send container, so the synth must be rendered in the original order. */
+	bool canBeRenderedInParallel() const override { return false; }
+
 	Processor *getChildProcessor(int /*processorIndex*/) override { return sendChain; };
 
 	const Processor *getChildProcessor(int /*processorIndex*/) const override { return sendChain; };
@@ -280,7 +280,7 @@ public:
 
 	void reset(int voiceIndex) override 
 	{
-		voiceStack.reset(voiceIndex);
+		voiceStack.reset(voiceIndex, &polyHandler);
 	}
 	
 	void handleHiseEvent(const HiseEvent &m) override
@@ -318,9 +318,9 @@ public:
 	void onVoiceReset(bool allVoices, int voiceIndex) override
 	{
 		if (allVoices)
-			voiceStack.voiceNoteOns.clear();
+			voiceStack.clear(&polyHandler);
 		else
-			voiceStack.reset(voiceIndex);
+			voiceStack.reset(voiceIndex, &polyHandler);
 	}
 
 	VoiceDataStack voiceStack;
@@ -330,6 +330,9 @@ public:
 	float getVoiceStartValueFor(const Processor *voiceStartModulator);
 
     int getNumActiveVoices() const override { return 0; };
+
+	/** The other synths depend on the modulation values so this must be rendered before them. */
+	bool canBeRenderedInParallel() const override { return false; }
     
 	GlobalModulatorContainer(MainController *mc, const String &id, int numVoices);;
 
@@ -0,0 +1,254 @@
+/*  ===========================================================================
+*
+*   This file is part of HISE.
+*   Copyright 2016 Christoph Hart
+*
+*   HISE is free software: you can redistribute it and/or modify
+*   it under the terms of the GNU General Public License as published by
+*   the Free Software Foundation, either version 3 of the License, or
+*   (at your option) any later version.
+*
+*   HISE is distributed in the hope that it will be useful,
+*   but WITHOUT ANY WARRANTY; without even the implied warranty of
+*   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*   GNU General Public License for more details.
+*
+*   You should have received a copy of the GNU General Public License
+*   along with HISE.  If not, see <http://www.gnu.org/licenses/>.
+*
+*   Commercial licenses for using HISE in an closed source project are
+*   available on request. Please visit the project's website to get more
+*   information about commercial licensing:
+*
+*   http://www.hise.audio/
+*
+*   HISE is based on the JUCE library,
+*   which also must be licenced for commercial applications:
+*
+*   http://www.juce.com
+*
+*   ===========================================================================
+*/
+
+#include "AppConfig.h"
+
+#if HI_RUN_UNIT_TESTS
+
+#include  "JuceHeader.h"
+
+using namespace hise;
+
+class WavetableMipmapTest : public UnitTest
+{
+public:
+
+	static constexpr int TableSize = 2048;
+
+	WavetableMipmapTest() :
+		UnitTest("Testing wavetable mipmaps")
+	{}
+
+	void runTest() override
+	{
+		testSelection();
+		testBandLimiting();
+		testAliasing();
+	}
+
+private:
+
+	/** Creates a sound with a naive saw and square table (which contain all harmonics up to the nyquist frequency). */
+	static WavetableSound* createSound(int numMipmapLevels, int numHarmonicsToUse=0)
+	{
+		MemoryBlock mb(sizeof(float) * TableSize * 2, true);
+		auto data = static_cast<float*>(mb.getData());
+
+		for (int i = 0; i < TableSize; i++)
+		{
+			if (numHarmonicsToUse == 0)
+			{
+				data[i] = 2.0f * (float)i / (float)TableSize - 1.0f;
+				data[TableSize + i] = i < TableSize / 2 ? 1.0f : -1.0f;
+			}
+			else
+			{
+				for (int h = 1; h <= numHarmonicsToUse; h++)
+				{
+					auto phase = MathConstants<double>::twoPi * (double)(h * i) / (double)TableSize;
+					data[i] += (float)(std::sin(phase) / (double)h);
+					data[TableSize + i] += (float)(std::cos(phase) / (double)h);
+				}
+			}
+		}
+
+		ValueTree v("wavetable");
+		v.setProperty("data", var(mb), nullptr);
+		v.setProperty("amount", 2, nullptr);
+		v.setProperty("noteNumber", 60, nullptr);
+		v.setProperty("sampleRate", 44100.0, nullptr);
+		v.setProperty("mipmapLevels", numMipmapLevels, nullptr);
+
+		return new WavetableSound(v);
+	}
+
+	/** Returns the magnitudes of the first TableSize / 2 + 1 bins of the given signal. */
+	static HeapBlock<float> getMagnitudes(const float* signal)
+	{
+		juce::dsp::FFT fft((int)std::log2(TableSize));
+
+		HeapBlock<float> d;
+		d.calloc(2 * TableSize);
+		FloatVectorOperations::copy(d, signal, TableSize);
+
+		fft.performFrequencyOnlyForwardTransform(d);
+		return d;
+	}
+
+	void testSelection()
+	{
+		beginTest("Testing mipmap level selection");
+
+		ReferenceCountedObjectPtr<WavetableSound> noMipmaps = createSound(0);
+
+		expectEquals(noMipmaps->getNumMipmapLevels(), 0, "sound without mipmaps has levels");
+		expectEquals(noMipmaps->getMipmapLevelForPitchRatio(16.0), 0, "level without mipmaps");
+		expect(noMipmaps->getWaveTableData(1, 3) == noMipmaps->getWaveTableData(1), "table without mipmaps");
+
+		ReferenceCountedObjectPtr<WavetableSound> s = createSound(20);
+
+		// The last level would only contain the fundamental
+		const int maxLevel = (int)std::log2(TableSize) - 2;
+
+		expectEquals(s->getNumMipmapLevels(), maxLevel, "level count isn't limited");
+		expectEquals(s->getNumHarmonics(), TableSize / 2, "harmonics of the naive saw");
+		expect(s->getWaveTableData(1, 0) == s->getWaveTableData(1), "level 0 isn't the original table");
+
+		expectEquals(s->getMipmapLevelForPitchRatio(0.5), 0, "level for ratio 0.5");
+		expectEquals(s->getMipmapLevelForPitchRatio(1.0), 0, "level for ratio 1");
+		expectEquals(s->getMipmapLevelForPitchRatio(1.5), 1, "level for ratio 1.5");
+		expectEquals(s->getMipmapLevelForPitchRatio(2.0), 1, "level for ratio 2");
+		expectEquals(s->getMipmapLevelForPitchRatio(3.0), 2, "level for ratio 3");
+		expectEquals(s->getMipmapLevelForPitchRatio(4.0), 2, "level for ratio 4");
+		expectEquals(s->getMipmapLevelForPitchRatio(4.5), 3, "level for ratio 4.5");
+		expectEquals(s->getMipmapLevelForPitchRatio(1000000.0), maxLevel, "level for a huge ratio");
+
+		int lastLevel = 0;
+		bool ok = true;
+
+		for (double ratio = 0.1; ratio < 600.0; ratio *= 1.01)
+		{
+			auto level = s->getMipmapLevelForPitchRatio(ratio);
+			ok &= level >= lastLevel;
+			lastLevel = level;
+
+			// Every level below must contain harmonics above the nyquist frequency
+			if (level > 0 && level < maxLevel)
+				ok &= (double)((TableSize / 2) >> (level - 1)) * ratio > (double)TableSize * 0.5;
+		}
+
+		expect(ok, "the selection isn't monotonic or doesn't pick the lowest alias free level");
+
+		beginTest("Testing mipmap level selection of band-limited tables");
+
+		ReferenceCountedObjectPtr<WavetableSound> bandLimited = createSound(20, 80);
+
+		expectEquals(bandLimited->getNumHarmonics(), 80, "harmonics of the band-limited table");
+
+		// 80 harmonics played 12 times faster stay below the nyquist frequency
+		expectEquals(bandLimited->getMipmapLevelForPitchRatio(12.0), 0, "band-limited table switches too early");
+
+		// Level 4 is the first level that removes harmonics of this table
+		expectEquals(bandLimited->getMipmapLevelForPitchRatio(13.0), 4, "band-limited table doesn't switch");
+	}
+
+	void testBandLimiting()
+	{
+		beginTest("Testing the harmonics of the mipmap levels");
+
+		ReferenceCountedObjectPtr<WavetableSound> s = createSound(20);
+
+		for (int t = 0; t < 2; t++)
+		{
+			auto original = getMagnitudes(s->getWaveTableData(t, 0));
+
+			for (int level = 1; level <= s->getNumMipmapLevels(); level++)
+			{
+				auto m = getMagnitudes(s->getWaveTableData(t, level));
+				const int numLevelHarmonics = (TableSize / 2) >> level;
+
+				double inside = 0.0, outside = 0.0;
+
+				for (int k = 1; k <= TableSize / 2; k++)
+				{
+					auto e = (double)m[k] * (double)m[k];
+
+					if (k <= numLevelHarmonics)
+						inside += e;
+					else
+						outside += e;
+				}
+
+				const String name = "table " + String(t) + ", level " + String(level) + ": ";
+
+				expect(outside < inside * 1e-8, name + "harmonics above the level limit: " + String(outside / inside));
+				expectWithinAbsoluteError(m[1] / original[1], 1.0f, 0.001f, name + "fundamental changed");
+
+				// The square table has no even harmonics
+				const int lastHarmonic = t == 0 ? numLevelHarmonics : numLevelHarmonics - 1;
+				expectWithinAbsoluteError(m[lastHarmonic] / original[lastHarmonic], 1.0f, 0.01f, name + "last harmonic changed");
+			}
+		}
+	}
+
+	void testAliasing()
+	{
+		// With an integer ratio there's no interpolation and every harmonic
+		// that isn't aliased ends up in a bin that is a multiple of the ratio
+		ReferenceCountedObjectPtr<WavetableSound> s = createSound(20);
+
+		for (auto ratio : { 3, 5, 7 })
+		{
+			beginTest("Testing aliasing with pitch ratio " + String(ratio));
+
+			auto getAliasingRatio = [&](int level)
+			{
+				auto table = s->getWaveTableData(0, level);
+
+				HeapBlock<float> output;
+				output.calloc(TableSize);
+
+				for (int i = 0; i < TableSize; i++)
+					output[i] = table[(i * ratio) % TableSize];
+
+				auto m = getMagnitudes(output);
+
+				double aliased = 0.0, total = 0.0;
+
+				for (int k = 1; k <= TableSize / 2; k++)
+				{
+					auto e = (double)m[k] * (double)m[k];
+					total += e;
+
+					if (k % ratio != 0)
+						aliased += e;
+				}
+
+				return aliased / total;
+			};
+
+			const auto level = s->getMipmapLevelForPitchRatio((double)ratio);
+
+			auto withoutMipmap = getAliasingRatio(0);
+			auto withMipmap = getAliasingRatio(level);
+
+			logMessage("Aliasing without mipmaps: " + String(Decibels::gainToDecibels(std::sqrt(withoutMipmap))) + "dB, with level " + String(level) + ": " + String(Decibels::gainToDecibels(std::sqrt(withMipmap), -200.0)) + "dB");
+
+			expect(withoutMipmap > 1e-4, "test signal doesn't alias without mipmaps");
+			expect(withMipmap < 1e-8, "mipmap level " + String(level) + " aliases: " + String(withMipmap));
+		}
+	}
+};
+
+static WavetableMipmapTest wavetableMipmapTest;
+
+#endif
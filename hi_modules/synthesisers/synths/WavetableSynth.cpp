@@ -124,141 +124,206 @@ float WavetableSynthVoice::getGainValue(float modValue)
 	return wavetableSynth->getGainValueFromTable(modValue);
 }
 
-void WavetableSynthVoice::calculateBlock(int startSample, int numSamples)
-{
-	const int startIndex = startSample;
-	const int samplesToCopy = numSamples;
+/** Contains the block kernel of the WavetableSynthVoice.
 
-	const float *voicePitchValues = getOwnerSynth()->getPitchValuesForVoice();
-		
-	if (auto tableValues = getTableModulationValues())
-	{
-		while (--numSamples >= 0)
-		{
-			int index = (int)voiceUptime;
+	The voice gathers the sample pairs of the lower and upper table for a chunk of samples
+	and then interpolates and crossfades the whole chunk in a vectorised loop.
+*/
+namespace WavetableKernel
+{
+static constexpr int ChunkSize = 64;
 
-			const int i1 = index % (tableSize);
+struct Chunk
+{
+	float l1[ChunkSize];
+	float l2[ChunkSize];
+	float u1[ChunkSize];
+	float u2[ChunkSize];
+	float alpha[ChunkSize];
+	float tableDelta[ChunkSize];
+	float gain[ChunkSize];
+};
 
-			int i2 = i1 + 1;
+/** Writes lerp(lerp(l1, l2, alpha), lerp(u1, u2, alpha), tableDelta) * gain into the output. */
+static void render(const Chunk& c, float* output, int numSamples)
+{
+	int i = 0;
 
-			auto numTables = currentSound->getWavetableAmount();
+#if JUCE_INTEL
+	for (; i + 4 <= numSamples; i += 4)
+	{
+		const auto alpha = _mm_loadu_ps(c.alpha + i);
+		const auto l1 = _mm_loadu_ps(c.l1 + i);
+		const auto u1 = _mm_loadu_ps(c.u1 + i);
 
-			if (i2 >= tableSize)
-			{
-				const float tableModValue = tableValues[startSample];
-				currentTableIndex = roundToInt(tableModValue * (double)(numTables-1));
-				i2 = 0;
-			}
-			
-			const float tableModValue = tableValues[startSample];
-			const float tableValue = jlimit<float>(0.0f, 1.0f, tableModValue) * (float)(numTables -1);
+		const auto lower = _mm_add_ps(l1, _mm_mul_ps(alpha, _mm_sub_ps(_mm_loadu_ps(c.l2 + i), l1)));
+		const auto upper = _mm_add_ps(u1, _mm_mul_ps(alpha, _mm_sub_ps(_mm_loadu_ps(c.u2 + i), u1)));
+		const auto sample = _mm_add_ps(lower, _mm_mul_ps(_mm_loadu_ps(c.tableDelta + i), _mm_sub_ps(upper, lower)));
 
-			const int lowerTableIndex = (int)(tableValue);
-			const int upperTableIndex = jmin(numTables-1, lowerTableIndex + 1);
-			const float tableDelta = tableValue - (float)lowerTableIndex;
-			jassert(0.0f <= tableDelta && tableDelta <= 1.0f);
+		_mm_storeu_ps(output + i, _mm_mul_ps(sample, _mm_loadu_ps(c.gain + i)));
+	}
+#endif
 
-			lowerTable = currentSound->getWaveTableData(lowerTableIndex);
-			upperTable = currentSound->getWaveTableData(upperTableIndex);
+	for (; i < numSamples; i++)
+	{
+		const float lower = c.l1[i] + c.alpha[i] * (c.l2[i] - c.l1[i]);
+		const float upper = c.u1[i] + c.alpha[i] * (c.u2[i] - c.u1[i]);
 
-			float tableGainValue = tableGainInterpolator.interpolateLinear(currentSound->getUnnormalizedGainValue(lowerTableIndex), currentSound->getUnnormalizedGainValue(upperTableIndex), tableDelta);
+		output[i] = (lower + c.tableDelta[i] * (upper - lower)) * c.gain[i];
+	}
+}
 
-			tableGainValue *= getGainValue(tableModValue);
+/** Fades from the samples of the previous mipmap level to the output with a linear ramp that starts at the given gain. */
+static void crossfade(const float* previousLevel, float* output, int numSamples, float startGain, float gainDelta)
+{
+	for (int i = 0; i < numSamples; i++)
+	{
+		const float gain = startGain + (float)(i + 1) * gainDelta;
+		output[i] = previousLevel[i] + gain * (output[i] - previousLevel[i]);
+	}
+}
+}
 
-			float u1 = upperTable[i1];
-			float u2 = upperTable[i2];
+int WavetableSynthVoice::getMipmapLevel(const float* voicePitchValues, int startSample) const
+{
+	if (currentSound->getNumMipmapLevels() == 0)
+		return 0;
 
-			float l1 = lowerTable[i1];
-			float l2 = lowerTable[i2];
+	// The uptime delta is the amount of table samples per output sample
+	auto ratio = uptimeDelta;
 
-			const float alpha = float(voiceUptime) - (float)index;
-			//const float invAlpha = 1.0f - alpha;
+	if (voicePitchValues != nullptr)
+		ratio *= (double)voicePitchValues[startSample];
 
-			const float upperSample = tableGainInterpolator.interpolateLinear(u1, u2, alpha);
+	return currentSound->getMipmapLevelForPitchRatio(ratio);
+}
 
-			const float lowerSample = tableGainInterpolator.interpolateLinear(l1, l2, alpha);
+void WavetableSynthVoice::calculateBlock(int startSample, int numSamples)
+{
+	const int startIndex = startSample;
+	const int samplesToCopy = numSamples;
 
-			float sample = lowerTableIndex != upperTableIndex ? tableGainInterpolator.interpolateLinear(lowerSample, upperSample, tableDelta) : lowerSample;
+	const float *voicePitchValues = getOwnerSynth()->getPitchValuesForVoice();
+	const auto tableValues = getTableModulationValues();
 
-			sample *= tableGainValue;
+	const auto numTables = currentSound->getWavetableAmount();
+	const auto mipmapLevel = getMipmapLevel(voicePitchValues, startSample);
 
-			sample *= 1.0f / currentSound->getUnnormalizedMaximum();
+	// Switching the level changes the harmonics, so it fades over from the previous level to avoid a click
+	if (lastMipmapLevel != -1 && lastMipmapLevel != mipmapLevel)
+	{
+		fadeMipmapLevel = lastMipmapLevel;
+		numMipmapFadeSamples = MipmapFadeLength;
+	}
 
-			// Stereo mode assumed
-			voiceBuffer.setSample(0, startSample, sample);
+	lastMipmapLevel = mipmapLevel;
 
-			jassert(voicePitchValues == nullptr || voicePitchValues[startSample] > 0.0f);
+	float const* fadeLowerTable = nullptr;
+	float const* fadeUpperTable = nullptr;
 
-			const double delta = (uptimeDelta * (voicePitchValues == nullptr ? 1.0 : voicePitchValues[startSample]));
+	const float normalizeGain = 1.0f / currentSound->getUnnormalizedMaximum();
 
-			voiceUptime += delta;
+	// The constant table position is calculated once for the entire block
+	int lowerTableIndex = 0;
+	float tableDelta = 0.0f;
+	float tableGainValue = 1.0f;
 
-			++startSample;
-		}
-	}
-	else
+	auto updateTables = [&](float tableModValue)
 	{
-		const float tableModValue = static_cast<WavetableSynth*>(getOwnerSynth())->getConstantTableModValue();
+		const float tableValue = jlimit<float>(0.0f, 1.0f, tableModValue) * (float)(numTables - 1);
 
-		while (--numSamples >= 0)
-		{
-			int index = (int)voiceUptime;
+		lowerTableIndex = (int)(tableValue);
+		const int upperTableIndex = jmin(numTables - 1, lowerTableIndex + 1);
+		tableDelta = tableValue - (float)lowerTableIndex;
+		jassert(0.0f <= tableDelta && tableDelta <= 1.0f);
 
-			const int i1 = index % (tableSize);
+		lowerTable = currentSound->getWaveTableData(lowerTableIndex, mipmapLevel);
+		upperTable = currentSound->getWaveTableData(upperTableIndex, mipmapLevel);
 
-			int i2 = i1 + 1;
+		if (numMipmapFadeSamples > 0)
+		{
+			fadeLowerTable = currentSound->getWaveTableData(lowerTableIndex, fadeMipmapLevel);
+			fadeUpperTable = currentSound->getWaveTableData(upperTableIndex, fadeMipmapLevel);
+		}
 
-			auto numTables = currentSound->getWavetableAmount();
+		tableGainValue = tableGainInterpolator.interpolateLinear(currentSound->getUnnormalizedGainValue(lowerTableIndex), currentSound->getUnnormalizedGainValue(upperTableIndex), tableDelta);
+		tableGainValue *= getGainValue(tableModValue) * normalizeGain;
+	};
 
-			if (i2 >= tableSize)
-			{
-				i2 = 0;
-			}
+	if (tableValues == nullptr)
+		updateTables(static_cast<WavetableSynth*>(getOwnerSynth())->getConstantTableModValue());
 
-			const float tableValue = jlimit<float>(0.0f, 1.0f, tableModValue) * (float)(numTables - 1);
+	WavetableKernel::Chunk chunk, fadeChunk;
+	float* output = voiceBuffer.getWritePointer(0);
 
-			const int lowerTableIndex = (int)(tableValue);
-			const int upperTableIndex = jmin(numTables - 1, lowerTableIndex + 1);
-			const float tableDelta = tableValue - (float)lowerTableIndex;
-			jassert(0.0f <= tableDelta && tableDelta <= 1.0f);
+	while (numSamples > 0)
+	{
+		const int numThisTime = jmin(numSamples, WavetableKernel::ChunkSize);
+		const int numFadeThisTime = jmin(numThisTime, numMipmapFadeSamples);
 
-			lowerTable = currentSound->getWaveTableData(lowerTableIndex);
-			upperTable = currentSound->getWaveTableData(upperTableIndex);
+		for (int i = 0; i < numThisTime; i++)
+		{
+			const int index = (int)voiceUptime;
+			const int i1 = index % (tableSize);
 
-			float tableGainValue = tableGainInterpolator.interpolateLinear(currentSound->getUnnormalizedGainValue(lowerTableIndex), currentSound->getUnnormalizedGainValue(upperTableIndex), tableDelta);
+			int i2 = i1 + 1;
 
-			tableGainValue *= getGainValue(tableModValue);
+			if (tableValues != nullptr)
+			{
+				const float tableModValue = tableValues[startSample + i];
 
-			float u1 = upperTable[i1];
-			float u2 = upperTable[i2];
+				if (i2 >= tableSize)
+					currentTableIndex = roundToInt(tableModValue * (double)(numTables - 1));
 
-			float l1 = lowerTable[i1];
-			float l2 = lowerTable[i2];
+				updateTables(tableModValue);
+			}
 
-			const float alpha = float(voiceUptime) - (float)index;
-			//const float invAlpha = 1.0f - alpha;
+			if (i2 >= tableSize)
+				i2 = 0;
 
-			const float upperSample = tableGainInterpolator.interpolateLinear(u1, u2, alpha);
+			chunk.l1[i] = lowerTable[i1];
+			chunk.l2[i] = lowerTable[i2];
+			chunk.u1[i] = upperTable[i1];
+			chunk.u2[i] = upperTable[i2];
+			chunk.alpha[i] = float(voiceUptime) - (float)index;
+			chunk.tableDelta[i] = tableDelta;
+			chunk.gain[i] = tableGainValue;
 
-			const float lowerSample = tableGainInterpolator.interpolateLinear(l1, l2, alpha);
+			if (i < numFadeThisTime)
+			{
+				fadeChunk.l1[i] = fadeLowerTable[i1];
+				fadeChunk.l2[i] = fadeLowerTable[i2];
+				fadeChunk.u1[i] = fadeUpperTable[i1];
+				fadeChunk.u2[i] = fadeUpperTable[i2];
+			}
 
-			float sample = lowerTableIndex != upperTableIndex ? tableGainInterpolator.interpolateLinear(lowerSample, upperSample, tableDelta) : lowerSample;
+			jassert(voicePitchValues == nullptr || voicePitchValues[startSample + i] > 0.0f);
 
-			sample *= tableGainValue;
+			voiceUptime += (uptimeDelta * (voicePitchValues == nullptr ? 1.0 : voicePitchValues[startSample + i]));
+		}
 
-			sample *= 1.0f / currentSound->getUnnormalizedMaximum();
+		// Stereo mode assumed
+		WavetableKernel::render(chunk, output + startSample, numThisTime);
 
-			// Stereo mode assumed
-			voiceBuffer.setSample(0, startSample, sample);
+		if (numFadeThisTime > 0)
+		{
+			FloatVectorOperations::copy(fadeChunk.alpha, chunk.alpha, numFadeThisTime);
+			FloatVectorOperations::copy(fadeChunk.tableDelta, chunk.tableDelta, numFadeThisTime);
+			FloatVectorOperations::copy(fadeChunk.gain, chunk.gain, numFadeThisTime);
 
-			jassert(voicePitchValues == nullptr || voicePitchValues[startSample] > 0.0f);
+			float previousLevel[WavetableKernel::ChunkSize];
+			WavetableKernel::render(fadeChunk, previousLevel, numFadeThisTime);
 
-			const double delta = (uptimeDelta * (voicePitchValues == nullptr ? 1.0 : voicePitchValues[startSample]));
+			const float gainDelta = 1.0f / (float)MipmapFadeLength;
+			const float startGain = (float)(MipmapFadeLength - numMipmapFadeSamples) * gainDelta;
 
-			voiceUptime += delta;
+			WavetableKernel::crossfade(previousLevel, output + startSample, numFadeThisTime, startGain, gainDelta);
 
-			++startSample;
+			numMipmapFadeSamples -= numFadeThisTime;
 		}
+
+		startSample += numThisTime;
+		numSamples -= numThisTime;
 	}
 
 	if (auto modValues = getOwnerSynth()->getVoiceGainValues())
@@ -308,6 +373,9 @@ void WavetableSynthVoice::startNote(int midiNoteNumber, float /*velocity*/, Synt
 	nextTableIndex = 0;
 	currentTableIndex = 0;
 
+	lastMipmapLevel = -1;
+	numMipmapFadeSamples = 0;
+
 	static_cast<WavetableSynth*>(getOwnerSynth())->lastGainIndex = -1;
 
 	tableSize = currentSound->getTableSize();
@@ -346,9 +414,25 @@ WavetableSound::WavetableSound(const ValueTree &wavetableData)
 
 	normalizeTables();
 
+	createMipmaps(wavetableData.getProperty("mipmapLevels", 0));
+
 	pitchRatio = 1.0;
 }
 
+const float * WavetableSound::getWaveTableData(int wavetableIndex, int mipmapLevel) const
+{
+	if (mipmapLevel <= 0 || mipmaps.isEmpty())
+		return getWaveTableData(wavetableIndex);
+
+	if (wavetableIndex < wavetableAmount)
+	{
+		auto b = mipmaps[jmin(mipmaps.size(), mipmapLevel) - 1];
+		return b->getReadPointer(0, wavetableIndex * wavetableSize);
+	}
+
+	return nullptr;
+}
+
 const float * WavetableSound::getWaveTableData(int wavetableIndex) const
 {
 	if (wavetableIndex < wavetableAmount)
@@ -395,4 +479,69 @@ void WavetableSound::normalizeTables()
 	maximum = 1.0f;
 }
 
+void WavetableSound::createMipmaps(int numLevels)
+{
+	mipmaps.clear();
+	numHarmonics = wavetableSize / 2;
+
+	if (numLevels <= 0 || !isPowerOfTwo(wavetableSize) || wavetableSize < 16)
+		return;
+
+	const int order = (int)std::log2(wavetableSize);
+	juce::dsp::FFT fft(order);
+
+	HeapBlock<float> spectrum, levelData, maxMagnitudes;
+	spectrum.calloc(2 * wavetableSize);
+	levelData.calloc(2 * wavetableSize);
+	maxMagnitudes.calloc(wavetableSize / 2 + 1);
+
+	// Stop if the level would only contain the fundamental
+	numLevels = jmin(numLevels, order - 2);
+
+	for (int level = 1; level <= numLevels; level++)
+		mipmaps.add(new AudioSampleBuffer(1, wavetables.getNumSamples()));
+
+	for (int i = 0; i < wavetableAmount; i++)
+	{
+		FloatVectorOperations::clear(spectrum, 2 * wavetableSize);
+		FloatVectorOperations::copy(spectrum, wavetables.getReadPointer(0, i * wavetableSize), wavetableSize);
+
+		fft.performRealOnlyForwardTransform(spectrum, true);
+
+		for (int k = 0; k <= wavetableSize / 2; k++)
+			maxMagnitudes[k] = jmax(maxMagnitudes[k], std::hypot(spectrum[2 * k], spectrum[2 * k + 1]));
+
+		for (int level = 1; level <= numLevels; level++)
+		{
+			const int numLevelHarmonics = (wavetableSize / 2) >> level;
+
+			FloatVectorOperations::copy(levelData, spectrum, 2 * wavetableSize);
+
+			// The inverse transform only uses the bins up to the nyquist frequency
+			FloatVectorOperations::clear(levelData + 2 * (numLevelHarmonics + 1), wavetableSize - 2 * numLevelHarmonics);
+
+			fft.performRealOnlyInverseTransform(levelData);
+
+			FloatVectorOperations::copy(mipmaps[level - 1]->getWritePointer(0, i * wavetableSize), levelData, wavetableSize);
+		}
+	}
+
+	// The highest harmonic above -80dB decides when the voice needs to switch to the next level
+	float maxMagnitude = 0.0f;
+
+	for (int k = 1; k <= wavetableSize / 2; k++)
+		maxMagnitude = jmax(maxMagnitude, maxMagnitudes[k]);
+
+	numHarmonics = 0;
+
+	for (int k = wavetableSize / 2; k > 0; k--)
+	{
+		if (maxMagnitudes[k] > maxMagnitude * 0.0001f)
+		{
+			numHarmonics = k;
+			break;
+		}
+	}
+}
+
 } // namespace hise
@@ -53,6 +53,7 @@ public:
 	*	- 'amount' the number of wavetables
 	*	- 'noteNumber' the noteNumber
 	*	- 'sampleRate' the sample rate
+	*	- 'mipmapLevels' the number of band-limited octave levels that should be created (optional)
 	*
 	*/
 	WavetableSound(const ValueTree &wavetableData);;
@@ -67,6 +68,37 @@ public:
 	*/
 	const float *getWaveTableData(int wavetableIndex) const;
 
+	/** Returns a read pointer to the band-limited version of the wavetable for the given mipmap level.
+	*
+	*	Level 0 is the original table and each level removes the upper half of the harmonics
+	*	of the previous level so that it can be played one octave higher without aliasing.
+	*/
+	const float *getWaveTableData(int wavetableIndex, int mipmapLevel) const;
+
+	int getNumMipmapLevels() const { return mipmaps.size(); }
+
+	/** Returns the lowest mipmap level that can be played back without aliasing.
+	*
+	*	The ratio is the amount of table samples per output sample (like the pitch ratio of this sound).
+	*	A level is alias free if its highest harmonic stays below the nyquist frequency, so a table that
+	*	only contains the lower harmonics can be played back higher before it has to switch to the next level.
+	*/
+	int getMipmapLevelForPitchRatio(double ratio) const
+	{
+		for (int level = 0; level < mipmaps.size(); level++)
+		{
+			const int numLevelHarmonics = jmin(numHarmonics, (wavetableSize / 2) >> level);
+
+			if ((double)numLevelHarmonics * ratio <= (double)wavetableSize * 0.5)
+				return level;
+		}
+
+		return mipmaps.size();
+	}
+
+	/** Returns the highest harmonic that is contained in the tables (this is only calculated if the sound uses mipmaps). */
+	int getNumHarmonics() const { return numHarmonics; }
+
 	float getUnnormalizedMaximum()
 	{
 		return unnormalizedMaximum;
@@ -97,6 +129,9 @@ public:
 
 	void normalizeTables();
 
+	/** Creates the band-limited tables for the given amount of octaves. The table size must be a power of two. */
+	void createMipmaps(int numLevels);
+
 	float getUnnormalizedGainValue(int tableIndex)
 	{
 		jassert(tableIndex < 64);
@@ -117,6 +152,9 @@ private:
 	AudioSampleBuffer wavetables;
 	AudioSampleBuffer emptyBuffer;
 
+	OwnedArray<AudioSampleBuffer> mipmaps;
+	int numHarmonics = 0;
+
 	double sampleRate;
 	double pitchRatio;
 
@@ -147,6 +185,12 @@ public:
 
 	void calculateBlock(int startSample, int numSamples) override;;
 
+	/** Returns the mipmap level of the current sound for the pitch at the start of the block. */
+	int getMipmapLevel(const float* voicePitchValues, int startSample) const;
+
+	/** The amount of samples that are crossfaded when the voice switches to another mipmap level. */
+	static constexpr int MipmapFadeLength = 128;
+
 	int getCurrentTableIndex() const
 	{
 		return currentTableIndex;
@@ -192,6 +236,10 @@ private:
 	float const *lowerTable;
 	float const *upperTable;
 
+	int lastMipmapLevel = -1;
+	int fadeMipmapLevel = 0;
+	int numMipmapFadeSamples = 0;
+
 
 
 	float const *currentTable;
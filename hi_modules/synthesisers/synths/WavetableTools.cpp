@@ -1094,6 +1094,9 @@ void SampleMapToWavetableConverter::storeData(int noteNumber, float* data, Value
 	child.setProperty("amount", numPartsToUse, nullptr);
 	child.setProperty("sampleRate", sampleRate, nullptr);
 
+	if (numMipmapLevels > 0)
+		child.setProperty("mipmapLevels", numMipmapLevels, nullptr);
+
 	MemoryBlock mb(length * sizeof(float));
 
 	FloatVectorOperations::copy((float*)mb.getData(), data, length);
@@ -163,6 +163,9 @@ public:
 	bool channelToUse = 0;
     WindowType windowType = FFTHelpers::FlatTop;
 
+	/** The number of band-limited octaves that the WavetableSound will create when it's loaded. */
+	int numMipmapLevels = 0;
+
 	Result refreshCurrentWavetable(double& progress, bool forceReanalysis = true);
 
 	void moveCurrentSampleIndex(bool advance)
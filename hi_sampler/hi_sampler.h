@@ -54,6 +54,8 @@ END_JUCE_MODULE_DECLARATION
 #include "../hi_components/hi_components.h"
 #include "../hi_dsp_library/hi_dsp_library.h"
 
+#include <deque>
+
 /** @defgroup sampler Sampler
 	@ingroup dsp
 	
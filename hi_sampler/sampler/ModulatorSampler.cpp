@@ -84,6 +84,9 @@ SET_DOCUMENTATION(ModulatorSampler)
 
     ADD_PARAMETER_DOC(UseStaticMatrix,
         "If this is true, then the routing matrix will not be resized when you load a sample map with another mic position amount.");
+
+	ADD_PARAMETER_DOC(InterpolationMode,
+		"The interpolation that is used for pitching the samples. *Linear* (0) is the fastest, *Sinc* (1) uses a 32 point windowed sinc kernel which removes most aliasing at a higher CPU cost.");
     
 	ADD_CHAIN_DOC(SampleStartModulation, "Sample Start", 
 		"Allows modification of the sample start if the sound allows this. The modulation range is depending on the *SampleStartMod* value of each sample.");
@@ -149,6 +152,7 @@ temporaryVoiceBuffer(DEFAULT_BUFFER_TYPE_IS_FLOAT, 2, 0)
 	parameterNames.add("Reversed");
     parameterNames.add("UseStaticMatrix");
 	parameterNames.add("LowPassEnvelopeOrder");
+	parameterNames.add("InterpolationMode");
 
 	editorStateIdentifiers.add("SampleStartChainShown");
 	editorStateIdentifiers.add("SettingsShown");
@@ -176,6 +180,8 @@ temporaryVoiceBuffer(DEFAULT_BUFFER_TYPE_IS_FLOAT, 2, 0)
 		getTable(i)->setYTextConverterRaw(Modulation::getValueAsDecibel);
 
 	getMatrix().setAllowResizing(true);
+
+	soundCollector = new SoundLookupCollector(this, false);
 }
 
 
@@ -401,6 +407,7 @@ void ModulatorSampler::restoreFromValueTree(const ValueTree &v)
 	setVoiceAmount(v.getProperty("VoiceAmount", voiceAmount));
 	
 	loadAttribute(Reversed, "Reversed");
+	loadAttribute(InterpolationMode, "InterpolationMode");
 
 	loadAttribute(SamplerRepeatMode, "SamplerRepeatMode");
 	loadAttribute(Purged, "Purged");
@@ -444,6 +451,7 @@ ValueTree ModulatorSampler::exportAsValueTree() const
 	saveAttribute(Reversed, "Reversed");
 	v.setProperty("NumChannels", numChannels, nullptr);
     saveAttribute(UseStaticMatrix, "UseStaticMatrix");
+	saveAttribute(InterpolationMode, "InterpolationMode");
 
 	ValueTree channels("channels");
 
@@ -519,6 +527,7 @@ float ModulatorSampler::getAttribute(int parameterIndex) const
 	case Reversed:			return reversed ? 1.0f : 0.0f;
     case UseStaticMatrix:   return useStaticMatrix ? 1.0f : 0.0f;
 	case LowPassEnvelopeOrder: return (float)lowPassOrder * 6.0f;
+	case InterpolationMode:	return (float)(int)interpolationMode;
 	default:				jassertfalse; return -1.0f;
 	}
 }
@@ -554,6 +563,18 @@ void ModulatorSampler::setInternalAttribute(int parameterIndex, float newValue)
 		if (envelopeFilter != nullptr)
 			envelopeFilter->setOrder(lowPassOrder);
 		break;
+	case InterpolationMode:
+	{
+		using Mode = StreamingSamplerVoice::Interpolator::Mode;
+
+		interpolationMode = (Mode)jlimit(0, (int)Mode::numModes - 1, roundToInt(newValue));
+
+		// Build the tables here so that the audio thread doesn't have to
+		if (interpolationMode == Mode::Sinc)
+			StreamingSamplerVoice::Interpolator::initSincTables();
+
+		break;
+	}
 	default:				jassertfalse; break;
 	}
 }
@@ -919,14 +940,16 @@ void ModulatorSampler::setDisplayedGroup(int index, bool shouldBeVisible, Modifi
 
 void ModulatorSampler::setSortByGroup(bool shouldSortByGroup)
 {
-	if (shouldSortByGroup != (soundCollector != nullptr))
+	auto c = dynamic_cast<SoundLookupCollector*>(soundCollector.get());
+
+	if (c == nullptr || c->isGroupedByRRGroup() != shouldSortByGroup)
 	{
-		LockHelpers::SafeLock sl(getMainController(), LockHelpers::AudioLock);
+		ScopedPointer<SoundCollectorBase> newCollector = new SoundLookupCollector(this, shouldSortByGroup);
 
-		if (shouldSortByGroup)
-			soundCollector = new GroupedRoundRobinCollector(this);
-		else
-			soundCollector = nullptr;
+		{
+			LockHelpers::SafeLock sl(getMainController(), LockHelpers::AudioLock);
+			soundCollector.swapWith(newCollector);
+		}
 	}
 }
 
@@ -1605,6 +1628,88 @@ void ModulatorSampler::toggleMidiInputLock(const Identifier& id, int lockValue)
 	}
 }
 
+/** Preloads a batch of sounds that are stored in the same file in the order of their file offset. */
+struct ModulatorSampler::PreloadJob : public ThreadPoolJob
+{
+	struct Context
+	{
+		bool shouldExit() const
+		{
+			return failed.load() || sampleThread->threadShouldExit();
+		}
+
+		Thread* sampleThread = nullptr;
+		int preloadSize = 0;
+
+		// Only set if the jobs run on the sample thread (otherwise the progress is set by the caller)
+		double* progress = nullptr;
+		int numToLoad = 1;
+
+		std::atomic<int> numLoaded = { 0 };
+		std::atomic<bool> failed = { false };
+
+		CriticalSection errorLock;
+		String errorMessage;
+	};
+
+	PreloadJob(Context& c, const File& f) :
+		ThreadPoolJob("Preloading " + f.getFileName()),
+		context(c),
+		file(f)
+	{}
+
+	/** Sorts the sounds by their offset in the file and removes duplicates. */
+	void sortAndRemoveDuplicates()
+	{
+		std::sort(sounds.begin(), sounds.end(), [](StreamingSamplerSound* a, StreamingSamplerSound* b)
+		{
+			auto aOffset = a->getMonolithOffset();
+			auto bOffset = b->getMonolithOffset();
+
+			return aOffset != bOffset ? aOffset < bOffset : a < b;
+		});
+
+		for (int i = sounds.size() - 1; i > 0; i--)
+		{
+			if (sounds.getUnchecked(i) == sounds.getUnchecked(i - 1))
+				sounds.remove(i);
+		}
+	}
+
+	JobStatus runJob() override
+	{
+		for (auto s : sounds)
+		{
+			if (context.shouldExit() || shouldExit())
+				return jobHasFinished;
+
+			String errorMessage;
+
+			if (!StreamingHelpers::preloadSample(s, context.preloadSize, errorMessage))
+			{
+				ScopedLock sl(context.errorLock);
+
+				if (context.errorMessage.isEmpty())
+					context.errorMessage = errorMessage;
+
+				context.failed = true;
+				return jobHasFinished;
+			}
+
+			auto numLoaded = ++context.numLoaded;
+
+			if (context.progress != nullptr)
+				*context.progress = (double)numLoaded / (double)context.numToLoad;
+		}
+
+		return jobHasFinished;
+	}
+
+	Context& context;
+	const File file;
+	ReferenceCountedArray<StreamingSamplerSound> sounds;
+};
+
 bool ModulatorSampler::preloadAllSamples()
 {
 	int preloadSizeToUse = (int)getAttribute(ModulatorSampler::PreloadSize) * getPreloadScaleFactor();
@@ -1622,13 +1727,34 @@ bool ModulatorSampler::preloadAllSamples()
 	ModulatorSampler::SoundIterator sIter(this);
 	jassert(sIter.canIterate());
 
-	const int numToLoad = jmax<int>(1, sounds.size() * getNumMicPositions());
-	int currentIndex = 0;
-
 	auto& progress = getMainController()->getSampleManager().getPreloadProgress();
 
 	auto threadPool = getMainController()->getSampleManager().getGlobalSampleThreadPool();
 
+	PreloadJob::Context context;
+	context.sampleThread = threadPool;
+	context.preloadSize = preloadSizeToUse;
+
+	// The sounds are batched per file so that every file is read sequentially
+	// by a single thread (the HLAC decoder of a monolith can't be shared)
+	OwnedArray<PreloadJob> jobs;
+
+	auto addToJob = [&](StreamingSamplerSound* s)
+	{
+		auto f = s->getMonolithFile();
+
+		for (auto j : jobs)
+		{
+			if (j->file == f)
+			{
+				j->sounds.add(s);
+				return;
+			}
+		}
+
+		jobs.add(new PreloadJob(context, f))->sounds.add(s);
+	};
+
 	while (auto sound = sIter.getNextSound())
 	{
 		if (threadPool->threadShouldExit())
@@ -1638,12 +1764,7 @@ bool ModulatorSampler::preloadAllSamples()
 
 		if (getNumMicPositions() == 1)
 		{
-			auto s = sound->getReferenceToSound().get();
-
-			progress = (double)currentIndex++ / (double)numToLoad;
-
-			if (!preloadSample(s, preloadSizeToUse))
-				return false;
+			addToJob(sound->getReferenceToSound().get());
 		}
 		else
 		{
@@ -1651,24 +1772,128 @@ bool ModulatorSampler::preloadAllSamples()
 			{
 				const bool isEnabled = getChannelData(j).enabled;
 
-				progress = (double)currentIndex++ / (double)numToLoad;
-
 				if (auto s = sound->getReferenceToSound(j))
 				{
 					if (isEnabled)
-					{
-						if (!preloadSample(s.get(), preloadSizeToUse))
-							return false;
-					}
+						addToJob(s.get());
 					else
 						s->setPurged(true);
 				}
 			}
 		}
+	}
 
-		sound->setReversed(isReversed);
+	const int numThreads = jlimit(1, HISE_NUM_PRELOAD_THREADS, SystemStats::getNumCpus());
+
+	for (int i = 0; i < jobs.size(); i++)
+	{
+		auto j = jobs[i];
+
+		j->sortAndRemoveDuplicates();
+
+		// Sounds without a monolith are all in separate files, so we can split them up
+		if (j->file == File() && numThreads > 1)
+		{
+			const int numPerJob = j->sounds.size() / numThreads + 1;
+
+			while (j->sounds.size() > numPerJob)
+			{
+				auto split = jobs.add(new PreloadJob(context, File()));
+
+				for (int k = j->sounds.size() - numPerJob; k < j->sounds.size(); k++)
+					split->sounds.add(j->sounds[k]);
+
+				j->sounds.removeLast(numPerJob);
+			}
+		}
+	}
+
+	int numToLoad = 0;
+
+	for (auto j : jobs)
+		numToLoad += j->sounds.size();
+
+	context.numToLoad = jmax(1, numToLoad);
+
+	const int numThreadsToUse = jmin(numThreads, jobs.size());
+	const auto startTime = Time::getMillisecondCounterHiRes();
+
+	if (numThreadsToUse <= 1)
+	{
+		context.progress = &progress;
+
+		for (auto j : jobs)
+			j->runJob();
+
+		if (threadPool->threadShouldExit())
+			return false;
+	}
+	else
+	{
+		auto& pool = *getMainController()->getSampleManager().getPreloadThreadPool();
+
+		for (auto j : jobs)
+			pool.addJob(j, false);
+
+		auto isRunning = [&]()
+		{
+			for (auto j : jobs)
+			{
+				if (pool.contains(j))
+					return true;
+			}
+
+			return false;
+		};
+
+		while (isRunning())
+		{
+			if (threadPool->threadShouldExit())
+			{
+				// The jobs and the context live on this stack frame, so wait until every job is out of the pool
+				for (auto j : jobs)
+					pool.removeJob(j, true, -1);
+
+				return false;
+			}
+
+			progress = (double)context.numLoaded.load() / (double)context.numToLoad;
+			Thread::sleep(20);
+		}
+	}
+
+	if (context.failed)
+	{
+		logPreloadError(context.errorMessage);
+		return false;
 	}
 
+	const auto seconds = (Time::getMillisecondCounterHiRes() - startTime) * 0.001;
+
+	int64 numBytes = 0;
+
+	for (auto j : jobs)
+	{
+		for (auto s : j->sounds)
+			numBytes += (int64)s->getActualPreloadSize();
+	}
+
+	const double megaBytes = (double)numBytes / 1024.0 / 1024.0;
+
+	String timing;
+	timing << "Preloaded " << String(numToLoad) << " samples from " << String(jobs.size()) << " batches using " << String(numThreadsToUse) << " threads: ";
+	timing << String(megaBytes, 1) << " MB in " << String(seconds * 1000.0, 1) << " ms";
+
+	if (seconds > 0.0)
+		timing << " (" << String(megaBytes / seconds, 1) << " MB/s)";
+
+	debugToConsole(this, timing);
+
+	sIter.reset();
+
+	while (auto sound = sIter.getNextSound())
+		sound->setReversed(isReversed);
+
 	refreshMemoryUsage();
 	setShouldUpdateUI(true);
 	setHasPendingSampleLoad(false);
@@ -1678,32 +1903,15 @@ bool ModulatorSampler::preloadAllSamples()
 }
 
 
-bool ModulatorSampler::preloadSample(StreamingSamplerSound * s, const int preloadSizeToUse)
+void ModulatorSampler::logPreloadError(const String& errorMessage)
 {
-	jassert(s != nullptr);
-
-	String fileName = s->getFileName(false);
-
-	try
-	{
-		s->setPreloadSize(s->hasActiveState() ? preloadSizeToUse : 0, true);
-		s->closeFileHandle();
-		return true;
-	}
-	catch (StreamingSamplerSound::LoadingError l)
-	{
-		String x;
-		x << "Error at preloading sample " << l.fileName << ": " << l.errorDescription;
-		getMainController()->getDebugLogger().logMessage(x);
+	getMainController()->getDebugLogger().logMessage(errorMessage);
 
 #if USE_FRONTEND
-		getMainController()->sendOverlayMessage(DeactiveOverlay::State::CustomErrorMessage, x);
+	getMainController()->sendOverlayMessage(DeactiveOverlay::State::CustomErrorMessage, errorMessage);
 #else
-		debugError(this, x);
+	debugError(this, errorMessage);
 #endif
-
-		return false;
-	}
 }
 
 ModulatorSampler::ScopedUpdateDelayer::ScopedUpdateDelayer(ModulatorSampler* s) :
@@ -1725,77 +1933,80 @@ ModulatorSampler::ScopedUpdateDelayer::~ScopedUpdateDelayer()
 	}
 }
 
-ModulatorSampler::GroupedRoundRobinCollector::GroupedRoundRobinCollector(ModulatorSampler* s):
-	sampler(s),
-	ready(false)
+ModulatorSampler::SoundLookupCollector::SoundLookupCollector(ModulatorSampler* s, bool groupByRRGroup_):
+	groupByRRGroup(groupByRRGroup_),
+	sampler(s)
 {
 	sampler->getSampleMap()->addListener(this);
-	triggerAsyncUpdate();
+	invalidate();
 }
 
-ModulatorSampler::GroupedRoundRobinCollector::~GroupedRoundRobinCollector()
+ModulatorSampler::SoundLookupCollector::~SoundLookupCollector()
 {
 	if (sampler != nullptr)
 		sampler->getSampleMap()->removeListener(this);
 }
 
-void ModulatorSampler::GroupedRoundRobinCollector::collectSounds(const HiseEvent& m, UnorderedStack<ModulatorSynthSound *>& soundsAboutToBeStarted)
+bool ModulatorSampler::SoundLookupCollector::collectSounds(const HiseEvent& m, UnorderedStack<ModulatorSynthSound *>& soundsAboutToBeStarted)
 {
-	SimpleReadWriteLock::ScopedReadLock sl(rebuildLock);
+	// The index is outdated, so let the synth check all sounds
+	if (indexedVersion.load() != version.load())
+		return false;
 
-	if (!ready)
-		jassertfalse;
+	SimpleReadWriteLock::ScopedReadLock sl(rebuildLock);
 
-	auto currentGroup = sampler->getCurrentRRGroup() - 1;
+	auto index = groupByRRGroup ? indexes[sampler->getCurrentRRGroup() - 1] : indexes.getFirst();
 
-	if (isPositiveAndBelow(currentGroup, groups.size()))
+	if (index != nullptr)
 	{
-		auto& refArray = groups.getReference(currentGroup);
+		const int noteNumber = m.getNoteNumber() + m.getTransposeAmount();
+		const int velocity = (int)m.getVelocity();
 
-		for (auto s : refArray)
+		for (auto s : index->getSounds(noteNumber, velocity))
 		{
-			if (sampler->soundCanBePlayed(s, m.getChannel(), m.getNoteNumber(), m.getFloatVelocity()))
+			if (sampler->soundCanBePlayed(s, m.getChannel(), noteNumber, m.getFloatVelocity()))
 				soundsAboutToBeStarted.insertWithoutSearch(s);
 		}
 	}
+
+	return true;
 }
 
-void ModulatorSampler::GroupedRoundRobinCollector::handleAsyncUpdate()
+void ModulatorSampler::SoundLookupCollector::handleAsyncUpdate()
 {
-	Array<ReferenceCountedArray<ModulatorSynthSound>> newList;
+	const int versionToIndex = version.load();
 
-	auto numRRGroups = (int)sampler->getAttribute(ModulatorSampler::RRGroupAmount);
+	OwnedArray<ModulatorSynth::SoundLookupIndex> newIndexes;
 
-	if (numRRGroups > 0)
-	{
-		int numToStore = sampler->getNumSounds() / numRRGroups;
+	const int numIndexes = groupByRRGroup ? (int)sampler->getAttribute(ModulatorSampler::RRGroupAmount) : 1;
 
-		newList.ensureStorageAllocated(numRRGroups);
-
-		for (int i = 0; i < numRRGroups; i++)
-		{
-			ReferenceCountedArray<ModulatorSynthSound> newArray;
-			newArray.ensureStorageAllocated(numToStore);
-			newList.add(newArray);
-		}
+	for (int i = 0; i < numIndexes; i++)
+		newIndexes.add(new ModulatorSynth::SoundLookupIndex());
 
+	if (numIndexes > 0)
+	{
 		ModulatorSampler::SoundIterator it(sampler);
 		jassert(it.canIterate());
 
 		while (auto s = it.getNextSound())
 		{
-			auto rrIndex = (int)s->getSampleProperty(SampleIds::RRGroup) - 1;
+			auto index = groupByRRGroup ? newIndexes[(int)s->getSampleProperty(SampleIds::RRGroup) - 1] : newIndexes.getFirst();
 
-			if (isPositiveAndBelow(rrIndex, newList.size()))
+			if (index != nullptr)
 			{
-				newList.getReference(rrIndex).add(static_cast<ModulatorSynthSound*>(s));
+				index->addSound(s, (int)s->getSampleProperty(SampleIds::LoKey),
+								   (int)s->getSampleProperty(SampleIds::HiKey),
+								   (int)s->getSampleProperty(SampleIds::LoVel),
+								   (int)s->getSampleProperty(SampleIds::HiVel));
 			}
 		}
 	}
 
-	SimpleReadWriteLock::ScopedWriteLock sl(rebuildLock);
-	std::swap(groups, newList);
-	ready.store(true);
+	{
+		SimpleReadWriteLock::ScopedWriteLock sl(rebuildLock);
+		indexes.swapWith(newIndexes);
+		indexedVersion.store(versionToIndex);
+	}
 }
 
 } // namespace hise
@@ -82,50 +82,70 @@ public:
 		bool prevValue;
 	};
 
-	class GroupedRoundRobinCollector : public ModulatorSynth::SoundCollectorBase,
-									   public SampleMap::Listener,
-									   public AsyncUpdater
+	/** A sound collector that uses a SoundLookupIndex to find the sounds for a note on message.
+	
+		The index is rebuilt asynchronously whenever the sample map changes. Until then, the
+		collector falls back to the default search in ModulatorSynth::collectSoundsToBeStarted().
+	*/
+	class SoundLookupCollector : public ModulatorSynth::SoundCollectorBase,
+								 public SampleMap::Listener,
+								 public AsyncUpdater
 	{
 	public:
 
-		GroupedRoundRobinCollector(ModulatorSampler* s);
+		SoundLookupCollector(ModulatorSampler* s, bool groupByRRGroup);
+
+		~SoundLookupCollector();
 
-		~GroupedRoundRobinCollector();
+		bool collectSounds(const HiseEvent& m, UnorderedStack<ModulatorSynthSound *>& soundsToBeStarted) override;
 
-		void collectSounds(const HiseEvent& m, UnorderedStack<ModulatorSynthSound *>& soundsToBeStarted) override;
+		bool isGroupedByRRGroup() const noexcept { return groupByRRGroup; }
 
 		void sampleMapWasChanged(PoolReference newSampleMap)
 		{
-			triggerAsyncUpdate();
+			invalidate();
 		}
 
 		void samplePropertyWasChanged(ModulatorSamplerSound* , const Identifier& sampleId, const var& )
 		{
-			if(sampleId == SampleIds::RRGroup)
-				triggerAsyncUpdate();
+			if (sampleId == SampleIds::RRGroup || 
+				sampleId == SampleIds::LoKey || sampleId == SampleIds::HiKey ||
+				sampleId == SampleIds::LoVel || sampleId == SampleIds::HiVel)
+			{
+				invalidate();
+			}
 		};
 
 		virtual void sampleAmountChanged() 
 		{
-			triggerAsyncUpdate();
+			invalidate();
 		};
 
 		virtual void sampleMapCleared()
 		{
-			triggerAsyncUpdate();
+			invalidate();
 		};
 
 	private:
 
+		void invalidate()
+		{
+			++version;
+			triggerAsyncUpdate();
+		}
+
+		const bool groupByRRGroup;
+
 		SimpleReadWriteLock rebuildLock;
 
 		WeakReference<ModulatorSampler> sampler;
 
 		void handleAsyncUpdate() override;
 
-		std::atomic<bool> ready;
+		std::atomic<int> version = { 0 };
+		std::atomic<int> indexedVersion = { -1 };
 
-		Array<ReferenceCountedArray<ModulatorSynthSound>> groups;
+		OwnedArray<ModulatorSynth::SoundLookupIndex> indexes;
 	};
 
 	/** A small helper tool that iterates over the sound array in a thread-safe way.
@@ -219,6 +239,7 @@ public:
 		Reversed,
         UseStaticMatrix,
 		LowPassEnvelopeOrder,
+		InterpolationMode,
 		numModulatorSamplerParameters
 	};
 
@@ -413,8 +434,6 @@ public:
 	/** This function will be called on a background thread and preloads all samples. */
 	bool preloadAllSamples();
 
-	bool preloadSample(StreamingSamplerSound * s, const int preloadSizeToUse);
-
 	bool saveSampleMap() const;
 
 	bool saveSampleMapAsReference() const;
@@ -438,6 +457,9 @@ public:
 	void setRRGroupAmount(int newGroupLimit);
 
 	bool isPitchTrackingEnabled() const {return pitchTrackingEnabled; };
+
+	/** Returns the interpolation algorithm that the voices use for resampling. */
+	StreamingSamplerVoice::Interpolator::Mode getInterpolationMode() const noexcept { return interpolationMode; }
 	bool isOneShot() const {return oneShotEnabled; };
 
 	bool isNoteNumberMapped(int noteNumber) const;
@@ -660,7 +682,10 @@ private:
 
 	bool abortIteration = false;
 	
-	
+	struct PreloadJob;
+
+	void logPreloadError(const String& errorMessage);
+
 
 	bool isOnSampleLoadingThread() const
 	{
@@ -787,6 +812,8 @@ private:
 	bool delayUpdate = false;
 	int lowPassOrder = 0;
 
+	StreamingSamplerVoice::Interpolator::Mode interpolationMode = StreamingSamplerVoice::Interpolator::Mode::Linear;
+
 	float groupGainValues[8];
 	float currentCrossfadeValue;
 
@@ -477,13 +477,104 @@ void SampleMap::valueTreePropertyChanged(ValueTree& treeWhosePropertyHasChanged,
 	if (treeWhosePropertyHasChanged == data)
 		return;
 
-	auto i = data.indexOf(treeWhosePropertyHasChanged);
+	// setSampleProperties() has already updated the cache and the sound
+	if (property == batchProperty && treeWhosePropertyHasChanged == batchSample)
+		return;
 
-	if (i != -1)
+	if (auto sound = getSoundForSample(treeWhosePropertyHasChanged))
 	{
 		auto v = treeWhosePropertyHasChanged.getProperty(property);
-		notifier.addPropertyChange(i, property, v);
+
+		propertyCache.setValue(sound->getPropertyCacheRow(), property, v);
+		notifier.addPropertyChange(sound, property, v);
+	}
+}
+
+void SampleMap::setSampleProperties(const Array<ReferenceCountedObjectPtr<ModulatorSamplerSound>>& sounds, const Identifier& id, const var& newValue, bool useUndo)
+{
+	auto columnIndex = PropertyCache::getColumnIndex(id);
+
+	if (columnIndex == -1)
+	{
+		for (auto s : sounds)
+		{
+			if (s != nullptr)
+				s->setSampleProperty(id, newValue, useUndo);
+		}
+
+		return;
+	}
+
+	auto um = useUndo ? sampler->getMainController()->getControlUndoManager() : nullptr;
+
+	for (auto s : sounds)
+	{
+		if (s == nullptr)
+			continue;
+
+		auto v = s->clipSampleProperty(id, newValue, useUndo);
+
+		propertyCache.setValue(s->getPropertyCacheRow(), columnIndex, v);
+
+		{
+			ScopedValueSetter<ValueTree> svs1(batchSample, s->getData());
+			ScopedValueSetter<Identifier> svs2(batchProperty, id);
+
+			s->getData().setProperty(id, SampleIds::Helpers::toPropertyValue(id, v), um);
+		}
+
+		notifier.addPropertyChange(s.get(), id, v);
+	}
+}
+
+int SampleMap::getIndexOfSample(const ValueTree& sampleData) const
+{
+	auto hint = lastSampleIndex.load();
+
+	for (int i = hint; i < hint + 2; i++)
+	{
+		if (data.getChild(i) == sampleData)
+		{
+			lastSampleIndex.store(i);
+			return i;
+		}
 	}
+
+	auto index = data.indexOf(sampleData);
+
+	if (index != -1)
+		lastSampleIndex.store(index);
+
+	return index;
+}
+
+hise::ModulatorSamplerSound* SampleMap::getSoundForSample(const ValueTree& sampleData)
+{
+	auto index = getIndexOfSample(sampleData);
+
+	if (index == -1)
+		return nullptr;
+
+	auto s = getSound(index);
+
+	// The sounds are usually in the same order as the samples, but an undone deletion appends the sound
+	if (s != nullptr && s->getData() != sampleData)
+	{
+		s = nullptr;
+
+		for (int i = 0; i < sampler->getNumSounds(); i++)
+		{
+			auto candidate = getSound(i);
+
+			if (candidate != nullptr && candidate->getData() == sampleData)
+			{
+				s = candidate;
+				break;
+			}
+		}
+	}
+
+	return s;
 }
 
 void SampleMap::valueTreeChildAdded(ValueTree& parentTree, ValueTree& childWhichHasBeenAdded)
@@ -1227,6 +1318,79 @@ void MonolithExporter::threadFinished()
 }
 
 
+struct MonolithExporter::FileEncodingJob : public ThreadPoolJob
+{
+	FileEncodingJob(int sampleIndex_, const File& file_, AudioFormatReader* reader_, hlac::HiseLosslessAudioFormat* format_, hlac::HiseLosslessAudioFormatWriter* writer_) :
+		ThreadPoolJob("Encode " + file_.getFileName()),
+		sampleIndex(sampleIndex_),
+		file(file_),
+		numBytesToEncode(reader_->lengthInSamples * (int64)reader_->numChannels * (int64)sizeof(int16)),
+		format(format_),
+		reader(reader_),
+		writer(writer_)
+	{}
+
+	JobStatus runJob() override
+	{
+		// AudioFormatWriter::writeFromAudioReader() splits the data into chunks of 16384 samples, 
+		// so we need to use a multiple of that in order to get the same blocks
+		const int64 numSamplesPerChunk = 16384 * 16;
+
+		for (int64 i = 0; i < reader->lengthInSamples; i += numSamplesPerChunk)
+		{
+			if (shouldExit())
+				return jobHasFinished;
+
+			const auto numToDo = jmin(numSamplesPerChunk, reader->lengthInSamples - i);
+
+			if (!writer->writeFromAudioReader(*reader, i, numToDo))
+				return jobHasFinished;
+		}
+
+		reader = nullptr;
+		ok = true;
+
+		return jobHasFinished;
+	}
+
+	const int sampleIndex;
+	const File file;
+	const int64 numBytesToEncode;
+
+	// The format owns the block offsets of the writer, so it must be destroyed last
+	ScopedPointer<hlac::HiseLosslessAudioFormat> format;
+	ScopedPointer<AudioFormatReader> reader;
+	ScopedPointer<hlac::HiseLosslessAudioFormatWriter> writer;
+
+	bool ok = false;
+};
+
+hlac::HlacEncoder::CompressorOptions MonolithExporter::getCompressorOptions()
+{
+	auto options = hlac::HlacEncoder::CompressorOptions::getPreset(hlac::HlacEncoder::CompressorOptions::Presets::Diff);
+
+	options.applyDithering = false;
+	options.normalisationMode = (uint8)getComboBoxComponent("normalise")->getSelectedItemIndex();
+
+	return options;
+}
+
+hlac::HiseLosslessAudioFormatWriter* MonolithExporter::createEncodingWriter(hlac::HiseLosslessAudioFormat& hlac, bool isMono)
+{
+	auto options = getCompressorOptions();
+
+	StringPairArray empty;
+
+	ScopedPointer<AudioFormatWriter> writer = hlac.createWriterFor(nullptr, sampleRate, isMono ? 1 : 2, 16, empty, 5);
+
+	auto hWriter = dynamic_cast<hlac::HiseLosslessAudioFormatWriter*>(writer.get());
+
+	hWriter->setOptions(options);
+
+	writer.release();
+	return hWriter;
+}
+
 juce::AudioFormatWriter* MonolithExporter::createWriter(hlac::HiseLosslessAudioFormat& hlac, const File& outputFile, bool isMono)
 {
 	bool ok = outputFile.deleteFile();
@@ -1237,10 +1401,7 @@ juce::AudioFormatWriter* MonolithExporter::createWriter(hlac::HiseLosslessAudioF
 
 	FileOutputStream* hlacOutput = new FileOutputStream(outputFile);
 
-	auto options = hlac::HlacEncoder::CompressorOptions::getPreset(hlac::HlacEncoder::CompressorOptions::Presets::Diff);
-
-	options.applyDithering = false;
-	options.normalisationMode = (uint8)getComboBoxComponent("normalise")->getSelectedItemIndex();
+	auto options = getCompressorOptions();
 
 	StringPairArray empty;
 
@@ -1390,30 +1551,76 @@ void MonolithExporter::writeFiles(int channelIndex, bool overwriteExistingData)
 
 		int64 numBytesWritten = 0;
 
-		for (int i = 0; i < channelList->size(); i++)
-		{
-			auto s = channelList->getUnchecked(i);
+		// The files are encoded in parallel and appended to the monolith in their original order.
+		// The amount of pending sample data is limited by MaxNumBytesInFlight.
+		OwnedArray<FileEncodingJob> pendingJobs;
+		ThreadPool encodingPool(SystemStats::getNumCpus());
 
-			showStatusMessage("Encode file " + s.getFileName());
+		int64 numBytesInFlight = 0;
+		int nextFileIndex = 0;
 
-			setProgress((double)i / (double)numSamples);
+		while (nextFileIndex < channelList->size() || !pendingJobs.isEmpty())
+		{
+			if (threadShouldExit())
+			{
+				encodingPool.removeAllJobs(true, -1);
+				return;
+			}
 
-            if(threadShouldExit())
-                return;
-            
-			ScopedPointer<AudioFormatReader> reader = afm.createReaderFor(s);
+			const bool canAddJob = nextFileIndex < channelList->size() &&
+								   pendingJobs.size() < 2 * encodingPool.getNumThreads() &&
+								   (pendingJobs.isEmpty() || numBytesInFlight < MaxNumBytesInFlight);
 
-			if (reader != nullptr)
+			if (canAddJob)
 			{
-				writer->writeFromAudioReader(*reader, 0, -1);
-				
-				if (auto hWriter = dynamic_cast<hlac::HiseLosslessAudioFormatWriter*>(writer.get()))
+				auto s = channelList->getUnchecked(nextFileIndex);
+
+				ScopedPointer<AudioFormatReader> reader = afm.createReaderFor(s);
+
+				if (reader == nullptr)
 				{
-					numBytesWritten = hWriter->getNumBytesWritten();
+					encodingPool.removeAllJobs(true, -1);
+
+					error = "Could not read the source file " + s.getFullPathName();
+					writer->flush();
+					writer = nullptr;
+
+					return;
 				}
+
+				ScopedPointer<hlac::HiseLosslessAudioFormat> jobFormat = new hlac::HiseLosslessAudioFormat();
+				auto jobWriter = createEncodingWriter(*jobFormat, isMono);
+
+				jobWriter->preallocateMemory(reader->lengthInSamples, reader->numChannels);
+
+				auto job = pendingJobs.add(new FileEncodingJob(nextFileIndex, s, reader.release(), jobFormat.release(), jobWriter));
+
+				numBytesInFlight += job->numBytesToEncode;
+				encodingPool.addJob(job, false);
+
+				++nextFileIndex;
+				continue;
 			}
-			else
+
+			ScopedPointer<FileEncodingJob> job = pendingJobs.removeAndReturn(0);
+
+			encodingPool.waitForJobToFinish(job, -1);
+			numBytesInFlight -= job->numBytesToEncode;
+
+			const int i = job->sampleIndex;
+			auto s = job->file;
+
+			showStatusMessage("Encode file " + s.getFileName());
+
+			setProgress((double)i / (double)numSamples);
+
+			if (!job->ok)
 			{
+				encodingPool.removeAllJobs(true, -1);
+
+				if (threadShouldExit())
+					return;
+
 				error = "Could not read the source file " + s.getFullPathName();
 				writer->flush();
 				writer = nullptr;
@@ -1421,6 +1628,24 @@ void MonolithExporter::writeFiles(int channelIndex, bool overwriteExistingData)
 				return;
 			}
 
+			if (auto hWriter = dynamic_cast<hlac::HiseLosslessAudioFormatWriter*>(writer.get()))
+			{
+				if (!hWriter->appendEncodedData(*job->writer))
+				{
+					encodingPool.removeAllJobs(true, -1);
+
+					error = "Could not write " + s.getFileName() + " to the monolith " + outputFile.getFullPathName();
+					writer = nullptr;
+
+					// Don't leave a truncated monolith behind
+					outputFile.deleteFile();
+
+					return;
+				}
+
+				numBytesWritten = hWriter->getNumBytesWritten();
+			}
+
 			if (shouldSplit(channelIndex, numBytesWritten, i))
 			{
 				writer->flush();
@@ -1747,9 +1972,9 @@ void SampleMap::Notifier::sendMapChangeMessage(NotificationType n)
 		handleLightweightPropertyChanges();
 }
 
-void SampleMap::Notifier::addPropertyChange(int index, const Identifier& id, const var& newValue)
+void SampleMap::Notifier::addPropertyChange(ModulatorSamplerSound* sound, const Identifier& id, const var& newValue)
 {
-	if (auto sound = parent.getSound(index))
+	if (sound != nullptr)
 	{
 		if (!ModulatorSamplerSound::isAsyncProperty(id))
 		{
@@ -1757,26 +1982,17 @@ void SampleMap::Notifier::addPropertyChange(int index, const Identifier& id, con
 
 			ScopedLock sl(pendingChanges.getLock());
 
-			bool found = false;
-
-			for (int i = 0; i < pendingChanges.size(); i++)
+			if (auto existing = pendingChangeMap[sound])
 			{
-				auto p = pendingChanges[i];
-
-				if (*p == index)
-				{
-					p->set(id, newValue);
-					found = true;
-					break;
-				}
+				existing->set(id, newValue);
 			}
-
-			if (!found)
+			else
 			{
 				ScopedPointer<PropertyChange> newChange = new PropertyChange();
-				newChange->index = index;
+				newChange->sound = sound;
 				newChange->set(id, newValue);
 
+				pendingChangeMap.set(sound, newChange.get());
 				pendingChanges.add(newChange.release());
 			}
 
@@ -1932,11 +2148,17 @@ void SampleMap::Notifier::handleLightweightPropertyChanges()
 	}
 	else
 	{
-		while (!pendingChanges.isEmpty())
+		OwnedArray<PropertyChange, CriticalSection> changesThisTime;
+
 		{
-			ScopedPointer<PropertyChange> c = pendingChanges.removeAndReturn(0);
+			ScopedLock sl(pendingChanges.getLock());
+			changesThisTime.swapWith(pendingChanges);
+			pendingChangeMap.clear();
+		}
 
-			if (auto sound = parent.getSound(c->index))
+		for (auto c : changesThisTime)
+		{
+			if (auto sound = static_cast<ModulatorSamplerSound*>(c->sound.get()))
 			{
 				ScopedLock sl(parent.listeners.getLock());
 
@@ -1989,16 +2211,16 @@ SampleMap::Notifier::AsyncPropertyChange::AsyncPropertyChange(ModulatorSamplerSo
 
 void SampleMap::Notifier::AsyncPropertyChange::addPropertyChange(ModulatorSamplerSound* sound, const var& newValue)
 {
-	int index = selection.indexOf(sound);
-
-	if (index == -1)
+	// Only coalesce with the last entry - a full search would make batch edits quadratic and
+	// duplicates are harmless because the values are applied in order.
+	if (selection.getLast().get() == sound)
 	{
-		selection.add(sound);
-		values.add(newValue);
+		values.set(values.size() - 1, newValue);
 	}
 	else
 	{
-		values.set(index, newValue);
+		selection.add(sound);
+		values.add(newValue);
 	}
 }
 
@@ -2014,4 +2236,119 @@ void SampleMap::Notifier::Collector::handleAsyncUpdate()
 	parent.handleHeavyweightPropertyChanges();
 }
 
+int SampleMap::PropertyCache::getColumnIndex(const Identifier& id)
+{
+	static const Array<Identifier> ids =
+	{
+		SampleIds::Root, SampleIds::HiKey, SampleIds::LoKey, SampleIds::LoVel, SampleIds::HiVel,
+		SampleIds::RRGroup, SampleIds::Volume, SampleIds::Pan, SampleIds::Normalized, SampleIds::Pitch,
+		SampleIds::SampleStart, SampleIds::SampleEnd, SampleIds::SampleStartMod, SampleIds::LoopStart,
+		SampleIds::LoopEnd, SampleIds::LoopXFade, SampleIds::LoopEnabled, SampleIds::LowerVelocityXFade,
+		SampleIds::UpperVelocityXFade, SampleIds::SampleState, SampleIds::Reversed
+	};
+
+	static_assert(NumColumns <= 32, "the set flags of a row must fit into a uint32");
+	jassert(ids.size() == NumColumns);
+
+	return ids.indexOf(id);
+}
+
+int SampleMap::PropertyCache::addRow(const ValueTree& sampleData)
+{
+	int rowIndex;
+
+	{
+		ScopedLock sl(rowAllocationLock);
+
+		if (!freeRows.isEmpty())
+		{
+			rowIndex = freeRows.removeAndReturn(freeRows.size() - 1);
+		}
+		else
+		{
+			SimpleReadWriteLock::ScopedWriteLock swl(rowLock);
+
+			rowIndex = (int)setFlags.size();
+			setFlags.emplace_back(0u);
+
+			for (auto& c : columns)
+				c.emplace_back(0);
+		}
+	}
+
+	for (int i = 0; i < sampleData.getNumProperties(); i++)
+	{
+		auto id = sampleData.getPropertyName(i);
+		setValue(rowIndex, id, sampleData.getProperty(id));
+	}
+
+	return rowIndex;
+}
+
+void SampleMap::PropertyCache::removeRow(int rowIndex)
+{
+	ScopedLock sl(rowAllocationLock);
+
+	if (isPositiveAndBelow(rowIndex, getNumRows()))
+	{
+		{
+			SimpleReadWriteLock::ScopedReadLock srl(rowLock);
+			setFlags[rowIndex].store(0);
+		}
+
+		freeRows.add(rowIndex);
+	}
+}
+
+void SampleMap::PropertyCache::setValue(int rowIndex, const Identifier& id, const var& newValue)
+{
+	auto columnIndex = getColumnIndex(id);
+
+	if (columnIndex == -1)
+		return;
+
+	if (newValue.isVoid())
+	{
+		SimpleReadWriteLock::ScopedReadLock srl(rowLock);
+
+		if (isPositiveAndBelow(rowIndex, getNumRows()))
+			setFlags[rowIndex].fetch_and(~(1u << (uint32)columnIndex));
+	}
+	else
+	{
+		setValue(rowIndex, columnIndex, (int)newValue);
+	}
+}
+
+void SampleMap::PropertyCache::setValue(int rowIndex, int columnIndex, int newValue)
+{
+	jassert(isPositiveAndBelow(columnIndex, NumColumns));
+
+	SimpleReadWriteLock::ScopedReadLock srl(rowLock);
+
+	if (isPositiveAndBelow(rowIndex, getNumRows()))
+	{
+		columns[columnIndex][rowIndex].store(newValue);
+		setFlags[rowIndex].fetch_or(1u << (uint32)columnIndex);
+	}
+}
+
+bool SampleMap::PropertyCache::getValue(int rowIndex, const Identifier& id, int& value) const
+{
+	auto columnIndex = getColumnIndex(id);
+
+	if (columnIndex == -1)
+		return false;
+
+	SimpleReadWriteLock::ScopedReadLock srl(rowLock);
+
+	if (isPositiveAndBelow(rowIndex, getNumRows()) && (setFlags[rowIndex].load() & (1u << (uint32)columnIndex)) != 0)
+	{
+		value = columns[columnIndex][rowIndex].load();
+		return true;
+	}
+
+	return false;
+}
+
 } // namespace hise
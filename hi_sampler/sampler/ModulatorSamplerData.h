@@ -102,6 +102,65 @@ public:
 		MonolithEncrypted,
 		numSaveModes
 	};
+
+	/** A struct-of-arrays store for the numeric properties of all sounds in a SampleMap.
+	*
+	*	Every sound gets a row when it is created and every numeric sample property (root note,
+	*	key / velocity ranges, RR group, loop points, volume, pan etc.) gets an int column, so 
+	*	reading a property is a plain array lookup instead of a NamedValueSet search with a var conversion.
+	*
+	*	The ValueTree of each sample is still the authoritative data model for undo and persistence:
+	*	the SampleMap mirrors every property change of a sample tree into this cache, and 
+	*	SampleMap::setSampleProperties() writes here first and syncs the ValueTrees afterwards.
+	*/
+	class PropertyCache
+	{
+	public:
+
+		PropertyCache() {};
+
+		/** Returns the column index of the property or -1 if the property is not cached. */
+		static int getColumnIndex(const Identifier& id);
+
+		/** Creates a row for a new sound and initialises it with the properties of its ValueTree. */
+		int addRow(const ValueTree& sampleData);
+
+		/** Releases the row so that it can be reused by the next sound. */
+		void removeRow(int rowIndex);
+
+		/** Writes the value into the cache. A void var marks the property as not set. */
+		void setValue(int rowIndex, const Identifier& id, const var& newValue);
+
+		/** Writes the value into the cache. */
+		void setValue(int rowIndex, int columnIndex, int newValue);
+
+		/** Reads the value from the cache. 
+		*
+		*	Returns false if the property is not cached or isn't set in the ValueTree of the sample
+		*	(in which case the caller should use its default value).
+		*/
+		bool getValue(int rowIndex, const Identifier& id, int& value) const;
+
+		int getNumRows() const { return (int)setFlags.size(); }
+
+	private:
+
+		static constexpr int NumColumns = 21;
+
+		/** The rows only grow in addRow(), so this is only locked for writing there. */
+		mutable SimpleReadWriteLock rowLock;
+
+		/** Serialises addRow() / removeRow() calls, which might happen on different threads. */
+		CriticalSection rowAllocationLock;
+
+		/** The cells are changed from multiple threads with only the read lock, so they are atomic.
+			A deque doesn't move its elements when it grows, which atomics don't allow. */
+		std::deque<std::atomic<int>> columns[NumColumns];
+		std::deque<std::atomic<uint32>> setFlags;
+		Array<int> freeRows;
+
+		JUCE_DECLARE_NON_COPYABLE(PropertyCache);
+	};
 	
 	SampleMap(ModulatorSampler *sampler_);
 
@@ -205,6 +264,23 @@ public:
 	void valueTreePropertyChanged(ValueTree& /*treeWhosePropertyHasChanged*/,
 		const Identifier& /*property*/);
 
+	/** Sets the property for all given sounds in one go.
+	*
+	*	This writes the (clipped) values into the property cache and updates the sounds directly, then
+	*	syncs the ValueTrees without going through the per-sample change notification. Use this instead 
+	*	of calling ModulatorSamplerSound::setSampleProperty() in a loop when you change lots of samples.
+	*/
+	void setSampleProperties(const Array<ReferenceCountedObjectPtr<ModulatorSamplerSound>>& sounds, const Identifier& id, const var& newValue, bool useUndo);
+
+	PropertyCache& getPropertyCache() { return propertyCache; }
+	const PropertyCache& getPropertyCache() const { return propertyCache; }
+
+	/** Returns the index of the sample in the samplemap (or -1 if it's not a child of this map). 
+	*
+	*	This checks the neighbours of the last lookup first, so iterating over the samples in order is O(1).
+	*/
+	int getIndexOfSample(const ValueTree& sampleData) const;
+
 	void valueTreeChildAdded(ValueTree& parentTree,
 		ValueTree& childWhichHasBeenAdded) override;;
 
@@ -323,7 +399,7 @@ private:
 
 	void setCurrentMonolith();
 
-	
+	ModulatorSamplerSound* getSoundForSample(const ValueTree& sampleData);
 
 	bool delayNotifications = false;
 	bool notificationPending = false;
@@ -340,7 +416,7 @@ private:
 
 		void sendMapClearMessage(NotificationType n);
 
-		void addPropertyChange(int index, const Identifier& id, const var& newValue);
+		void addPropertyChange(ModulatorSamplerSound* sound, const Identifier& id, const var& newValue);
 		void sendSampleAmountChangeMessage(NotificationType n);
 
 		struct Collector : public LockfreeAsyncUpdater
@@ -385,18 +461,11 @@ private:
 
 		struct PropertyChange
 		{
-			PropertyChange():
-				index(-1)
-			{};
-
-			bool operator==(int indexToCompare) const
-			{
-				return indexToCompare == index;
-			}
+			PropertyChange() {};
 
 			void set(const Identifier& id, const var& newValue);
 
-			int index;
+			SynthesiserSound::Ptr sound;
 
 			NamedValueSet propertyChanges;
 
@@ -416,6 +485,7 @@ private:
 		
 
 		OwnedArray<PropertyChange, CriticalSection> pendingChanges;
+		HashMap<const void*, PropertyChange*> pendingChangeMap;
 		Array<AsyncPropertyChange, CriticalSection> asyncPendingChanges;
 
 		bool lightWeightUpdatePending = false;
@@ -442,6 +512,14 @@ private:
 
 	ValueTree data;
 
+	PropertyCache propertyCache;
+
+	mutable std::atomic<int> lastSampleIndex = { 0 };
+
+	/** The sample tree & property that is currently written by setSampleProperties(). */
+	ValueTree batchSample;
+	Identifier batchProperty;
+
 	void setNewValueTree(const ValueTree& v);
 
 	ModulatorSampler *sampler;
@@ -550,8 +628,18 @@ private:
 
 	Array<int> splitIndexes;
 
+	struct FileEncodingJob;
+
+	/** The maximum amount of sample data that is encoded in parallel before it is appended to the monolith. */
+	static constexpr int64 MaxNumBytesInFlight = 512 * 1024 * 1024;
+
+	hlac::HlacEncoder::CompressorOptions getCompressorOptions();
+
 	AudioFormatWriter* createWriter(hlac::HiseLosslessAudioFormat& hlaf, const File& f, bool isMono);
 
+	/** Creates a writer without output stream that encodes a single file on a background thread. */
+	hlac::HiseLosslessAudioFormatWriter* createEncodingWriter(hlac::HiseLosslessAudioFormat& hlaf, bool isMono);
+
 	/** The max monolith size is 2GB - 60MB (to guarantee to stay below 2GB for FAT32. */
 	//constexpr static int maxMonolithSize = 2084569088;
 
@@ -122,6 +122,11 @@ void ModulatorSamplerSound::loadSampleFromValueTree(const ValueTree& sampleData,
 
 int ModulatorSamplerSound::getPropertyValueWithDefault(const Identifier& id) const
 {
+	int cachedValue;
+
+	if (getCachedProperty(id, cachedValue))
+		return cachedValue;
+
 	if (auto s = getReferenceToSound(0))
 	{
 		auto fullLength = (int)s->getLengthInSamples();
@@ -136,6 +141,22 @@ int ModulatorSamplerSound::getPropertyValueWithDefault(const Identifier& id) con
 	return (int)data.getProperty(id, 0);
 }
 
+bool ModulatorSamplerSound::getCachedProperty(const Identifier& id, int& value) const
+{
+	if (auto map = parentMap.get())
+		return map->getPropertyCache().getValue(propertyCacheRow, id, value);
+
+	return false;
+}
+
+int ModulatorSamplerSound::getId() const
+{
+	if (auto map = parentMap.get())
+		return map->getIndexOfSample(data);
+
+	return data.getParent().indexOf(data);
+}
+
 ModulatorSamplerSound::ModulatorSamplerSound(SampleMap* parent, const ValueTree& d, HlacMonolithInfo* hmaf) :
 	ControlledObject(parent->getSampler()->getMainController()),
 	parentMap(parent),
@@ -149,6 +170,8 @@ ModulatorSamplerSound::ModulatorSamplerSound(SampleMap* parent, const ValueTree&
 	purgeChannels(0),
 	pitchFactor(1.0)
 {
+	propertyCacheRow = parent->getPropertyCache().addRow(data);
+
 	if (isMultiMicSound)
 	{
 		for (const auto& child: data)
@@ -184,8 +207,11 @@ ModulatorSamplerSound::ModulatorSamplerSound(SampleMap* parent, const ValueTree&
 
 ModulatorSamplerSound::~ModulatorSamplerSound()
 {   
-	if(parentMap != nullptr)
+	if (parentMap != nullptr)
+	{
+		parentMap->getPropertyCache().removeRow(propertyCacheRow);
 		parentMap->getCurrentSamplePool()->clearUnreferencedSamples();
+	}
 
 	firstSound = nullptr;
 	soundArray.clear();
@@ -859,12 +885,17 @@ void ModulatorSamplerSound::setSampleProperty(const Identifier& id, const var& n
 		return;
 	}
 
+	auto v = clipSampleProperty(id, newValue, useUndo);
+
+	data.setProperty(id, SampleIds::Helpers::toPropertyValue(id, v), useUndo ? undoManager : nullptr);
+}
+
+int ModulatorSamplerSound::clipSampleProperty(const Identifier& id, const var& newValue, bool useUndo)
+{
 	clipRangeProperties(id, newValue, useUndo);
 
 	jassert(!newValue.isString());
-	auto v = getPropertyRange(id).clipValue((int)newValue);
-
-	data.setProperty(id, v, useUndo ? undoManager : nullptr);
+	return getPropertyRange(id).clipValue((int)newValue);
 }
 
 var ModulatorSamplerSound::getSampleProperty(const Identifier& id) const
@@ -875,6 +906,16 @@ var ModulatorSamplerSound::getSampleProperty(const Identifier& id) const
 	if (id == SampleIds::FileName && data.getNumChildren() != 0)
 		return data.getChild(0)[id];
 
+	int cachedValue;
+
+	if (getCachedProperty(id, cachedValue))
+	{
+		if (SampleIds::Helpers::isMapProperty(id))
+			return jlimit(0, 127, cachedValue);
+
+		return SampleIds::Helpers::toPropertyValue(id, cachedValue);
+	}
+
 	var rv = data.getProperty(id, getDefaultValue(id));
 
 	if (SampleIds::Helpers::isMapProperty(id))
@@ -202,6 +202,20 @@ struct Helpers
 			id == LoopStart || id == LoopEnd || id == LoopXFade;
 	}
 
+	static bool isBoolProperty(const Identifier& id)
+	{
+		return id == Normalized || id == LoopEnabled || id == Reversed;
+	}
+
+	/** Converts a clipped or cached int value back to the var type of the property. */
+	static var toPropertyValue(const Identifier& id, int value)
+	{
+		if (isBoolProperty(id))
+			return var(value != 0);
+
+		return var(value);
+	}
+
 };
 
 const int numProperties = 26;
@@ -349,7 +363,7 @@ public:
 	/** Returns the id.
 	*
 	*	Can also be achieved by getProperty(ID), but this is more convenient. */
-	int getId() const { return data.getParent().indexOf(data); };
+	int getId() const;
 
 	Range<int> getNoteRange() const;
 	Range<int> getVelocityRange() const;
@@ -491,8 +505,18 @@ public:
 
 	void setSampleProperty(const Identifier& id, const var& newValue, bool useUndo=true);
 
+	/** Adjusts the dependent properties and returns the value clipped to the property range.
+	*
+	*	This is the first half of setSampleProperty() and is used by SampleMap::setSampleProperties()
+	*	to write the result directly into the property cache.
+	*/
+	int clipSampleProperty(const Identifier& id, const var& newValue, bool useUndo);
+
 	var getSampleProperty(const Identifier& id) const;
 
+	/** Returns the row of this sound in the SampleMap's PropertyCache. */
+	int getPropertyCacheRow() const noexcept { return propertyCacheRow; }
+
 	void setDeletePending()
 	{
 		deletePending = true;
@@ -647,7 +671,10 @@ private:
 
 	int getPropertyValueWithDefault(const Identifier& id) const;
 
+	bool getCachedProperty(const Identifier& id, int& value) const;
+
 	WeakReference<SampleMap> parentMap;
+	int propertyCacheRow = -1;
 	ValueTree data;
 	UndoManager *undoManager;
 
@@ -40,6 +40,7 @@ void ModulatorSamplerVoice::startVoiceInternal(int midiNoteNumber, float velocit
 
 	wrappedVoice.setPitchFactor(midiNoteNumber, !sampler->isPitchTrackingEnabled() ? midiNoteNumber : currentlyPlayingSamplerSound->getRootNote(), sound.get(), getOwnerSynth()->getMainController()->getGlobalPitchFactor());
 	wrappedVoice.setSampleStartModValue(startMod);
+	wrappedVoice.setInterpolationMode(sampler->getInterpolationMode());
 	wrappedVoice.startNote(midiNoteNumber, velocity, sound.get(), -1);
 
 	voiceUptime = wrappedVoice.voiceUptime;
@@ -444,6 +445,7 @@ void MultiMicModulatorSamplerVoice::startVoiceInternal(int midiNoteNumber, float
 
 		voiceToUse->setPitchFactor(midiNoteNumber, rootNote, micSound.get(), globalPitchFactor);
 		voiceToUse->setSampleStartModValue(startMod);
+		voiceToUse->setInterpolationMode(sampler->getInterpolationMode());
 		voiceToUse->startNote(midiNoteNumber, velocity, micSound.get(), -1);
 
 		voiceUptime = wrappedVoices[i]->voiceUptime;
@@ -0,0 +1,253 @@
+/*  ===========================================================================
+*
+*   This file is part of HISE.
+*   Copyright 2016 Christoph Hart
+*
+*   HISE is free software: you can redistribute it and/or modify
+*   it under the terms of the GNU General Public License as published by
+*   the Free Software Foundation, either version 3 of the License, or
+*   (at your option) any later version.
+*
+*   HISE is distributed in the hope that it will be useful,
+*   but WITHOUT ANY WARRANTY; without even the implied warranty of
+*   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*   GNU General Public License for more details.
+*
+*   You should have received a copy of the GNU General Public License
+*   along with HISE.  If not, see <http://www.gnu.org/licenses/>.
+*
+*   Commercial licenses for using HISE in an closed source project are
+*   available on request. Please visit the project's website to get more
+*   information about commercial licensing:
+*
+*   http://www.hise.audio/
+*
+*   HISE is based on the JUCE library,
+*   which also must be licenced for commercial applications:
+*
+*   http://www.juce.com
+*
+*   ===========================================================================
+*/
+
+#include "AppConfig.h"
+
+#if HI_RUN_UNIT_TESTS
+
+#include  "JuceHeader.h"
+
+using namespace hise;
+
+class SamplePropertyCacheTest : public UnitTest
+{
+public:
+
+	SamplePropertyCacheTest() :
+		UnitTest("Testing the sample property cache")
+	{}
+
+	void runTest() override
+	{
+		SampleMap::PropertyCache cache;
+
+		beginTest("Testing row initialisation");
+
+		ValueTree s1("sample");
+		s1.setProperty(SampleIds::Root, 64, nullptr);
+		s1.setProperty(SampleIds::HiKey, "72", nullptr);
+		s1.setProperty(SampleIds::LoopEnabled, true, nullptr);
+		s1.setProperty(SampleIds::FileName, "file.wav", nullptr);
+
+		auto r1 = cache.addRow(s1);
+		auto r2 = cache.addRow(ValueTree("sample"));
+
+		expectEquals(cache.getNumRows(), 2, "two rows");
+		expectValue(cache, r1, SampleIds::Root, 64);
+		expectValue(cache, r1, SampleIds::HiKey, 72);
+		expectValue(cache, r1, SampleIds::LoopEnabled, 1);
+
+		int v = 0;
+		expect(!cache.getValue(r1, SampleIds::FileName, v), "strings are not cached");
+		expect(!cache.getValue(r1, SampleIds::Volume, v), "unset property uses default");
+		expect(!cache.getValue(r2, SampleIds::Root, v), "empty row");
+
+		beginTest("Testing value changes");
+
+		cache.setValue(r2, SampleIds::Volume, -6);
+		cache.setValue(r1, SampleIds::Root, var());
+
+		expectValue(cache, r2, SampleIds::Volume, -6);
+		expect(!cache.getValue(r1, SampleIds::Root, v), "removed property");
+
+		beginTest("Testing row reuse");
+
+		cache.removeRow(r1);
+
+		ValueTree s3("sample");
+		s3.setProperty(SampleIds::RRGroup, 3, nullptr);
+
+		auto r3 = cache.addRow(s3);
+
+		expectEquals(r3, r1, "freed row is reused");
+		expectEquals(cache.getNumRows(), 2, "no new row");
+		expectValue(cache, r3, SampleIds::RRGroup, 3);
+		expect(!cache.getValue(r3, SampleIds::HiKey, v), "old values are cleared");
+
+		testSampleMap();
+	}
+
+	/** Counts the property notifications of a SampleMap. */
+	struct CountingListener : public SampleMap::Listener
+	{
+		void sampleMapWasChanged(PoolReference) override {}
+
+		void samplePropertyWasChanged(ModulatorSamplerSound*, const Identifier& id, const var& newValue) override
+		{
+			numChanges.set(id, (int)numChanges[id] + 1);
+			lastValues.set(id, newValue);
+		}
+
+		NamedValueSet numChanges;
+		NamedValueSet lastValues;
+	};
+
+	/** Loads a few samples into a sampler and changes their properties with SampleMap::setSampleProperties(). */
+	void testSampleMap()
+	{
+		beginTest("Testing batch property changes");
+
+		ScopedValueSetter<bool> s(MainController::unitTestMode, true);
+
+		ScopedPointer<BackendProcessor> bp = new BackendProcessor(nullptr, nullptr);
+		ScopedPointer<ModulatorSampler> sampler = new ModulatorSampler(bp, "Sampler", 8);
+
+		OwnedArray<TemporaryFile> sampleFiles;
+		ValueTree v("samplemap");
+		v.setProperty("ID", "PropertyCacheTest", nullptr);
+
+		for (int i = 0; i < NumSounds; i++)
+		{
+			auto f = sampleFiles.add(new TemporaryFile(".wav"));
+
+			AudioSampleBuffer b(2, 2000);
+
+			for (int j = 0; j < b.getNumSamples(); j++)
+			{
+				b.setSample(0, j, 0.5f * std::sin((float)j * 0.05f));
+				b.setSample(1, j, 0.5f * std::sin((float)j * 0.07f));
+			}
+
+			{
+				WavAudioFormat wav;
+				ScopedPointer<AudioFormatWriter> writer = wav.createWriterFor(new FileOutputStream(f->getFile()), 44100.0, 2, 24, {}, 0);
+
+				expect(writer != nullptr, "create writer");
+
+				if (writer == nullptr)
+					return;
+
+				writer->writeFromAudioSampleBuffer(b, 0, b.getNumSamples());
+			}
+
+			ValueTree sample("sample");
+			sample.setProperty(SampleIds::FileName, f->getFile().getFullPathName(), nullptr);
+			sample.setProperty(SampleIds::Root, 60, nullptr);
+			sample.setProperty(SampleIds::LoKey, 60 + i, nullptr);
+			sample.setProperty(SampleIds::HiKey, 60 + i, nullptr);
+			sample.setProperty(SampleIds::LoVel, 0, nullptr);
+			sample.setProperty(SampleIds::HiVel, 127, nullptr);
+			sample.setProperty(SampleIds::RRGroup, 1, nullptr);
+			v.addChild(sample, -1, nullptr);
+		}
+
+		auto map = sampler->getSampleMap();
+		map->loadUnsavedValueTree(v);
+
+		Array<ModulatorSamplerSound::Ptr> sounds;
+
+		for (int i = 0; i < sampler->getNumSounds(); i++)
+			sounds.add(dynamic_cast<ModulatorSamplerSound*>(sampler->getSound(i)));
+
+		expectEquals(sounds.size(), NumSounds, "all samples are loaded");
+
+		if (sounds.size() != NumSounds)
+			return;
+
+		CountingListener l;
+		map->addListener(&l);
+
+		auto um = bp->getControlUndoManager();
+
+		um->beginNewTransaction();
+		map->setSampleProperties(sounds, SampleIds::Root, 64, true);
+
+		um->beginNewTransaction();
+		map->setSampleProperties(sounds, SampleIds::HiKey, 200, true);
+
+		um->beginNewTransaction();
+		map->setSampleProperties(sounds, SampleIds::Normalized, true, true);
+
+		for (auto sound : sounds)
+		{
+			expectEquals((int)sound->getSampleProperty(SampleIds::Root), 64, "Root");
+			expectEquals((int)sound->getData()[SampleIds::Root], 64, "Root is written to the ValueTree");
+			expectEquals((int)sound->getSampleProperty(SampleIds::HiKey), 127, "HiKey is clipped");
+			expect(sound->getRootNote() == 64, "the sound is updated");
+
+			auto normalized = sound->getSampleProperty(SampleIds::Normalized);
+			expect(normalized.isBool() && (bool)normalized, "Normalized is a bool");
+			expect(sound->getData()[SampleIds::Normalized].isBool(), "Normalized is a bool in the ValueTree");
+		}
+
+		beginTest("Testing property change notifications");
+
+		// The lock free dispatcher calls the listeners synchronously on the message thread
+		expectEquals((int)l.numChanges[SampleIds::Root], NumSounds, "Root notifications");
+		expectEquals((int)l.numChanges[SampleIds::HiKey], NumSounds, "HiKey notifications");
+		expectEquals((int)l.lastValues[SampleIds::HiKey], 127, "clipped HiKey is sent");
+		expect(l.lastValues[SampleIds::Normalized].isBool(), "Normalized is sent as bool");
+
+		beginTest("Testing undo of batch property changes");
+
+		um->undo();
+		um->undo();
+
+		for (auto sound : sounds)
+		{
+			auto index = sounds.indexOf(sound);
+
+			expectEquals((int)sound->getSampleProperty(SampleIds::HiKey), 60 + index, "HiKey is restored");
+			expect(!(bool)sound->getSampleProperty(SampleIds::Normalized), "Normalized is restored");
+			expectEquals((int)sound->getSampleProperty(SampleIds::Root), 64, "Root is not undone yet");
+		}
+
+		expectEquals((int)l.numChanges[SampleIds::HiKey], 2 * NumSounds, "undo sends HiKey notifications");
+
+		um->undo();
+
+		for (auto sound : sounds)
+		{
+			expectEquals((int)sound->getSampleProperty(SampleIds::Root), 60, "Root is restored");
+			expect(sound->getRootNote() == 60, "the sound is restored");
+		}
+
+		expectEquals((int)l.numChanges[SampleIds::Root], 2 * NumSounds, "undo sends Root notifications");
+
+		map->removeListener(&l);
+		sounds.clear();
+		sampler = nullptr;
+	}
+
+	static constexpr int NumSounds = 3;
+
+	void expectValue(const SampleMap::PropertyCache& cache, int row, const Identifier& id, int expected)
+	{
+		int v = 0;
+		expect(cache.getValue(row, id, v), id.toString() + " is cached");
+		expectEquals(v, expected, id.toString());
+	}
+};
+
+static SamplePropertyCacheTest samplePropertyCacheTest;
+
+#endif
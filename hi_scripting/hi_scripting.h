@@ -60,6 +60,16 @@ compile / debug cycle and don't need all nodes in scriptnode you might want to t
 #define INCLUDE_BIG_SCRIPTNODE_OBJECT_COMPILATION 1
 #endif
 
+/** Config: HISE_USE_SCRIPT_BYTECODE_COMPILER
+
+If this is true, then expressions in the script callbacks (operators and API calls) will be compiled
+into a register based bytecode after the other optimisation passes. In HISE this is only applied if
+the optimisations are enabled in the settings, in exported plugins it will always be used.
+*/
+#ifndef HISE_USE_SCRIPT_BYTECODE_COMPILER
+#define HISE_USE_SCRIPT_BYTECODE_COMPILER 0
+#endif
+
 // Periodically dumps the value tree of a dsp network
 #define DUMP_SCRIPTNODE_VALUETREE 1
 
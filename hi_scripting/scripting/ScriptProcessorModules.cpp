@@ -500,6 +500,13 @@ void JavascriptPolyphonicEffect::renderVoice(int voiceIndex, AudioSampleBuffer &
 {
 	if (auto n = getActiveNetwork())
 	{
+		// The voice couldn't acquire a slot when it was started
+		if (!n->getPolyHandler()->hasVoiceSlot(voiceIndex))
+		{
+			isTailing = false;
+			return;
+		}
+
 		float* channels[NUM_MAX_CHANNELS];
 
 		int numChannels = b.getNumChannels();
@@ -521,14 +528,15 @@ void JavascriptPolyphonicEffect::startVoice(int voiceIndex, const HiseEvent& e)
 {
 	if (auto n = getActiveNetwork())
 	{
+		// The voice will be passed through unprocessed if there's no free slot
 		voiceData.startVoice(*n, *n->getPolyHandler(), voiceIndex, e);
-		
 	}
 }
 
 void JavascriptPolyphonicEffect::reset(int voiceIndex)
 {
-	voiceData.reset(voiceIndex);
+	auto n = getActiveNetwork();
+	voiceData.reset(voiceIndex, n != nullptr ? n->getPolyHandler() : nullptr);
 }
 
 void JavascriptPolyphonicEffect::handleHiseEvent(const HiseEvent &m)
@@ -1304,7 +1312,9 @@ float JavascriptEnvelopeModulator::startVoice(int voiceIndex)
 
 	if (auto n = getActiveNetwork())
 	{
-		voiceData.startVoice(*n, *n->getPolyHandler(), voiceIndex, lastNoteOn);
+		// The envelope stops (and kills the voice) if there's no free slot
+		if (!voiceData.startVoice(*n, *n->getPolyHandler(), voiceIndex, lastNoteOn))
+			state->isPlaying = false;
 	}
 
     return 0.0f;
@@ -1324,7 +1334,8 @@ void JavascriptEnvelopeModulator::reset(int voiceIndex)
 	state->isPlaying = false;
 	state->isRingingOff = false;
 
-	voiceData.reset(voiceIndex);
+	auto n = getActiveNetwork();
+	voiceData.reset(voiceIndex, n != nullptr ? n->getPolyHandler() : nullptr);
 }
 
 bool JavascriptEnvelopeModulator::isPlaying(int voiceIndex) const
@@ -1572,8 +1583,15 @@ void JavascriptSynthesiser::Voice::calculateBlock(int startSample, int numSample
 		if (isVoiceStart)
 		{
 			n->setVoiceKiller(synth->vk);
-			synth->voiceData.startVoice(*n, *n->getPolyHandler(), getVoiceIndex(), getCurrentHiseEvent());
 			isVoiceStart = false;
+
+			if (!synth->voiceData.startVoice(*n, *n->getPolyHandler(), getVoiceIndex(), getCurrentHiseEvent()))
+			{
+				// All voice slots of the network are used by other voices
+				voiceBuffer.clear(startSample, numSamples);
+				resetVoice();
+				return;
+			}
 		}
 
 		float* channels[NUM_MAX_CHANNELS];
@@ -1652,7 +1670,7 @@ hise::ProcessorEditorBody * ScriptnodeVoiceKiller::createEditor(ProcessorEditor
 #endif
 }
 
-void VoiceDataStack::reset(int voiceIndex)
+void VoiceDataStack::reset(int voiceIndex, PolyHandler* ph)
 {
 	for (int i = 0; i < voiceNoteOns.size(); i++)
 	{
@@ -1662,6 +1680,17 @@ void VoiceDataStack::reset(int voiceIndex)
 			break;
 		}
 	}
+
+	if (ph != nullptr)
+		ph->releaseVoiceSlot(voiceIndex);
+}
+
+void VoiceDataStack::clear(PolyHandler* ph)
+{
+	voiceNoteOns.clear();
+
+	if (ph != nullptr)
+		ph->releaseAllVoiceSlots();
 }
 
 } // namespace hise
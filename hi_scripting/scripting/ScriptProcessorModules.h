@@ -496,7 +496,11 @@ struct VoiceDataStack
 		HiseEvent noteOn;
 	};
 
-	void reset(int voiceIndex);
+	/** Removes the voice from the stack and releases its slot in the poly handler of the network (if it exists). */
+	void reset(int voiceIndex, PolyHandler* ph);
+
+	/** Removes all voices from the stack and releases all slots of the poly handler (if it exists). */
+	void clear(PolyHandler* ph);
 
 	bool containsVoiceIndex(int voiceIndex) const
 	{
@@ -554,8 +558,12 @@ struct VoiceDataStack
 		}
 	}
 
-	template <typename T> void startVoice(T& n, PolyHandler& ph, int voiceIndex, const HiseEvent& e)
+	/** Starts the voice. Returns false if the poly handler has no free voice slot, in which case the voice must not be rendered. */
+	template <typename T> bool startVoice(T& n, PolyHandler& ph, int voiceIndex, const HiseEvent& e)
 	{
+		if (!ph.allocateVoiceSlot(voiceIndex))
+			return false;
+
 		voiceNoteOns.insertWithoutSearch({ voiceIndex, e });
 		HiseEvent c(e);
 
@@ -570,6 +578,7 @@ struct VoiceDataStack
 		}
 
 		n.handleHiseEvent(copy);
+		return true;
 	}
 
 	UnorderedStack<VoiceData, NUM_POLYPHONIC_VOICES> voiceNoteOns;
@@ -939,10 +948,12 @@ public:
 
     void onVoiceReset(bool allVoices, int voiceIndex) override
     {
+        auto ph = getActiveNetwork() != nullptr ? getActiveNetwork()->getPolyHandler() : nullptr;
+
         if (allVoices)
-            voiceData.voiceNoteOns.clear();
+            voiceData.clear(ph);
         else
-            voiceData.reset(voiceIndex);
+            voiceData.reset(voiceIndex, ph);
     }
     
 private:
@@ -992,7 +1003,8 @@ public:
 		virtual void resetVoice() override
 		{
 			ModulatorSynthVoice::resetVoice();
-			synth->voiceData.reset(getVoiceIndex());
+			auto n = synth->getActiveNetwork();
+			synth->voiceData.reset(getVoiceIndex(), n != nullptr ? n->getPolyHandler() : nullptr);
 		}
 
 		JavascriptSynthesiser* synth;
@@ -1941,6 +1941,862 @@ private:
 
 static CustomContainerTest unorderedStackTest;
 
+class SoundLookupIndexTest : public UnitTest
+{
+public:
+
+	struct DummySound : public ModulatorSynthSound
+	{
+		DummySound(int lowKey_, int highKey_, int lowVelocity_, int highVelocity_) :
+			lowKey(lowKey_),
+			highKey(highKey_),
+			lowVelocity(lowVelocity_),
+			highVelocity(highVelocity_)
+		{};
+
+		bool appliesToNote(int midiNoteNumber) override { return midiNoteNumber >= lowKey && midiNoteNumber <= highKey; }
+		bool appliesToChannel(int) override { return true; }
+		bool appliesToVelocity(int velocity) override { return velocity >= lowVelocity && velocity <= highVelocity; }
+
+		const int lowKey, highKey, lowVelocity, highVelocity;
+	};
+
+	SoundLookupIndexTest() :
+		UnitTest("Testing sound lookup index")
+	{}
+
+	void runTest() override
+	{
+		beginTest("Creating synthetic sample map");
+
+		ReferenceCountedArray<ModulatorSynthSound> sounds;
+		ModulatorSynth::SoundLookupIndex index;
+
+		// 88 keys x 10 velocity layers x 68 round robins = 59840 samples
+		for (int k = 21; k < 109; k++)
+		{
+			for (int v = 0; v < 10; v++)
+			{
+				auto lowVelocity = v * 13;
+				auto highVelocity = jmin(127, lowVelocity + 12);
+
+				for (int rr = 0; rr < 68; rr++)
+				{
+					auto s = new DummySound(k, k, lowVelocity, highVelocity);
+					sounds.add(s);
+					index.addSound(s, k, k, lowVelocity, highVelocity);
+				}
+			}
+		}
+
+		expectEquals(index.getNumSounds(), sounds.size(), "sound amount");
+
+		beginTest("Comparing index with linear search");
+
+		Random r;
+
+		for (int i = 0; i < 1000; i++)
+		{
+			auto n = r.nextInt(128);
+			auto v = r.nextInt(128);
+
+			int numLinear = 0;
+			int numIndexed = 0;
+
+			for (auto s : sounds)
+				numLinear += (int)s->appliesToMessage(1, n, v);
+
+			for (auto s : index.getSounds(n, v))
+				numIndexed += (int)s->appliesToMessage(1, n, v);
+
+			expectEquals(numIndexed, numLinear, "matching sounds for " + String(n) + ", " + String(v));
+		}
+
+		beginTest("Benchmarking dense chords");
+
+		const int numChords = 500;
+		const int chordSize = 10;
+
+		int numFound = 0;
+
+		auto start = Time::getHighResolutionTicks();
+
+		for (int c = 0; c < numChords; c++)
+		{
+			for (int i = 0; i < chordSize; i++)
+			{
+				for (auto s : sounds)
+					numFound += (int)s->appliesToMessage(1, 40 + c % 24 + i * 3, 100);
+			}
+		}
+
+		auto linearTime = Time::highResolutionTicksToSeconds(Time::getHighResolutionTicks() - start);
+
+		start = Time::getHighResolutionTicks();
+
+		for (int c = 0; c < numChords; c++)
+		{
+			for (int i = 0; i < chordSize; i++)
+			{
+				for (auto s : index.getSounds(40 + c % 24 + i * 3, 100))
+					numFound -= (int)s->appliesToMessage(1, 40 + c % 24 + i * 3, 100);
+			}
+		}
+
+		auto indexTime = Time::highResolutionTicksToSeconds(Time::getHighResolutionTicks() - start);
+
+		expectEquals(numFound, 0, "same result");
+
+		logMessage("Linear search: " + String(linearTime * 1000.0 / (double)numChords, 4) + "ms per chord");
+		logMessage("Lookup index:  " + String(indexTime * 1000.0 / (double)numChords, 4) + "ms per chord");
+	}
+};
+
+static SoundLookupIndexTest soundLookupIndexTest;
+
+class ParallelSynthRenderingTest : public UnitTest
+{
+public:
+
+	ParallelSynthRenderingTest() :
+		UnitTest("Testing parallel synth rendering")
+	{}
+
+	void runTest() override
+	{
+		ScopedValueSetter<bool> s(MainController::unitTestMode, true);
+
+		beginTest("Comparing parallel with serial rendering");
+
+		AudioSampleBuffer serial = render(0);
+
+		for (int numWorkerThreads = 1; numWorkerThreads <= 4; numWorkerThreads++)
+		{
+			AudioSampleBuffer parallel = render(numWorkerThreads);
+
+			for (int c = 0; c < 2; c++)
+			{
+				auto numDifferent = 0;
+
+				for (int i = 0; i < serial.getNumSamples(); i++)
+					numDifferent += (int)(serial.getSample(c, i) != parallel.getSample(c, i));
+
+				expectEquals(numDifferent, 0, "different samples in channel " + String(c) + " with " + String(numWorkerThreads) + " worker threads");
+			}
+		}
+	}
+
+private:
+
+	AudioSampleBuffer render(int numWorkerThreads)
+	{
+		ScopedPointer<BackendProcessor> bp = new BackendProcessor(nullptr, nullptr);
+
+		bp->getMainSynthChain()->setNumParallelRenderThreads(numWorkerThreads);
+
+		// The NoiseSynth uses rand(), so we need a deterministic signal
+		for (int i = 0; i < 6; i++)
+		{
+			auto s = new SineSynth(bp, "Synth" + String(i), NUM_POLYPHONIC_VOICES);
+
+			s->addProcessorsWhenEmpty();
+
+			// Odd gain values make sure that the summing order changes the rounding
+			s->setAttribute(ModulatorSynth::Parameters::Gain, 0.1f + 0.137f * (float)i, dontSendNotification);
+			s->setAttribute(SineSynth::SemiTones, (float)(i * 5 % 12), dontSendNotification);
+
+			bp->getMainSynthChain()->getHandler()->add(s, nullptr);
+		}
+
+		const int blockSize = 512;
+
+		AudioSampleBuffer output(2, 44100);
+		output.clear();
+
+		MidiBuffer midi;
+		midi.addEvent(MidiMessage::noteOn(1, 64, 1.0f), 0);
+		midi.addEvent(MidiMessage::noteOn(1, 67, 0.6f), 3000);
+		midi.addEvent(MidiMessage::noteOff(1, 64), 20000);
+		midi.addEvent(MidiMessage::noteOff(1, 67), 30000);
+
+		bp->prepareToPlay(44100.0, blockSize);
+
+		for (int offset = 0; offset < output.getNumSamples(); offset += blockSize)
+		{
+			auto numThisTime = jmin(blockSize, output.getNumSamples() - offset);
+
+			float* d[2] = { output.getWritePointer(0, offset), output.getWritePointer(1, offset) };
+
+			AudioSampleBuffer subAudio(d, 2, numThisTime);
+			MidiBuffer subMidi;
+			subMidi.addEvents(midi, offset, numThisTime, -offset);
+
+			bp->processBlock(subAudio, subMidi);
+		}
+
+		return output;
+	}
+};
+
+static ParallelSynthRenderingTest parallelSynthRenderingTest;
+
+class ScriptBytecodeTest : public UnitTest
+{
+public:
+
+	ScriptBytecodeTest() :
+		UnitTest("Testing script bytecode compiler")
+	{}
+
+	void runTest() override
+	{
+		ScopedValueSetter<bool> s(MainController::unitTestMode, true);
+
+		ScopedPointer<BackendProcessor> bp = new BackendProcessor(nullptr, nullptr);
+		ScopedPointer<JavascriptMidiProcessor> jp = new JavascriptMidiProcessor(bp, "BytecodeTest");
+
+		beginTest("Comparing operator expressions");
+
+		compare(jp, "function test(a, b) { return a + b * 2 - a / (b + 1); }");
+		compare(jp, "function test(a, b) { return a % 3 + (b != 4 ? 1 : 0) - (a >= b) * 7; }");
+		compare(jp, "function test(a, b) { return (a > b) && (a < 10) || b == 3; }");
+		compare(jp, "function test(a, b) { return \"x\" + a + b * 0.5; }");
+
+		beginTest("Comparing API calls");
+
+		compare(jp, "function test(a, b) { return a > b ? Math.max(a, b) * 2 : Math.min(a, Math.abs(b - 7)); }");
+		compare(jp, "function test(a, b) { return Math.round(Math.sin(a) * 1000) + Math.floor(b / 3); }");
+		compare(jp, "function test(a, b) { return Math.range(a * b, -5, Math.pow(b, 2) + 1.5); }");
+
+		beginTest("Comparing inline functions with const and reg variables");
+
+		compare(jp, "const var offset = 4;\n"
+					"reg gain = 0.5;\n"
+					"inline function scale(x) { local y = x * gain + offset; return Math.pow(y, 2) - y; }\n"
+					"function test(a, b) { return scale(a) + scale(b) > 20 ? scale(a - b) : Math.range(a * b, -5, 5); }");
+	}
+
+private:
+
+	var run(JavascriptMidiProcessor* jp, const String& code, const var& a, const var& b, bool useBytecode)
+	{
+		HiseJavascriptEngine engine(jp, jp->getMainController());
+
+		if (useBytecode)
+			engine.enableBytecodeCompiler();
+
+		auto r = engine.execute(code);
+		expect(r.wasOk(), r.getErrorMessage());
+
+		var args[2] = { a, b };
+		var::NativeFunctionArgs functionArgs(var(), args, 2);
+
+		auto result = engine.callFunction("test", functionArgs, &r);
+		expect(r.wasOk(), r.getErrorMessage());
+
+		return result;
+	}
+
+	void compare(JavascriptMidiProcessor* jp, const String& code)
+	{
+		const var values[] = { var(0), var(3), var(-4), var(12), var(2.5), var(-0.75), var(7.0) };
+
+		for (const auto& a : values)
+		{
+			for (const auto& b : values)
+			{
+				auto expected = run(jp, code, a, b, false);
+				auto actual = run(jp, code, a, b, true);
+
+				auto typeMatches = expected.isInt() == actual.isInt() &&
+								   expected.isInt64() == actual.isInt64() &&
+								   expected.isDouble() == actual.isDouble() &&
+								   expected.isBool() == actual.isBool() &&
+								   expected.isString() == actual.isString();
+
+				expect(typeMatches, "Type mismatch for " + a.toString() + ", " + b.toString());
+				expectEquals(actual.toString(), expected.toString(), "Result for " + a.toString() + ", " + b.toString());
+			}
+		}
+	}
+};
+
+static ScriptBytecodeTest scriptBytecodeTest;
+
+class InlineCacheTest : public UnitTest
+{
+public:
+
+	InlineCacheTest() :
+		UnitTest("Testing script inline caches")
+	{}
+
+	void runTest() override
+	{
+		ScopedValueSetter<bool> s(MainController::unitTestMode, true);
+
+		ScopedPointer<BackendProcessor> bp = new BackendProcessor(nullptr, nullptr);
+		ScopedPointer<JavascriptMidiProcessor> jp = new JavascriptMidiProcessor(bp, "InlineCacheTest");
+
+		testPropertyIndexChanges(jp);
+		testDifferentObjects(jp);
+		testApiConstants(jp);
+		testApiMethodsAfterRecompiling(jp);
+	}
+
+private:
+
+	void testPropertyIndexChanges(JavascriptMidiProcessor* jp)
+	{
+		beginTest("Moving the cached property index");
+
+		HiseJavascriptEngine engine(jp, jp->getMainController());
+		compile(engine, "function test(x) { return x.c; }");
+
+		DynamicObject::Ptr o = new DynamicObject();
+		o->setProperty("a", 1);
+		o->setProperty("b", 2);
+		o->setProperty("c", 3);
+
+		for (int i = 0; i < 4; i++)
+			expectEquals((int)call(engine, var(o.get())), 3, "Initial layout");
+
+		o->removeProperty("a");
+		expectEquals((int)call(engine, var(o.get())), 3, "After removing a property before the cached one");
+
+		o->setProperty("a", 4);
+		expectEquals((int)call(engine, var(o.get())), 3, "After adding a property");
+
+		o->removeProperty("b");
+		o->removeProperty("c");
+		o->setProperty("c", 5);
+		expectEquals((int)call(engine, var(o.get())), 5, "After moving the cached property to the end");
+
+		o->removeProperty("c");
+		expect(call(engine, var(o.get())).isVoid(), "After removing the cached property");
+
+		int64 numHits, numMisses;
+		engine.getInlineCacheStatistics(numHits, numMisses);
+		expect(numHits > 0, "The cache was used");
+	}
+
+	void testDifferentObjects(JavascriptMidiProcessor* jp)
+	{
+		beginTest("Different objects at the same call site");
+
+		HiseJavascriptEngine engine(jp, jp->getMainController());
+		compile(engine, "function test(x) { return x.value; }");
+
+		for (int i = 0; i < 4; i++)
+		{
+			DynamicObject::Ptr o = new DynamicObject();
+
+			// Every object has the property at another index
+			for (int j = 0; j < i; j++)
+				o->setProperty("p" + String(j), -1);
+
+			o->setProperty("value", i);
+
+			expectEquals((int)call(engine, var(o.get())), i, "Object " + String(i));
+		}
+
+		DynamicObject::Ptr other = new DynamicObject();
+		other->setProperty("p0", -1);
+		other->setProperty("p1", -1);
+		other->setProperty("p2", -1);
+		other->setProperty("p3", -1);
+
+		expect(call(engine, var(other.get())).isVoid(), "Object without the property at the cached index");
+	}
+
+	void testApiConstants(JavascriptMidiProcessor* jp)
+	{
+		beginTest("API constant caches");
+
+		HiseJavascriptEngine engine(jp, jp->getMainController());
+		compile(engine, "function test(x) { return x.Empty; }");
+
+		var holder(new ScriptingObjects::ScriptingMessageHolder(jp));
+		var file(new ScriptingObjects::ScriptFile(jp, File::getSpecialLocation(File::tempDirectory)));
+
+		for (int i = 0; i < 4; i++)
+			expectEquals((int)call(engine, holder), 0, "Message holder constant");
+
+		// The file object has another constant at the cached index
+		expect(call(engine, file).isUndefined(), "File object without the constant");
+		expectEquals((int)call(engine, holder), 0, "Message holder constant after a miss");
+
+		compile(engine, "function test(x) { return x.NoteOff + x.Controller; }");
+		expectEquals((int)call(engine, holder), 5, "Different constants after recompiling");
+	}
+
+	void testApiMethodsAfterRecompiling(JavascriptMidiProcessor* jp)
+	{
+		beginTest("API method caches after recompiling");
+
+		HiseJavascriptEngine engine(jp, jp->getMainController());
+
+		auto h1 = new ScriptingObjects::ScriptingMessageHolder(jp);
+		auto h2 = new ScriptingObjects::ScriptingMessageHolder(jp);
+		var v1(h1), v2(h2);
+
+		h1->setMessage(HiseEvent(HiseEvent::Type::NoteOn, 60, 100, 1));
+		h2->setMessage(HiseEvent(HiseEvent::Type::NoteOn, 72, 20, 2));
+
+		compile(engine, "function test(x) { return x.getNoteNumber(); }");
+
+		for (int i = 0; i < 4; i++)
+		{
+			expectEquals((int)call(engine, v1), 60, "First message holder");
+			expectEquals((int)call(engine, v2), 72, "Second message holder");
+		}
+
+		compile(engine, "function test(x) { return x.getVelocity(); }");
+
+		expectEquals((int)call(engine, v1), 100, "Velocity of the first message holder");
+		expectEquals((int)call(engine, v2), 20, "Velocity of the second message holder");
+
+		compile(engine, "function test(x) { x.setVelocity(x.getNoteNumber()); return x.getVelocity(); }");
+
+		expectEquals((int)call(engine, v1), 60, "Method with an argument");
+		expectEquals((int)call(engine, v2), 72, "Method with an argument on the second object");
+	}
+
+	void compile(HiseJavascriptEngine& engine, const String& code)
+	{
+		auto r = engine.execute(code);
+		expect(r.wasOk(), r.getErrorMessage());
+	}
+
+	var call(HiseJavascriptEngine& engine, const var& argument)
+	{
+		auto r = Result::ok();
+		var args[1] = { argument };
+		var::NativeFunctionArgs functionArgs(var(), args, 1);
+
+		auto result = engine.callFunction("test", functionArgs, &r);
+		expect(r.wasOk(), r.getErrorMessage());
+		return result;
+	}
+};
+
+static InlineCacheTest inlineCacheTest;
+
+#if HISE_INCLUDE_SNEX
+class JitFrozenNetworkTest : public UnitTest
+{
+public:
+
+	JitFrozenNetworkTest() :
+		UnitTest("Testing JIT frozen DspNetworks")
+	{}
+
+	void runTest() override
+	{
+		ScopedValueSetter<bool> s(MainController::unitTestMode, true);
+
+		ScopedPointer<BackendProcessor> bp = new BackendProcessor(nullptr, nullptr);
+		ScopedPointer<JavascriptMasterEffect> fx = new JavascriptMasterEffect(bp, "JitTest");
+
+		auto n = fx->getOrCreate("jit_test");
+		auto root = var(n->getRootNode());
+
+		auto addNode = [&](const String& path, const String& id, double value)
+		{
+			auto node = dynamic_cast<scriptnode::NodeBase*>(n->createAndAdd(path, id, root).getObject());
+			expect(node != nullptr, "Creating " + path);
+			node->getParameterFromIndex(0)->setValueSync(value);
+		};
+
+		addNode("math.mul", "mul1", 0.5);
+		addNode("filters.one_pole", "lp1", 2000.0);
+		addNode("math.add", "add1", 0.25);
+
+		n->setNumChannels(2);
+		n->prepareToPlay(44100.0, BlockSize);
+
+		beginTest("Comparing the JIT frozen with the interpreted output");
+
+		AudioSampleBuffer interpreted, frozen, unfrozen;
+
+		render(n, interpreted);
+
+		auto r = n->setUseJitFrozenNode(true);
+		expect(r.wasOk(), r.getErrorMessage());
+		expect(n->isJitFrozen(), "JIT node is active");
+
+		render(n, frozen);
+		compare(interpreted, frozen, "JIT frozen");
+
+		beginTest("Unfreezing restores the interpreted network");
+
+		r = n->setUseJitFrozenNode(false);
+		expect(r.wasOk(), r.getErrorMessage());
+		expect(!n->isJitFrozen(), "JIT node is removed");
+
+		render(n, unfrozen);
+		compare(interpreted, unfrozen, "Unfrozen");
+	}
+
+private:
+
+	static constexpr int BlockSize = 512;
+	static constexpr int NumBlocks = 16;
+
+	void render(scriptnode::DspNetwork* n, AudioSampleBuffer& output)
+	{
+		n->reset();
+
+		output.setSize(2, BlockSize * NumBlocks);
+
+		Random r(0);
+
+		for (int c = 0; c < output.getNumChannels(); c++)
+		{
+			for (int i = 0; i < output.getNumSamples(); i++)
+				output.setSample(c, i, r.nextFloat() * 2.0f - 1.0f);
+		}
+
+		HiseEventBuffer events;
+
+		for (int i = 0; i < NumBlocks; i++)
+		{
+			float* channels[2] = { output.getWritePointer(0, i * BlockSize), output.getWritePointer(1, i * BlockSize) };
+
+			scriptnode::ProcessDataDyn d(channels, BlockSize, 2);
+			d.setEventBuffer(events);
+			n->process(d);
+		}
+	}
+
+	void compare(const AudioSampleBuffer& expected, const AudioSampleBuffer& actual, const String& name)
+	{
+		float maxError = 0.0f;
+
+		for (int c = 0; c < expected.getNumChannels(); c++)
+		{
+			for (int i = 0; i < expected.getNumSamples(); i++)
+				maxError = jmax(maxError, std::abs(expected.getSample(c, i) - actual.getSample(c, i)));
+		}
+
+		expect(maxError < 1e-5f, name + " output deviation: " + String(maxError));
+	}
+};
+
+static JitFrozenNetworkTest jitFrozenNetworkTest;
+#endif
+
+class GlobalCableBatchingTest : public UnitTest
+{
+public:
+
+	using Manager = scriptnode::routing::GlobalRoutingManager;
+	using Snapshot = Manager::LockFreeSnapshot<Array<int>>;
+
+	GlobalCableBatchingTest() :
+		UnitTest("Testing global cable snapshots and batching")
+	{}
+
+	struct CountingTarget : public Manager::CableTargetBase
+	{
+		void sendValue(double v) override
+		{
+			lastValue = v;
+			numCalls++;
+		}
+
+		Path getTargetIcon() const override { return {}; }
+		void selectCallback(Component*) override {}
+		String getTargetId() const override { return "CountingTarget"; }
+
+		double lastValue = -1.0;
+		int numCalls = 0;
+	};
+
+	void runTest() override
+	{
+		testSnapshotReading();
+		testRetiredListsWithActiveReaders();
+		testConcurrentPublishing();
+		testBatchedFlush();
+	}
+
+private:
+
+	static int getSum(const Snapshot& s)
+	{
+		int sum = -1;
+
+		s.read([&sum](const Array<int>& l)
+		{
+			sum = 0;
+
+			for (auto v : l)
+				sum += v;
+		});
+
+		return sum;
+	}
+
+	void testSnapshotReading()
+	{
+		beginTest("Reading the published list");
+
+		Snapshot s;
+
+		expectEquals(getSum(s), -1, "No list before the first publication");
+
+		s.publish({ 1, 2, 3 });
+		expectEquals(getSum(s), 6, "First list");
+		expectEquals((int)s.getVersion(), 1, "Version after first publication");
+
+		s.publish({ 4, 5 });
+		expectEquals(getSum(s), 9, "Second list");
+		expectEquals((int)s.getVersion(), 2, "Version after second publication");
+		expectEquals(s.getNumRetiredLists(), 0, "Old list is deleted without readers");
+	}
+
+	void testRetiredListsWithActiveReaders()
+	{
+		beginTest("Retired lists with active readers");
+
+		Snapshot s;
+		s.publish({ 1 });
+
+		s.read([&](const Array<int>& l)
+		{
+			s.publish({ 2 });
+
+			expectEquals(s.getNumRetiredLists(), 1, "List is kept alive for the active reader");
+			expectEquals(l[0], 1, "Active reader still sees the old list");
+		});
+
+		s.publish({ 3 });
+		expectEquals(s.getNumRetiredLists(), 0, "Retired lists are deleted by the next publication");
+
+		// Publish while a reader is always active, the retired lists must not pile up
+		for (int i = 0; i < 100; i++)
+		{
+			s.read([&](const Array<int>&)
+			{
+				s.publish({ i });
+				expect(s.getNumRetiredLists() <= 2, "Retired lists are freed while readers are active");
+			});
+		}
+
+		expectEquals(getSum(s), 99, "Last published list");
+	}
+
+	void testConcurrentPublishing()
+	{
+		beginTest("Publishing from multiple threads");
+
+		Snapshot s;
+		s.publish({ 0, 0 });
+
+		std::atomic<bool> stop = { false };
+		std::atomic<int> numErrors = { 0 };
+
+		struct Writer : public Thread
+		{
+			Writer(Snapshot& s_, int offset_) :
+				Thread("Snapshot Writer"),
+				s(s_),
+				offset(offset_)
+			{}
+
+			void run() override
+			{
+				for (int i = 0; i < 2000; i++)
+					s.publish({ offset + i, -(offset + i) });
+			}
+
+			Snapshot& s;
+			const int offset;
+		};
+
+		std::thread reader([&]()
+		{
+			while (!stop.load())
+			{
+				if (getSum(s) != 0)
+					numErrors++;
+			}
+		});
+
+		Writer w1(s, 0), w2(s, 10000);
+
+		w1.startThread();
+		w2.startThread();
+
+		w1.waitForThreadToExit(-1);
+		w2.waitForThreadToExit(-1);
+
+		stop.store(true);
+		reader.join();
+
+		expectEquals(numErrors.load(), 0, "Every read sees a consistent list");
+		expectEquals((int)s.getVersion(), 4001, "Number of publications");
+
+		s.publish({ 0, 0 });
+		expectEquals(s.getNumRetiredLists(), 0, "All retired lists are deleted without readers");
+	}
+
+	void testBatchedFlush()
+	{
+		beginTest("Flushing batched cables in the audio callback");
+
+		ScopedValueSetter<bool> svs(MainController::unitTestMode, true);
+
+		ScopedPointer<BackendProcessor> bp = new BackendProcessor(nullptr, nullptr);
+
+		auto m = Manager::Helpers::getOrCreate(bp);
+		auto slot = m->getSlotBase("BatchedCable", Manager::SlotBase::SlotType::Cable);
+		auto cable = dynamic_cast<Manager::Cable*>(slot.get());
+
+		CountingTarget target;
+		cable->addTarget(&target);
+		target.numCalls = 0;
+
+		m->setBlockRateBatching(slot, true);
+		expect(cable->isBlockRateBatched(), "Cable is batched");
+
+		cable->sendValue(nullptr, 0.25);
+		cable->sendValue(nullptr, 0.5);
+		cable->sendValue(nullptr, 0.75);
+
+		expectEquals(target.numCalls, 0, "Batched values are not sent immediately");
+
+		const int blockSize = 512;
+
+		bp->prepareToPlay(44100.0, blockSize);
+
+		AudioSampleBuffer b(2, blockSize);
+		MidiBuffer mb;
+
+		b.clear();
+		bp->processBlock(b, mb);
+
+		expectEquals(target.numCalls, 1, "One call per block");
+		expectEquals(target.lastValue, 0.75, "Last value is sent");
+
+		b.clear();
+		bp->processBlock(b, mb);
+
+		expectEquals(target.numCalls, 1, "No call without a new value");
+
+		cable->sendValue(nullptr, 0.1);
+		m->setBlockRateBatching(slot, false);
+
+		expectEquals(target.numCalls, 2, "Pending value is sent when the batching is disabled");
+		expectEquals(target.lastValue, 0.1, "Pending value");
+
+		cable->sendValue(nullptr, 0.2);
+		expectEquals(target.numCalls, 3, "Unbatched values are sent immediately");
+
+		cable->removeTarget(&target);
+	}
+};
+
+static GlobalCableBatchingTest globalCableBatchingTest;
+
+class InterleavedFilterTest : public UnitTest
+{
+public:
+
+	InterleavedFilterTest() :
+		UnitTest("Testing interleaved filter kernels")
+	{}
+
+	void runTest() override
+	{
+		for (int numChannels : { 1, 2, 3, 5, 8 })
+		{
+			beginTest("Biquad with " + String(numChannels) + " channels");
+
+			for (int t = 0; t < StaticBiquadSubType::numFilterTypes; t++)
+				compareWithFrameProcessing<StaticBiquadSubType>(t, numChannels);
+
+			beginTest("State variable filter with " + String(numChannels) + " channels");
+
+			for (int t = 0; t < StateVariableFilterSubType::numTypes; t++)
+				compareWithFrameProcessing<StateVariableFilterSubType>(t, numChannels);
+		}
+	}
+
+private:
+
+	static constexpr int NumSamples = 1024;
+
+	// Not a multiple of the lane count, so the update happens in the middle of a block
+	static constexpr int UpdateOffset = 301;
+
+	template <typename FilterType> static void updateCoefficients(FilterType& f, bool secondHalf)
+	{
+		if (secondHalf)
+			f.updateCoefficients(44100.0, 6500.0, 0.8, -4.0);
+		else
+			f.updateCoefficients(44100.0, 700.0, 3.0, 6.0);
+	}
+
+	/** Compares processSamples() with the per channel processFrame() loop and changes the coefficients in the middle of the block. */
+	template <typename FilterType> void compareWithFrameProcessing(int filterType, int numChannels)
+	{
+		FilterType interleaved, perChannel;
+
+		for (auto f : { &interleaved, &perChannel })
+		{
+			f->setType(filterType);
+			f->reset(numChannels);
+			updateCoefficients(*f, false);
+		}
+
+		AudioSampleBuffer b(numChannels, NumSamples);
+		Random r(filterType * 100 + numChannels);
+
+		for (int c = 0; c < numChannels; c++)
+		{
+			for (int i = 0; i < NumSamples; i++)
+				b.setSample(c, i, r.nextFloat() * 2.0f - 1.0f);
+		}
+
+		AudioSampleBuffer expected;
+		expected.makeCopyOf(b);
+
+		interleaved.processSamples(b, 0, UpdateOffset);
+		updateCoefficients(interleaved, true);
+		interleaved.processSamples(b, UpdateOffset, NumSamples - UpdateOffset);
+
+		float frame[NUM_MAX_CHANNELS];
+
+		for (int i = 0; i < NumSamples; i++)
+		{
+			if (i == UpdateOffset)
+				updateCoefficients(perChannel, true);
+
+			for (int c = 0; c < numChannels; c++)
+				frame[c] = expected.getSample(c, i);
+
+			perChannel.processFrame(frame, numChannels);
+
+			for (int c = 0; c < numChannels; c++)
+				expected.setSample(c, i, frame[c]);
+		}
+
+		float maxError = 0.0f;
+
+		for (int c = 0; c < numChannels; c++)
+		{
+			for (int i = 0; i < NumSamples; i++)
+				maxError = jmax(maxError, std::abs(b.getSample(c, i) - expected.getSample(c, i)));
+		}
+
+		expect(maxError < 1e-5f, "Filter type " + String(filterType) + " deviation: " + String(maxError));
+	}
+};
+
+static InterleavedFilterTest interleavedFilterTest;
+
 
 
 #endif
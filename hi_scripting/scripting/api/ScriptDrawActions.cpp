@@ -241,19 +241,19 @@ namespace ScriptedDrawActions
 
 	struct fillPath : public DrawActions::ActionBase
 	{
-		fillPath(const Path& p_) : p(p_) {};
-		void perform(Graphics& g) override { g.fillPath(p); };
-		Path p;
+		fillPath(DrawActions::SharedPath::Ptr p_) : p(p_) {};
+		void perform(Graphics& g) override { g.fillPath(p->p); };
+		DrawActions::SharedPath::Ptr p;
 	};
 
 	struct drawPath : public DrawActions::ActionBase
 	{
-		drawPath(const Path& p_, PathStrokeType strokeType) : p(p_), s(strokeType) {};
+		drawPath(DrawActions::SharedPath::Ptr p_, PathStrokeType strokeType) : p(p_), s(strokeType) {};
 		void perform(Graphics& g) override
 		{
-			g.strokePath(p, s);
+			g.strokePath(p->p, s);
 		}
-		Path p;
+		DrawActions::SharedPath::Ptr p;
 		PathStrokeType s;
 	};
 
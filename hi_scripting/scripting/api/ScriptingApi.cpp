@@ -3883,16 +3883,9 @@ void ScriptingApi::Sampler::setSoundPropertyForSelection(int propertyId, var new
 	auto& sounds = soundSelection.getItemArray();
 	auto id = sampleIds[propertyId];
 
-	auto f = [sounds, id, newValue](Processor* /*p*/)
+	auto f = [sounds, id, newValue](Processor* p)
 	{
-		const int numSelected = sounds.size();
-
-		for (int i = 0; i < numSelected; i++)
-		{
-			if (sounds[i].get() != nullptr)
-				sounds[i]->setSampleProperty(id, newValue, false);
-		}
-
+		static_cast<ModulatorSampler*>(p)->getSampleMap()->setSampleProperties(sounds, id, newValue, false);
 		return SafeFunctionCall::OK;
 	};
 
@@ -3917,10 +3910,17 @@ void ScriptingApi::Sampler::setSoundPropertyForAllSamples(int propertyIndex, var
 	{
 		auto s = static_cast<ModulatorSampler*>(p);
 
-		ModulatorSampler::SoundIterator iter(s);
+		SampleSelection sounds;
+
+		{
+			ModulatorSampler::SoundIterator iter(s);
+			sounds.ensureStorageAllocated(iter.size());
+
+			while (auto sound = iter.getNextSound())
+				sounds.add(sound.get());
+		}
 
-		while (auto sound = iter.getNextSound())
-			sound->setSampleProperty(id, newValue, false);
+		s->getSampleMap()->setSampleProperties(sounds, id, newValue, false);
 
 		return SafeFunctionCall::OK;
 	};
@@ -6095,6 +6095,12 @@ void ScriptingApi::Console::print(var x)
 #endif
 }
 
+void ScriptingApi::Console::startBenchmark()
+{
+	startTime = Time::highResolutionTicksToSeconds(Time::getHighResolutionTicks());
+	getInlineCacheStatistics(numCacheHitsAtStart, numCacheMissesAtStart);
+}
+
 void ScriptingApi::Console::stopBenchmark()
 {
 #if USE_BACKEND
@@ -6111,12 +6117,37 @@ void ScriptingApi::Console::stopBenchmark()
 	const double ms = (now - startTime) * 1000.0;
 	startTime = 0.0;
 
-    
-    
-	debugToConsole(getProcessor(), "Benchmark Result: " + String(ms, 3) + " ms");
+	String result = "Benchmark Result: " + String(ms, 3) + " ms";
+
+	int64 numHits, numMisses;
+
+	if (getInlineCacheStatistics(numHits, numMisses))
+	{
+		numHits = jmax<int64>(0, numHits - numCacheHitsAtStart);
+		numMisses = jmax<int64>(0, numMisses - numCacheMissesAtStart);
+
+		if (numHits + numMisses > 0)
+			result << " (Inline caches: " << String(numHits) << " hits, " << String(numMisses) << " misses)";
+	}
+
+	debugToConsole(getProcessor(), result);
 #endif
 }
 
+bool ScriptingApi::Console::getInlineCacheStatistics(int64& numHits, int64& numMisses)
+{
+	if (auto jp = dynamic_cast<JavascriptProcessor*>(getScriptProcessor()))
+	{
+		if (auto engine = jp->getScriptEngine())
+		{
+			engine->getInlineCacheStatistics(numHits, numMisses);
+			return true;
+		}
+	}
+
+	return false;
+}
+
 void ScriptingApi::Console::stop(bool condition)
 {
 	if (!condition)
@@ -1250,7 +1250,7 @@ public:
 		void print(var debug);
 
 		/** Starts the benchmark. You can give it a name that will be displayed with the result if desired. */
-		void startBenchmark() { startTime = Time::highResolutionTicksToSeconds(Time::getHighResolutionTicks()); };
+		void startBenchmark();
 
 		/** Stops the benchmark and prints the result. */
 		void stopBenchmark();
@@ -1300,6 +1300,11 @@ public:
 
 		double startTime;
 
+		bool getInlineCacheStatistics(int64& numHits, int64& numMisses);
+
+		int64 numCacheHitsAtStart = 0;
+		int64 numCacheMissesAtStart = 0;
+
 
 
 		JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(Console)
@@ -3600,6 +3600,8 @@ bool ScriptingApi::Content::ScriptPanel::internalRepaintIdle(bool forceRepaint,
 		engine->maximumExecutionTime = HiseJavascriptEngine::getDefaultTimeOut();
 	}
 
+	graphics->getDrawHandler().beginDrawing();
+
 	engine->callExternalFunction(paintRoutine, args, &r);
 
 	if (r.failed())
@@ -3890,7 +3892,7 @@ void ScriptingApi::Content::ScriptPanel::setImage(String imageName, int xOffset,
 	if (auto drawHandler = getDrawActionHandler())
 	{
 		drawHandler->beginDrawing();
-		drawHandler->addDrawAction(new ScriptedDrawActions::drawImageWithin(img, b.toFloat()));
+		drawHandler->addDrawAction(new (drawHandler->getArena()) ScriptedDrawActions::drawImageWithin(img, b.toFloat()));
 		drawHandler->flush();
 	}
 }
@@ -4263,6 +4265,27 @@ hise::DebugInformationBase::Ptr ScriptingApi::Content::ScriptPanel::createChildE
 		break;
 	}
 	case DebugWatchIndex::FileCallback:		   return fileDropRoutine.createDebugObject("fileCallback");
+	case DebugWatchIndex::FrameStatistics:
+	{
+		if (paintRoutine.isUndefined() || paintRoutine.isVoid())
+			return nullptr;
+
+		WeakReference<ScriptPanel> safeThis(const_cast<ScriptPanel*>(this));
+
+		auto sf = [safeThis]()
+		{
+			if (safeThis != nullptr)
+			{
+				if (auto h = safeThis->getDrawActionHandler())
+					return var(h->getFrameStatistics().toString());
+			}
+
+			return var();
+		};
+
+		id << "frameStatistics";
+		return new LambdaValueInformation(sf, Identifier(id), {}, DebugInformation::Type::Constant, getLocation());
+	}
 	case DebugWatchIndex::NumDebugWatchIndexes:
 	default:
 		break;
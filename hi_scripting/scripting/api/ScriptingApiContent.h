@@ -1782,6 +1782,7 @@ public:
 			MouseCallback,
 			PreloadCallback,
 			FileCallback,
+			FrameStatistics,
 			NumDebugWatchIndexes
 		};
 
@@ -7072,6 +7072,7 @@ struct ScriptingObjects::GlobalCableReference::Wrapper
 	API_VOID_METHOD_WRAPPER_3(GlobalCableReference, setRangeWithStep);
 	API_VOID_METHOD_WRAPPER_2(GlobalCableReference, registerCallback);
 	API_VOID_METHOD_WRAPPER_3(GlobalCableReference, connectToMacroControl);
+	API_VOID_METHOD_WRAPPER_1(GlobalCableReference, setBlockRateBatching);
 };
 
 struct ScriptingObjects::GlobalCableReference::DummyTarget : public scriptnode::routing::GlobalRoutingManager::CableTargetBase
@@ -7136,6 +7137,7 @@ ScriptingObjects::GlobalCableReference::GlobalCableReference(ProcessorWithScript
 	ADD_API_METHOD_3(setRangeWithStep);
 	ADD_API_METHOD_2(registerCallback);
 	ADD_API_METHOD_3(connectToMacroControl);
+	ADD_API_METHOD_1(setBlockRateBatching);
 }
 
 ScriptingObjects::GlobalCableReference::~GlobalCableReference()
@@ -7152,7 +7154,7 @@ double ScriptingObjects::GlobalCableReference::getValue() const
 double ScriptingObjects::GlobalCableReference::getValueNormalised() const
 {
 	if (auto c = getCableFromVar(cable))
-		return c->lastValue;
+		return c->getLastValue();
 	
 	return 0.0;
 }
@@ -7169,6 +7171,15 @@ void ScriptingObjects::GlobalCableReference::setValue(double inputWithinRange)
 	setValueNormalised(v);
 }
 
+void ScriptingObjects::GlobalCableReference::setBlockRateBatching(bool shouldBatch)
+{
+	if (auto c = getCableFromVar(cable))
+	{
+		auto m = scriptnode::routing::GlobalRoutingManager::Helpers::getOrCreate(getScriptProcessor()->getMainController_());
+		m->setBlockRateBatching(c, shouldBatch);
+	}
+}
+
 void ScriptingObjects::GlobalCableReference::setRange(double min, double max)
 {
 	inputRange = scriptnode::InvertableParameterRange(min, max);
@@ -2392,6 +2392,9 @@ namespace ScriptingObjects
 		/** Connects the cable to a macro control. */
 		void connectToMacroControl(int macroIndex, bool macroIsTarget, bool filterRepetitions);
 
+		/** If enabled, the cable only sends the last value once per audio block instead of every time it changes. */
+		void setBlockRateBatching(bool shouldBatch);
+
 		// =============================================================================================
 
 	private:
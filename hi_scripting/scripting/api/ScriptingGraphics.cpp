@@ -1607,7 +1607,7 @@ void ScriptingObjects::GraphicsObject::gaussianBlur(var blurAmount)
 {
 	if (auto cl = drawActionHandler.getCurrentLayer())
 	{
-		cl->addPostAction(new ScriptedPostDrawActions::guassianBlur(jlimit(0, 100, (int)blurAmount)));
+		cl->addPostAction(new (drawActionHandler.getArena()) ScriptedPostDrawActions::guassianBlur(jlimit(0, 100, (int)blurAmount)));
 	}
 	else
 		reportScriptError("You need to create a layer for gaussian blur");
@@ -1617,7 +1617,7 @@ void ScriptingObjects::GraphicsObject::boxBlur(var blurAmount)
 {
 	if (auto cl = drawActionHandler.getCurrentLayer())
 	{
-		cl->addPostAction(new ScriptedPostDrawActions::boxBlur(jlimit(0, 100, (int)blurAmount)));
+		cl->addPostAction(new (drawActionHandler.getArena()) ScriptedPostDrawActions::boxBlur(jlimit(0, 100, (int)blurAmount)));
 	}
 	else
 		reportScriptError("You need to create a layer for box blur");
@@ -1626,7 +1626,7 @@ void ScriptingObjects::GraphicsObject::boxBlur(var blurAmount)
 void ScriptingObjects::GraphicsObject::applyHSL(float hue, float saturation, float lightness)
 {
 	if (auto cl = drawActionHandler.getCurrentLayer())
-		cl->addPostAction(new ScriptedPostDrawActions::applyHSL(hue, saturation, lightness));
+		cl->addPostAction(new (drawActionHandler.getArena()) ScriptedPostDrawActions::applyHSL(hue, saturation, lightness));
 	else
 		reportScriptError("You need to create a layer for applying HSL");
 }
@@ -1634,7 +1634,7 @@ void ScriptingObjects::GraphicsObject::applyHSL(float hue, float saturation, flo
 void ScriptingObjects::GraphicsObject::applyGamma(float gamma)
 {
 	if (auto cl = drawActionHandler.getCurrentLayer())
-		cl->addPostAction(new ScriptedPostDrawActions::applyGamma(gamma));
+		cl->addPostAction(new (drawActionHandler.getArena()) ScriptedPostDrawActions::applyGamma(gamma));
 	else
 		reportScriptError("You need to create a layer for applying gamma");
 }
@@ -1645,7 +1645,7 @@ void ScriptingObjects::GraphicsObject::applyGradientMap(var darkColour, var brig
 	auto c2 = ScriptingApi::Content::Helpers::getCleanedObjectColour(brightColour);
 
 	if (auto cl = drawActionHandler.getCurrentLayer())
-		cl->addPostAction(new ScriptedPostDrawActions::applyGradientMap(c1, c2));
+		cl->addPostAction(new (drawActionHandler.getArena()) ScriptedPostDrawActions::applyGradientMap(c1, c2));
 	else
 		reportScriptError("You need to create a layer for applyGradientMap");
 }
@@ -1653,7 +1653,7 @@ void ScriptingObjects::GraphicsObject::applyGradientMap(var darkColour, var brig
 void ScriptingObjects::GraphicsObject::applySharpness(int delta)
 {
 	if (auto cl = drawActionHandler.getCurrentLayer())
-		cl->addPostAction(new ScriptedPostDrawActions::applySharpness(delta));
+		cl->addPostAction(new (drawActionHandler.getArena()) ScriptedPostDrawActions::applySharpness(delta));
 	else
 		reportScriptError("You need to create a layer for applySharpness");
 }
@@ -1661,7 +1661,7 @@ void ScriptingObjects::GraphicsObject::applySharpness(int delta)
 void ScriptingObjects::GraphicsObject::applySepia()
 {
 	if (auto cl = drawActionHandler.getCurrentLayer())
-		cl->addPostAction(new ScriptedPostDrawActions::applySepia());
+		cl->addPostAction(new (drawActionHandler.getArena()) ScriptedPostDrawActions::applySepia());
 	else
 		reportScriptError("You need to create a layer for applySepia");
 }
@@ -1669,7 +1669,7 @@ void ScriptingObjects::GraphicsObject::applySepia()
 void ScriptingObjects::GraphicsObject::applyVignette(float amount, float radius, float falloff)
 {
 	if (auto cl = drawActionHandler.getCurrentLayer())
-		cl->addPostAction(new ScriptedPostDrawActions::applyVignette(amount, radius, falloff));
+		cl->addPostAction(new (drawActionHandler.getArena()) ScriptedPostDrawActions::applyVignette(amount, radius, falloff));
 	else
 		reportScriptError("You need to create a layer for applySepia");
 }
@@ -1690,7 +1690,7 @@ void ScriptingObjects::GraphicsObject::addNoise(var noiseAmount)
 		if (ar.isEmpty())
 			reportScriptError("No valid area for noise map specified");
 		else
-			drawActionHandler.addDrawAction(new ScriptedPostDrawActions::addNoise(m, jlimit(0.0f, 1.0f, (float)noiseAmount), ar));
+			drawActionHandler.addDrawAction(new (drawActionHandler.getArena()) ScriptedPostDrawActions::addNoise(m, jlimit(0.0f, 1.0f, (float)noiseAmount), ar));
 	}
 	else if (auto obj = noiseAmount.getDynamicObject())
 	{
@@ -1715,7 +1715,7 @@ void ScriptingObjects::GraphicsObject::addNoise(var noiseAmount)
 
 			auto scale = jlimit(0.125, 2.0, (double)sf);
 
-			drawActionHandler.addDrawAction(new ScriptedPostDrawActions::addNoise(m, jlimit(0.0f, 1.0f, (float)alpha), ar, monochrom, scale));
+			drawActionHandler.addDrawAction(new (drawActionHandler.getArena()) ScriptedPostDrawActions::addNoise(m, jlimit(0.0f, 1.0f, (float)alpha), ar, monochrom, scale));
 		}
 	}
 }
@@ -1724,7 +1724,7 @@ void ScriptingObjects::GraphicsObject::desaturate()
 {
 	if (auto cl = drawActionHandler.getCurrentLayer())
 	{
-		cl->addPostAction(new ScriptedPostDrawActions::desaturate());
+		cl->addPostAction(new (drawActionHandler.getArena()) ScriptedPostDrawActions::desaturate());
 	}
 	else
 		reportScriptError("You need to create a layer for desaturating");
@@ -1741,7 +1741,7 @@ void ScriptingObjects::GraphicsObject::applyMask(var path, var area, bool invert
 			Rectangle<float> r = getRectangleFromVar(area);
 			p.scaleToFit(r.getX(), r.getY(), r.getWidth(), r.getHeight(), false);
 
-			cl->addPostAction(new ScriptedPostDrawActions::applyMask(p, invert));
+			cl->addPostAction(new (drawActionHandler.getArena()) ScriptedPostDrawActions::applyMask(p, invert));
 		}
 		else
 			reportScriptError("No valid path object supplied");
@@ -1754,18 +1754,18 @@ void ScriptingObjects::GraphicsObject::applyMask(var path, var area, bool invert
 void ScriptingObjects::GraphicsObject::fillAll(var colour)
 {
 	Colour c = ScriptingApi::Content::Helpers::getCleanedObjectColour(colour);
-	drawActionHandler.addDrawAction(new ScriptedDrawActions::fillAll(c));
+	drawActionHandler.addDrawAction(new (drawActionHandler.getArena()) ScriptedDrawActions::fillAll(c));
 }
 
 void ScriptingObjects::GraphicsObject::fillRect(var area)
 {
-	drawActionHandler.addDrawAction(new ScriptedDrawActions::fillRect(getRectangleFromVar(area)));
+	drawActionHandler.addDrawAction(new (drawActionHandler.getArena()) ScriptedDrawActions::fillRect(getRectangleFromVar(area)));
 }
 
 void ScriptingObjects::GraphicsObject::drawRect(var area, float borderSize)
 {
 	auto bs = (float)borderSize;
-	drawActionHandler.addDrawAction(new ScriptedDrawActions::drawRect(getRectangleFromVar(area), SANITIZED(bs)));
+	drawActionHandler.addDrawAction(new (drawActionHandler.getArena()) ScriptedDrawActions::drawRect(getRectangleFromVar(area), SANITIZED(bs)));
 }
 
 void ScriptingObjects::GraphicsObject::fillRoundedRectangle(var area, var cornerData)
@@ -1775,7 +1775,7 @@ void ScriptingObjects::GraphicsObject::fillRoundedRectangle(var area, var corner
 		auto cs = (float)cornerData["CornerSize"];
 		cs = SANITIZED(cs);
 
-		auto newAction = new ScriptedDrawActions::fillRoundedRect(getRectangleFromVar(area), cs);
+		auto newAction = new (drawActionHandler.getArena()) ScriptedDrawActions::fillRoundedRect(getRectangleFromVar(area), cs);
 		auto ra = cornerData["Rounded"];
 
 		if (ra.isArray())
@@ -1793,7 +1793,7 @@ void ScriptingObjects::GraphicsObject::fillRoundedRectangle(var area, var corner
 	{
 		auto cs = (float)cornerData;
 		cs = SANITIZED(cs);
-		drawActionHandler.addDrawAction(new ScriptedDrawActions::fillRoundedRect(getRectangleFromVar(area), cs));
+		drawActionHandler.addDrawAction(new (drawActionHandler.getArena()) ScriptedDrawActions::fillRoundedRect(getRectangleFromVar(area), cs));
 	}
 }
 
@@ -1807,7 +1807,7 @@ void ScriptingObjects::GraphicsObject::drawRoundedRectangle(var area, var corner
 		auto cs = (float)cornerData["CornerSize"];
 		cs = SANITIZED(cs);
 
-		auto newAction = new ScriptedDrawActions::drawRoundedRectangle(getRectangleFromVar(area), borderSize, cs);
+		auto newAction = new (drawActionHandler.getArena()) ScriptedDrawActions::drawRoundedRectangle(getRectangleFromVar(area), borderSize, cs);
 		auto ra = cornerData["Rounded"];
 
 		if (ra.isArray())
@@ -1825,35 +1825,35 @@ void ScriptingObjects::GraphicsObject::drawRoundedRectangle(var area, var corner
 	{
 		auto cs = (float)cornerData;
 		cs = SANITIZED(cs);
-		drawActionHandler.addDrawAction(new ScriptedDrawActions::drawRoundedRectangle(ar, bs, cs));
+		drawActionHandler.addDrawAction(new (drawActionHandler.getArena()) ScriptedDrawActions::drawRoundedRectangle(ar, bs, cs));
 	}
 }
 
 void ScriptingObjects::GraphicsObject::drawHorizontalLine(int y, float x1, float x2)
 {
-	drawActionHandler.addDrawAction(new ScriptedDrawActions::drawHorizontalLine(y, SANITIZED(x1), SANITIZED(x2)));
+	drawActionHandler.addDrawAction(new (drawActionHandler.getArena()) ScriptedDrawActions::drawHorizontalLine(y, SANITIZED(x1), SANITIZED(x2)));
 }
 
 void ScriptingObjects::GraphicsObject::drawVerticalLine(int x, float y1, float y2)
 {
-	drawActionHandler.addDrawAction(new ScriptedDrawActions::drawVerticalLine(x, SANITIZED(y1), SANITIZED(y2)));
+	drawActionHandler.addDrawAction(new (drawActionHandler.getArena()) ScriptedDrawActions::drawVerticalLine(x, SANITIZED(y1), SANITIZED(y2)));
 }
 
 void ScriptingObjects::GraphicsObject::setOpacity(float alphaValue)
 {
-	drawActionHandler.addDrawAction(new ScriptedDrawActions::setOpacity(alphaValue));
+	drawActionHandler.addDrawAction(new (drawActionHandler.getArena()) ScriptedDrawActions::setOpacity(alphaValue));
 }
 
 void ScriptingObjects::GraphicsObject::drawLine(float x1, float x2, float y1, float y2, float lineThickness)
 {
-	drawActionHandler.addDrawAction(new ScriptedDrawActions::drawLine(
+	drawActionHandler.addDrawAction(new (drawActionHandler.getArena()) ScriptedDrawActions::drawLine(
 		SANITIZED(x1), SANITIZED(y1), SANITIZED(x2), SANITIZED(y2), SANITIZED(lineThickness)));
 }
 
 void ScriptingObjects::GraphicsObject::setColour(var colour)
 {
 	auto c = ScriptingApi::Content::Helpers::getCleanedObjectColour(colour);
-	drawActionHandler.addDrawAction(new ScriptedDrawActions::setColour(c));
+	drawActionHandler.addDrawAction(new (drawActionHandler.getArena()) ScriptedDrawActions::setColour(c));
 }
 
 void ScriptingObjects::GraphicsObject::setFont(String fontName, float fontSize)
@@ -1861,7 +1861,7 @@ void ScriptingObjects::GraphicsObject::setFont(String fontName, float fontSize)
 	MainController *mc = getScriptProcessor()->getMainController_();
 	auto f = mc->getFontFromString(fontName, SANITIZED(fontSize));
 	currentFont = f;
-	drawActionHandler.addDrawAction(new ScriptedDrawActions::setFont(f));
+	drawActionHandler.addDrawAction(new (drawActionHandler.getArena()) ScriptedDrawActions::setFont(f));
 }
 
 void ScriptingObjects::GraphicsObject::setFontWithSpacing(String fontName, float fontSize, float spacing)
@@ -1871,13 +1871,13 @@ void ScriptingObjects::GraphicsObject::setFontWithSpacing(String fontName, float
 
 	f.setExtraKerningFactor(spacing);
 	currentFont = f;
-	drawActionHandler.addDrawAction(new ScriptedDrawActions::setFont(f));
+	drawActionHandler.addDrawAction(new (drawActionHandler.getArena()) ScriptedDrawActions::setFont(f));
 }
 
 void ScriptingObjects::GraphicsObject::drawText(String text, var area)
 {
 	Rectangle<float> r = getRectangleFromVar(area);
-	drawActionHandler.addDrawAction(new ScriptedDrawActions::drawText(text, r));
+	drawActionHandler.addDrawAction(new (drawActionHandler.getArena()) ScriptedDrawActions::drawText(text, r));
 }
 
 void ScriptingObjects::GraphicsObject::drawAlignedText(String text, var area, String alignment)
@@ -1890,7 +1890,7 @@ void ScriptingObjects::GraphicsObject::drawAlignedText(String text, var area, St
 	if (re.failed())
 		reportScriptError(re.getErrorMessage());
 
-	drawActionHandler.addDrawAction(new ScriptedDrawActions::drawText(text, r, just));
+	drawActionHandler.addDrawAction(new (drawActionHandler.getArena()) ScriptedDrawActions::drawText(text, r, just));
 }
 
 void ScriptingObjects::GraphicsObject::drawFittedText(String text, var area, String alignment, int maxLines, float scale)
@@ -1901,7 +1901,7 @@ void ScriptingObjects::GraphicsObject::drawFittedText(String text, var area, Str
 	if (re.failed())
 		reportScriptError(re.getErrorMessage());
 
-	drawActionHandler.addDrawAction(new ScriptedDrawActions::drawFittedText(text, area, just, maxLines, scale));
+	drawActionHandler.addDrawAction(new (drawActionHandler.getArena()) ScriptedDrawActions::drawFittedText(text, area, just, maxLines, scale));
 }
 
 void ScriptingObjects::GraphicsObject::drawMultiLineText(String text, var xy, int maxWidth, String alignment, float leading)
@@ -1915,7 +1915,7 @@ void ScriptingObjects::GraphicsObject::drawMultiLineText(String text, var xy, in
     int startX = (int)xy[0];
     int baseLineY = (int)xy[1];
     
-    drawActionHandler.addDrawAction(new ScriptedDrawActions::drawMultiLineText(text, startX, baseLineY, maxWidth, just, leading));
+    drawActionHandler.addDrawAction(new (drawActionHandler.getArena()) ScriptedDrawActions::drawMultiLineText(text, startX, baseLineY, maxWidth, just, leading));
 }
 
 void ScriptingObjects::GraphicsObject::drawMarkdownText(var markdownRenderer)
@@ -1936,7 +1936,7 @@ void ScriptingObjects::GraphicsObject::drawSVG(var svgObject, var bounds, float
     if (auto obj = dynamic_cast<SVGObject*>(svgObject.getObject()))
     {
         auto b = ApiHelpers::getRectangleFromVar(bounds);
-        drawActionHandler.addDrawAction(new ScriptedDrawActions::drawSVG(svgObject, b, opacity));
+        drawActionHandler.addDrawAction(new (drawActionHandler.getArena()) ScriptedDrawActions::drawSVG(svgObject, b, opacity));
     }
     else
         reportScriptError("not a SVG object");
@@ -1957,7 +1957,7 @@ void ScriptingObjects::GraphicsObject::setGradientFill(var gradientData)
 				c2, (float)data->getUnchecked(4), (float)data->getUnchecked(5), false);
 
 
-			drawActionHandler.addDrawAction(new ScriptedDrawActions::setGradientFill(grad));
+			drawActionHandler.addDrawAction(new (drawActionHandler.getArena()) ScriptedDrawActions::setGradientFill(grad));
 		}
 		else if (gradientData.getArray()->size() >= 7)
 		{
@@ -1979,7 +1979,7 @@ void ScriptingObjects::GraphicsObject::setGradientFill(var gradientData)
 				}
 			}
 
-			drawActionHandler.addDrawAction(new ScriptedDrawActions::setGradientFill(grad));
+			drawActionHandler.addDrawAction(new (drawActionHandler.getArena()) ScriptedDrawActions::setGradientFill(grad));
 		}
 	}
 	else
@@ -1990,14 +1990,14 @@ void ScriptingObjects::GraphicsObject::setGradientFill(var gradientData)
 
 void ScriptingObjects::GraphicsObject::drawEllipse(var area, float lineThickness)
 {
-	drawActionHandler.addDrawAction(new ScriptedDrawActions::drawEllipse(getRectangleFromVar(area), lineThickness));
+	drawActionHandler.addDrawAction(new (drawActionHandler.getArena()) ScriptedDrawActions::drawEllipse(getRectangleFromVar(area), lineThickness));
 }
 
 
 
 void ScriptingObjects::GraphicsObject::fillEllipse(var area)
 {
-	drawActionHandler.addDrawAction(new ScriptedDrawActions::fillEllipse(getRectangleFromVar(area)));
+	drawActionHandler.addDrawAction(new (drawActionHandler.getArena()) ScriptedDrawActions::fillEllipse(getRectangleFromVar(area)));
 }
 
 void ScriptingObjects::GraphicsObject::drawImage(String imageName, var area, int /*xOffset*/, int yOffset)
@@ -2024,17 +2024,17 @@ void ScriptingObjects::GraphicsObject::drawImage(String imageName, var area, int
 		if (r.getWidth() != 0)
 		{
 			const double scaleFactor = (double)img.getWidth() / (double)r.getWidth();
-			drawActionHandler.addDrawAction(new ScriptedDrawActions::drawImage(img, r, (float)scaleFactor, yOffset));
+			drawActionHandler.addDrawAction(new (drawActionHandler.getArena()) ScriptedDrawActions::drawImage(img, r, (float)scaleFactor, yOffset));
 		}
 	}
 	else
 	{
-		drawActionHandler.addDrawAction(new ScriptedDrawActions::setColour(Colours::grey));
-		drawActionHandler.addDrawAction(new ScriptedDrawActions::fillRect(getRectangleFromVar(area)));
-		drawActionHandler.addDrawAction(new ScriptedDrawActions::setColour(Colours::black));
-		drawActionHandler.addDrawAction(new ScriptedDrawActions::drawRect(getRectangleFromVar(area), 1.0f));
-		drawActionHandler.addDrawAction(new ScriptedDrawActions::setFont(GLOBAL_BOLD_FONT()));
-		drawActionHandler.addDrawAction(new ScriptedDrawActions::drawText("XXX", getRectangleFromVar(area), Justification::centred));
+		drawActionHandler.addDrawAction(new (drawActionHandler.getArena()) ScriptedDrawActions::setColour(Colours::grey));
+		drawActionHandler.addDrawAction(new (drawActionHandler.getArena()) ScriptedDrawActions::fillRect(getRectangleFromVar(area)));
+		drawActionHandler.addDrawAction(new (drawActionHandler.getArena()) ScriptedDrawActions::setColour(Colours::black));
+		drawActionHandler.addDrawAction(new (drawActionHandler.getArena()) ScriptedDrawActions::drawRect(getRectangleFromVar(area), 1.0f));
+		drawActionHandler.addDrawAction(new (drawActionHandler.getArena()) ScriptedDrawActions::setFont(GLOBAL_BOLD_FONT()));
+		drawActionHandler.addDrawAction(new (drawActionHandler.getArena()) ScriptedDrawActions::drawText("XXX", getRectangleFromVar(area), Justification::centred));
 
 		debugError(dynamic_cast<Processor*>(getScriptProcessor()), "Image " + imageName + " not found");
 	}
@@ -2048,7 +2048,7 @@ void ScriptingObjects::GraphicsObject::drawDropShadow(var area, var colour, int
 	shadow.colour = ScriptingApi::Content::Helpers::getCleanedObjectColour(colour);
 	shadow.radius = radius;
 
-	drawActionHandler.addDrawAction(new ScriptedDrawActions::drawDropShadow(r, shadow));
+	drawActionHandler.addDrawAction(new (drawActionHandler.getArena()) ScriptedDrawActions::drawDropShadow(r, shadow));
 }
 
 void ScriptingObjects::GraphicsObject::drawDropShadowFromPath(var path, var area, var colour, int radius, var offset)
@@ -2063,7 +2063,7 @@ void ScriptingObjects::GraphicsObject::drawDropShadowFromPath(var path, var area
 		
 		auto area = r.toFloat().translated(o.getX(), o.getY());
 
-		drawActionHandler.addDrawAction(new ScriptedDrawActions::drawDropShadowFromPath(sp, area, c, radius));
+		drawActionHandler.addDrawAction(new (drawActionHandler.getArena()) ScriptedDrawActions::drawDropShadowFromPath(sp, area, c, radius));
 	}
 }
 
@@ -2078,7 +2078,7 @@ void ScriptingObjects::GraphicsObject::drawTriangle(var area, float angle, float
 	auto r = getRectangleFromVar(area);
 	p.scaleToFit(r.getX(), r.getY(), r.getWidth(), r.getHeight(), false);
 
-	drawActionHandler.addDrawAction(new ScriptedDrawActions::drawPath(p, PathStrokeType(lineThickness)));
+	drawActionHandler.addDrawAction(new (drawActionHandler.getArena()) ScriptedDrawActions::drawPath(drawActionHandler.internPath(p), PathStrokeType(lineThickness)));
 }
 
 void ScriptingObjects::GraphicsObject::fillTriangle(var area, float angle)
@@ -2092,7 +2092,7 @@ void ScriptingObjects::GraphicsObject::fillTriangle(var area, float angle)
 	auto r = getRectangleFromVar(area);
 	p.scaleToFit(r.getX(), r.getY(), r.getWidth(), r.getHeight(), false);
 
-	drawActionHandler.addDrawAction(new ScriptedDrawActions::fillPath(p));
+	drawActionHandler.addDrawAction(new (drawActionHandler.getArena()) ScriptedDrawActions::fillPath(drawActionHandler.internPath(p)));
 }
 
 void ScriptingObjects::GraphicsObject::addDropShadowFromAlpha(var colour, int radius)
@@ -2102,7 +2102,7 @@ void ScriptingObjects::GraphicsObject::addDropShadowFromAlpha(var colour, int ra
 	shadow.colour = ScriptingApi::Content::Helpers::getCleanedObjectColour(colour);
 	shadow.radius = radius;
 
-	drawActionHandler.addDrawAction(new ScriptedDrawActions::addDropShadowFromAlpha(shadow));
+	drawActionHandler.addDrawAction(new (drawActionHandler.getArena()) ScriptedDrawActions::addDropShadowFromAlpha(shadow));
 }
 
 bool ScriptingObjects::GraphicsObject::applyShader(var shader, var area)
@@ -2110,7 +2110,7 @@ bool ScriptingObjects::GraphicsObject::applyShader(var shader, var area)
 	if (auto obj = dynamic_cast<ScriptingObjects::ScriptShader*>(shader.getObject()))
 	{
 		Rectangle<int> b = getRectangleFromVar(area).toNearestInt();
-		drawActionHandler.addDrawAction(new ScriptedDrawActions::addShader(&drawActionHandler, obj, b));
+		drawActionHandler.addDrawAction(new (drawActionHandler.getArena()) ScriptedDrawActions::addShader(&drawActionHandler, obj, b));
 		return true;
 	}
 
@@ -2137,7 +2137,7 @@ void ScriptingObjects::GraphicsObject::fillPath(var path, var area)
 			p.scaleToFit(r.getX(), r.getY(), r.getWidth(), r.getHeight(), false);
 		}
 
-		drawActionHandler.addDrawAction(new ScriptedDrawActions::fillPath(p));
+		drawActionHandler.addDrawAction(new (drawActionHandler.getArena()) ScriptedDrawActions::fillPath(drawActionHandler.internPath(p)));
 	}
 }
 
@@ -2163,7 +2163,7 @@ void ScriptingObjects::GraphicsObject::drawPath(var path, var area, var strokeTy
 
 		auto s = ApiHelpers::createPathStrokeType(strokeType);
 
-		drawActionHandler.addDrawAction(new ScriptedDrawActions::drawPath(p, s));
+		drawActionHandler.addDrawAction(new (drawActionHandler.getArena()) ScriptedDrawActions::drawPath(drawActionHandler.internPath(p), s));
 	}
 }
 
@@ -2173,7 +2173,7 @@ void ScriptingObjects::GraphicsObject::rotate(var angleInRadian, var center)
 	auto air = (float)angleInRadian;
 	auto a = AffineTransform::rotation(SANITIZED(air), c.getX(), c.getY());
 
-	drawActionHandler.addDrawAction(new ScriptedDrawActions::addTransform(a));
+	drawActionHandler.addDrawAction(new (drawActionHandler.getArena()) ScriptedDrawActions::addTransform(a));
 }
 
 void ScriptingObjects::GraphicsObject::flip(bool horizontally, var area)
@@ -2192,7 +2192,7 @@ void ScriptingObjects::GraphicsObject::flip(bool horizontally, var area)
                             0.0f, -1.0f, (float)r.getHeight());
     }
     
-    drawActionHandler.addDrawAction(new ScriptedDrawActions::addTransform(a));
+    drawActionHandler.addDrawAction(new (drawActionHandler.getArena()) ScriptedDrawActions::addTransform(a));
 }
 
 
@@ -2397,6 +2397,7 @@ bool ScriptingObjects::ScriptedLookAndFeel::callWithGraphics(Graphics& g_, const
 				auto engine = dynamic_cast<JavascriptProcessor*>(getScriptProcessor())->getScriptEngine();
 				lastResult = Result::ok();
 
+				g->getDrawHandler().beginDrawing();
 				engine->callExternalFunction(f, arg, &lastResult, true);
 
 				if (lastResult.wasOk())
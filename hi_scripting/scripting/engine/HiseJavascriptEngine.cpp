@@ -614,7 +614,9 @@ struct HiseJavascriptEngine::RootObject::Statement
 
 		if (idx != -1)
 		{
-			arrayToSwap.set(idx, dynamic_cast<T*>(newChild.release()), true);
+			auto oc = arrayToSwap.getUnchecked(idx);
+			arrayToSwap.set(idx, dynamic_cast<T*>(newChild.release()), false);
+			newChild = dynamic_cast<Statement*>(oc);
 			return true;
 		}
 
@@ -874,6 +876,12 @@ void HiseJavascriptEngine::setCallStackEnabled(bool shouldBeEnabled)
 	root->setCallStackEnabled(shouldBeEnabled);
 }
 
+void HiseJavascriptEngine::getInlineCacheStatistics(int64& numHits, int64& numMisses) const
+{
+	numHits = root->inlineCacheStatistics.numHits.load();
+	numMisses = root->inlineCacheStatistics.numMisses.load();
+}
+
 void HiseJavascriptEngine::registerApiClass(ApiClass *apiClass)
 {
 	root->hiseSpecialData.apiClasses.add(apiClass);
@@ -1937,6 +1945,10 @@ hise::HiseJavascriptEngine::RootObject::OptimizationPass::OptimizationResult His
 				auto ok = st->replaceChildStatement(newExpr, child);
                 ignoreUnused(ok);
 				jassert(ok);
+
+				if (takesOwnershipOfReplacedStatement())
+					newExpr.release();
+
 				r.numOptimizedStatements++;
 			}
 		}
@@ -213,6 +213,12 @@ public:
 	*/
 	Result execute(const String& javascriptCode, bool allowConstDeclarations = true, const Identifier& callbackId = {});
 
+	/** Adds the bytecode compiler pass even if it's disabled by the settings or HISE_USE_SCRIPT_BYTECODE_COMPILER. 
+	
+		Call this before execute(). The unit tests use it to compare the bytecode with the syntax tree.
+	*/
+	void enableBytecodeCompiler();
+
 	/** Attempts to parse and run a javascript expression, and returns the result.
 	If there's a syntax error, or the expression can't be evaluated, the return value
 	will be var::undefined(). The errorMessage parameter gives you a way to find out
@@ -322,6 +328,9 @@ public:
 
 	void setCallStackEnabled(bool shouldBeEnabled);
 
+	/** Returns the number of inline cache hits and misses for property and method lookups since the last compilation. */
+	void getInlineCacheStatistics(int64& numHits, int64& numMisses) const;
+
 	void registerApiClass(ApiClass *apiClass);
 
     void setIsInitialising(bool shouldBeInitialising)
@@ -597,6 +606,12 @@ public:
 			*/
 			virtual Statement* getOptimizedStatement(Statement* parentStatement, Statement* statementToOptimize) = 0;
 
+			/** Override this and return true if the optimized statement keeps using the statement it replaces.
+
+				In this case the replaced statement will not be deleted and the optimized statement must take ownership.
+			*/
+			virtual bool takesOwnershipOfReplacedStatement() const { return false; }
+
 			static bool callForEach(Statement* root, const std::function<bool(Statement* child)>& f);
 
 			OptimizationResult executePass(Statement* rootStatementToOptimize);
@@ -728,7 +743,8 @@ public:
 		struct GlobalVarStatement;		struct GlobalReference;		struct LocalVarStatement;
 		struct LocalReference;			struct LockStatement;	    struct CallbackParameterReference;
 		struct CallbackLocalStatement;  struct CallbackLocalReference;  struct ExternalCFunction;
-		struct NativeJIT;				struct IsDefinedTest;		
+		struct NativeJIT;				struct IsDefinedTest;		struct CompiledExpression;
+		struct InlineCache;
 
 		// Snex stuff
 
@@ -1094,6 +1110,15 @@ public:
 
 		HiseSpecialData hiseSpecialData;
 
+		/** The hit and miss counters of the inline caches. They are only updated in HISE (the exported plugins skip the counting). */
+		struct InlineCacheStatistics
+		{
+			std::atomic<int64> numHits = { 0 };
+			std::atomic<int64> numMisses = { 0 };
+		};
+
+		InlineCacheStatistics inlineCacheStatistics;
+
 #if HISE_INCLUDE_SNEX
 		snex::jit::GlobalScope snexGlobalScope;
 #endif
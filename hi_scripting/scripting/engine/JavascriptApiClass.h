@@ -198,6 +198,9 @@ public:
 	/** Returns the name for the constant as it is used in the scripting context. */
 	Identifier getConstantName(int index) const;
 
+	/** Checks whether the constant at the given index has the given name. This is used to validate cached indexes. */
+	bool isConstantAtIndex(int index, const Identifier& id) const noexcept;
+
 	// ================================================================================================================
 
     /** Adds a function with no parameters. 
@@ -235,6 +238,11 @@ public:
     *   The JavascriptEngine uses this to resolve the function call into a function pointer at compile time.
     *   When the script is executed, this information will be used for blazing fast access to the methods.*/
 	void getIndexAndNumArgsForFunction(const Identifier &id, int &index, int &numArgs) const;
+
+	/** Checks whether the function with the given index and argument amount has the given name. 
+	*
+	*   This is a cheap check that the script engine uses to validate cached function indexes. */
+	bool isFunctionAtIndex(const Identifier& id, int index, int numArgs) const noexcept;
     
     /** Calls the function with the index and the argument data.
     *
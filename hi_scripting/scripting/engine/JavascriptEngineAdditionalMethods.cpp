@@ -346,7 +346,7 @@ var HiseJavascriptEngine::RootObject::FunctionCall::getResult(const Scope& s) co
 
 			if (ConstScriptingObject* c = dynamic_cast<ConstScriptingObject*>(thisObject.getObject()))
 			{
-				c->getIndexAndNumArgsForFunction(dot->child, functionIndex, numArgs);
+				functionCache.getIndexAndNumArgsForFunction(s, c, dot->child, functionIndex, numArgs);
 
 				CHECK_CONDITION_WITH_LOCATION(functionIndex != -1, "function not found");
 				CHECK_CONDITION_WITH_LOCATION(numArgs == arguments.size(), "argument amount mismatch: " + String(arguments.size()) + ", Expected: " + String(numArgs));
@@ -361,7 +361,8 @@ var HiseJavascriptEngine::RootObject::FunctionCall::getResult(const Scope& s) co
 
 			if (DynamicObject* dynObj = thisObject.getDynamicObject())
 			{
-				var property = dynObj->getProperty(dot->child);
+				auto propertyPointer = propertyCache.getPropertyPointer(s, dynObj, dot->child);
+				var property = propertyPointer != nullptr ? *propertyPointer : dynObj->getProperty(dot->child);
 
 				if (auto obj = dynamic_cast<InlineFunction::Object*>(property.getObject()))
 				{
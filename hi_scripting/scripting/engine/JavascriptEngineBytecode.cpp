@@ -0,0 +1,392 @@
+namespace hise { using namespace juce;
+
+/** An expression tree that was lowered into a flat list of register instructions.
+
+	The BytecodeCompiler pass replaces expressions with this object. All variable slots (literals, `reg`,
+	`const var`, `local` variables and callback parameters) are resolved at compile time, so evaluating the
+	expression is a single loop over the instructions with a small register file on the stack instead of a
+	virtual getResult() call for every node of the tree.
+
+	Subexpressions that can't be lowered are evaluated with the syntax tree. The original tree is kept
+	alive because the instructions point to its nodes.
+*/
+struct HiseJavascriptEngine::RootObject::CompiledExpression : public Expression
+{
+	static constexpr int MaxNumRegisters = 8;
+
+	enum class OpCode : uint8
+	{
+		LoadPointer,		// r[dst] = *data (literals, reg variables and callback parameters)
+		LoadConstVar,		// r[dst] = const var
+		LoadLocal,			// r[dst] = local variable of an inline function
+		LoadCallbackLocal,	// r[dst] = local variable of a callback
+		LoadParameter,		// r[dst] = parameter of an inline function
+		Evaluate,			// r[dst] = expression->getResult(s)
+		Add,				// r[dst] = r[dst] + r[src]
+		Subtract,
+		Multiply,
+		Divide,
+		LessThan,
+		LessThanOrEqual,
+		GreaterThan,
+		GreaterThanOrEqual,
+		Equals,
+		NotEquals,
+		BinaryOp,			// r[dst] = r[dst] op r[src] for all other binary operators
+		CallApi,			// r[dst] = apiCall(r[dst], r[dst+1], ...), the arguments are calculated by the instructions up to target
+		LogicalAnd,			// if(!r[dst]) { r[dst] = false; pc = target; }
+		LogicalOr,			// if(r[dst]) { r[dst] = true; pc = target; }
+		ToBool,				// r[dst] = (bool)r[dst]
+		JumpIfFalse,		// if(!r[dst]) pc = target;
+		Jump,				// pc = target
+		numOpCodes
+	};
+
+	struct Instruction
+	{
+		OpCode op;
+		uint8 dst;
+		uint8 src;
+		int target;
+		const Expression* expression;
+		const var* data;
+	};
+
+	struct Builder;
+
+	CompiledExpression(Expression* source_, Array<Instruction>& instructionsToUse) noexcept :
+		Expression(source_->location),
+		source(source_)
+	{
+		instructions.swapWith(instructionsToUse);
+	}
+
+	var getResult(const Scope& s) const override;
+
+	/** Runs the instructions from startIndex up to endIndex. */
+	void execute(const Scope& s, var* r, int startIndex, int endIndex) const;
+
+	Statement* getChildStatement(int) override { return nullptr; };
+
+	ExpPtr source;
+	Array<Instruction> instructions;
+};
+
+struct HiseJavascriptEngine::RootObject::CompiledExpression::Builder
+{
+	/** Only operators and API calls are compiled, everything else is either an assignment target or not worth it. */
+	static bool isCompileableRoot(Statement* s)
+	{
+		return dynamic_cast<BinaryOperatorBase*>(s) != nullptr ||
+			   dynamic_cast<ApiCall*>(s) != nullptr;
+	}
+
+	bool compileRoot(const Expression* e)
+	{
+		auto dst = allocateRegister();
+		return compile(e, dst) && numOperations > 1;
+	}
+
+	Array<Instruction> instructions;
+
+private:
+
+	/** Compiles the expression into the given register. This must always be the last allocated register. */
+	bool compile(const Expression* e, int dst)
+	{
+		jassert(dst == numUsedRegisters - 1);
+
+		if (auto lv = dynamic_cast<const LiteralValue*>(e))
+			return add(OpCode::LoadPointer, dst, 0, nullptr, &lv->value);
+
+		if (auto rn = dynamic_cast<const RegisterName*>(e))
+			return add(OpCode::LoadPointer, dst, 0, nullptr, rn->data);
+
+		if (auto cp = dynamic_cast<const CallbackParameterReference*>(e))
+			return add(OpCode::LoadPointer, dst, 0, nullptr, cp->data);
+
+		if (dynamic_cast<const ConstReference*>(e) != nullptr)
+			return add(OpCode::LoadConstVar, dst, 0, e);
+
+		if (dynamic_cast<const LocalReference*>(e) != nullptr)
+			return add(OpCode::LoadLocal, dst, 0, e);
+
+		if (dynamic_cast<const CallbackLocalReference*>(e) != nullptr)
+			return add(OpCode::LoadCallbackLocal, dst, 0, e);
+
+		if (dynamic_cast<const InlineFunction::ParameterReference*>(e) != nullptr)
+			return add(OpCode::LoadParameter, dst, 0, e);
+
+		if (auto bo = dynamic_cast<const BinaryOperator*>(e))
+		{
+			if (!compile(bo->lhs.get(), dst))
+				return false;
+
+			auto src = allocateRegister();
+
+			if (src == -1 || !compile(bo->rhs.get(), src))
+				return false;
+
+			releaseRegistersFrom(src);
+			numOperations++;
+			return add(getOpCode(bo->operation), dst, src, e);
+		}
+
+		if (auto la = dynamic_cast<const LogicalAndOp*>(e))
+			return compileLogicalOp(OpCode::LogicalAnd, la, dst);
+
+		if (auto lo = dynamic_cast<const LogicalOrOp*>(e))
+			return compileLogicalOp(OpCode::LogicalOr, lo, dst);
+
+		if (auto co = dynamic_cast<const ConditionalOp*>(e))
+		{
+			if (!compile(co->condition.get(), dst))
+				return false;
+
+			auto jumpToFalseBranch = instructions.size();
+			add(OpCode::JumpIfFalse, dst, 0, nullptr);
+
+			if (!compile(co->trueBranch.get(), dst))
+				return false;
+
+			auto jumpToEnd = instructions.size();
+			add(OpCode::Jump, dst, 0, nullptr);
+
+			instructions.getReference(jumpToFalseBranch).target = instructions.size();
+
+			if (!compile(co->falseBranch.get(), dst))
+				return false;
+
+			instructions.getReference(jumpToEnd).target = instructions.size();
+			numOperations++;
+			return true;
+		}
+
+		if (auto ac = dynamic_cast<const ApiCall*>(e))
+		{
+			// The call comes first so that it can evaluate the arguments within the audio thread guard scope
+			auto callIndex = instructions.size();
+			add(OpCode::CallApi, dst, 0, e);
+
+			// The arguments must be in consecutive registers starting with dst
+			for (int i = 0; i < ac->expectedNumArguments; i++)
+			{
+				auto argRegister = i == 0 ? dst : allocateRegister();
+
+				if (argRegister == -1 || !compile(ac->argumentList[i].get(), argRegister))
+					return false;
+			}
+
+			instructions.getReference(callIndex).target = instructions.size();
+
+			releaseRegistersFrom(dst + 1);
+			numOperations++;
+			return true;
+		}
+
+		return add(OpCode::Evaluate, dst, 0, e);
+	}
+
+	bool compileLogicalOp(OpCode op, const BinaryOperatorBase* e, int dst)
+	{
+		if (!compile(e->lhs.get(), dst))
+			return false;
+
+		auto shortCircuit = instructions.size();
+		add(op, dst, 0, nullptr);
+
+		if (!compile(e->rhs.get(), dst))
+			return false;
+
+		add(OpCode::ToBool, dst, 0, nullptr);
+		instructions.getReference(shortCircuit).target = instructions.size();
+		numOperations++;
+		return true;
+	}
+
+	static OpCode getOpCode(TokenType t)
+	{
+		if (t == TokenTypes::plus)					return OpCode::Add;
+		if (t == TokenTypes::minus)					return OpCode::Subtract;
+		if (t == TokenTypes::times)					return OpCode::Multiply;
+		if (t == TokenTypes::divide)				return OpCode::Divide;
+		if (t == TokenTypes::lessThan)				return OpCode::LessThan;
+		if (t == TokenTypes::lessThanOrEqual)		return OpCode::LessThanOrEqual;
+		if (t == TokenTypes::greaterThan)			return OpCode::GreaterThan;
+		if (t == TokenTypes::greaterThanOrEqual)	return OpCode::GreaterThanOrEqual;
+		if (t == TokenTypes::equals)				return OpCode::Equals;
+		if (t == TokenTypes::notEquals)				return OpCode::NotEquals;
+
+		return OpCode::BinaryOp;
+	}
+
+	bool add(OpCode op, int dst, int src, const Expression* e, const var* data = nullptr)
+	{
+		instructions.add({ op, (uint8)dst, (uint8)src, -1, e, data });
+		return true;
+	}
+
+	int allocateRegister()
+	{
+		if (numUsedRegisters == MaxNumRegisters)
+			return -1;
+
+		return numUsedRegisters++;
+	}
+
+	void releaseRegistersFrom(int firstRegisterToRelease)
+	{
+		numUsedRegisters = firstRegisterToRelease;
+	}
+
+	int numUsedRegisters = 0;
+	int numOperations = 0;
+};
+
+#define NUMERIC_BINARY_OP(opCode, resultExpression) case OpCode::opCode: \
+{ \
+	const auto& b = r[i.src]; \
+	if (isNumericOrUndefined(d) && isNumericOrUndefined(b)) \
+	{ \
+		if (d.isDouble() || b.isDouble()) { const auto x = (double)d; const auto y = (double)b; d = var(resultExpression); } \
+		else							  { const auto x = (int64)d;  const auto y = (int64)b;  d = var(resultExpression); } \
+	} \
+	else \
+		d = static_cast<const BinaryOperator*>(i.expression)->getResultForValues(d, b); \
+	break; \
+}
+
+var HiseJavascriptEngine::RootObject::CompiledExpression::getResult(const Scope& s) const
+{
+	var r[MaxNumRegisters];
+
+	execute(s, r, 0, instructions.size());
+
+	return r[0];
+}
+
+void HiseJavascriptEngine::RootObject::CompiledExpression::execute(const Scope& s, var* r, int startIndex, int endIndex) const
+{
+	auto pc = startIndex;
+
+	while (pc < endIndex)
+	{
+		const auto& i = instructions.getReference(pc++);
+		auto& d = r[i.dst];
+
+		switch (i.op)
+		{
+		case OpCode::LoadPointer:		d = *i.data; break;
+		case OpCode::LoadConstVar:		d = static_cast<const ConstReference*>(i.expression)->ConstReference::getResult(s); break;
+		case OpCode::LoadLocal:			d = static_cast<const LocalReference*>(i.expression)->LocalReference::getResult(s); break;
+		case OpCode::LoadCallbackLocal: d = static_cast<const CallbackLocalReference*>(i.expression)->CallbackLocalReference::getResult(s); break;
+		case OpCode::LoadParameter:		d = static_cast<const InlineFunction::ParameterReference*>(i.expression)->InlineFunction::ParameterReference::getResult(s); break;
+		case OpCode::Evaluate:			d = i.expression->getResult(s); break;
+		NUMERIC_BINARY_OP(Add, x + y);
+		NUMERIC_BINARY_OP(Subtract, x - y);
+		NUMERIC_BINARY_OP(Multiply, x * y);
+		NUMERIC_BINARY_OP(Divide, y != 0 ? (double)x / (double)y : std::numeric_limits<double>::infinity());
+		NUMERIC_BINARY_OP(LessThan, x < y);
+		NUMERIC_BINARY_OP(LessThanOrEqual, x <= y);
+		NUMERIC_BINARY_OP(GreaterThan, x > y);
+		NUMERIC_BINARY_OP(GreaterThanOrEqual, x >= y);
+		NUMERIC_BINARY_OP(Equals, x == y);
+		NUMERIC_BINARY_OP(NotEquals, x != y);
+		case OpCode::BinaryOp:			d = static_cast<const BinaryOperator*>(i.expression)->getResultForValues(d, r[i.src]); break;
+		case OpCode::CallApi:
+		{
+			const auto argumentStart = pc;
+			const auto argumentEnd = i.target;
+
+			d = static_cast<const ApiCall*>(i.expression)->callWithArguments(&d, [&]()
+			{
+				execute(s, r, argumentStart, argumentEnd);
+			});
+
+			pc = argumentEnd;
+			break;
+		}
+		case OpCode::LogicalAnd:		if (!d) { d = false; pc = i.target; } break;
+		case OpCode::LogicalOr:			if (d) { d = true; pc = i.target; } break;
+		case OpCode::ToBool:			d = (bool)d; break;
+		case OpCode::JumpIfFalse:		if (!d) pc = i.target; break;
+		case OpCode::Jump:				pc = i.target; break;
+		case OpCode::numOpCodes:		jassertfalse; break;
+		}
+	}
+}
+
+#undef NUMERIC_BINARY_OP
+
+struct BytecodeCompiler : public HiseJavascriptEngine::RootObject::OptimizationPass
+{
+	using Statement = HiseJavascriptEngine::RootObject::Statement;
+	using Expression = HiseJavascriptEngine::RootObject::Expression;
+	using CompiledExpression = HiseJavascriptEngine::RootObject::CompiledExpression;
+
+	String getPassName() const override { return "Bytecode Compiler"; }
+
+	bool takesOwnershipOfReplacedStatement() const override { return true; }
+
+	Statement* getOptimizedStatement(Statement* parentStatement, Statement* statementToOptimize) override
+	{
+		if (CompiledExpression::Builder::isCompileableRoot(statementToOptimize))
+		{
+			auto e = dynamic_cast<Expression*>(statementToOptimize);
+
+			CompiledExpression::Builder b;
+
+			if (b.compileRoot(e))
+				return new CompiledExpression(e, b.instructions);
+		}
+
+		return statementToOptimize;
+	}
+};
+
+void HiseJavascriptEngine::RootObject::HiseSpecialData::registerOptimisationPasses()
+{
+	bool shouldOptimize = false;
+
+#if USE_BACKEND
+
+	auto enable = GET_HISE_SETTING(processor->mainController->getMainSynthChain(), HiseSettings::Scripting::EnableOptimizations).toString();
+
+	shouldOptimize = enable == "1";
+
+	optimizations.add(new LocationInjector());
+
+#endif
+
+
+
+	if (shouldOptimize)
+	{
+		optimizations.add(new ConstantFolding());
+		optimizations.add(new BlockRemover());
+		optimizations.add(new FunctionInliner());
+	}
+
+#if HISE_USE_SCRIPT_BYTECODE_COMPILER
+
+	// This must be the last pass because it hides the compiled expression trees from the other passes.
+	if (shouldOptimize || !USE_BACKEND)
+		optimizations.add(new BytecodeCompiler());
+
+#endif
+}
+
+void HiseJavascriptEngine::enableBytecodeCompiler()
+{
+	auto& passes = root->hiseSpecialData.optimizations;
+
+	for (auto p : passes)
+	{
+		if (dynamic_cast<BytecodeCompiler*>(p) != nullptr)
+			return;
+	}
+
+	passes.add(new BytecodeCompiler());
+}
+
+} // namespace hise
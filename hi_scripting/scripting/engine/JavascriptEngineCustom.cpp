@@ -109,19 +109,31 @@ struct HiseJavascriptEngine::RootObject::ApiCall : public Expression
 	};
 
 	var getResult(const Scope& s) const override
+	{
+		var results[5];
+
+		return callWithArguments(results, [&]()
+		{
+			for (int i = 0; i < expectedNumArguments; i++)
+				results[i] = argumentList[i]->getResult(s);
+		});
+	}
+
+	/** Evaluates the arguments into the results array with the given function and calls the API function.
+	
+		Both happen in the scope of the audio thread guard suspender of this function.
+	*/
+	template <typename ArgumentEvaluator> var callWithArguments(var* results, const ArgumentEvaluator& evaluateArguments) const
 	{
 #if JUCE_ENABLE_AUDIO_GUARD
         const bool allowIllegalCalls = apiClass->allowIllegalCallsOnAudioThread(functionIndex);
 		AudioThreadGuard::Suspender suspender(allowIllegalCalls);
 #endif
 
-		var results[5];
-		for (int i = 0; i < expectedNumArguments; i++)
-		{
-			results[i] = argumentList[i]->getResult(s);
+		evaluateArguments();
 
+		for (int i = 0; i < expectedNumArguments; i++)
 			HiseJavascriptEngine::checkValidParameter(i, results[i], argumentList[i]->location);
-		}
 
 		CHECK_CONDITION_WITH_LOCATION(apiClass != nullptr, "API class does not exist");
 
@@ -987,30 +999,4 @@ struct FunctionInliner : public HiseJavascriptEngine::RootObject::OptimizationPa
 	}
 };
 
-void HiseJavascriptEngine::RootObject::HiseSpecialData::registerOptimisationPasses()
-{
-	bool shouldOptimize = false;
-
-#if USE_BACKEND
-
-	auto enable = GET_HISE_SETTING(processor->mainController->getMainSynthChain(), HiseSettings::Scripting::EnableOptimizations).toString();
-	
-	shouldOptimize = enable == "1";
-
-	optimizations.add(new LocationInjector());
-
-#endif
-
-
-
-	if (shouldOptimize)
-	{
-		optimizations.add(new ConstantFolding());
-		optimizations.add(new BlockRemover());
-		optimizations.add(new FunctionInliner());
-	}
-
-	
-}
-
 } // namespace hise
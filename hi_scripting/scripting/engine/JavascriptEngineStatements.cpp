@@ -108,7 +108,8 @@ struct HiseJavascriptEngine::RootObject::BlockStatement : public Statement
 		else
 		{
 			auto idx = statements.indexOf(childToReplace);
-			statements.set(idx, newStatement.release(), true);
+			statements.set(idx, newStatement.release(), false);
+			newStatement = childToReplace;
 			return true;
 		}
 	}
@@ -65,6 +65,9 @@ DspNetwork::DspNetwork(hise::ProcessorWithScriptingContent* p, ValueTree data_,
 #endif
 	parentHolder(dynamic_cast<Holder*>(p)),
 	projectNodeHolder(*this)
+#if HISE_INCLUDE_SNEX
+	, jitNodeHolder(*this)
+#endif
 {
 	jassert(data.getType() == PropertyIds::Network);
 
@@ -231,6 +234,11 @@ DspNetwork::DspNetwork(hise::ProcessorWithScriptingContent* p, ValueTree data_,
 	checkIfDeprecated();
 
 	runPostInitFunctions();
+
+#if HISE_INCLUDE_SNEX
+	// The SNEX nodes are compiled synchronously while the network is loaded
+	codeManager.logCompileCacheStatistics();
+#endif
 }
 
 DspNetwork::~DspNetwork()
@@ -463,6 +471,10 @@ void DspNetwork::reset()
 	
 	if (projectNodeHolder.isActive())
 		projectNodeHolder.n.reset();
+#if HISE_INCLUDE_SNEX
+	else if (jitNodeHolder.isActive())
+		jitNodeHolder.reset();
+#endif
 	else if (auto rn = getRootNode())
 		rn->reset();
 }
@@ -471,6 +483,10 @@ void DspNetwork::handleHiseEvent(HiseEvent& e)
 {
 	if (projectNodeHolder.isActive())
 		projectNodeHolder.n.handleHiseEvent(e);
+#if HISE_INCLUDE_SNEX
+	else if (jitNodeHolder.isActive())
+		jitNodeHolder.handleHiseEvent(e);
+#endif
 	else
 		getRootNode()->handleHiseEvent(e);
 }
@@ -496,6 +512,14 @@ void DspNetwork::process(ProcessDataDyn& data)
 
 	if (auto s = SimpleReadWriteLock::ScopedTryReadLock(getConnectionLock()))
 	{
+#if HISE_INCLUDE_SNEX
+		if (jitNodeHolder.isActive())
+		{
+			jitNodeHolder.process(data);
+			return;
+		}
+#endif
+
 		if (exceptionHandler.isOk())
 			getRootNode()->process(data);
 	}
@@ -540,14 +564,41 @@ void DspNetwork::prepareToPlay(double sampleRate, double blockSize)
 			{
 				currentSpecs.voiceIndex = getPolyHandler();
 
+#if HISE_USE_COMPACT_POLY_DATA
+				// ModulatorSynth::setVoiceLimit() prepares the network again when the limit changes
+				if (isPolyphonic() && getParentNetwork() == nullptr)
+					polyHandler.setVoiceLimit(getVoiceLimitForPolyData());
+#endif
+
+				polyHandler.resetMemoryStatistics();
+
 				getRootNode()->prepare(currentSpecs);
 
+#if USE_BACKEND
+				auto memory = polyHandler.getMemoryStatistics();
+
+				if (memory != lastReportedPolyDataMemory && memory.numBytesUncompacted > 0)
+				{
+					lastReportedPolyDataMemory = memory;
+
+					String message;
+					message << getId() << ": PolyData memory: " << String((double)memory.numBytesUsed / 1024.0, 1) << " KB";
+					message << " (" << String((double)memory.numBytesUncompacted / 1024.0, 1) << " KB without compaction)";
+					debugToConsole(dynamic_cast<Processor*>(getScriptProcessor()), message);
+				}
+#endif
+
 				runPostInitFunctions();
 
 				getRootNode()->reset();
 
 				if (projectNodeHolder.isActive())
 					projectNodeHolder.prepare(currentSpecs);
+
+#if HISE_INCLUDE_SNEX
+				if (jitNodeHolder.isActive())
+					jitNodeHolder.prepare(currentSpecs);
+#endif
 			}
             
             initialised = true;
@@ -559,6 +610,28 @@ void DspNetwork::prepareToPlay(double sampleRate, double blockSize)
 	}
 }
 
+int DspNetwork::getVoiceLimitForPolyData()
+{
+	auto p = dynamic_cast<Processor*>(getScriptProcessor());
+
+	if (p == nullptr)
+		return NUM_POLYPHONIC_VOICES;
+
+	auto synth = dynamic_cast<ModulatorSynth*>(p);
+
+	if (synth == nullptr)
+		synth = dynamic_cast<ModulatorSynth*>(ProcessorHelpers::findParentProcessor(p, true));
+
+	if (synth == nullptr)
+		return NUM_POLYPHONIC_VOICES;
+
+	auto multiplier = jmax(1.0f, p->getMainController()->getVoiceAmountMultiplier());
+	auto numVoices = roundToInt(synth->getAttribute(ModulatorSynth::VoiceLimit) * multiplier);
+
+	// Leave some room for the voices that are fading out after being stolen
+	return jmin(NUM_POLYPHONIC_VOICES, 2 * numVoices);
+}
+
 void DspNetwork::processBlock(var pData)
 {
 	if (auto ar = pData.getArray())
@@ -1147,6 +1220,11 @@ void DspNetwork::setUseFrozenNode(bool shouldBeEnabled)
 	if (projectNodeHolder.isActive() == shouldBeEnabled)
 		return;
 
+#if HISE_INCLUDE_SNEX
+	if (shouldBeEnabled)
+		setUseJitFrozenNode(false);
+#endif
+
 	if (shouldBeEnabled && currentSpecs)
 		projectNodeHolder.prepare(currentSpecs);
 
@@ -1162,14 +1240,74 @@ bool DspNetwork::hashMatches()
 void DspNetwork::setExternalData(const snex::ExternalData& d, int index)
 {
 	projectNodeHolder.n.setExternalData(d, index);
+
+#if HISE_INCLUDE_SNEX
+	if (jitNodeHolder.isActive())
+		jitNodeHolder.setExternalData(d, index);
+#endif
 }
 
+#if HISE_INCLUDE_SNEX
+Result DspNetwork::setUseJitFrozenNode(bool shouldBeEnabled)
+{
+	if (jitNodeHolder.isActive() == shouldBeEnabled)
+		return Result::ok();
+
+	ScopedPointer<snex::jit::GlobalScope> newScope;
+	snex::jit::JitCompiledNode::Ptr newNode;
+
+	if (shouldBeEnabled)
+	{
+		if (projectNodeHolder.isActive())
+			setUseFrozenNode(false);
+
+		auto r = jitNodeHolder.compile(newScope, newNode);
+
+		if (!r.wasOk())
+			return r;
+
+		if (currentSpecs && currentSpecs.numChannels >= newNode->getNumChannels())
+		{
+			newNode->prepare(currentSpecs);
+			newNode->reset();
+		}
+	}
+
+	auto oldHandler = getCurrentParameterHandler();
+
+	Array<float> parameterValues;
+
+	for (int i = 0; i < oldHandler->getNumParameters(); i++)
+		parameterValues.add(oldHandler->getParameter(i));
+
+	jitNodeHolder.swap(newScope, newNode);
+
+	// The old JIT object (if there was one) is destroyed here, outside the lock
+	newNode = nullptr;
+	newScope = nullptr;
+
+	auto newHandler = getCurrentParameterHandler();
+
+	for (int i = 0; i < jmin(parameterValues.size(), newHandler->getNumParameters()); i++)
+		newHandler->setParameter(i, parameterValues[i]);
+
+	reset();
+
+	return Result::ok();
+}
+#endif
+
 hise::ScriptParameterHandler* DspNetwork::getCurrentParameterHandler()
 {
 	if (projectNodeHolder.isActive())
 		return &projectNodeHolder;
-	else
-		return &networkParameterHandler;
+
+#if HISE_INCLUDE_SNEX
+	if (jitNodeHolder.isActive())
+		return &jitNodeHolder;
+#endif
+
+	return &networkParameterHandler;
 }
 
 void DspNetwork::runPostInitFunctions()
@@ -1483,6 +1621,29 @@ juce::File DspNetwork::CodeManager::getCodeFolder() const
 	return f;
 }
 
+void DspNetwork::CodeManager::logCompileCacheStatistics()
+{
+	int numHits = 0;
+	int numCompilations = 0;
+	double millisecondsSaved = 0.0;
+
+	for (auto e : entries)
+	{
+		const auto& cache = e->wb->getCompileCache();
+		numHits += cache.getNumHits();
+		numCompilations += cache.getNumCompilations();
+		millisecondsSaved += cache.getMillisecondsSaved();
+	}
+
+	if (numHits == 0)
+		return;
+
+	String message;
+	message << "Compile cache for " << parent.getId() << ": ";
+	message << snex::ui::WorkbenchData::CompileCache::createStatistics(numHits, numCompilations, millisecondsSaved);
+	debugToConsole(dynamic_cast<Processor*>(parent.getScriptProcessor()), message);
+}
+
 DspNetwork::CodeManager::SnexSourceCompileHandler::SnexSourceCompileHandler(snex::ui::WorkbenchData* d, ProcessorWithScriptingContent* sp_) :
 	Thread("SNEX Compile Thread", HISE_DEFAULT_STACK_SIZE),
 	CompileHandler(d),
@@ -1692,6 +1853,129 @@ void DspNetwork::ProjectNodeHolder::init(dll::StaticLibraryHostFactory* staticLi
 	}
 }
 
+#if HISE_INCLUDE_SNEX
+struct CodeLibraryProvider : public snex::cppgen::ValueTreeBuilder::CodeProvider
+{
+	CodeLibraryProvider(const File& codeFolder_) :
+		codeFolder(codeFolder_)
+	{}
+
+	String getCode(const snex::NamespacedIdentifier& path, const Identifier& classId) const override
+	{
+		auto f = codeFolder.getChildFile(path.getIdentifier().toString()).getChildFile(classId.toString()).withFileExtension("h");
+		return f.loadFileAsString();
+	}
+
+	const File codeFolder;
+};
+
+Result DspNetwork::JitNodeHolder::compile(ScopedPointer<snex::jit::GlobalScope>& newScope, snex::jit::JitCompiledNode::Ptr& newNode)
+{
+	using namespace snex::cppgen;
+
+	auto rootTree = network.getValueTree().getChildWithName(PropertyIds::Node);
+
+	if (!rootTree.isValid())
+		return Result::fail("The network doesn't have a root node");
+
+	ValueTreeBuilder builder(rootTree, ValueTreeBuilder::Format::JitCompiledInstance);
+	builder.setOutputFormat(ValueTreeBuilder::Format::JitCompiledInstance);
+	builder.setCodeProvider(new CodeLibraryProvider(network.codeManager.getCodeFolder()));
+
+	auto br = builder.createCppCode();
+
+	if (br.r.failed())
+		return br.r;
+
+	if (!br.faustClassIds->empty())
+		return Result::fail("Faust nodes can't be compiled with SNEX");
+
+	newScope = new snex::jit::GlobalScope();
+	newScope->setPolyphonic(network.isPolyphonic());
+
+	for (auto o : snex::jit::OptimizationIds::getDefaultIds())
+		newScope->addOptimization(o);
+
+	snex::jit::Compiler::Ptr compiler = new snex::jit::Compiler(*newScope);
+
+	auto numChannels = ValueTreeBuilder::getRootChannelAmount(rootTree);
+
+	newNode = new snex::jit::JitCompiledNode(*compiler, br.code, rootTree[PropertyIds::ID].toString(), numChannels);
+
+	if (newNode->r.failed())
+	{
+		auto r = newNode->r;
+		newNode = nullptr;
+		newScope = nullptr;
+		return r;
+	}
+
+	return Result::ok();
+}
+
+void DspNetwork::JitNodeHolder::swap(ScopedPointer<snex::jit::GlobalScope>& newScope, snex::jit::JitCompiledNode::Ptr& newNode)
+{
+	ParameterDataList newParameters;
+
+	if (newNode != nullptr)
+		newParameters.addArray(newNode->getParameterList());
+
+	SimpleReadWriteLock::ScopedWriteLock sl(nodeLock);
+
+	std::swap(scope, newScope);
+	std::swap(node, newNode);
+	parameters.swapWith(newParameters);
+	memset(parameterValues, 0, sizeof(parameterValues));
+}
+
+void DspNetwork::JitNodeHolder::prepare(PrepareSpecs ps)
+{
+	SimpleReadWriteLock::ScopedReadLock sl(nodeLock);
+
+	if (node != nullptr && ps.numChannels >= node->getNumChannels())
+	{
+		node->prepare(ps);
+		node->reset();
+	}
+}
+
+void DspNetwork::JitNodeHolder::reset()
+{
+	SimpleReadWriteLock::ScopedReadLock sl(nodeLock);
+
+	if (node != nullptr)
+		node->reset();
+}
+
+void DspNetwork::JitNodeHolder::handleHiseEvent(HiseEvent& e)
+{
+	SimpleReadWriteLock::ScopedReadLock sl(nodeLock);
+
+	if (node != nullptr)
+		node->handleHiseEvent(e);
+}
+
+void DspNetwork::JitNodeHolder::setExternalData(const snex::ExternalData& d, int index)
+{
+	SimpleReadWriteLock::ScopedReadLock sl(nodeLock);
+
+	if (node != nullptr)
+		node->setExternalData(d, index);
+}
+
+void DspNetwork::JitNodeHolder::process(ProcessDataDyn& data)
+{
+	SimpleReadWriteLock::ScopedReadLock sl(nodeLock);
+
+	if (node == nullptr || data.getNumChannels() < node->getNumChannels())
+		return;
+
+	NodeProfiler np(network.getRootNode(), data.getNumSamples());
+
+	node->process(data);
+}
+#endif
+
 int HostHelpers::getNumMaxDataObjects(const ValueTree& v, snex::ExternalData::DataType t)
 {
 	auto id = Identifier(snex::ExternalData::getDataTypeName(t, false));
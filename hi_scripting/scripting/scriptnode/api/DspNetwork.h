@@ -553,6 +553,8 @@ public:
 			}
 
 			bool triggerCompilation() override;
+
+			bool canUseCompileCache() const override { return true; }
 			
 			/** This returns the mutex used for synchronising the compilation. 
 			
@@ -618,6 +620,11 @@ public:
 			return {};
 		}
 		
+		File getCodeFolder() const;
+
+		/** Prints the combined hit rate of the compile caches to the console if a compilation was reused. */
+		void logCompileCacheStatistics();
+
 		StringArray getClassList(const Identifier& id, const String& fileExtension = "*.h")
 		{
 			auto f = getCodeFolder();
@@ -694,8 +701,6 @@ public:
 
 		OwnedArray<Entry> entries;
 
-		File getCodeFolder() const;
-
 		DspNetwork& parent;
 	} codeManager;
 #endif
@@ -1003,6 +1008,21 @@ public:
 
 	bool hashMatches();
 
+#if HISE_INCLUDE_SNEX
+
+	/** Compiles the entire network into a single SNEX JIT object and processes this instead of the node tree.
+
+		This feeds the code of the C++ generator directly into the SNEX compiler, so you get rid of the
+		virtual calls and parameter indirections without having to export and compile a DLL. It returns an 
+		error if the network contains nodes that can't be compiled with SNEX. The compiled object is a
+		snapshot of the current network, so changes to the node tree require a recompilation.
+	*/
+	Result setUseJitFrozenNode(bool shouldBeEnabled);
+
+	bool isJitFrozen() const { return jitNodeHolder.isActive(); }
+
+#endif
+
 	void setExternalData(const snex::ExternalData & d, int index);
 
 	ScriptParameterHandler* getCurrentParameterHandler();
@@ -1102,6 +1122,13 @@ private:
 	snex::Types::DllBoundaryTempoSyncer tempoSyncer;
 	snex::Types::PolyHandler polyHandler;
 
+	/** Returns the amount of voice slots the PolyData containers need for the sound generator of this network. */
+	int getVoiceLimitForPolyData();
+
+#if USE_BACKEND
+	PolyHandler::MemoryStatistics lastReportedPolyDataMemory;
+#endif
+
 	SelectedItemSet<NodeBase::Ptr> selection;
 
 	struct SelectionUpdater : public ChangeListener
@@ -1244,6 +1271,62 @@ private:
 		bool loaded = false;
 		bool forwardToNode = false;
 	} projectNodeHolder;
+
+#if HISE_INCLUDE_SNEX
+	struct JitNodeHolder: public hise::ScriptParameterHandler
+	{
+		JitNodeHolder(DspNetwork& parent):
+			network(parent)
+		{}
+
+		Identifier getParameterId(int index) const override { return network.networkParameterHandler.getParameterId(index); }
+		int getNumParameters() const override { return parameters.size(); }
+
+		void setParameter(int index, float newValue) override
+		{
+			SimpleReadWriteLock::ScopedReadLock sl(nodeLock);
+
+			if (isPositiveAndBelow(index, parameters.size()))
+			{
+				parameterValues[index] = newValue;
+				parameters.getReference(index).callback.call((double)newValue);
+			}
+		}
+
+		float getParameter(int index) const override
+		{
+			if (isPositiveAndBelow(index, parameters.size()))
+				return parameterValues[index];
+
+			return 0.0f;
+		}
+
+		bool isActive() const { return node != nullptr; }
+
+		/** Creates the code for the current network state and compiles it. This doesn't touch the active node. */
+		Result compile(ScopedPointer<snex::jit::GlobalScope>& newScope, snex::jit::JitCompiledNode::Ptr& newNode);
+
+		/** Replaces the active node with the given one under the write lock. The previous node and scope
+			are moved into the arguments, so the caller can destroy them after the lock is released. */
+		void swap(ScopedPointer<snex::jit::GlobalScope>& newScope, snex::jit::JitCompiledNode::Ptr& newNode);
+
+		// The callbacks acquire the read lock and do nothing if the node was removed in the meantime
+
+		void prepare(PrepareSpecs ps);
+		void reset();
+		void handleHiseEvent(HiseEvent& e);
+		void setExternalData(const snex::ExternalData& d, int index);
+		void process(ProcessDataDyn& data);
+
+		DspNetwork& network;
+
+		SimpleReadWriteLock nodeLock;
+		ScopedPointer<snex::jit::GlobalScope> scope;
+		snex::jit::JitCompiledNode::Ptr node;
+		ParameterDataList parameters;
+		float parameterValues[OpaqueNode::NumMaxParameters] = { 0.0f };
+	} jitNodeHolder;
+#endif
     
 	JUCE_DECLARE_WEAK_REFERENCEABLE(DspNetwork);
 };
@@ -49,6 +49,7 @@ struct ScriptNetworkTest::Wrapper
 	API_METHOD_WRAPPER_0(ScriptNetworkTest, checkCompileHashCodes);
 	API_METHOD_WRAPPER_3(ScriptNetworkTest, createAsciiDiff);
 	API_METHOD_WRAPPER_0(ScriptNetworkTest, getDllInfo);
+	API_METHOD_WRAPPER_1(ScriptNetworkTest, runBenchmark);
 	API_VOID_METHOD_WRAPPER_2(ScriptNetworkTest, addRuntimeFunction);
 };
 
@@ -74,6 +75,7 @@ ScriptNetworkTest::ScriptNetworkTest(DspNetwork* n, var testData) :
 	ADD_API_METHOD_0(getListOfAllCompileableNodes);
 	ADD_API_METHOD_0(checkCompileHashCodes);
 	ADD_API_METHOD_0(getDllInfo);
+	ADD_API_METHOD_1(runBenchmark);
 	ADD_API_METHOD_2(addRuntimeFunction);
 }
 
@@ -172,6 +174,119 @@ juce::var ScriptNetworkTest::getDllInfo()
 	return mg->getStatistics();
 }
 
+juce::var ScriptNetworkTest::runBenchmark(int numBlocks)
+{
+	auto h = dynamic_cast<CHandler*>(wb->getCompileHandler());
+	auto n = h->network.get();
+
+	if (n == nullptr || numBlocks <= 0)
+		return var();
+
+	auto ps = h->getPrepareSpecs();
+
+	if (ps.sampleRate <= 0.0 || ps.blockSize <= 0)
+	{
+		ps.sampleRate = 44100.0;
+		ps.blockSize = 512;
+	}
+
+	const auto originalSpecs = n->getCurrentSpecs();
+	const bool wasFrozen = n->isFrozen();
+	const bool wasJitFrozen = n->isJitFrozen();
+
+	DynamicObject::Ptr results = new DynamicObject();
+	AudioSampleBuffer reference;
+
+	auto measure = [&](const Identifier& id)
+	{
+		n->setNumChannels(ps.numChannels);
+		n->prepareToPlay(ps.sampleRate, ps.blockSize);
+		n->reset();
+
+		AudioSampleBuffer b(ps.numChannels, ps.blockSize);
+		HiseEventBuffer events;
+		Random r(0);
+
+		double milliseconds = 0.0;
+
+		for (int i = 0; i < numBlocks; i++)
+		{
+			for (int c = 0; c < b.getNumChannels(); c++)
+			{
+				auto ptr = b.getWritePointer(c);
+
+				for (int s = 0; s < b.getNumSamples(); s++)
+					ptr[s] = r.nextFloat() * 2.0f - 1.0f;
+			}
+
+			ProcessDataDyn d(b.getArrayOfWritePointers(), b.getNumSamples(), b.getNumChannels());
+			d.setEventBuffer(events);
+
+			auto before = Time::getMillisecondCounterHiRes();
+			n->process(d);
+			milliseconds += Time::getMillisecondCounterHiRes() - before;
+		}
+
+		auto processedMilliseconds = 1000.0 * (double)(numBlocks * ps.blockSize) / ps.sampleRate;
+
+		DynamicObject::Ptr result = new DynamicObject();
+		result->setProperty("Milliseconds", milliseconds);
+		result->setProperty("RealtimeFactor", milliseconds > 0.0 ? processedMilliseconds / milliseconds : 0.0);
+
+		if (reference.getNumSamples() == 0)
+			reference.makeCopyOf(b);
+		else
+		{
+			float maxDeviation = 0.0f;
+
+			for (int c = 0; c < b.getNumChannels(); c++)
+			{
+				FloatVectorOperations::subtract(b.getWritePointer(c), reference.getReadPointer(c), b.getNumSamples());
+				maxDeviation = jmax(maxDeviation, b.getMagnitude(c, 0, b.getNumSamples()));
+			}
+
+			result->setProperty("MaxDeviation", maxDeviation);
+		}
+
+		results->setProperty(id, var(result.get()));
+	};
+
+	n->setUseFrozenNode(false);
+	n->setUseJitFrozenNode(false);
+	measure("Interpreted");
+
+	auto r = n->setUseJitFrozenNode(true);
+
+	if (r.wasOk())
+		measure("JitFrozen");
+	else
+		results->setProperty("JitFrozen", r.getErrorMessage());
+
+	n->setUseJitFrozenNode(false);
+
+	if (n->canBeFrozen())
+	{
+		n->setUseFrozenNode(true);
+		measure("DllFrozen");
+	}
+	else
+		results->setProperty("DllFrozen", "The node is not compiled in the project DLL");
+
+	n->setUseFrozenNode(wasFrozen);
+
+	if (wasJitFrozen)
+		n->setUseJitFrozenNode(true);
+
+	if (originalSpecs)
+	{
+		n->setNumChannels(originalSpecs.numChannels);
+		n->prepareToPlay(originalSpecs.sampleRate, originalSpecs.blockSize);
+		n->reset();
+	}
+
+	return var(results.get());
+}
+
 juce::var ScriptNetworkTest::runTest()
 {
 	wb->triggerRecompile();
@@ -202,6 +202,9 @@ struct ScriptNetworkTest : public hise::ConstScriptingObject
 	/** Returns an object containing the information about the project dll. */
 	var getDllInfo();
 
+	/** Processes the given amount of noise blocks with the interpreted, JIT frozen and DLL frozen network and returns the timings. */
+	var runBenchmark(int numBlocks);
+
 	// ================================================================================= API Methods
 
 private:
@@ -265,7 +265,7 @@ struct GlobalRoutingManager::DebugComponent : public Component,
 			g.drawRoundedRectangle(valueArea, valueArea.getHeight() / 2.0f, 1.0f);
 
 			valueArea = valueArea.reduced(3.0f);
-			valueArea = valueArea.removeFromLeft(jmax<float>(valueArea.getHeight(), valueArea.getWidth() * c->lastValue));
+			valueArea = valueArea.removeFromLeft(jmax<float>(valueArea.getHeight(), valueArea.getWidth() * (float)c->getLastValue()));
 
 			g.fillRoundedRectangle(valueArea, valueArea.getHeight() / 2.0f);
 		}
@@ -630,6 +630,9 @@ void GlobalRoutingManager::removeUnconnectedSlots(SlotBase::SlotType type)
 				didSomething = true;
 			}
 		}
+
+		if (didSomething)
+			updateBatchedCables();
 	}
 	else
 	{
@@ -675,6 +678,46 @@ juce::ReferenceCountedObjectPtr<scriptnode::routing::GlobalRoutingManager::SlotB
 	return newSlot;
 }
 
+void GlobalRoutingManager::setBlockRateBatching(SlotBase::Ptr cable, bool shouldBatch)
+{
+	if (auto c = dynamic_cast<Cable*>(cable.get()))
+	{
+		if (c->batched.exchange(shouldBatch) != shouldBatch)
+		{
+			updateBatchedCables();
+
+			// Deliver a value that was stored while the cable was batched
+			if (!shouldBatch)
+				c->flushPendingValue();
+		}
+	}
+}
+
+void GlobalRoutingManager::flushBatchedCables()
+{
+	batchedCables.read([](const ReferenceCountedArray<Cable>& list)
+	{
+		for (auto c : list)
+			c->flushPendingValue();
+	});
+}
+
+void GlobalRoutingManager::updateBatchedCables()
+{
+	ReferenceCountedArray<Cable> newList;
+
+	for (auto c : cables)
+	{
+		if (auto typed = dynamic_cast<Cable*>(c))
+		{
+			if (typed->isBlockRateBatched())
+				newList.add(typed);
+		}
+	}
+
+	batchedCables.publish(newList);
+}
+
 void GlobalRoutingManager::sendOSCError(const String& r)
 {
 	if (oscErrorHandler != nullptr)
@@ -1308,7 +1351,7 @@ struct GlobalCableNode::Editor : public SlotBaseEditor<GlobalCableNode>
 
 		if (auto s = getObject()->currentCable)
 		{
-			peakMeter.setPeak(s->lastValue, 0.0f);
+			peakMeter.setPeak((float)s->getLastValue(), 0.0f);
 		}
 
 		repaint();
@@ -1427,7 +1470,7 @@ void GlobalCableNode::updateConnection(Identifier id, var newValue)
 
 			if (currentCable->targets.isEmpty())
 			{
-				currentCable->lastValue = lastValue;
+				currentCable->setLastValueWithoutNotification(lastValue);
 			}
 
 			currentCable->addTarget(this);
@@ -1667,12 +1710,22 @@ GlobalRoutingManager::Cable::Cable(const String& id_) :
 
 bool GlobalRoutingManager::Cable::cleanup()
 {
+	SimpleReadWriteLock::ScopedWriteLock sl(lock);
+
+	bool didSomething = false;
+
 	for (int i = 0; i < targets.size(); i++)
 	{
 		if (targets[i] == nullptr)
+		{
 			targets.remove(i--);
+			didSomething = true;
+		}
 	}
 
+	if (didSomething)
+		updateTargetSnapshot();
+
 	return targets.isEmpty();
 }
 
@@ -1691,27 +1744,60 @@ scriptnode::routing::GlobalRoutingManager::SelectableTargetBase::List GlobalRout
 void GlobalRoutingManager::Cable::addTarget(CableTargetBase* n)
 {
 	SimpleReadWriteLock::ScopedWriteLock sl(lock);
-	targets.addIfNotAlreadyThere(n);
-	n->sendValue(lastValue);
+
+	if (targets.addIfNotAlreadyThere(n))
+		updateTargetSnapshot();
+
+	n->sendValue(getLastValue());
 }
 
 void GlobalRoutingManager::Cable::removeTarget(CableTargetBase* n)
 {
 	SimpleReadWriteLock::ScopedWriteLock sl(lock);
-	targets.removeAllInstancesOf(n);
+
+	if (targets.removeAllInstancesOf(n) > 0)
+		updateTargetSnapshot();
 }
 
 void GlobalRoutingManager::Cable::sendValue(CableTargetBase* source, double v)
 {
-	lastValue = jlimit(0.0, 1.0, v);
+	v = jlimit(0.0, 1.0, v);
+	lastValue.store(v);
 
-	for (auto t : targets)
+	if (batched.load())
 	{
-		if (t == source)
-			continue;
-
-		t->sendValue(lastValue);
+		pendingSource.store(source);
+		pending.store(true);
+		return;
 	}
+
+	sendToTargets(source, v);
+}
+
+void GlobalRoutingManager::Cable::flushPendingValue()
+{
+	if (pending.exchange(false))
+		sendToTargets(pendingSource.load(), getLastValue());
+}
+
+void GlobalRoutingManager::Cable::sendToTargets(CableTargetBase* source, double v)
+{
+	targetSnapshot.read([source, v](const CableTargetBase::List& list)
+	{
+		for (const auto& t : list)
+		{
+			if (auto typed = t.get())
+			{
+				if (typed != source)
+					typed->sendValue(v);
+			}
+		}
+	});
+}
+
+void GlobalRoutingManager::Cable::updateTargetSnapshot()
+{
+	targetSnapshot.publish(targets);
 }
 
 GlobalRoutingManager::Signal::Signal(const String& id_) :
@@ -1917,7 +2003,10 @@ void GlobalRoutingManager::addOSCTarget(SlotBase::Ptr p)
 					if (oc->sender != nullptr)
 						return;
 					else
-						c->targets.remove(i--);
+					{
+						c->removeTarget(oc);
+						i--;
+					}
 				}
 			}
 
@@ -126,6 +126,97 @@ struct GlobalRoutingManager: public ReferenceCountedObject
 		GlobalRoutingManager::Ptr manager;
 	};
 
+	/** A container for a list that is rebuilt on the message thread and iterated on the audio thread.
+
+		The writer swaps in an immutable copy and keeps the old one alive until no reader can use it,
+		so reading never locks or allocates. The readers are counted in two slots that alternate with
+		every publication: new readers always use the slot of the latest version, so the other slot 
+		drains even if there is always a reader active. A retired list is deleted by a later publication
+		as soon as both slots were seen empty after it was replaced.
+	*/
+	template <typename ListType> struct LockFreeSnapshot
+	{
+		LockFreeSnapshot() = default;
+
+		~LockFreeSnapshot()
+		{
+			delete current.load();
+		}
+
+		/** Calls f with the current list (if it was published). This is wait-free. */
+		template <typename F> void read(const F& f) const
+		{
+			auto& counter = numReaders[version.load() & 1];
+
+			++counter;
+
+			if (auto l = current.load())
+				f(*l);
+
+			--counter;
+		}
+
+		/** Publishes a copy of the given list. This can be called from multiple threads. */
+		void publish(const ListType& newList)
+		{
+			auto newCopy = new ListType(newList);
+
+			ScopedLock sl(writeLock);
+
+			if (auto old = current.exchange(newCopy))
+				retired.add(new RetiredList(old));
+
+			++version;
+
+			// A reader that increments a counter after this check will already see the new list
+			for (int slot = 0; slot < 2; slot++)
+			{
+				if (numReaders[slot].load() == 0)
+				{
+					for (auto r : retired)
+						r->drained[slot] = true;
+				}
+			}
+
+			for (int i = retired.size() - 1; i >= 0; i--)
+			{
+				if (retired[i]->drained[0] && retired[i]->drained[1])
+					retired.remove(i);
+			}
+		}
+
+		/** Returns the number of publications so far. */
+		uint32 getVersion() const { return version.load(); }
+
+		/** Returns the number of old lists that are kept alive for the readers. */
+		int getNumRetiredLists() const
+		{
+			ScopedLock sl(writeLock);
+			return retired.size();
+		}
+
+	private:
+
+		struct RetiredList
+		{
+			RetiredList(ListType* l) :
+				list(l)
+			{}
+
+			ScopedPointer<ListType> list;
+			bool drained[2] = { false, false };
+		};
+
+		mutable std::atomic<int> numReaders[2] = { {0}, {0} };
+		std::atomic<ListType*> current = { nullptr };
+		std::atomic<uint32> version = { 0 };
+
+		mutable CriticalSection writeLock;
+		OwnedArray<RetiredList> retired;
+
+		JUCE_DECLARE_NON_COPYABLE(LockFreeSnapshot);
+	};
+
 	struct SlotBase: public ReferenceCountedObject
 	{
 		using Ptr = ReferenceCountedObjectPtr<SlotBase>;
@@ -167,11 +258,36 @@ struct GlobalRoutingManager: public ReferenceCountedObject
 		void addTarget(CableTargetBase* n);
 		void removeTarget(CableTargetBase* n);
 
+		/** Sends the value to all targets except the source. If the cable is batched, the value is just stored
+			and will be sent once at the start of the next audio block. 
+		*/
 		void sendValue(CableTargetBase* source, double v);
-		double getLastValue() const { return lastValue; }
+		double getLastValue() const { return lastValue.load(); }
+
+		/** Changes the value without notifying any targets. */
+		void setLastValueWithoutNotification(double v) { lastValue.store(jlimit(0.0, 1.0, v)); }
+
+		bool isBlockRateBatched() const { return batched.load(); }
+
+		/** Sends the last value to the targets if it has changed since the last flush. */
+		void flushPendingValue();
 
-		double lastValue = 0.0;
+		/** The target list for the message thread. Use addTarget() / removeTarget() to change it. */
 		CableTargetBase::List targets;
+
+	private:
+
+		friend struct GlobalRoutingManager;
+
+		void sendToTargets(CableTargetBase* source, double v);
+		void updateTargetSnapshot();
+
+		std::atomic<double> lastValue = { 0.0 };
+		std::atomic<bool> batched = { false };
+		std::atomic<bool> pending = { false };
+		std::atomic<CableTargetBase*> pendingSource = { nullptr };
+
+		LockFreeSnapshot<CableTargetBase::List> targetSnapshot;
 	};
 
 	struct Signal: public SlotBase
@@ -229,6 +345,17 @@ struct GlobalRoutingManager: public ReferenceCountedObject
 
 	ReferenceCountedObjectPtr<SlotBase> getSlotBase(const String& id, SlotBase::SlotType t);
 
+	/** Enables block-rate batching for the given cable. A batched cable only stores the values that are 
+		sent to it and delivers the last one once per audio block, which saves a lot of callbacks if a 
+		cable is modulated at a high rate. 
+	*/
+	void setBlockRateBatching(SlotBase::Ptr cable, bool shouldBatch);
+
+	/** Sends the pending values of all batched cables. This is called by the audio callback before 
+		the processing of each block. 
+	*/
+	void flushBatchedCables();
+
 	SlotBase::List signals, cables;
 
 	LambdaBroadcaster<SlotBase::SlotType, IdList> listUpdater;
@@ -273,6 +400,12 @@ struct GlobalRoutingManager: public ReferenceCountedObject
 	OSCBase::Ptr sender;
 	OSCBase::Ptr receiver;
 
+private:
+
+	void updateBatchedCables();
+
+	LockFreeSnapshot<ReferenceCountedArray<Cable>> batchedCables;
+
 	JUCE_DECLARE_WEAK_REFERENCEABLE(GlobalRoutingManager);
 };
 
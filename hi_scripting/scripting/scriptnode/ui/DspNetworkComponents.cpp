@@ -217,6 +217,7 @@ juce::Path DspNetworkPathFactory::createPath(const String& url) const
     LOAD_PATH_IF_URL("save", SampleMapIcons::saveSampleMap);
     LOAD_PATH_IF_URL("export", SampleMapIcons::monolith);
 	LOAD_PATH_IF_URL("debug", SnexIcons::bugIcon);
+	LOAD_PATH_IF_URL("jit", SnexIcons::optimizeIcon);
 #endif
 
 	return p;
@@ -1285,6 +1286,22 @@ bool DspNetworkGraph::Actions::toggleFreeze(DspNetworkGraph& g)
 
 
 
+bool DspNetworkGraph::Actions::toggleJitFreeze(DspNetworkGraph& g)
+{
+#if HISE_INCLUDE_SNEX
+	auto r = g.network->setUseJitFrozenNode(!g.network->isJitFrozen());
+
+	if (!r.wasOk())
+		PresetHandler::showMessageWindow("JIT compilation failed", r.getErrorMessage(), PresetHandler::IconType::Error);
+
+	g.repaint();
+	return true;
+#else
+	ignoreUnused(g);
+	return false;
+#endif
+}
+
 bool DspNetworkGraph::Actions::save(DspNetworkGraph& g)
 {
 #if USE_BACKEND
@@ -2585,6 +2602,10 @@ void DspNetworkGraph::WrapperWithMenuBar::rebuildAfterContentChange()
 	if(n->canBeFrozen())
 		addButton("export");
 
+#if HISE_INCLUDE_SNEX
+	addButton("jit");
+#endif
+
 	addButton("zoom");
 
 	addBookmarkComboBox();
@@ -2703,6 +2724,12 @@ void DspNetworkGraph::WrapperWithMenuBar::addButton(const String& name)
 			}
 		};
 	}
+	if (name == "jit")
+	{
+		b->actionFunction = Actions::toggleJitFreeze;
+		b->stateFunction = [](DspNetworkGraph& g) { return g.network->isJitFrozen(); };
+		b->setTooltip("Compile the network into a single SNEX JIT object");
+	}
 	if (name == "swap-orientation")
 	{
 		b->actionFunction = Actions::swapOrientation;
@@ -768,6 +768,7 @@ public:
 
 		static bool toggleBypass(DspNetworkGraph& g);
 		static bool toggleFreeze(DspNetworkGraph& g);
+		static bool toggleJitFreeze(DspNetworkGraph& g);
 
 		static bool toggleProbe(DspNetworkGraph& g);
 		static bool setRandomColour(DspNetworkGraph& g);
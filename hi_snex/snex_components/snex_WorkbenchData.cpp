@@ -208,7 +208,20 @@ bool ui::WorkbenchData::handleCompilation()
 		if (getGlobalScope().getBreakpointHandler().shouldAbort())
 			return true;
 
-		lastCompileResult = compileHandler->compile(s);
+		String cacheKey;
+
+		if (compileHandler->canUseCompileCache())
+			cacheKey = CompileCache::createKey(*this, s);
+
+		if (cacheKey.isEmpty() || !compileCache.restore(cacheKey, lastCompileResult))
+		{
+			auto start = Time::getMillisecondCounterHiRes();
+
+			lastCompileResult = compileHandler->compile(s);
+
+			if (cacheKey.isNotEmpty())
+				compileCache.store(cacheKey, lastCompileResult, Time::getMillisecondCounterHiRes() - start);
+		}
 
 		callAsyncWithSafeCheck([](WorkbenchData* d) { d->postCompile(); });
 
@@ -226,6 +239,85 @@ bool ui::WorkbenchData::handleCompilation()
 
 
 
+String ui::WorkbenchData::CompileCache::createKey(WorkbenchData& wb, const String& preprocessedCode)
+{
+	auto& gs = wb.getGlobalScope();
+
+	String key;
+	key << preprocessedCode;
+	key << "#channels:" << wb.numChannels;
+	key << "#poly:" << (int)gs.getPolyHandler()->isEnabled();
+	key << "#debug:" << (int)gs.isDebugModeEnabled();
+	key << "#opt:" << gs.getOptimizationPassList().joinIntoString(",");
+
+	for (const auto& d : gs.getPreprocessorDefinitions())
+		key << "#" << d.name << "=" << d.value;
+
+	return key;
+}
+
+bool ui::WorkbenchData::CompileCache::restore(const String& key, CompileResult& r)
+{
+	auto hash = key.hashCode64();
+
+	for (const auto& e : entries)
+	{
+		// The hash is just a shortcut, the key must match completely
+		if (e.hash == hash && e.key == key)
+		{
+			r = e.result;
+			numHits++;
+			millisecondsSaved += e.compileTime;
+			return true;
+		}
+	}
+
+	return false;
+}
+
+void ui::WorkbenchData::CompileCache::store(const String& key, const CompileResult& r, double compileTimeMilliseconds)
+{
+	numCompilations++;
+
+	if (!r.compiledOk())
+		return;
+
+	Entry e;
+	e.hash = key.hashCode64();
+	e.key = key;
+	e.result = r;
+	e.compileTime = compileTimeMilliseconds;
+
+	if (entries.size() >= MaxNumEntries)
+		entries.remove(0);
+
+	entries.add(e);
+}
+
+void ui::WorkbenchData::CompileCache::clear()
+{
+	entries.clear();
+	numHits = 0;
+	numCompilations = 0;
+	millisecondsSaved = 0.0;
+}
+
+String ui::WorkbenchData::CompileCache::getStatistics() const
+{
+	return createStatistics(numHits, numCompilations, millisecondsSaved);
+}
+
+String ui::WorkbenchData::CompileCache::createStatistics(int numHits, int numCompilations, double millisecondsSaved)
+{
+	auto numRequests = numHits + numCompilations;
+	auto hitRate = numRequests > 0 ? roundToInt(100.0 * (double)numHits / (double)numRequests) : 0;
+
+	String s;
+	s << numHits << " of " << numRequests << " compilations reused (" << hitRate << "%), ";
+	s << String(millisecondsSaved, 1) << "ms saved";
+	return s;
+}
+
 snex::ui::WorkbenchData::Ptr ui::WorkbenchManager::getWorkbenchDataForCodeProvider(WorkbenchData::CodeProvider* p, bool ownCodeProvider)
 {
 	ScopedPointer<WorkbenchData::CodeProvider> owned = p;
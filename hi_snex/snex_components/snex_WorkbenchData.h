@@ -339,6 +339,58 @@ public:
 		void* dataPtr = nullptr;
 	};
 
+	/** A small cache that keeps the results of the last compilations of a workbench.
+
+		Loading a network calls triggerRecompile() for every node that uses the same class,
+		so if neither the code nor the compiler settings have changed, the workbench reuses
+		the last result instead of running the entire compilation again. The results can't
+		be shared between workbenches (or written to disk) because the generated code refers
+		to the data of the global scope (eg. the voice index of the PolyHandler).
+	*/
+	struct CompileCache
+	{
+		/** Creates the key from the preprocessed code and the current compiler settings. */
+		static String createKey(WorkbenchData& wb, const String& preprocessedCode);
+
+		/** Copies the cached result for the given key into r and returns true if it was found. */
+		bool restore(const String& key, CompileResult& r);
+
+		/** Adds the result to the cache (failed compilations will not be stored). */
+		void store(const String& key, const CompileResult& r, double compileTimeMilliseconds);
+
+		/** Removes all entries and resets the statistics. */
+		void clear();
+
+		int getNumEntries() const { return entries.size(); }
+
+		/** Returns a description of the hit rate and the time that was saved. */
+		String getStatistics() const;
+
+		/** Creates the description of getStatistics() for the combined values of multiple caches. */
+		static String createStatistics(int numHits, int numCompilations, double millisecondsSaved);
+
+		int getNumHits() const { return numHits; }
+		int getNumCompilations() const { return numCompilations; }
+		double getMillisecondsSaved() const { return millisecondsSaved; }
+
+	private:
+
+		struct Entry
+		{
+			int64 hash = 0;
+			String key;
+			CompileResult result;
+			double compileTime = 0.0;
+		};
+
+		static constexpr int MaxNumEntries = 4;
+
+		Array<Entry> entries;
+		int numHits = 0;
+		int numCompilations = 0;
+		double millisecondsSaved = 0.0;
+	};
+
 	struct TestRunnerBase
 	{
 		struct ParameterEvent
@@ -912,6 +964,12 @@ public:
 			
 		}
 
+		/** Override this and return true if compile() has no side effects apart from
+		    the returned CompileResult. The workbench will then reuse the cached result
+			if the code and the compiler settings didn't change.
+		*/
+		virtual bool canUseCompileCache() const { return false; }
+
 		virtual Compiler::Ptr createCompiler()
 		{
 			auto p = getParent();
@@ -1170,6 +1228,8 @@ public:
 
 	CompileResult& getLastResultReference() { return lastCompileResult; }
 
+	const CompileCache& getCompileCache() const { return compileCache; }
+
 	JitObject getLastJitObject() const { return lastCompileResult.obj; }
 	String getLastAssembly() const { return lastCompileResult.assembly; }
 
@@ -1196,6 +1256,7 @@ public:
 
 	void setCodeProvider(CodeProvider* newCodeProvider, NotificationType recompile=dontSendNotification)
 	{
+		compileCache.clear();
 		codeProvider = newCodeProvider;
 		codeProvider->parent = this;
 
@@ -1205,6 +1266,7 @@ public:
 
 	void setCompileHandler(CompileHandler* ownedNewCompileHandler, NotificationType recompile = dontSendNotification)
 	{
+		compileCache.clear();
 		compileHandler = ownedNewCompileHandler;
 
 		if (recompile != dontSendNotification)
@@ -1263,6 +1325,7 @@ private:
 	ScopedPointer<CompileHandler> compileHandler;
 	TestData currentTestData;
 	CompileResult lastCompileResult;
+	CompileCache compileCache;
 
 	Array<WeakReference<Listener>> listeners;
 
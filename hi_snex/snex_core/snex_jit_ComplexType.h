@@ -138,6 +138,7 @@ template <int BitLength> struct ConstDataBase
     uint32_t values[NumU32];
 };
 
+using Data256 = ConstDataBase<256>;
 using Data128 = ConstDataBase<128>;
 using Data64 = ConstDataBase<64>;
 
@@ -656,6 +656,14 @@ struct ValueTreeBuilder: public Base
 		codeProvider = p;
 	}
 
+	/** The constructor always creates the C++ code for the DLL export. Call this
+	    before createCppCode() if you need the glue code for another format. */
+	void setOutputFormat(Format newFormat)
+	{
+		outputFormat = newFormat;
+		setHeaderForFormat();
+	}
+
 	static Result cleanValueTreeIds(ValueTree& vToClean);
 
 	void addAudioFileProvider(hise::MultiChannelAudioBuffer::DataProvider* p)
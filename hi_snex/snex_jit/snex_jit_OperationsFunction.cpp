@@ -1461,7 +1461,7 @@ void Operations::FunctionCall::addDefaultParameterExpressions(const FunctionData
 bool Operations::FunctionCall::isVectorOpFunction() const
 {
 	return findParentStatementOfType<VectorOp>(this) != nullptr &&
-		   VectorOp::getFunctionSignatureId(function.id.getIdentifier().toString(), false) != 0;
+		   VectorOp::getFunctionSignatureId(function.id.getIdentifier().toString(), VectorOp::SimdWidth::Scalar) != 0;
 }
 
 void Operations::FunctionCall::adjustBaseClassPointer(BaseCompiler* compiler, BaseScope* scope)
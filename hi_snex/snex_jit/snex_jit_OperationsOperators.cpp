@@ -591,7 +591,7 @@ struct Operations::VectorOp::SerialisedVectorOp : public ReferenceCountedObject
 		auto fc = as<FunctionCall>(s);
 		String id = fc != nullptr ? fc->function.id.getIdentifier().toString() : "";
 
-		if (getFunctionSignatureId(id, false) != 0)
+		if (getFunctionSignatureId(id, SimdWidth::Scalar) != 0)
 		{
 			readerType = Type::VectorFunction;
 			opType = id.getCharPointer();
@@ -610,7 +610,7 @@ struct Operations::VectorOp::SerialisedVectorOp : public ReferenceCountedObject
 			if (s->isConstExpr())
 			{
 				readerType = Type::ImmediateScalar;
-				auto immValue = s->getConstExprValue().toFloat();
+				immValue = s->getConstExprValue().toFloat();
 				dbgString << "imm " << String(immValue);
 
                 auto cv = Data128::fromF32(immValue);
@@ -756,7 +756,7 @@ struct Operations::VectorOp::SerialisedVectorOp : public ReferenceCountedObject
 
 		if (auto fc = as<FunctionCall>(p))
 		{
-			if (getFunctionSignatureId(fc->function.id.getIdentifier().toString(), false) != 0)
+			if (getFunctionSignatureId(fc->function.id.getIdentifier().toString(), SimdWidth::Scalar) != 0)
 				return fc->getSubRegister(0);
 			else
 				return fc->reg;
@@ -804,16 +804,45 @@ struct Operations::VectorOp::SerialisedVectorOp : public ReferenceCountedObject
 			c->safeCheckPtrs(cc, loopEnd);
 	}
 
-	void process(x86::Compiler& cc, bool isSimd)
+	/** Creates the 256 bit constants and broadcasts the scalar values before entering the AVX loop. */
+	void prepareAVX(x86::Compiler& cc)
 	{
 		for (auto c : childOps)
-			c->process(cc, isSimd);
+			c->prepareAVX(cc);
+
+		if (readerType == Type::ImmediateScalar)
+		{
+			auto cv = Data256::fromF32(immValue);
+			wideConst = cc.newConst(ConstPoolScope::kGlobal, cv.getData(), cv.size());
+		}
+		else if (readerType == Type::VectorFunction && String(opType) == "abs")
+		{
+			auto cv = Data256::fromU32(0x7fffffff);
+			wideConst = cc.newConst(ConstPoolScope::kGlobal, cv.getData(), cv.size());
+		}
+		else if (readerType == Type::ScalarVariable)
+		{
+			wideReg = cc.newYmmPs();
+			cc.vbroadcastss(wideReg, dataReg);
+		}
+	}
+
+	void process(x86::Compiler& cc, SimdWidth width)
+	{
+		for (auto c : childOps)
+			c->process(cc, width);
 
 		if (isVectorType() || isFunction())
 		{
 			if (readerType == Type::VectorVariable)
 			{
-				if (isSimd)
+				if (width == SimdWidth::AVX)
+				{
+					wideReg = cc.newYmmPs();
+					cc.setInlineComment("Load data from address");
+					cc.vmovups(wideReg, x86::ptr(addressReg));
+				}
+				else if (width == SimdWidth::SSE)
 				{
 					dataReg = cc.newXmmPs();
 					cc.setInlineComment("Load data from address");
@@ -829,11 +858,16 @@ struct Operations::VectorOp::SerialisedVectorOp : public ReferenceCountedObject
 
 			if (isOp())
 			{
-				emitOp(cc, isSimd);
+				if (width == SimdWidth::AVX)
+					emitAVXOp(cc);
+				else
+					emitOp(cc, width == SimdWidth::SSE);
 
 				if (!isFunction())
 				{
-					if (isSimd)
+					if (width == SimdWidth::AVX)
+						cc.vmovups(x86::ptr(addressReg), getWideRegToUse());
+					else if (width == SimdWidth::SSE)
 						cc.movaps(x86::ptr(addressReg), getDataRegToUse());
 					else
 						cc.movss(x86::ptr(addressReg), getDataRegToUse());
@@ -842,16 +876,16 @@ struct Operations::VectorOp::SerialisedVectorOp : public ReferenceCountedObject
 		}
 	}
 
-	void incAdress(x86::Compiler& cc, bool isSimd)
+	void incAdress(x86::Compiler& cc, SimdWidth width)
 	{
 		if (isVectorType())
         {
-            int offset = isSimd ? 4 * sizeof(float) : sizeof(float);
+            int offset = (int)width * sizeof(float);
 			cc.add(addressReg, offset);
         }
 
 		for (auto c : childOps)
-			c->incAdress(cc, isSimd);
+			c->incAdress(cc, width);
 	}
 
 	String toString(int& intendation) const
@@ -884,7 +918,7 @@ private:
 	{
 		if (readerType == Type::VectorFunction)
 		{
-			if (getFunctionSignatureId(opType, false))
+			if (getFunctionSignatureId(opType, SimdWidth::Scalar))
 				return childOps[0]->getDataRegToUse();
 			else
 				jassertfalse;
@@ -899,11 +933,60 @@ private:
 		return dataReg;
 	}
 
-	
+	/** The 256 bit counterpart of getDataRegToUse(). */
+	x86::Ymm getWideRegToUse() const
+	{
+		if (readerType == Type::VectorFunction)
+			return childOps[0]->getWideRegToUse();
+		else if (isOp())
+			return childOps[1]->getWideRegToUse();
+
+		jassert(wideReg.isValid());
+		return wideReg;
+	}
+
+	void emitAVXOp(x86::Compiler& cc)
+	{
+		auto instId = getFunctionSignatureId(opType, SimdWidth::AVX);
+
+		if (instId == 0)
+		{
+			jassertfalse;
+			return;
+		}
+
+		auto r = childOps[0];
+		jassert(r != nullptr);
+
+		Operand source;
+
+		if (r->readerType == Type::ImmediateScalar)
+			source = r->wideConst;
+		else if (readerType == Type::VectorFunction)
+		{
+			bool isAbs = String(opType) == "abs";
+			r = isAbs ? this : childOps[1].get();
+
+			if (r->readerType == Type::ImmediateScalar || isAbs)
+				source = r->wideConst;
+			else
+				source = r->getWideRegToUse();
+		}
+		else
+			source = r->getWideRegToUse();
+
+		auto target = getWideRegToUse();
+
+		// The VEX encoded ops take the first source operand separately
+		if (instId == x86::Inst::kIdVmovups)
+			cc.emit(instId, target, source);
+		else
+			cc.emit(instId, target, target, source);
+	}
 
 	void emitOp(x86::Compiler& cc, bool isSimd)
 	{
-		auto instId = getFunctionSignatureId(opType, isSimd);
+		auto instId = getFunctionSignatureId(opType, isSimd ? SimdWidth::SSE : SimdWidth::Scalar);
 
 		if (instId != 0)
 		{
@@ -944,10 +1027,14 @@ private:
 	TokenType opType = JitTokens::void_;
 	String dbgString;
 
+	float immValue = 0.0f;
+
 	x86::Mem immConst;
+	x86::Mem wideConst;
 	x86::Gp  addressReg;
 	x86::Mem sizeMem;
 	x86::Xmm dataReg;
+	x86::Ymm wideReg;
 
 	List childOps;
 };
@@ -1025,7 +1112,7 @@ void Operations::VectorOp::emitVectorOp(BaseCompiler* compiler, BaseScope* scope
 		jassertfalse;
 
 		SerialisedVectorOp::Ptr root = new SerialisedVectorOp(this, cc);
-		root->process(cc, true);
+		root->process(cc, SimdWidth::SSE);
 
 		return;
 	}
@@ -1048,9 +1135,36 @@ void Operations::VectorOp::emitVectorOp(BaseCompiler* compiler, BaseScope* scope
 			root->safeCheckPtrs(cc, loopEnd);
 		}
 
-		if (scope->getGlobalScope()->getOptimizationPassList().contains(OptimizationIds::AutoVectorisation))
+		if (scope->getGlobalScope()->getOptimizationPassList().contains(OptimizationIds::AutoVectorisation) &&
+			scope->getGlobalScope()->isAVXAllowed() && canUseAVX())
 		{
-			static constexpr int SimdSize = 4;
+			static constexpr int SimdSize = (int)SimdWidth::AVX;
+
+			// The AVX loop uses unaligned loads and stores so there's
+			// no need for an alignment check here
+			cc.mov(sizeReg, root->getSizeMem());
+
+			cc.setInlineComment("Skip the AVX loop if i < 8");
+			cc.cmp(sizeReg, SimdSize);
+			cc.jb(leftOverLoop);
+
+			root->prepareAVX(cc);
+
+			cc.bind(simdLoop);
+
+			root->process(cc, SimdWidth::AVX);
+			root->incAdress(cc, SimdWidth::AVX);
+
+			cc.sub(sizeReg, SimdSize);
+			cc.cmp(sizeReg, SimdSize);
+			cc.jae(simdLoop);
+
+			// Clear the upper lanes to avoid the AVX-SSE transition penalty in the leftover loop
+			cc.vzeroupper();
+		}
+		else if (scope->getGlobalScope()->getOptimizationPassList().contains(OptimizationIds::AutoVectorisation))
+		{
+			static constexpr int SimdSize = (int)SimdWidth::SSE;
 
 			cc.xor_(sizeReg, sizeReg);
 			root->checkAlignment(cc, sizeReg);
@@ -1068,8 +1182,8 @@ void Operations::VectorOp::emitVectorOp(BaseCompiler* compiler, BaseScope* scope
 
 			cc.bind(simdLoop);
 
-			root->process(cc, true);
-			root->incAdress(cc, true);
+			root->process(cc, SimdWidth::SSE);
+			root->incAdress(cc, SimdWidth::SSE);
 
 			cc.sub(sizeReg, SimdSize);
 			cc.cmp(sizeReg, SimdSize);
@@ -1086,8 +1200,8 @@ void Operations::VectorOp::emitVectorOp(BaseCompiler* compiler, BaseScope* scope
 		cc.test(sizeReg, sizeReg);
 		cc.jz(loopEnd);
 
-		root->process(cc, false);
-		root->incAdress(cc, false);
+		root->process(cc, SimdWidth::Scalar);
+		root->incAdress(cc, SimdWidth::Scalar);
 
 		cc.dec(sizeReg);
 		cc.jmp(leftOverLoop);
@@ -1095,21 +1209,49 @@ void Operations::VectorOp::emitVectorOp(BaseCompiler* compiler, BaseScope* scope
 	}
 }
 
-juce::uint32 Operations::VectorOp::getFunctionSignatureId(const String& functionName, bool isSimd)
+struct VectorOpSignature
 {
-	HashMap<String, std::array<uint32, 2>> opMap;
+	const char* name;
+	uint32 ids[3];
+};
 
+juce::uint32 Operations::VectorOp::getFunctionSignatureId(const String& functionName, SimdWidth width)
+{
 	using namespace asmjit::x86;
 
-	opMap.set(JitTokens::plus, { Inst::kIdAddss, Inst::kIdAddps });
-	opMap.set(JitTokens::assign_, { Inst::kIdMovss, Inst::kIdMovaps });
-	opMap.set(JitTokens::times, { Inst::kIdMulss, Inst::kIdMulps });
-	opMap.set(JitTokens::minus, { Inst::kIdSubss, Inst::kIdSubps });
-	opMap.set("min", { Inst::kIdMinss, Inst::kIdMinps });
-	opMap.set("max", { Inst::kIdMaxss, Inst::kIdMaxps });
-	opMap.set("abs", { Inst::kIdAndps,  Inst::kIdAndps });
+	static const VectorOpSignature signatures[] =
+	{
+		{ JitTokens::plus,	  { Inst::kIdAddss, Inst::kIdAddps, Inst::kIdVaddps } },
+		{ JitTokens::assign_, { Inst::kIdMovss, Inst::kIdMovaps, Inst::kIdVmovups } },
+		{ JitTokens::times,	  { Inst::kIdMulss, Inst::kIdMulps, Inst::kIdVmulps } },
+		{ JitTokens::minus,	  { Inst::kIdSubss, Inst::kIdSubps, Inst::kIdVsubps } },
+		{ "min",			  { Inst::kIdMinss, Inst::kIdMinps, Inst::kIdVminps } },
+		{ "max",			  { Inst::kIdMaxss, Inst::kIdMaxps, Inst::kIdVmaxps } },
+		{ "abs",			  { Inst::kIdAndps, Inst::kIdAndps, Inst::kIdVandps } }
+	};
 
-	return opMap[functionName][(int)isSimd];
+	int index;
+
+	switch (width)
+	{
+	case SimdWidth::Scalar: index = 0; break;
+	case SimdWidth::SSE:	index = 1; break;
+	case SimdWidth::AVX:	index = 2; break;
+	default:				return 0;
+	}
+
+	for (const auto& s : signatures)
+	{
+		if (functionName == s.name)
+			return s.ids[index];
+	}
+
+	return 0;
+}
+
+bool Operations::VectorOp::canUseAVX()
+{
+	return SystemStats::hasAVX2();
 }
 
 void Operations::Increment::process(BaseCompiler* compiler, BaseScope* scope)
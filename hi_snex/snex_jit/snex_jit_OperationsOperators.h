@@ -137,7 +137,22 @@ struct Operations::VectorOp : public Expression
 
 	void process(BaseCompiler* compiler, BaseScope* scope) override;
 
-	static uint32 getFunctionSignatureId(const String& functionName, bool isSimd);
+	/** The number of float elements that are processed by a single loop iteration. */
+	enum class SimdWidth
+	{
+		Scalar = 1,
+		SSE = 4,
+		AVX = 8
+	};
+
+	static uint32 getFunctionSignatureId(const String& functionName, SimdWidth width);
+
+	/** Checks whether the vector loop can be emitted with 256 bit registers.
+
+		The code is generated on the machine that executes it, so this is just a
+		check of the host CPU features (the broadcast of scalar values requires AVX2).
+	*/
+	static bool canUseAVX();
 
 	struct SerialisedVectorOp;
 
@@ -292,6 +292,18 @@ private:
 	
 };
 
+/** Converts range based loops over float spans and dyn blocks into vector ops.
+
+	The conversion only works for loops where every iteration is independent from the
+	previous one. Loops over the frames of a FrameProcessor are not converted: the frame data
+	is interleaved, and the loop body usually calls processFrame() of the node chain, which
+	carries state from one frame to the next (filter history, oscillator phase, envelope state),
+	so the frames can't be computed in parallel lanes.
+	There is also no loop over voices to vectorise: polyphonic nodes render one voice per
+	callback and the PolyData slot is selected by the PolyHandler before the call.
+
+	The generated vector ops use AVX registers if the CPU supports it (see VectorOp::canUseAVX()).
+*/
 class LoopVectoriser : public OptimizationPass
 {
 	using Ptr = Operations::Statement::Ptr;
@@ -585,9 +585,19 @@ public:
 
 	bool isDebugModeEnabled() const { return debugMode; }
 
+	/** Allows the auto vectorisation to use 256 bit AVX registers if the CPU supports it.
+
+		This is enabled by default. If you disable it, the vector ops will use the 128 bit SSE
+		loop instead, which is useful for comparing both code paths on the same machine.
+	*/
+	void setAllowAVX(bool shouldAllowAVX) { allowAVX = shouldAllowAVX; }
+
+	bool isAVXAllowed() const { return allowAVX; }
+
 private:
 
 	bool debugMode = false;
+	bool allowAVX = true;
 
 	Array<Identifier> noInliners;
 
@@ -285,7 +285,7 @@ struct VectorTestObject
 class VectorOpTestCase: public VectorTestObject
 {
 public:
-	VectorOpTestCase(UnitTest& t_, const StringArray optimizationList, const String& line):
+	VectorOpTestCase(UnitTest& t_, const StringArray optimizationList, const String& line, bool allowAVX=true):
 		t(t_)
 	{
 		code = makeCode(line);
@@ -293,6 +293,8 @@ public:
 		for (auto o : optimizationList)
 			m.addOptimization(o);
 
+		m.setAllowAVX(allowAVX);
+
 
 		Compiler c(m);
 		Types::SnexObjectDatabase::registerObjects(c, 2);
@@ -537,6 +539,7 @@ public:
 		optimizations = {};
 		testOptimizations();
 		testInlining();
+		testAVXVectorOps();
 
 		runTestsWithOptimisation({});
 		runTestsWithOptimisation(OptimizationIds::getAllIds());
@@ -1663,6 +1666,61 @@ private:
 		testVectorOps({ OptimizationIds::AutoVectorisation, OptimizationIds::BinaryOpOptimisation, OptimizationIds::AsmOptimisation });
 	}
 
+	void testAVXVectorOps()
+	{
+		beginTest("Testing AVX vector ops against scalar code");
+
+		if (!SystemStats::hasAVX2())
+			logMessage("No AVX2 support, the AVX run will use the SSE loop");
+
+		const StringArray lines =
+		{
+			"a = Math.min(Math.max(a, 35.0f), 40.0f)",
+			"a *= (b - 80.0f) * s + (a - s + b)",
+			"a = Math.abs(a)",
+			"a = Math.abs(b) + (a * 12.0f)",
+			"a = Math.min(a, b)",
+			"a = Math.max(a, 12.0f) + b",
+			"a = s",
+			"a = 15.0f",
+			"a = b - 15.0f",
+			"a *= s",
+			"a += b",
+			"a = b + (a * b)"
+		};
+
+		// Covers sizes below, at and above multiples of the SSE and AVX width
+		const int sizes[] = { 1, 3, 4, 7, 8, 9, 15, 16, 17, 31, 64, 71 };
+
+		auto runLine = [&](const String& line, const StringArray& opt, bool useAVX, int size, int offset)
+		{
+			std::unique_ptr<VectorOpTestCase> t(new VectorOpTestCase(*this, opt, line, useAVX));
+			t->test(3.0f, size, offset, offset);
+			return t;
+		};
+
+		for (const auto& line : lines)
+		{
+			for (auto size : sizes)
+			{
+				for (int offset = 0; offset < 3; offset++)
+				{
+					String message;
+					message << line << ", size: " << String(size) << ", offset: " << String(offset);
+
+					auto scalar = runLine(line, {}, false, size, offset);
+					auto sse = runLine(line, { OptimizationIds::AutoVectorisation }, false, size, offset);
+					auto avx = runLine(line, { OptimizationIds::AutoVectorisation }, true, size, offset);
+					auto avxAsm = runLine(line, { OptimizationIds::AutoVectorisation, OptimizationIds::AsmOptimisation }, true, size, offset);
+
+					expect(*sse == *scalar, "SSE mismatch: " + message);
+					expect(*avx == *scalar, "AVX mismatch: " + message);
+					expect(*avxAsm == *scalar, "AVX with asm optimisation mismatch: " + message);
+				}
+			}
+		}
+	}
+
 	void testVectorOps(const StringArray& opt)
 	{
 		optimizations = opt;
@@ -3508,6 +3566,101 @@ private:
 
 static HiseJITUnitTest njut;
 
+class WorkbenchCompileCacheTest : public UnitTest
+{
+public:
+
+	WorkbenchCompileCacheTest() :
+		UnitTest("Testing SNEX compile cache", "snex")
+	{}
+
+	struct CountingCompileHandler : public ui::WorkbenchData::CompileHandler
+	{
+		CountingCompileHandler(ui::WorkbenchData* d) :
+			CompileHandler(d)
+		{}
+
+		ui::WorkbenchData::CompileResult compile(const String& codeToCompile) override
+		{
+			numCompilations++;
+
+			auto cc = createCompiler();
+
+			ui::WorkbenchData::CompileResult r;
+			r.obj = cc->compileJitObject(codeToCompile);
+			r.compileResult = cc->getCompileResult();
+			return r;
+		}
+
+		bool canUseCompileCache() const override { return true; }
+
+		void processTestParameterEvent(int, double) override {}
+		Result prepareTest(PrepareSpecs, const Array<ParameterEvent>&) override { return Result::ok(); }
+		void processTest(ProcessDataDyn&) override {}
+
+		int numCompilations = 0;
+	};
+
+	void runTest() override
+	{
+		beginTest("Testing hit, miss and invalidation");
+
+		ui::WorkbenchData::Ptr wb = new ui::WorkbenchData();
+
+		Value code("int test(int input) { return input + 1; }");
+
+		ScopedPointer<ui::WorkbenchData::CodeProvider> provider = new ui::WorkbenchData::ValueBasedCodeProvider(wb.get(), code, "test");
+
+		auto handler = new CountingCompileHandler(wb.get());
+		wb->setCodeProvider(provider);
+		wb->setCompileHandler(handler);
+
+		auto expectCompilations = [&](int expected, int expectedResult, const String& message)
+		{
+			wb->triggerRecompile();
+
+			expectEquals(handler->numCompilations, expected, message);
+			expect(wb->getLastResult().compiledOk(), message + ": compile error");
+
+			auto r = wb->getLastResult();
+			auto f = r.obj["test"];
+			expectEquals(f.call<int>(1), expectedResult, message + ": wrong result");
+		};
+
+		expectCompilations(1, 2, "first compilation");
+		expectCompilations(1, 2, "same code");
+
+		code.setValue("int test(int input) { return input + 2; }");
+		expectCompilations(2, 3, "changed code");
+
+		code.setValue("int test(int input) { return input + 1; }");
+		expectCompilations(2, 2, "restored code");
+
+		wb->getGlobalScope().addOptimization(OptimizationIds::AutoVectorisation);
+		expectCompilations(3, 2, "changed optimisations");
+
+		wb->setNumChannels(1);
+		expectEquals(handler->numCompilations, 4, "changed channel amount");
+
+		wb->setNumChannels(2);
+		expectEquals(handler->numCompilations, 4, "restored channel amount");
+
+		code.setValue("int test(int input) { return input +; }");
+		wb->triggerRecompile();
+		wb->triggerRecompile();
+		expectEquals(handler->numCompilations, 6, "failed compilations are not cached");
+
+		handler = new CountingCompileHandler(wb.get());
+		wb->setCompileHandler(handler);
+		expectEquals(wb->getCompileCache().getNumEntries(), 0, "new compile handler clears cache");
+
+		code.setValue("int test(int input) { return input + 1; }");
+		expectCompilations(1, 2, "compilation after clear");
+	}
+};
+
+static WorkbenchCompileCacheTest wcct;
+
 
 #undef CREATE_TEST
 #undef CREATE_TEST_SETUP
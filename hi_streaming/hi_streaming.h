@@ -87,6 +87,29 @@ Set this to true if you add this module to your existing C++ project and don't e
 #define STANDALONE_STREAMING 1
 #endif
 
+//=============================================================================
+/** Config: HISE_NUM_STREAMING_THREADS
+
+The number of threads that are used for streaming samples from the disk. The first thread is the sample loading thread
+which also executes all other background jobs, every additional thread will only pick up streaming jobs (sorted by urgency).
+*/
+#ifndef HISE_NUM_STREAMING_THREADS
+#define HISE_NUM_STREAMING_THREADS 1
+#endif
+
+/** Config: HISE_USE_MAPPED_PRELOAD_BUFFERS
+
+If enabled, the preload buffers of samples in uncompressed monoliths will point directly into the memory mapped file
+instead of copying the data. The pages are shared with the OS file cache (and other plugin instances that load the
+same library), which reduces the memory usage. Samples that are reversed or need a baked loop / crossfade are still copied.
+
+Every page of the preload buffer is read once when it is created so that the audio thread doesn't cause page faults,
+but the pages are not locked and the OS can evict them again under memory pressure.
+*/
+#ifndef HISE_USE_MAPPED_PRELOAD_BUFFERS
+#define HISE_USE_MAPPED_PRELOAD_BUFFERS 0
+#endif
+
 
 #include "hi_streaming/lockfree_fifo/readerwriterqueue.h"
 #include "hi_streaming/lockfree_fifo/concurrentqueue.h"
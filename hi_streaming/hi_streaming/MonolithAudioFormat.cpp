@@ -380,6 +380,22 @@ juce::AudioFormatReader* HlacMonolithInfo::createUserInterfaceReader(int sampleI
 	return nullptr;
 }
 
+const int16* HlacMonolithInfo::getMappedData(int sampleIndex, int channelIndex, int64 startSample, int numSamples) const
+{
+	if (isPositiveAndBelow(sampleIndex, sampleInfo.size()))
+	{
+		const auto& info = sampleInfo[sampleIndex];
+
+		if (startSample < 0 || startSample + numSamples > info.length)
+			return nullptr;
+
+		if (auto r = memoryReaders[getFileIndex(channelIndex, sampleIndex)])
+			return r->getMappedMonolithData({ info.start + startSample, info.start + startSample + numSamples });
+	}
+
+	return nullptr;
+}
+
 juce::AudioFormatReader* HlacMonolithInfo::createMonolithicReader(int sampleIndex, int channelIndex)
 {
 	if (isPositiveAndBelow(sampleIndex, sampleInfo.size()))
@@ -132,6 +132,9 @@ public:
 
 	int64 getMonolithOffset(int sampleIndex) const;
 
+	/** Returns the monolith file that contains the data of the given sample. */
+	File getFile(int channelIndex, int sampleIndex) const;
+
 	int getNumSamplesInMonolith() const;
 
 	int64 getMonolithLength(int sampleIndex) const;
@@ -144,14 +147,19 @@ public:
 	/** Use this for UI rendering stuff to avoid multithreading issues. */
 	AudioFormatReader* createUserInterfaceReader(int sampleIndex, int channelIndex);
 
+	/** Returns a pointer to the memory mapped data of the given sample range if the monolith is not compressed.
+	*
+	*	The data is interleaved and stays valid as long as this object exists. It returns nullptr if the monolith is compressed,
+	*	not mapped or if the range exceeds the length of the sample.
+	*/
+	const int16* getMappedData(int sampleIndex, int channelIndex, int64 startSample, int numSamples) const;
+
 	using Ptr = ReferenceCountedObjectPtr<HlacMonolithInfo>;
 
 private:
 
 	int getFileIndex(int channelIndex, int sampleIndex) const;
 
-	File getFile(int channelIndex, int sampleIndex) const;
-
 	struct SampleInfo
 	{
 		double sampleRate;
@@ -35,60 +35,387 @@ namespace hise { using namespace juce;
 
 struct SampleThreadPool::Pimpl
 {
-	Pimpl() :
+	/** The runtime state of each thread (index 0 is the sample loading thread). */
+	struct ThreadState
+	{
+		std::atomic<double> diskUsage = { 0.0 };
+		int64 startTime = 0, endTime = 0;
+		std::atomic<Job*> currentlyExecutedJob = { nullptr };
+		std::atomic<bool> idle = { false };
+	};
+
+	/** An additional thread that only executes jobs with a deadline. */
+	struct Worker : public Thread
+	{
+		Worker(Pimpl& parent_, int threadIndex_) :
+			Thread("Sample Streaming Thread " + String(threadIndex_), HISE_DEFAULT_STACK_SIZE),
+			parent(parent_),
+			threadIndex(threadIndex_)
+		{
+			startThread(9);
+		}
+
+		~Worker()
+		{
+			stopThread(1000);
+		}
+
+		void run() override
+		{
+			while (!threadShouldExit())
+			{
+				if (!parent.runNextJob(this, threadIndex))
+				{
+					parent.states[threadIndex]->idle.store(true);
+					wait(500);
+					parent.states[threadIndex]->idle.store(false);
+				}
+			}
+		}
+
+		Pimpl& parent;
+		const int threadIndex;
+	};
+
+	struct PendingJob
+	{
+		WeakReference<Job> job;
+		int deadline;
+		uint32 order;
+		uint32 generation;
+	};
+
+	struct DeadlineComparator
+	{
+		static int compareElements(const PendingJob& first, const PendingJob& second)
+		{
+			if (first.deadline != second.deadline)
+				return first.deadline < second.deadline ? -1 : 1;
+
+			if (first.order != second.order)
+				return first.order < second.order ? -1 : 1;
+
+			return 0;
+		}
+	};
+
+	Pimpl(int numThreads) :
 		jobQueue(8192),
-		currentlyExecutedJob(nullptr),
-		diskUsage(0.0)
-	{};
+		consumerToken(jobQueue)
+	{
+		for (int i = 0; i < jmax(1, numThreads); i++)
+			states.add(new ThreadState());
+
+		streamingJobs.ensureStorageAllocated(1024);
+		backgroundJobs.ensureStorageAllocated(1024);
+	};
 
 	~Pimpl()
 	{
-		if (auto currentJob = currentlyExecutedJob.load())
+		for (auto s : states)
 		{
-			currentJob->signalJobShouldExit();
+			if (auto currentJob = s->currentlyExecutedJob.load())
+				currentJob->signalJobShouldExit();
 		}
+
+		workers.clear();
 	}
 
-	CriticalSection clearLock;
+	void startWorkers()
+	{
+		for (int i = 1; i < states.size(); i++)
+			workers.add(new Worker(*this, i));
+	}
+
+	void notifyWorkers()
+	{
+		for (auto w : workers)
+		{
+			if (states[w->threadIndex]->idle.load())
+			{
+				w->notify();
+				return;
+			}
+		}
+	}
+
+	void enqueue(Job* j)
+	{
+		prepareForQueue(j);
+		jobQueue.enqueue(makeQueueEntry(j));
+	}
+
+	void enqueue(Job* j, moodycamel::ProducerToken& token)
+	{
+		prepareForQueue(j);
+		jobQueue.enqueue(token, makeQueueEntry(j));
+	}
+
+	void prepareForQueue(Job* j)
+	{
+		j->generation.store(clearGeneration.load());
+		j->queued.store(true);
+	}
+
+	PendingJob makeQueueEntry(Job* j)
+	{
+		return { j, Job::NoDeadline, 0, j->generation.load() };
+	}
+
+	/** Returns true if clearPendingTasks() was called after the job was added. */
+	bool isCancelled(const PendingJob& p) const
+	{
+		return p.generation != clearGeneration.load();
+	}
+
+	/** Marks the job as cancelled unless it was added again after the clearPendingTasks() call. */
+	static void cancel(const PendingJob& p)
+	{
+		if (auto j = p.job.get())
+		{
+			if (j->generation.load() == p.generation)
+			{
+				j->queued.store(false);
+				j->signalJobShouldExit();
+			}
+		}
+	}
+
+	/** Moves the jobs from the lock free queue into the scheduler lists. Must be called with the schedulerLock. */
+	void dequeueIncomingJobs()
+	{
+		PendingJob next;
+
+		while (jobQueue.try_dequeue(consumerToken, next))
+			schedule(next);
+	}
+
+	/** Removes all jobs that were cancelled with clearPendingTasks(). Must be called with the schedulerLock. */
+	void removeCancelledJobs()
+	{
+		auto thisGeneration = clearGeneration.load();
+
+		if (thisGeneration == lastClearedGeneration)
+			return;
+
+		lastClearedGeneration = thisGeneration;
+
+		auto removeIfCancelled = [this](const PendingJob& p)
+		{
+			if (isCancelled(p))
+			{
+				cancel(p);
+				return true;
+			}
+
+			return false;
+		};
+
+		streamingJobs.removeIf(removeIfCancelled);
+		backgroundJobs.removeIf(removeIfCancelled);
+	}
+
+	/** Must be called with the schedulerLock. */
+	void schedule(PendingJob p)
+	{
+		if (p.job.get() == nullptr)
+			return;
+
+		if (isCancelled(p))
+		{
+			cancel(p);
+			return;
+		}
+
+		p.deadline = p.job->getDeadline();
+
+		if (p.deadline == Job::NoDeadline)
+			backgroundJobs.add(p);
+		else
+		{
+			DeadlineComparator comparator;
+			p.order = orderCounter++;
+			streamingJobs.addSorted(comparator, p);
+		}
+	}
+
+	/** Picks up deadline changes of the queued streaming jobs and restores the order. Must be called with the schedulerLock. */
+	void refreshDeadlines()
+	{
+		bool orderChanged = false;
+
+		for (int i = 0; i < streamingJobs.size(); i++)
+		{
+			auto& p = streamingJobs.getReference(i);
+
+			if (auto j = p.job.get())
+			{
+				auto newDeadline = j->getDeadline();
+
+				if (newDeadline == Job::NoDeadline)
+				{
+					p.deadline = newDeadline;
+					backgroundJobs.add(p);
+					streamingJobs.remove(i--);
+				}
+				else if (newDeadline != p.deadline)
+				{
+					p.deadline = newDeadline;
+					orderChanged = true;
+				}
+			}
+		}
+
+		if (orderChanged)
+		{
+			DeadlineComparator comparator;
+			streamingJobs.sort(comparator, true);
+		}
+	}
+
+	PendingJob getNextJob(int threadIndex)
+	{
+		ScopedLock sl(schedulerLock);
+
+		removeCancelledJobs();
+		refreshDeadlines();
+		dequeueIncomingJobs();
+
+		if (!streamingJobs.isEmpty())
+			return streamingJobs.removeAndReturn(0);
+
+		if (threadIndex == 0 && !backgroundJobs.isEmpty())
+			return backgroundJobs.removeAndReturn(0);
+
+		return {};
+	}
+
+	bool runNextJob(Thread* thread, int threadIndex)
+	{
+		// clearPendingTasks() acquires the write lock to wait for the running jobs
+		ScopedReadLock sl(clearLock);
+
+		PendingJob next = getNextJob(threadIndex);
+
+		Job* j = next.job.get();
+
+		if (j == nullptr)
+			return false;
+
+		auto& state = *states[threadIndex];
+
+#if ENABLE_CPU_MEASUREMENT
+		const int64 lastEndTime = state.endTime;
+		state.startTime = Time::getHighResolutionTicks();
+#endif
+
+		state.currentlyExecutedJob.store(j);
+
+		j->currentThread.store(thread);
+		j->running.store(true);
+
+		Job::JobStatus status = j->runJob();
+
+		j->running.store(false);
+
+		if (status == Job::jobHasFinished)
+		{
+			j->queued.store(false);
+		}
+		else if (status == Job::jobNeedsRunningAgain)
+		{
+			ScopedLock sl2(schedulerLock);
+			schedule(next);
+		}
+
+		state.currentlyExecutedJob.store(nullptr);
+
+#if ENABLE_CPU_MEASUREMENT
+		state.endTime = Time::getHighResolutionTicks();
+
+		const int64 idleTime = state.startTime - lastEndTime;
+		const int64 busyTime = state.endTime - state.startTime;
+
+		state.diskUsage.store((double)busyTime / (double)(idleTime + busyTime));
+#endif
+
+		return true;
+	}
+
+	CriticalSection schedulerLock;
+	ReadWriteLock clearLock;
+
+	moodycamel::ConcurrentQueue<PendingJob> jobQueue;
+
+	// Only used by the thread that holds the schedulerLock
+	moodycamel::ConsumerToken consumerToken;
+
+	std::atomic<uint32> clearGeneration = { 0 };
+	uint32 lastClearedGeneration = 0;
+
+	Array<PendingJob> streamingJobs;
+	Array<PendingJob> backgroundJobs;
+	uint32 orderCounter = 0;
+
+	OwnedArray<ThreadState> states;
+	OwnedArray<Worker> workers;
 
-	std::atomic<double> diskUsage;
-	int64 startTime, endTime;
-	moodycamel::ReaderWriterQueue<WeakReference<Job>> jobQueue;
-	std::atomic<Job*> currentlyExecutedJob;
 	static const String errorMessage;
 };
 
-SampleThreadPool::SampleThreadPool() :
+SampleThreadPool::SampleThreadPool(int numThreadsToUse) :
 	Thread("Sample Loading Thread", HISE_DEFAULT_STACK_SIZE),
-	pimpl(new Pimpl())
+	pimpl(new Pimpl(numThreadsToUse))
 {
-
 	startThread(9);
-	
+	pimpl->startWorkers();
 }
 
 SampleThreadPool::~SampleThreadPool()
 {
+	pimpl->workers.clear();
 	stopThread(1000);
 	pimpl = nullptr;
 }
 
 double SampleThreadPool::getDiskUsage() const noexcept
 {
-	return pimpl->diskUsage.load();
+	double sum = 0.0;
+
+	for (auto s : pimpl->states)
+		sum += s->diskUsage.load();
+
+	return sum / (double)pimpl->states.size();
+}
+
+double SampleThreadPool::getDiskUsage(int threadIndex) const noexcept
+{
+	if (auto s = pimpl->states[threadIndex])
+		return s->diskUsage.load();
+
+	return 0.0;
+}
+
+int SampleThreadPool::getNumThreads() const noexcept
+{
+	return pimpl->states.size();
 }
 
 void SampleThreadPool::clearPendingTasks()
 {
-	ScopedLock sl(pimpl->clearLock);
-		
-	WeakReference<Job> next;
+	// This waits for the running jobs, so it must not be called on the audio thread
+	jassert(!AudioThreadGuard::isAudioThread());
+
+	// Every job that was added before this point carries the old generation
+	// and will be discarded by the next call to getNextJob()
+	pimpl->clearGeneration.fetch_add(1);
 
-	while (pimpl->jobQueue.try_dequeue(next))
 	{
-		next->queued.store(false);
-		next->signalJobShouldExit();
+		// Wait until the jobs that were picked up before the generation change are finished
+		ScopedWriteLock sl(pimpl->clearLock);
 	}
+
+	notify();
 }
 
 void SampleThreadPool::addJob(Job* jobToAdd, bool unused)
@@ -102,79 +429,51 @@ void SampleThreadPool::addJob(Job* jobToAdd, bool unused)
 	}
 #endif
 
-
-	jobToAdd->queued.store(true);
-	pimpl->jobQueue.enqueue(jobToAdd);
+	pimpl->enqueue(jobToAdd);
 
 	notify();
+
+	if (jobToAdd->getDeadline() != Job::NoDeadline)
+		pimpl->notifyWorkers();
 }
 
-void SampleThreadPool::run()
+void SampleThreadPool::addJob(Job* jobToAdd, ProducerToken& token)
 {
-	while (!threadShouldExit())
+#if ENABLE_CONSOLE_OUTPUT
+	if (jobToAdd->isQueued())
 	{
-		WeakReference<Job> next;
-
-		if (pimpl->jobQueue.try_dequeue(next))
-		{
-			ScopedLock sl(pimpl->clearLock);
-
-			Job* j = next.get();
-
-#if ENABLE_CPU_MEASUREMENT
-
-			const int64 lastEndTime = pimpl->endTime;
-			pimpl->startTime = Time::getHighResolutionTicks();
+		Logger::writeToLog(pimpl->errorMessage);
+	}
 #endif
 
-			if (j != nullptr)
-			{
-				pimpl->currentlyExecutedJob.store(j);
-
-				j->currentThread.store(this);
-
-				j->running.store(true);
-				
-				Job::JobStatus status = j->runJob();
+	pimpl->enqueue(jobToAdd, token.token);
 
-				j->running.store(false);
-
-				if (status == Job::jobHasFinished)
-				{
-					j->queued.store(false);
-				}
-				else if (status == Job::jobNeedsRunningAgain)
-				{
-					pimpl->jobQueue.enqueue(next);
-				}
-
-				pimpl->currentlyExecutedJob.store(nullptr);
-			}
-			else
-			{
-				pimpl->jobQueue.pop();
-			}
+	notify();
 
-#if ENABLE_CPU_MEASUREMENT
-			pimpl->endTime = Time::getHighResolutionTicks();
+	if (jobToAdd->getDeadline() != Job::NoDeadline)
+		pimpl->notifyWorkers();
+}
 
-			const int64 idleTime = pimpl->startTime - lastEndTime;
-			const int64 busyTime = pimpl->endTime - pimpl->startTime;
+SampleThreadPool::ProducerToken::ProducerToken(SampleThreadPool& pool) :
+	token(pool.pimpl->jobQueue)
+{
+}
 
-			pimpl->diskUsage.store((double)busyTime / (double)(idleTime + busyTime));
-#endif
-		}
+SampleThreadPool::ProducerToken::~ProducerToken()
+{
+}
 
+void SampleThreadPool::run()
+{
+	while (!threadShouldExit())
+	{
 #if 0 // Set this to true to enable defective threading (for debugging purposes)
+		pimpl->runNextJob(this, 0);
 		wait(2500);
 #else
-		else
-		{
+		if (!pimpl->runNextJob(this, 0))
 			wait(500);
-		}
 #endif
-
-
 	}
 }
 
@@ -187,6 +486,7 @@ void SampleThreadPool::Job::resetJob()
 	running.store(false);
 	shouldStop.store(false);
 	currentThread.store(nullptr);
+	deadline.store(NoDeadline);
 }
 
 } // namespace hise
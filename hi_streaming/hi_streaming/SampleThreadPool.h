@@ -35,11 +35,18 @@
 
 namespace hise { using namespace juce;
 
+/** The background thread pool that executes the sample streaming and loading jobs.
+*
+*	The pool thread itself is the sample loading thread that executes every job in the order it was added.
+*	If you create it with more than one thread, the additional worker threads will help out with jobs that
+*	have a deadline (the SampleLoader jobs that fill the streaming buffers) and every thread will always pick
+*	the job with the most urgent deadline first, so that a slow read operation doesn't stall the other voices.
+*/
 class SampleThreadPool : public Thread
 {
 public:
 
-	SampleThreadPool();
+	SampleThreadPool(int numThreadsToUse=HISE_NUM_STREAMING_THREADS);
 
 	~SampleThreadPool();
 	
@@ -52,7 +59,9 @@ public:
 			name(name_),
 			queued(false),
 			running(false),
-			shouldStop(false)
+			shouldStop(false),
+			deadline(NoDeadline),
+			generation(0)
 		{};
         
         virtual ~Job() { masterReference.clear(); }
@@ -63,6 +72,8 @@ public:
 			jobNeedsRunningAgain
 		};
 
+		static constexpr int NoDeadline = -1;
+
 		virtual JobStatus runJob() = 0;
 
 		bool shouldExit() const noexcept{ return shouldStop.load(); }
@@ -73,6 +84,17 @@ public:
 
 		bool isQueued() const noexcept{ return queued.load(); };
 
+		/** Sets the number of samples that can be processed until this job must be finished. 
+		
+			Jobs with a deadline can be picked up by any worker thread of the pool (the one with the smallest
+			deadline first). You can update the deadline while the job is queued, the pool will pick up the
+			new value before it chooses the next job.
+		*/
+		void setDeadline(int numSamplesUntilDeadline) noexcept { deadline.store(jmax(0, numSamplesUntilDeadline)); }
+
+		/** Returns the deadline or NoDeadline if the job has to be executed on the sample loading thread. */
+		int getDeadline() const noexcept { return deadline.load(); }
+
 	protected:
 
 		void resetJob();
@@ -88,17 +110,63 @@ public:
 		std::atomic<bool> queued;
 		std::atomic<bool> running;
 		std::atomic<bool> shouldStop;
+		std::atomic<int> deadline;
+		std::atomic<uint32> generation;
 		std::atomic<Thread*> currentThread;
 
 		const String name;
 	};
 
+	/** Returns the average disk usage of all threads. */
 	double getDiskUsage() const noexcept;
 
+	/** Returns the disk usage of the given thread (0 is the sample loading thread). */
+	double getDiskUsage(int threadIndex) const noexcept;
+
+	/** Returns the number of threads (including the sample loading thread). */
+	int getNumThreads() const noexcept;
+
+	/** A token that speeds up adding jobs from the same producer.
+
+		Jobs can be added from any thread, but without a token the queue has to look up the
+		producer of the calling thread (and create one on the first call from a new thread).
+		A token must not be used by two threads at the same time, so the best place for it is
+		an object that is only accessed by one audio thread at once (eg. the SampleLoader of a voice).
+	*/
+	class ProducerToken
+	{
+	public:
+
+		ProducerToken(SampleThreadPool& pool);
+		~ProducerToken();
+
+	private:
+
+		friend class SampleThreadPool;
+
+		moodycamel::ProducerToken token;
+
+		JUCE_DECLARE_NON_COPYABLE(ProducerToken);
+	};
+
+	/** Cancels all jobs that were added before this call.
+
+		The pending jobs are marked as cancelled without locking the queue and the pool threads
+		will discard them before picking up the next job. Jobs that are currently running are not
+		interrupted, but this function waits until they are finished, so it's safe to delete the
+		objects the cancelled jobs refer to after this call.
+
+		This is meant for the loading path only (eg. the sample loading thread or the message thread).
+		It may block for as long as the running jobs take, so never call it from the audio thread.
+	*/
 	void clearPendingTasks();
 
+	/** Adds a job to the pool. This is lock free and can be called from multiple threads at once. */
 	void addJob(Job* jobToAdd, bool unused);
 
+	/** Adds a job to the pool using the queue slot of the given producer token. */
+	void addJob(Job* jobToAdd, ProducerToken& token);
+
 	void run() override;
 
 	struct Pimpl;
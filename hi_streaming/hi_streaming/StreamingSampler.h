@@ -95,7 +95,7 @@ public:
 
 private:
 
-	int numOpenFileHandles = 0;
+	std::atomic<int> numOpenFileHandles = { 0 };
 
 	JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(StreamingSamplerSoundPool);
 };
@@ -183,6 +183,13 @@ struct StereoChannelData
 
 #define NUM_UNMAPPERS 8
 
+// The maximum number of threads that preload the samples of a sampler. The sounds are batched per monolith file
+// and read in the order of their offset in the file, so each thread reads sequentially. Set this to 1 to
+// preload everything on the sample loading thread.
+#ifndef HISE_NUM_PRELOAD_THREADS
+#define HISE_NUM_PRELOAD_THREADS 4
+#endif
+
 
 
 } // namespace hise
@@ -210,6 +210,43 @@ void StreamingSamplerSound::setPreloadSize(int newPreloadSize, bool forceReload)
 
 	auto sampleStartToUse = isReversed() ? 0 : sampleStart;
 
+	if (sampleRate <= 0.0)
+	{
+		if (AudioFormatReader *reader = fileReader.getReader())
+		{
+			sampleRate = reader->sampleRate;
+			sampleEnd = jmin<int>(sampleEnd, (int)reader->lengthInSamples);
+			sampleLength = jmax<int>(0, sampleEnd - sampleStart);
+			loopEnd = jmin(loopEnd, sampleEnd);
+		}
+	}
+
+	bool applyLoopToPreloadBuffer = (loopEnd - sampleStart) < internalPreloadSize;
+
+	if (isReversed())
+		applyLoopToPreloadBuffer = getLoopEnd(true) < internalPreloadSize;
+
+	applyLoopToPreloadBuffer &= loopEnabled;
+	applyLoopToPreloadBuffer &= getLoopLength() > 0;
+
+#if HISE_USE_MAPPED_PRELOAD_BUFFERS
+
+	// The mapped data can only be used if it can be played back as it is
+	if (!isReversed() && !applyLoopToPreloadBuffer && internalPreloadSize <= sampleLength)
+	{
+		if (auto mappedData = fileReader.getMappedMonolithData(sampleStartToUse, internalPreloadSize))
+		{
+			preloadBuffer = hlac::HiseSampleBuffer::createReadOnlyView(mappedData, fileReader.isStereo() ? 2 : 1, internalPreloadSize);
+			preloadBuffer.allocateNormalisationTables(sampleStartToUse);
+
+			rebuildCrossfadeBuffer();
+			applyCrossfadeToInternalBuffers();
+			return;
+		}
+	}
+
+#endif
+
 	preloadBuffer = hlac::HiseSampleBuffer(!fileReader.isMonolithic(), fileReader.isStereo() ? 2 : 1, 0);
 
 	try
@@ -231,27 +268,6 @@ void StreamingSamplerSound::setPreloadSize(int newPreloadSize, bool forceReload)
 	preloadBuffer.clear();
 	preloadBuffer.allocateNormalisationTables(sampleStartToUse);
 
-	if (sampleRate <= 0.0)
-	{
-		if (AudioFormatReader *reader = fileReader.getReader())
-		{
-			sampleRate = reader->sampleRate;
-			sampleEnd = jmin<int>(sampleEnd, (int)reader->lengthInSamples);
-			sampleLength = jmax<int>(0, sampleEnd - sampleStart);
-			loopEnd = jmin(loopEnd, sampleEnd);
-		}
-	}
-
-	
-
-	bool applyLoopToPreloadBuffer = (loopEnd - sampleStart) < internalPreloadSize;
-
-	if (isReversed())
-		applyLoopToPreloadBuffer = getLoopEnd(true) < internalPreloadSize;
-
-	applyLoopToPreloadBuffer &= loopEnabled;
-	applyLoopToPreloadBuffer &= getLoopLength() > 0;
-
 	if (applyLoopToPreloadBuffer)
 	{
 		const int samplesPerFillOp = getLoopLength();
@@ -316,7 +332,10 @@ size_t StreamingSamplerSound::getActualPreloadSize() const
 
 	auto loopBytes = loopBuffer != nullptr ? loopBuffer->getNumSamples() * loopBuffer->getNumChannels() : 0;
 
-	return hasActiveState() ? (size_t)(internalPreloadSize *preloadBuffer.getNumChannels()) * bytesPerSample + (size_t)(loopBytes) * bytesPerSample : 0;
+	// A preload buffer that points to the mapped monolith doesn't allocate any memory
+	auto preloadBytes = preloadBuffer.isReadOnlyView() ? 0 : internalPreloadSize * preloadBuffer.getNumChannels();
+
+	return hasActiveState() ? (size_t)(preloadBytes) * bytesPerSample + (size_t)(loopBytes) * bytesPerSample : 0;
 }
 
 void StreamingSamplerSound::loadEntireSample() { setPreloadSize(-1); }
@@ -615,6 +634,8 @@ void StreamingSamplerSound::applyCrossfadeToInternalBuffers()
         
 		if (fadePos < numInBuffer)
 		{
+			// The crossfade needs to be written into the preload buffer, so we can't use the mapped data
+			preloadBuffer.copyReadOnlyViewIntoOwnedData();
 			preloadBuffer.burnNormalisation();
 
 			while (fadePos < numInBuffer)
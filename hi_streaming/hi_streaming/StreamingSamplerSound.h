@@ -216,6 +216,7 @@ public:
 	AudioFormatReader* createReaderForAnalysis();
 
 	int64 getMonolithOffset() const { return fileReader.getMonolithOffset(); }
+	File getMonolithFile() const { return fileReader.getMonolithFile(); }
 	int64 getMonolithLength() const { return fileReader.getMonolithLength(); }
 	double getMonolithSampleRate() const { return fileReader.getMonolithSampleRate(); }
 
@@ -353,6 +354,14 @@ private:
 			return 0;
 		}
 
+		File getMonolithFile() const
+		{
+			if (monolithicInfo != nullptr)
+				return monolithicInfo->getFile(monolithicChannelIndex, monolithicIndex);
+
+			return {};
+		}
+
 		int64 getMonolithLength() const
 		{
 			if (monolithicInfo != nullptr)
@@ -361,6 +370,15 @@ private:
 			return 0;
 		}
 
+		/** Returns the memory mapped data of the sample if it is stored in an uncompressed monolith (or nullptr). */
+		const int16* getMappedMonolithData(int startSample, int numSamples) const
+		{
+			if (monolithicInfo != nullptr)
+				return monolithicInfo->getMappedData(monolithicIndex, monolithicChannelIndex, startSample, numSamples);
+
+			return nullptr;
+		}
+
 		int64 getSampleLength() const
 		{
 			return sampleLength;
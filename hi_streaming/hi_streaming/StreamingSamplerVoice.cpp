@@ -57,6 +57,9 @@ SampleLoader::SampleLoader(SampleThreadPool *pool_) :
 {
 	unmapper.setLoader(this);
 
+	if (backgroundPool != nullptr)
+		producerToken = new SampleThreadPool::ProducerToken(*backgroundPool);
+
 	setBufferSize(BUFFER_SIZE_FOR_STREAM_BUFFERS);
 }
 
@@ -305,6 +308,23 @@ StereoChannelData SampleLoader::fillVoiceBuffer(hlac::HiseSampleBuffer &voiceBuf
 
 		return returnData;
 	}
+	else if (localReadBuffer->isInterleaved())
+	{
+		// The preload buffer points to the interleaved data of a mapped monolith, so we need to copy the channels
+		const int index = (int)readIndexDouble;
+		const int numToCopy = jmin(maxSampleIndexForFillOperation - index + 1, numSamplesInBuffer - index, voiceBuffer.getNumSamples());
+
+		voiceBuffer.setUseOneMap(localReadBuffer->useOneMap);
+		voiceBuffer.clearNormalisation({});
+
+		hlac::HiseSampleBuffer::copy(voiceBuffer, *localReadBuffer, 0, index, numToCopy);
+
+		StereoChannelData returnData;
+		returnData.b = &voiceBuffer;
+		returnData.offsetInBuffer = 0;
+
+		return returnData;
+	}
 	else
 	{
 		const int index = (int)readIndexDouble;
@@ -348,6 +368,10 @@ bool SampleLoader::advanceReadIndex(double uptime)
 		}
 	}
 
+	// Keep the deadline of a pending job up to date so that the pool can reorder it
+	if (isQueued() && !isRunning())
+		setDeadline(numSamplesInBuffer - (int)readIndexDouble);
+
 	return true;
 }
 
@@ -367,6 +391,9 @@ bool SampleLoader::requestNewData()
 		return true;
 	}
 
+	// The samples left in the read buffer define the urgency of this job
+	setDeadline(readBuffer.get()->getNumSamples() - (int)readIndexDouble);
+
 #if KILL_VOICES_WHEN_STREAMING_IS_BLOCKED
 	if (this->isQueued())
 	{
@@ -378,11 +405,11 @@ bool SampleLoader::requestNewData()
 	}
 	else
 	{
-		backgroundPool->addJob(this, false);
+		backgroundPool->addJob(this, *producerToken);
 		return true;
 	}
 #else
-	backgroundPool->addJob(this, false);
+	backgroundPool->addJob(this, *producerToken);
 	return true;
 #endif
 };
@@ -529,6 +556,8 @@ StreamingSamplerVoice::StreamingSamplerVoice(SampleThreadPool *pool) :
 	sampleStartModValue(0)
 {
 	pitchData = nullptr;
+
+	zeromem(sincHistory, sizeof(sincHistory));
 };
 
 
@@ -547,6 +576,8 @@ void StreamingSamplerVoice::startNote(int /*midiNoteNumber*/,
 		
 		voiceUptime = (double)sampleStartModValue;
 
+		zeromem(sincHistory, sizeof(sincHistory));
+
 		// You have to call setPitchFactor() before startNote().
 		jassert(uptimeDelta != 0.0);
 
@@ -592,114 +623,600 @@ void StreamingSamplerVoice::setDebugLogger(DebugLogger* newLogger)
 static int alignedCalls = 0;
 static int unalignedCalls = 0;
 
-template <typename SignalType, bool isFloat> void interpolateMonoSamples(const SignalType* inL, const SignalType* unusedIn, const float* pitchData, float* outL, float* unusedOut, int startSample, double indexInBuffer, double uptimeDelta, int numSamples)
+#if HI_ENABLE_LEGACY_CPU_SUPPORT || !(JUCE_INTEL || JUCE_ARM)
+#define SAMPLER_SIMD_INTERPOLATION 0
+#else
+#define SAMPLER_SIMD_INTERPOLATION 1
+#endif
+
+// GCC and clang need the target attribute in order to use intrinsics beyond the compiler flags.
+#if SAMPLER_SIMD_INTERPOLATION && JUCE_INTEL && (JUCE_GCC || JUCE_CLANG)
+#define SAMPLER_TARGET(x) __attribute__((target(x)))
+#else
+#define SAMPLER_TARGET(x)
+#endif
+
+/** Contains the resampling kernels of the StreamingSamplerVoice.
+
+	The SIMD kernels calculate the read index of every lane directly (using the lane offset for a constant
+	pitch or a prefix sum of the pitch values) and stop before a lane would read past maxIndexInBuffer.
+	They return the number of calculated samples and advance the read index, so that the scalar code
+	can take over for the rest of the block.
+*/
+namespace SimdInterpolation
+{
+using InstructionSet = StreamingSamplerVoice::Interpolator::InstructionSet;
+
+static std::atomic<int>& getCurrentInstructionSet()
 {
-	ignoreUnused(unusedIn, unusedOut);
+	static std::atomic<int> instructionSet((int)hlac::BitCompressors::getBestSupportedInstructionSet());
+	return instructionSet;
+}
 
-	constexpr float gainFactor = isFloat ? 1.0f : (1.0f / (float)INT16_MAX);
+template <typename SignalType> static constexpr float getGainFactor()
+{
+	return std::is_same<SignalType, float>::value ? 1.0f : (1.0f / (float)INT16_MAX);
+}
 
-	if (pitchData != nullptr)
-	{
-		pitchData += startSample;
+template <typename SignalType> static void processScalar(const SignalType* inL, const SignalType* inR, const float* pitchData, float* outL, float* outR, float indexInBufferFloat, float uptimeDeltaFloat, int numSamples, int maxIndexInBuffer)
+{
+	constexpr float gainFactor = getGainFactor<SignalType>();
 
-		float indexInBufferFloat = (float)indexInBuffer;
+	for (int i = 0; i < numSamples; i++)
+	{
+		const int pos = int(indexInBufferFloat);
 
-		for (int i = 0; i < numSamples; i++)
-		{
-			const int pos = int(indexInBufferFloat);
-			const float alpha = indexInBufferFloat - (float)pos;
-			const float invAlpha = 1.0f - alpha;
+		if (pitchData != nullptr && pos >= maxIndexInBuffer)
+			return;
 
-			float l = ((float)inL[pos] * invAlpha + (float)inL[pos + 1] * alpha);
+		const float alpha = indexInBufferFloat - (float)pos;
+		const float invAlpha = 1.0f - alpha;
 
-			outL[i] = l * gainFactor;
+		float l = ((float)inL[pos] * invAlpha + (float)inL[pos + 1] * alpha);
+		outL[i] = l * gainFactor;
 
-			jassert(*pitchData <= (float)MAX_SAMPLER_PITCH);
+		if (inR != nullptr)
+		{
+			float r = ((float)inR[pos] * invAlpha + (float)inR[pos + 1] * alpha);
+			outR[i] = r * gainFactor;
+		}
 
+		if (pitchData != nullptr)
+		{
+			jassert(pitchData[i] <= (float)MAX_SAMPLER_PITCH);
 			indexInBufferFloat += pitchData[i];
 		}
+		else
+			indexInBufferFloat += uptimeDeltaFloat;
 	}
-	else
+}
+
+#if SAMPLER_SIMD_INTERPOLATION
+
+/** Loads the samples at the given positions into a and the samples after them into b. */
+SAMPLER_TARGET("sse4.1") static inline void loadPairs(const float* in, __m128i pos, __m128& a, __m128& b)
+{
+	alignas(16) int p[4];
+	_mm_store_si128((__m128i*)p, pos);
+
+	auto v01 = _mm_loadh_pi(_mm_loadl_pi(_mm_setzero_ps(), (const __m64*)(in + p[0])), (const __m64*)(in + p[1]));
+	auto v23 = _mm_loadh_pi(_mm_loadl_pi(_mm_setzero_ps(), (const __m64*)(in + p[2])), (const __m64*)(in + p[3]));
+
+	a = _mm_shuffle_ps(v01, v23, _MM_SHUFFLE(2, 0, 2, 0));
+	b = _mm_shuffle_ps(v01, v23, _MM_SHUFFLE(3, 1, 3, 1));
+}
+
+/** Reads both 16 bit samples of each position as one 32 bit value and splits them in the register. */
+SAMPLER_TARGET("sse4.1") static inline void loadPairs(const int16* in, __m128i pos, __m128& a, __m128& b)
+{
+	alignas(16) int p[4];
+	_mm_store_si128((__m128i*)p, pos);
+
+	alignas(16) int32 v[4];
+
+	for (int i = 0; i < 4; i++)
+		memcpy(v + i, in + p[i], sizeof(int32));
+
+	const auto raw = _mm_load_si128((const __m128i*)v);
+
+	a = _mm_cvtepi32_ps(_mm_srai_epi32(_mm_slli_epi32(raw, 16), 16));
+	b = _mm_cvtepi32_ps(_mm_srai_epi32(raw, 16));
+}
+
+template <typename SignalType> SAMPLER_TARGET("sse4.1") static int processSSE41(const SignalType* inL, const SignalType* inR, const float* pitchData, float* outL, float* outR, float& indexInBufferFloat, float uptimeDeltaFloat, int numSamples, int maxIndexInBuffer)
+{
+	const auto gain = _mm_set1_ps(getGainFactor<SignalType>());
+	const auto one = _mm_set1_ps(1.0f);
+	const auto start = _mm_set1_ps(indexInBufferFloat);
+	const auto delta = _mm_set1_ps(uptimeDeltaFloat);
+	const auto four = _mm_set1_ps(4.0f);
+
+	auto laneIndex = _mm_setr_ps(0.0f, 1.0f, 2.0f, 3.0f);
+	auto carry = start;
+
+	int numDone = 0;
+
+	for (; numDone + 4 <= numSamples; numDone += 4)
 	{
-		float indexInBufferFloat = (float)indexInBuffer;
-		const float uptimeDeltaFloat = (float)uptimeDelta;
+		__m128 index, nextCarry;
 
-		while (numSamples > 0)
+		if (pitchData != nullptr)
 		{
-			const int pos = int(indexInBufferFloat);
-			const float alpha = indexInBufferFloat - (float)pos;
-			const float invAlpha = 1.0f - alpha;
+			// inclusive prefix sum of the pitch values
+			const auto p = _mm_loadu_ps(pitchData + numDone);
+			auto sum = _mm_add_ps(p, _mm_castsi128_ps(_mm_slli_si128(_mm_castps_si128(p), 4)));
+			sum = _mm_add_ps(sum, _mm_castsi128_ps(_mm_slli_si128(_mm_castps_si128(sum), 8)));
 
-			float l = ((float)inL[pos] * invAlpha + (float)inL[pos + 1] * alpha);
+			index = _mm_add_ps(carry, _mm_castsi128_ps(_mm_slli_si128(_mm_castps_si128(sum), 4)));
+			nextCarry = _mm_add_ps(carry, _mm_shuffle_ps(sum, sum, _MM_SHUFFLE(3, 3, 3, 3)));
+		}
+		else
+		{
+			index = _mm_add_ps(start, _mm_mul_ps(laneIndex, delta));
+			nextCarry = carry;
+		}
 
-			*outL++ = l * gainFactor;
+		const auto pos = _mm_cvttps_epi32(index);
 
-			indexInBufferFloat += uptimeDeltaFloat;
+		if (_mm_extract_epi32(pos, 3) + 1 >= maxIndexInBuffer)
+			break;
 
-			numSamples--;
+		const auto alpha = _mm_sub_ps(index, _mm_cvtepi32_ps(pos));
+		const auto invAlpha = _mm_sub_ps(one, alpha);
+
+		__m128 a, b;
+
+		loadPairs(inL, pos, a, b);
+		_mm_storeu_ps(outL + numDone, _mm_mul_ps(_mm_add_ps(_mm_mul_ps(a, invAlpha), _mm_mul_ps(b, alpha)), gain));
+
+		if (inR != nullptr)
+		{
+			loadPairs(inR, pos, a, b);
+			_mm_storeu_ps(outR + numDone, _mm_mul_ps(_mm_add_ps(_mm_mul_ps(a, invAlpha), _mm_mul_ps(b, alpha)), gain));
 		}
+
+		carry = nextCarry;
+		laneIndex = _mm_add_ps(laneIndex, four);
 	}
+
+	if (pitchData != nullptr)
+		indexInBufferFloat = _mm_cvtss_f32(carry);
+	else
+		indexInBufferFloat += (float)numDone * uptimeDeltaFloat;
+
+	return numDone;
 }
 
-template <typename SignalType, bool isFloat> void interpolateStereoSamples(const SignalType* inL, const SignalType* inR, const float* pitchData, float* outL, float* outR, int startSample, double indexInBuffer, double uptimeDelta, int numSamples, int maxIndexInBuffer)
+#if JUCE_INTEL
+
+SAMPLER_TARGET("avx2") static inline void loadPairs(const float* in, __m256i pos, __m256& a, __m256& b)
 {
-	constexpr float gainFactor = isFloat ? 1.0f : (1.0f / (float)INT16_MAX);
+	a = _mm256_i32gather_ps(in, pos, 4);
+	b = _mm256_i32gather_ps(in + 1, pos, 4);
+}
 
-	if (pitchData != nullptr)
+SAMPLER_TARGET("avx2") static inline void loadPairs(const int16* in, __m256i pos, __m256& a, __m256& b)
+{
+	const auto raw = _mm256_i32gather_epi32((const int*)in, pos, 2);
+
+	a = _mm256_cvtepi32_ps(_mm256_srai_epi32(_mm256_slli_epi32(raw, 16), 16));
+	b = _mm256_cvtepi32_ps(_mm256_srai_epi32(raw, 16));
+}
+
+template <typename SignalType> SAMPLER_TARGET("avx2") static int processAVX2(const SignalType* inL, const SignalType* inR, const float* pitchData, float* outL, float* outR, float& indexInBufferFloat, float uptimeDeltaFloat, int numSamples, int maxIndexInBuffer)
+{
+	const auto gain = _mm256_set1_ps(getGainFactor<SignalType>());
+	const auto one = _mm256_set1_ps(1.0f);
+	const auto start = _mm256_set1_ps(indexInBufferFloat);
+	const auto delta = _mm256_set1_ps(uptimeDeltaFloat);
+	const auto eight = _mm256_set1_ps(8.0f);
+	const auto shiftOneLane = _mm256_setr_epi32(0, 0, 1, 2, 3, 4, 5, 6);
+	const auto lastLane = _mm256_set1_epi32(7);
+
+	auto laneIndex = _mm256_setr_ps(0.0f, 1.0f, 2.0f, 3.0f, 4.0f, 5.0f, 6.0f, 7.0f);
+	auto carry = start;
+
+	int numDone = 0;
+
+	for (; numDone + 8 <= numSamples; numDone += 8)
 	{
-		pitchData += startSample;
+		__m256 index, nextCarry;
+
+		if (pitchData != nullptr)
+		{
+			// prefix sum within both 128 bit lanes, then add the sum of the lower to the upper lane
+			const auto p = _mm256_loadu_ps(pitchData + numDone);
+			auto sum = _mm256_add_ps(p, _mm256_castsi256_ps(_mm256_slli_si256(_mm256_castps_si256(p), 4)));
+			sum = _mm256_add_ps(sum, _mm256_castsi256_ps(_mm256_slli_si256(_mm256_castps_si256(sum), 8)));
 
-		float indexInBufferFloat = (float)indexInBuffer;
+			const auto lowerSum = _mm256_permute_ps(sum, _MM_SHUFFLE(3, 3, 3, 3));
+			sum = _mm256_add_ps(sum, _mm256_permute2f128_ps(lowerSum, lowerSum, 0x08));
 
-		for (int i = 0; i < numSamples; i++)
+			const auto exclusiveSum = _mm256_blend_ps(_mm256_permutevar8x32_ps(sum, shiftOneLane), _mm256_setzero_ps(), 0x01);
+
+			index = _mm256_add_ps(carry, exclusiveSum);
+			nextCarry = _mm256_add_ps(carry, _mm256_permutevar8x32_ps(sum, lastLane));
+		}
+		else
 		{
-			const int pos = int(indexInBufferFloat);
+			index = _mm256_add_ps(start, _mm256_mul_ps(laneIndex, delta));
+			nextCarry = carry;
+		}
 
-			if (pos >= maxIndexInBuffer)
-				return;
+		const auto pos = _mm256_cvttps_epi32(index);
 
-			const float alpha = indexInBufferFloat - (float)pos;
-			const float invAlpha = 1.0f - alpha;
+		if (_mm256_extract_epi32(pos, 7) + 1 >= maxIndexInBuffer)
+			break;
 
-			float l = ((float)inL[pos] * invAlpha + (float)inL[pos + 1] * alpha);
-			float r = ((float)inR[pos] * invAlpha + (float)inR[pos + 1] * alpha);
+		const auto alpha = _mm256_sub_ps(index, _mm256_cvtepi32_ps(pos));
+		const auto invAlpha = _mm256_sub_ps(one, alpha);
 
-			outL[i] = l * gainFactor;
-			outR[i] = r * gainFactor;
+		__m256 a, b;
 
-			jassert(*pitchData <= (float)MAX_SAMPLER_PITCH);
+		loadPairs(inL, pos, a, b);
+		_mm256_storeu_ps(outL + numDone, _mm256_mul_ps(_mm256_add_ps(_mm256_mul_ps(a, invAlpha), _mm256_mul_ps(b, alpha)), gain));
 
-			indexInBufferFloat += pitchData[i];
+		if (inR != nullptr)
+		{
+			loadPairs(inR, pos, a, b);
+			_mm256_storeu_ps(outR + numDone, _mm256_mul_ps(_mm256_add_ps(_mm256_mul_ps(a, invAlpha), _mm256_mul_ps(b, alpha)), gain));
 		}
+
+		carry = nextCarry;
+		laneIndex = _mm256_add_ps(laneIndex, eight);
 	}
+
+	if (pitchData != nullptr)
+		indexInBufferFloat = _mm256_cvtss_f32(carry);
 	else
-	{
-		float indexInBufferFloat = (float)indexInBuffer;
-		const float uptimeDeltaFloat = (float)uptimeDelta;
+		indexInBufferFloat += (float)numDone * uptimeDeltaFloat;
+
+	return numDone;
+}
 
+#endif
+#endif
+
+template <typename SignalType> static void process(const SignalType* inL, const SignalType* inR, const float* pitchData, float* outL, float* outR, int startSample, double indexInBuffer, double uptimeDelta, int numSamples, int maxIndexInBuffer)
+{
+	if (pitchData != nullptr)
+		pitchData += startSample;
+	else
+	{
 		auto numTargetSamples = (double)(maxIndexInBuffer - indexInBuffer);
 
 		jassert(numTargetSamples > 0.0);
 
 		numSamples = jmin(numSamples, (int)(numTargetSamples / uptimeDelta));
+	}
+
+	float indexInBufferFloat = (float)indexInBuffer;
+	const float uptimeDeltaFloat = (float)uptimeDelta;
+
+#if SAMPLER_SIMD_INTERPOLATION
+	const auto instructionSet = (InstructionSet)getCurrentInstructionSet().load(std::memory_order_relaxed);
+
+	if (instructionSet != InstructionSet::Scalar)
+	{
+		int numDone = 0;
+
+#if JUCE_INTEL
+		if (instructionSet == InstructionSet::AVX2)
+			numDone = processAVX2(inL, inR, pitchData, outL, outR, indexInBufferFloat, uptimeDeltaFloat, numSamples, maxIndexInBuffer);
+#endif
+
+		auto offset = [numDone](const float* p) { return p != nullptr ? p + numDone : nullptr; };
+
+		numDone += processSSE41(inL, inR, offset(pitchData), outL + numDone, outR != nullptr ? outR + numDone : nullptr, indexInBufferFloat, uptimeDeltaFloat, numSamples - numDone, maxIndexInBuffer);
+
+		if (pitchData != nullptr)
+			pitchData += numDone;
+
+		outL += numDone;
+
+		if (outR != nullptr)
+			outR += numDone;
+
+		numSamples -= numDone;
+	}
+#endif
+
+	processScalar(inL, inR, pitchData, outL, outR, indexInBufferFloat, uptimeDeltaFloat, numSamples, maxIndexInBuffer);
+}
+
+/** The coefficients of the sinc interpolation.
+
+	Each table contains the kernel for NumPhases + 1 fractional positions (the last one is only used to interpolate between
+	the phases). The kernel is a Kaiser windowed sinc and each phase is normalised to unity gain. In order to avoid aliasing
+	when the pitch goes up, there are multiple tables with a lower cutoff frequency for higher pitch ratios.
+*/
+struct SincTables
+{
+	static constexpr int NumTaps = StreamingSamplerVoice::Interpolator::NumSincTaps;
+	static constexpr int NumPhases = 128;
+	static constexpr int NumTables = 6;
+
+	SincTables()
+	{
+		const double ratios[NumTables] = { 1.0, 1.25, 1.5, 2.0, 3.0, 4.0 };
 
-		while (numSamples > 0)
+		// ~80dB stopband attenuation
+		const double beta = 8.6;
+		const double halfLength = (double)(NumTaps / 2);
+
+		for (int t = 0; t < NumTables; t++)
 		{
-			const int pos = int(indexInBufferFloat);
-			const float alpha = indexInBufferFloat - (float)pos;
-			const float invAlpha = 1.0f - alpha;
+			maxRatio[t] = ratios[t];
 
-			float l = ((float)inL[pos] * invAlpha + (float)inL[pos + 1] * alpha);
-			float r = ((float)inR[pos] * invAlpha + (float)inR[pos + 1] * alpha);
+			const double cutoff = 0.9 / ratios[t];
 
-			*outL++ = l * gainFactor;
-			*outR++ = r * gainFactor;
+			coefficients[t].calloc((NumPhases + 1) * NumTaps);
 
-			indexInBufferFloat += uptimeDeltaFloat;
+			for (int p = 0; p <= NumPhases; p++)
+			{
+				const double alpha = (double)p / (double)NumPhases;
+				auto row = coefficients[t] + p * NumTaps;
+
+				double values[NumTaps];
+				double sum = 0.0;
+
+				for (int k = 0; k < NumTaps; k++)
+				{
+					const double x = (double)(k - StreamingSamplerVoice::Interpolator::NumSincHistorySamples) - alpha;
+					const double windowPos = x / halfLength;
+
+					double v = 0.0;
+
+					if (std::abs(windowPos) < 1.0)
+					{
+						const double window = besselI0(beta * std::sqrt(1.0 - windowPos * windowPos)) / besselI0(beta);
+						const double sx = cutoff * x * double_Pi;
+						const double sinc = std::abs(sx) < 1e-9 ? 1.0 : std::sin(sx) / sx;
 
-			numSamples--;
+						v = cutoff * sinc * window;
+					}
+
+					values[k] = v;
+					sum += v;
+				}
+
+				for (int k = 0; k < NumTaps; k++)
+					row[k] = (float)(values[k] / sum);
+			}
 		}
 	}
+
+	static double besselI0(double x)
+	{
+		double sum = 1.0;
+		double term = 1.0;
+
+		for (int k = 1; k < 32; k++)
+		{
+			const double f = x / (2.0 * (double)k);
+			term *= f * f;
+			sum += term;
+
+			if (term < sum * 1e-12)
+				break;
+		}
+
+		return sum;
+	}
+
+	/** Returns the table with the highest cutoff frequency that doesn't alias at the given pitch ratio. */
+	const float* getTable(double pitchRatio) const
+	{
+		for (int t = 0; t < NumTables - 1; t++)
+		{
+			if (pitchRatio <= maxRatio[t])
+				return coefficients[t].get();
+		}
+
+		return coefficients[NumTables - 1].get();
+	}
+
+	static const SincTables& get()
+	{
+		static const SincTables instance;
+		return instance;
+	}
+
+	HeapBlock<float> coefficients[NumTables];
+	double maxRatio[NumTables];
+};
+
+/** Calculates the output sample at the given position. The weights are interpolated between the two closest phases. */
+struct SincScalar
+{
+	static void process(const float* inL, const float* inR, int pos, const float* a, const float* b, float phaseAlpha, float* outL, float* outR)
+	{
+		float l = 0.0f, r = 0.0f;
+
+		inL += pos - StreamingSamplerVoice::Interpolator::NumSincHistorySamples;
+
+		if (inR != nullptr)
+			inR += pos - StreamingSamplerVoice::Interpolator::NumSincHistorySamples;
+
+		for (int k = 0; k < SincTables::NumTaps; k++)
+		{
+			const float w = a[k] + phaseAlpha * (b[k] - a[k]);
+
+			l += w * inL[k];
+
+			if (inR != nullptr)
+				r += w * inR[k];
+		}
+
+		*outL = l;
+
+		if (inR != nullptr)
+			*outR = r;
+	}
+};
+
+#if SAMPLER_SIMD_INTERPOLATION
+
+struct SincSSE41
+{
+	SAMPLER_TARGET("sse4.1") static inline float sum(__m128 v)
+	{
+		v = _mm_add_ps(v, _mm_movehl_ps(v, v));
+		v = _mm_add_ss(v, _mm_shuffle_ps(v, v, _MM_SHUFFLE(1, 1, 1, 1)));
+		return _mm_cvtss_f32(v);
+	}
+
+	SAMPLER_TARGET("sse4.1") static void process(const float* inL, const float* inR, int pos, const float* a, const float* b, float phaseAlpha, float* outL, float* outR)
+	{
+		const auto f = _mm_set1_ps(phaseAlpha);
+		auto l = _mm_setzero_ps();
+		auto r = _mm_setzero_ps();
+
+		inL += pos - StreamingSamplerVoice::Interpolator::NumSincHistorySamples;
+
+		if (inR != nullptr)
+			inR += pos - StreamingSamplerVoice::Interpolator::NumSincHistorySamples;
+
+		for (int k = 0; k < SincTables::NumTaps; k += 4)
+		{
+			const auto wa = _mm_loadu_ps(a + k);
+			const auto w = _mm_add_ps(wa, _mm_mul_ps(f, _mm_sub_ps(_mm_loadu_ps(b + k), wa)));
+
+			l = _mm_add_ps(l, _mm_mul_ps(w, _mm_loadu_ps(inL + k)));
+
+			if (inR != nullptr)
+				r = _mm_add_ps(r, _mm_mul_ps(w, _mm_loadu_ps(inR + k)));
+		}
+
+		*outL = sum(l);
+
+		if (inR != nullptr)
+			*outR = sum(r);
+	}
+};
+
+#if JUCE_INTEL
+
+struct SincAVX2
+{
+	SAMPLER_TARGET("avx2") static inline float sum(__m256 v)
+	{
+		auto s = _mm_add_ps(_mm256_castps256_ps128(v), _mm256_extractf128_ps(v, 1));
+		s = _mm_add_ps(s, _mm_movehl_ps(s, s));
+		s = _mm_add_ss(s, _mm_shuffle_ps(s, s, _MM_SHUFFLE(1, 1, 1, 1)));
+		return _mm_cvtss_f32(s);
+	}
+
+	SAMPLER_TARGET("avx2") static void process(const float* inL, const float* inR, int pos, const float* a, const float* b, float phaseAlpha, float* outL, float* outR)
+	{
+		const auto f = _mm256_set1_ps(phaseAlpha);
+		auto l = _mm256_setzero_ps();
+		auto r = _mm256_setzero_ps();
+
+		inL += pos - StreamingSamplerVoice::Interpolator::NumSincHistorySamples;
+
+		if (inR != nullptr)
+			inR += pos - StreamingSamplerVoice::Interpolator::NumSincHistorySamples;
+
+		for (int k = 0; k < SincTables::NumTaps; k += 8)
+		{
+			const auto wa = _mm256_loadu_ps(a + k);
+			const auto w = _mm256_add_ps(wa, _mm256_mul_ps(f, _mm256_sub_ps(_mm256_loadu_ps(b + k), wa)));
+
+			l = _mm256_add_ps(l, _mm256_mul_ps(w, _mm256_loadu_ps(inL + k)));
+
+			if (inR != nullptr)
+				r = _mm256_add_ps(r, _mm256_mul_ps(w, _mm256_loadu_ps(inR + k)));
+		}
+
+		*outL = sum(l);
+
+		if (inR != nullptr)
+			*outR = sum(r);
+	}
+};
+
+#endif
+#endif
+
+/** Advances the double precision read index and calculates every output sample with the given kernel. */
+template <class Kernel> static void processSinc(const float* inL, const float* inR, const float* pitchData, float* outL, float* outR, double indexInBuffer, double uptimeDelta, int numSamples, const float* table)
+{
+	for (int i = 0; i < numSamples; i++)
+	{
+		const int pos = (int)indexInBuffer;
+		const double phase = (indexInBuffer - (double)pos) * (double)SincTables::NumPhases;
+		const int phaseIndex = (int)phase;
+
+		const float* a = table + phaseIndex * SincTables::NumTaps;
+
+		Kernel::process(inL, inR, pos, a, a + SincTables::NumTaps, (float)(phase - (double)phaseIndex), outL + i, inR != nullptr ? outR + i : nullptr);
+
+		indexInBuffer += pitchData != nullptr ? (double)pitchData[i] : uptimeDelta;
+	}
+}
+
+} // namespace SimdInterpolation
+
+void StreamingSamplerVoice::Interpolator::setInstructionSet(InstructionSet newInstructionSet)
+{
+	auto s = jmin((int)newInstructionSet, (int)hlac::BitCompressors::getBestSupportedInstructionSet());
+	SimdInterpolation::getCurrentInstructionSet().store(s);
+}
+
+StreamingSamplerVoice::Interpolator::InstructionSet StreamingSamplerVoice::Interpolator::getInstructionSet()
+{
+	return (InstructionSet)SimdInterpolation::getCurrentInstructionSet().load(std::memory_order_relaxed);
+}
+
+void StreamingSamplerVoice::Interpolator::initSincTables()
+{
+	SimdInterpolation::SincTables::get();
+}
+
+void StreamingSamplerVoice::Interpolator::processSinc(const float* inL, const float* inR, const float* pitchData, float* outL, float* outR, int startSample, double indexInBuffer, double uptimeDelta, int numSamples, double pitchRatio)
+{
+	using namespace SimdInterpolation;
+
+	if (pitchData != nullptr)
+		pitchData += startSample;
+
+	auto table = SincTables::get().getTable(pitchRatio);
+
+#if SAMPLER_SIMD_INTERPOLATION
+	const auto instructionSet = getInstructionSet();
+
+#if JUCE_INTEL
+	if (instructionSet == InstructionSet::AVX2)
+	{
+		SimdInterpolation::processSinc<SincAVX2>(inL, inR, pitchData, outL, outR, indexInBuffer, uptimeDelta, numSamples, table);
+		return;
+	}
+#endif
+
+	if (instructionSet != InstructionSet::Scalar)
+	{
+		SimdInterpolation::processSinc<SincSSE41>(inL, inR, pitchData, outL, outR, indexInBuffer, uptimeDelta, numSamples, table);
+		return;
+	}
+#endif
+
+	SimdInterpolation::processSinc<SincScalar>(inL, inR, pitchData, outL, outR, indexInBuffer, uptimeDelta, numSamples, table);
+}
+
+void StreamingSamplerVoice::Interpolator::processMono(const float* in, const float* pitchData, float* out, int startSample, double indexInBuffer, double uptimeDelta, int numSamples, int maxIndexInBuffer)
+{
+	SimdInterpolation::process<float>(in, nullptr, pitchData, out, nullptr, startSample, indexInBuffer, uptimeDelta, numSamples, maxIndexInBuffer);
+}
+
+void StreamingSamplerVoice::Interpolator::processStereo(const float* inL, const float* inR, const float* pitchData, float* outL, float* outR, int startSample, double indexInBuffer, double uptimeDelta, int numSamples, int maxIndexInBuffer)
+{
+	SimdInterpolation::process<float>(inL, inR, pitchData, outL, outR, startSample, indexInBuffer, uptimeDelta, numSamples, maxIndexInBuffer);
+}
+
+void StreamingSamplerVoice::Interpolator::processStereo(const int16* inL, const int16* inR, const float* pitchData, float* outL, float* outR, int startSample, double indexInBuffer, double uptimeDelta, int numSamples, int maxIndexInBuffer)
+{
+	SimdInterpolation::process<int16>(inL, inR, pitchData, outL, outR, startSample, indexInBuffer, uptimeDelta, numSamples, maxIndexInBuffer);
 }
 
 
@@ -721,15 +1238,20 @@ void StreamingSamplerVoice::renderNextBlock(AudioSampleBuffer &outputBuffer, int
 
 		auto tempVoiceBuffer = getTemporaryVoiceBuffer();
 
+		const bool useSinc = interpolationMode == Interpolator::Mode::Sinc;
+
+		// The sinc interpolation needs a few samples after the last read position
+		const double numSamplesToRead = pitchCounter + startAlpha + (useSinc ? (double)(Interpolator::NumSincTaps / 2) : 0.0);
+
 		jassert(tempVoiceBuffer != nullptr);
-		if (!isPositiveAndBelow(pitchCounter + startAlpha, (double)tempVoiceBuffer->getNumSamples()))
+		if (!isPositiveAndBelow(numSamplesToRead, (double)tempVoiceBuffer->getNumSamples()))
 		{
 			jassertfalse;
-			tempVoiceBuffer->setSize(tempVoiceBuffer->getNumChannels(), roundToInt((pitchCounter + startAlpha) * 1.5));
+			tempVoiceBuffer->setSize(tempVoiceBuffer->getNumChannels(), roundToInt(numSamplesToRead * 1.5));
 		}
 
 		// Copy the not resampled values into the voice buffer.
-		StereoChannelData data = loader.fillVoiceBuffer(*tempVoiceBuffer, pitchCounter + startAlpha);
+		StereoChannelData data = loader.fillVoiceBuffer(*tempVoiceBuffer, numSamplesToRead);
 
 		float* outL = outputBuffer.getWritePointer(0, startSample);
 		float* outR = outputBuffer.getWritePointer(1, startSample);
@@ -745,12 +1267,16 @@ void StreamingSamplerVoice::renderNextBlock(AudioSampleBuffer &outputBuffer, int
 
 		double indexInBuffer = startAlpha;
 
-		if (data.b->isFloatingPoint())
+		if (useSinc)
+		{
+			renderWithSincInterpolation(data, outL, outR, startSample, numSamples, startAlpha);
+		}
+		else if (data.b->isFloatingPoint())
 		{
 			const float* const inL = static_cast<const float*>(data.b->getReadPointer(0, data.offsetInBuffer));
 			const float* const inR = static_cast<const float*>(data.b->getReadPointer(1, data.offsetInBuffer));
 
-			interpolateStereoSamples<float, true>(inL, inR, pitchData, outL, outR, startSample, indexInBuffer, uptimeDelta, numSamples, indexInBuffer + samplesAvailable);
+			Interpolator::processStereo(inL, inR, pitchData, outL, outR, startSample, indexInBuffer, uptimeDelta, numSamples, indexInBuffer + samplesAvailable);
 		}
 		else
 		{
@@ -774,20 +1300,20 @@ void StreamingSamplerVoice::renderNextBlock(AudioSampleBuffer &outputBuffer, int
 
 					data.b->convertToFloatWithNormalisation(d, data.b->getNumChannels(), data.offsetInBuffer, numSamplesThisTime);
 
-					interpolateStereoSamples<float, true>(inL_f, inR_f, pitchData, outL, outR, startSample, indexInBuffer, uptimeDelta, numSamples, indexInBuffer + samplesAvailable);
+					Interpolator::processStereo(inL_f, inR_f, pitchData, outL, outR, startSample, indexInBuffer, uptimeDelta, numSamples, numSamplesThisTime);
 				}
 				else
 				{
 					data.b->convertToFloatWithNormalisation(d, 1, data.offsetInBuffer, numSamplesThisTime);
 
-					interpolateMonoSamples<float, true>(inL_f, nullptr, pitchData, outL, nullptr, startSample, indexInBuffer, uptimeDelta, numSamples);
+					Interpolator::processMono(inL_f, pitchData, outL, startSample, indexInBuffer, uptimeDelta, numSamples, numSamplesThisTime);
 
 					memcpy(outR, outL, sizeof(float) * numSamples);
 				}
 			}
 			else
 			{
-				interpolateStereoSamples<int16, false>(inL, inR, pitchData, outL, outR, startSample, indexInBuffer, uptimeDelta, numSamples, indexInBuffer + samplesAvailable);
+				Interpolator::processStereo(inL, inR, pitchData, outL, outR, startSample, indexInBuffer, uptimeDelta, numSamples, indexInBuffer + samplesAvailable);
 			}
 		}
 
@@ -837,6 +1363,57 @@ void StreamingSamplerVoice::renderNextBlock(AudioSampleBuffer &outputBuffer, int
 	}
 };
 
+void StreamingSamplerVoice::renderWithSincInterpolation(const StereoChannelData& data, float* outL, float* outR, int startSample, int numSamples, double startAlpha)
+{
+	constexpr int numHistory = Interpolator::NumSincHistorySamples;
+
+	const int numSamplesThisTime = (int)(ceil)(pitchCounter + startAlpha) + 1 + Interpolator::NumSincTaps / 2;
+	const int numSamplesAvailable = jlimit(0, numSamplesThisTime, data.b->getNumSamples() - data.offsetInBuffer);
+
+	const bool useNormalisation = !data.b->isFloatingPoint() && data.b->usesNormalisation();
+	const bool isStereo = data.b->getNumChannels() == 2 && !(useNormalisation && data.b->useOneMap);
+	const int numChannels = isStereo ? 2 : 1;
+
+	float* d[2] = { nullptr, nullptr };
+
+	for (int c = 0; c < numChannels; c++)
+	{
+		auto scratch = (float*)alloca(sizeof(float) * (numHistory + numSamplesThisTime));
+
+		memcpy(scratch, sincHistory[c], sizeof(float) * numHistory);
+		d[c] = scratch + numHistory;
+
+		if (data.b->isFloatingPoint())
+			FloatVectorOperations::copy(d[c], static_cast<const float*>(data.b->getReadPointer(c, data.offsetInBuffer)), numSamplesAvailable);
+		else if (!useNormalisation)
+			hlac::CompressionHelpers::fastInt16ToFloat(data.b->getReadPointer(c, data.offsetInBuffer), d[c], numSamplesAvailable);
+
+		FloatVectorOperations::clear(d[c] + numSamplesAvailable, numSamplesThisTime - numSamplesAvailable);
+	}
+
+	if (useNormalisation)
+		data.b->convertToFloatWithNormalisation(d, numChannels, data.offsetInBuffer, numSamplesAvailable);
+
+	Interpolator::processSinc(d[0], d[1], pitchData, outL, outR, startSample, startAlpha, uptimeDelta, numSamples, pitchCounter / (double)numSamples);
+
+	if (!isStereo)
+		memcpy(outR, outL, sizeof(float) * numSamples);
+
+	// Store the samples before the next read position
+	const int numToAdvance = (int)(voiceUptime + pitchCounter) - (int)voiceUptime;
+
+	for (int c = 0; c < 2; c++)
+		memcpy(sincHistory[c], d[isStereo ? c : 0] - numHistory + numToAdvance, sizeof(float) * numHistory);
+}
+
+void StreamingSamplerVoice::setInterpolationMode(Interpolator::Mode newMode)
+{
+	if (newMode == Interpolator::Mode::Sinc)
+		Interpolator::initSincTables();
+
+	interpolationMode = newMode;
+}
+
 void StreamingSamplerVoice::setPitchFactor(int midiNote, int rootNote, StreamingSamplerSound *sound, double globalPitchFactor)
 {
 	if (midiNote == rootNote)
@@ -897,7 +1474,7 @@ void StreamingSamplerVoice::initTemporaryVoiceBuffer(hlac::HiseSampleBuffer* buf
 	// The channel amount must be set correctly in the constructor
 	jassert(bufferToUse->getNumChannels() > 0);
 
-    auto requiredSampleAmount = roundToInt((double)samplesPerBlock* maxPitchRatio);
+    auto requiredSampleAmount = roundToInt((double)samplesPerBlock* maxPitchRatio) + Interpolator::NumSincTaps;
     
 	if (bufferToUse->getNumSamples() < requiredSampleAmount)
 	{
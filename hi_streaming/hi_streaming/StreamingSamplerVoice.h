@@ -200,6 +200,9 @@ private:
 	// just a pointer to the used pool
 	SampleThreadPool *backgroundPool;
 
+	// the voice is only rendered by one thread at once, so it can use its own queue slot
+	ScopedPointer<SampleThreadPool::ProducerToken> producerToken;
+
 	// the internal buffers
 
 	hlac::HiseSampleBuffer b1, b2;
@@ -297,10 +300,77 @@ public:
 	/** Set this to false if you're using HLAC compressed monoliths. */
 	void setStreamingBufferDataType(bool shouldBeFloat);
 
+	/** Fetches the streamed data synchronously in the render call (see SampleLoader::setIsNonRealtime()). */
+	void setIsNonRealtime(bool shouldBeNonRealtime) { loader.setIsNonRealtime(shouldBeNonRealtime); }
+
+	/** The linear interpolation kernels that resample the streamed data.
+	*
+	*	They calculate 8 (AVX2) or 4 (SSE4.1 / NEON) output samples at once. The instruction set is detected
+	*	at runtime, the remaining samples at the end of each block are calculated by the scalar code.
+	*/
+	struct Interpolator
+	{
+		using InstructionSet = hlac::BitCompressors::InstructionSet;
+
+		/** Overrides the automatic detection (this is used by the unit tests to compare the implementations). */
+		static void setInstructionSet(InstructionSet newInstructionSet);
+
+		static InstructionSet getInstructionSet();
+
+		/** Resamples the data using the pitch values (or the constant uptimeDelta if pitchData is nullptr).
+		*
+		*	maxIndexInBuffer is the number of samples that can be read from the source.
+		*/
+		static void processMono(const float* in, const float* pitchData, float* out, int startSample, double indexInBuffer, double uptimeDelta, int numSamples, int maxIndexInBuffer);
+
+		static void processStereo(const float* inL, const float* inR, const float* pitchData, float* outL, float* outR, int startSample, double indexInBuffer, double uptimeDelta, int numSamples, int maxIndexInBuffer);
+
+		/** Resamples the 16 bit data and converts it to the float range. */
+		static void processStereo(const int16* inL, const int16* inR, const float* pitchData, float* outL, float* outR, int startSample, double indexInBuffer, double uptimeDelta, int numSamples, int maxIndexInBuffer);
+
+		/** The interpolation algorithms of the voice. */
+		enum class Mode
+		{
+			Linear = 0, ///< linear interpolation between two samples
+			Sinc, ///< a polyphase windowed sinc kernel with NumSincTaps taps
+			numModes
+		};
+
+		/** The number of samples that are used to calculate one output sample with the sinc interpolation. */
+		static constexpr int NumSincTaps = 32;
+
+		/** The number of samples before the read position that the sinc interpolation needs. */
+		static constexpr int NumSincHistorySamples = NumSincTaps / 2 - 1;
+
+		/** Calculates the sinc tables. Call this before using the sinc interpolation so that the audio thread doesn't have to do it. */
+		static void initSincTables();
+
+		/** Resamples the float data with the sinc interpolation.
+		*
+		*	The read index is a double so that long notes don't lose precision. The source must contain NumSincHistorySamples
+		*	samples before the start and NumSincTaps / 2 samples after the last read position. pitchRatio is the average pitch
+		*	ratio of the block and is used to select the cutoff frequency. If inR is nullptr, only the left channel will be calculated.
+		*/
+		static void processSinc(const float* inL, const float* inR, const float* pitchData, float* outL, float* outR, int startSample, double indexInBuffer, double uptimeDelta, int numSamples, double pitchRatio);
+	};
+
+	/** Sets the interpolation algorithm that is used to resample the streamed data. */
+	void setInterpolationMode(Interpolator::Mode newMode);
+
+	Interpolator::Mode getInterpolationMode() const noexcept { return interpolationMode; }
+
 private:
 
+	/** Converts the streamed data to float, prepends the last samples of the previous block and renders it with the sinc interpolation. */
+	void renderWithSincInterpolation(const StereoChannelData& data, float* outL, float* outR, int startSample, int numSamples, double startAlpha);
+
 	double pitchCounter = 0.0;
 
+	Interpolator::Mode interpolationMode = Interpolator::Mode::Linear;
+
+	// the source samples before the current read position (needed by the sinc interpolation)
+	float sincHistory[2][Interpolator::NumSincHistorySamples];
+
 	hlac::HiseSampleBuffer* tvb = nullptr;
 
 	const float *pitchData;
@@ -0,0 +1,837 @@
+/*  ===========================================================================
+*
+*   This file is part of HISE.
+*   Copyright 2016 Christoph Hart
+*
+*   HISE is free software: you can redistribute it and/or modify
+*   it under the terms of the GNU General Public License as published by
+*   the Free Software Foundation, either version 3 of the License, or
+*   (at your option) any later version.
+*
+*   HISE is distributed in the hope that it will be useful,
+*   but WITHOUT ANY WARRANTY; without even the implied warranty of
+*   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*   GNU General Public License for more details.
+*
+*   You should have received a copy of the GNU General Public License
+*   along with HISE.  If not, see <http://www.gnu.org/licenses/>.
+*
+*   Commercial licenses for using HISE in an closed source project are
+*   available on request. Please visit the project's website to get more
+*   information about commercial licensing:
+*
+*   http://www.hise.audio/
+*
+*   HISE is based on the JUCE library,
+*   which also must be licenced for commercial applications:
+*
+*   http://www.juce.com
+*
+*   ===========================================================================
+*/
+
+#include "AppConfig.h"
+
+#if HI_RUN_UNIT_TESTS
+
+#include  "JuceHeader.h"
+
+using namespace hise;
+
+class SampleThreadPoolTest : public UnitTest
+{
+public:
+
+	struct CountingJob : public SampleThreadPool::Job
+	{
+		CountingJob() :
+			Job("CountingJob")
+		{};
+
+		JobStatus runJob() override
+		{
+			if (isExecuting.exchange(true))
+				numOverlaps++;
+
+			if (clearFlag != nullptr && clearFlag->load())
+				numCallsAfterClear++;
+
+			numCalls++;
+			isExecuting.store(false);
+			return jobHasFinished;
+		}
+
+		std::atomic<bool> isExecuting = { false };
+		std::atomic<int> numCalls = { 0 };
+		std::atomic<int> numOverlaps = { 0 };
+
+		const std::atomic<bool>* clearFlag = nullptr;
+		std::atomic<int> numCallsAfterClear = { 0 };
+	};
+
+	struct BlockingJob : public SampleThreadPool::Job
+	{
+		BlockingJob() :
+			Job("BlockingJob")
+		{};
+
+		JobStatus runJob() override
+		{
+			started.signal();
+			release.wait(5000);
+			finished.store(true);
+			return jobHasFinished;
+		}
+
+		WaitableEvent started, release;
+		std::atomic<bool> finished = { false };
+	};
+
+	/** Calls clearPendingTasks() and checks whether the blocking job was finished when it returned. */
+	struct ClearThread : public Thread
+	{
+		ClearThread(SampleThreadPool& pool_, BlockingJob& job_) :
+			Thread("Clear Thread"),
+			pool(pool_),
+			job(job_)
+		{}
+
+		void run() override
+		{
+			aboutToClear.signal();
+			pool.clearPendingTasks();
+			jobWasFinished.store(job.finished.load());
+			cleared.store(true);
+		}
+
+		SampleThreadPool& pool;
+		BlockingJob& job;
+		WaitableEvent aboutToClear;
+		std::atomic<bool> jobWasFinished = { false };
+		std::atomic<bool> cleared = { false };
+	};
+
+	/** Adds its jobs over and over again until each one was executed numRounds times. */
+	struct Producer : public Thread
+	{
+		Producer(SampleThreadPool& pool_, int index, int numRounds_) :
+			Thread("Producer " + String(index)),
+			pool(pool_),
+			token(pool_),
+			numRounds(numRounds_),
+			useToken(index % 2 == 0)
+		{
+			for (int i = 0; i < 16; i++)
+				jobs.add(new CountingJob());
+		}
+
+		void run() override
+		{
+			Random r;
+
+			for (int round = 0; round < numRounds; round++)
+			{
+				for (auto j : jobs)
+				{
+					while (j->isQueued())
+					{
+						if (threadShouldExit())
+							return;
+
+						Thread::yield();
+					}
+
+					if (r.nextBool())
+						j->setDeadline(r.nextInt(4096));
+
+					if (useToken)
+						pool.addJob(j, token);
+					else
+						pool.addJob(j, false);
+				}
+			}
+		}
+
+		SampleThreadPool& pool;
+		SampleThreadPool::ProducerToken token;
+		const int numRounds;
+		const bool useToken;
+		OwnedArray<CountingJob> jobs;
+	};
+
+	SampleThreadPoolTest() :
+		UnitTest("Testing sample thread pool")
+	{}
+
+	void runTest() override
+	{
+		testConcurrentProducers();
+		testCancellation();
+	}
+
+private:
+
+	static bool waitUntilIdle(OwnedArray<CountingJob>& jobs)
+	{
+		auto timeout = Time::getMillisecondCounter() + 10000;
+
+		for (auto j : jobs)
+		{
+			while (j->isQueued())
+			{
+				if (Time::getMillisecondCounter() > timeout)
+					return false;
+
+				Thread::sleep(1);
+			}
+		}
+
+		return true;
+	}
+
+	void testConcurrentProducers()
+	{
+		beginTest("Adding jobs from 8 concurrent producers");
+
+		SampleThreadPool pool(2);
+
+		const int numRounds = 200;
+
+		OwnedArray<Producer> producers;
+
+		for (int i = 0; i < 8; i++)
+			producers.add(new Producer(pool, i, numRounds));
+
+		for (auto p : producers)
+			p->startThread();
+
+		for (auto p : producers)
+			expect(p->waitForThreadToExit(20000), "producer finished");
+
+		for (auto p : producers)
+		{
+			expect(waitUntilIdle(p->jobs), "all jobs executed");
+
+			for (auto j : p->jobs)
+			{
+				expectEquals(j->numCalls.load(), numRounds, "call amount");
+				expectEquals(j->numOverlaps.load(), 0, "no concurrent execution of the same job");
+			}
+		}
+	}
+
+	void testCancellation()
+	{
+		beginTest("Cancelling pending jobs while a job is running");
+
+		SampleThreadPool pool(1);
+
+		BlockingJob blockingJob;
+		pool.addJob(&blockingJob, false);
+		expect(blockingJob.started.wait(2000), "blocking job started");
+
+		ClearThread clearThread(pool, blockingJob);
+
+		OwnedArray<CountingJob> jobs;
+
+		for (int i = 0; i < 64; i++)
+		{
+			jobs.add(new CountingJob());
+			jobs.getLast()->clearFlag = &clearThread.cleared;
+			pool.addJob(jobs.getLast(), false);
+		}
+
+		clearThread.startThread();
+
+		expect(clearThread.aboutToClear.wait(2000), "clear thread started");
+		expect(blockingJob.isRunning(), "running job is not interrupted");
+
+		blockingJob.release.signal();
+
+		expect(clearThread.waitForThreadToExit(5000), "clearPendingTasks() returned");
+		expect(clearThread.jobWasFinished.load(), "clearPendingTasks() waits for the running job");
+
+		CountingJob jobAfterClear;
+		pool.addJob(&jobAfterClear, false);
+
+		expect(waitUntilIdle(jobs), "cancelled jobs are not queued anymore");
+
+		// A job might be picked up between the release and the clear call, but
+		// no cancelled job may be executed after clearPendingTasks() returned
+		for (auto j : jobs)
+			expectEquals(j->numCallsAfterClear.load(), 0, "cancelled job was not executed");
+
+		auto timeout = Time::getMillisecondCounter() + 2000;
+
+		while (jobAfterClear.numCalls.load() == 0 && Time::getMillisecondCounter() < timeout)
+			Thread::sleep(1);
+
+		expectEquals(jobAfterClear.numCalls.load(), 1, "job added after clear is executed");
+	}
+};
+
+static SampleThreadPoolTest sampleThreadPoolTest;
+
+class SamplerInterpolationTest : public UnitTest
+{
+public:
+
+	using Interpolator = StreamingSamplerVoice::Interpolator;
+	using InstructionSet = Interpolator::InstructionSet;
+
+	SamplerInterpolationTest() :
+		UnitTest("Testing sampler interpolation")
+	{}
+
+	void runTest() override
+	{
+		auto best = Interpolator::getInstructionSet();
+
+		createSourceData();
+
+		for (int i = 1; i <= (int)hlac::BitCompressors::getBestSupportedInstructionSet(); i++)
+			testInstructionSet((InstructionSet)i);
+
+		testSincAccuracy();
+
+		for (int i = 1; i <= (int)hlac::BitCompressors::getBestSupportedInstructionSet(); i++)
+			testSinc((InstructionSet)i);
+
+		testSincVoiceContinuity();
+
+		benchmark();
+
+		Interpolator::setInstructionSet(best);
+	}
+
+private:
+
+	static constexpr int NumSourceSamples = 4096;
+	static constexpr int BlockSize = 512;
+
+	void createSourceData()
+	{
+		Random r;
+
+		for (int c = 0; c < 2; c++)
+		{
+			floatData[c].calloc(NumSourceSamples);
+			intData[c].calloc(NumSourceSamples);
+
+			// A low frequency signal so that rounding differences of the read index don't matter
+			for (int i = 0; i < NumSourceSamples; i++)
+			{
+				auto v = 0.9f * std::sin((float)i * 0.03f + (float)c) + r.nextFloat() * 0.001f;
+				floatData[c][i] = v;
+				intData[c][i] = (int16)(v * (float)INT16_MAX);
+			}
+		}
+
+		pitchValues.calloc(BlockSize);
+
+		for (int i = 0; i < BlockSize; i++)
+			pitchValues[i] = 0.5f + 1.5f * r.nextFloat();
+	}
+
+	template <typename SignalType> void render(const HeapBlock<SignalType>* data, bool useModulation, double delta, int numSamples, int maxIndex, HeapBlock<float>* out)
+	{
+		auto p = useModulation ? pitchValues.get() : nullptr;
+
+		Interpolator::processStereo(data[0].get(), data[1].get(), p, out[0].get(), out[1].get(), 0, 0.37, delta, numSamples, maxIndex);
+	}
+
+	template <typename SignalType> void compareWithScalar(InstructionSet s, const HeapBlock<SignalType>* data, bool useModulation, double delta, int numSamples, int maxIndex)
+	{
+		HeapBlock<float> expected[2], actual[2];
+
+		// Add a guard sample after each channel to detect buffer overruns
+		for (int c = 0; c < 2; c++)
+		{
+			expected[c].calloc(numSamples + 1);
+			actual[c].calloc(numSamples + 1);
+			actual[c][numSamples] = 42.0f;
+		}
+
+		Interpolator::setInstructionSet(InstructionSet::Scalar);
+		render(data, useModulation, delta, numSamples, maxIndex, expected);
+
+		Interpolator::setInstructionSet(s);
+		render(data, useModulation, delta, numSamples, maxIndex, actual);
+
+		for (int c = 0; c < 2; c++)
+		{
+			expectEquals(actual[c][numSamples], 42.0f, "buffer overrun");
+
+			float maxError = 0.0f;
+
+			for (int i = 0; i < numSamples; i++)
+				maxError = jmax(maxError, std::abs(expected[c][i] - actual[c][i]));
+
+			expect(maxError < 0.005f, "deviation to scalar code: " + String(maxError) + ", numSamples: " + String(numSamples) + ", delta: " + String(delta));
+		}
+	}
+
+	void testInstructionSet(InstructionSet s)
+	{
+		beginTest("Comparing " + hlac::BitCompressors::getInstructionSetName(s) + " interpolation with scalar code");
+
+		const double deltas[] = { 0.25, 0.5, 0.97, 1.0, 1.5, 2.99 };
+
+		for (int numSamples : { 1, 3, 7, 8, 9, 31, BlockSize })
+		{
+			for (auto d : deltas)
+			{
+				compareWithScalar(s, floatData, false, d, numSamples, NumSourceSamples);
+				compareWithScalar(s, intData, false, d, numSamples, NumSourceSamples);
+			}
+
+			compareWithScalar(s, floatData, true, 1.0, numSamples, NumSourceSamples);
+			compareWithScalar(s, intData, true, 1.0, numSamples, NumSourceSamples);
+		}
+
+		// The kernels must stop before they read past the end
+		compareWithScalar(s, intData, false, 2.0, BlockSize, 200);
+		compareWithScalar(s, floatData, false, 1.5, BlockSize, 200);
+	}
+
+	/** Renders the float data with the sinc interpolation (the first samples are used as history). */
+	void renderSinc(bool useModulation, double delta, double pitchRatio, int numSamples, HeapBlock<float>* out)
+	{
+		const int offset = Interpolator::NumSincHistorySamples;
+		auto p = useModulation ? pitchValues.get() : nullptr;
+
+		Interpolator::processSinc(floatData[0] + offset, floatData[1] + offset, p, out[0].get(), out[1].get(), 0, 0.37, delta, numSamples, pitchRatio);
+	}
+
+	void testSincAccuracy()
+	{
+		beginTest("Testing sinc interpolation accuracy");
+
+		Interpolator::setInstructionSet(InstructionSet::Scalar);
+
+		const int offset = Interpolator::NumSincHistorySamples;
+		const double w = 0.3;
+
+		HeapBlock<float> source, out[2];
+		source.calloc(NumSourceSamples);
+		out[0].calloc(BlockSize);
+
+		for (int i = 0; i < NumSourceSamples; i++)
+			source[i] = (float)std::sin(w * (double)(i - offset));
+
+		for (auto delta : { 0.5, 0.97, 1.0 })
+		{
+			Interpolator::processSinc(source + offset, nullptr, nullptr, out[0].get(), nullptr, 0, 0.37, delta, BlockSize, delta);
+
+			float maxError = 0.0f;
+
+			for (int i = 0; i < BlockSize; i++)
+			{
+				auto expected = (float)std::sin(w * (0.37 + delta * (double)i));
+				maxError = jmax(maxError, std::abs(out[0][i] - expected));
+			}
+
+			expect(maxError < 0.001f, "sinc deviation: " + String(maxError) + ", delta: " + String(delta));
+		}
+	}
+
+	void testSinc(InstructionSet s)
+	{
+		beginTest("Comparing " + hlac::BitCompressors::getInstructionSetName(s) + " sinc interpolation with scalar code");
+
+		HeapBlock<float> expected[2], actual[2];
+
+		for (int c = 0; c < 2; c++)
+		{
+			expected[c].calloc(BlockSize);
+			actual[c].calloc(BlockSize);
+		}
+
+		for (auto useModulation : { false, true })
+		{
+			for (auto ratio : { 1.0, 1.4, 2.7, 5.0 })
+			{
+				Interpolator::setInstructionSet(InstructionSet::Scalar);
+				renderSinc(useModulation, ratio, ratio, BlockSize, expected);
+
+				Interpolator::setInstructionSet(s);
+				renderSinc(useModulation, ratio, ratio, BlockSize, actual);
+
+				for (int c = 0; c < 2; c++)
+				{
+					float maxError = 0.0f;
+
+					for (int i = 0; i < BlockSize; i++)
+						maxError = jmax(maxError, std::abs(expected[c][i] - actual[c][i]));
+
+					expect(maxError < 0.0001f, "deviation to scalar code: " + String(maxError));
+				}
+			}
+		}
+	}
+
+	/** Streams a sample file through a voice with changing block sizes and compares the output with
+		a single sinc interpolation pass over the entire file. If the voice loses the history samples
+		at a block or streaming buffer boundary, the output will deviate around that position.
+	*/
+	void testSincVoiceContinuity()
+	{
+		beginTest("Testing sinc interpolation history across block and buffer boundaries");
+
+		Interpolator::setInstructionSet(InstructionSet::Scalar);
+
+		const int numFileSamples = 24000;
+		const int numOutputSamples = 12000;
+		const int maxBlockSize = 512;
+		const double sampleRate = 44100.0;
+
+		AudioSampleBuffer fileData(2, numFileSamples);
+
+		for (int i = 0; i < numFileSamples; i++)
+		{
+			fileData.setSample(0, i, 0.8f * std::sin((float)i * 0.05f));
+			fileData.setSample(1, i, 0.5f * std::sin((float)i * 0.11f + 1.0f));
+		}
+
+		TemporaryFile tempFile(".wav");
+
+		{
+			WavAudioFormat wav;
+			ScopedPointer<AudioFormatWriter> writer = wav.createWriterFor(new FileOutputStream(tempFile.getFile()), sampleRate, 2, 32, {}, 0);
+
+			expect(writer != nullptr, "create writer");
+
+			if (writer == nullptr)
+				return;
+
+			writer->writeFromAudioSampleBuffer(fileData, 0, numFileSamples);
+		}
+
+		// The history before the first sample is silent and the reference needs a few samples after the end
+		const int offset = Interpolator::NumSincHistorySamples;
+		AudioSampleBuffer padded(2, numFileSamples + offset + Interpolator::NumSincTaps);
+		padded.clear();
+
+		for (int c = 0; c < 2; c++)
+			padded.copyFrom(c, offset, fileData, c, 0, numFileSamples);
+
+		StreamingSamplerSoundPool soundPool;
+		SampleThreadPool threadPool(1);
+
+		StreamingSamplerSound::Ptr sound = new StreamingSamplerSound(tempFile.getFile().getFullPathName(), &soundPool);
+
+		// Use the smallest preload size so that the voice has to switch between the streaming buffers
+		sound->setPreloadSize(2048, true);
+
+		expect(!sound->isEntireSampleLoaded(), "sample is streamed");
+
+		hlac::HiseSampleBuffer voiceBuffer(true, 2, 0);
+		StreamingSamplerVoice::initTemporaryVoiceBuffer(&voiceBuffer, maxBlockSize, (double)MAX_SAMPLER_PITCH);
+
+		const int blockSizes[] = { 512, 37, 1, 256, 129, 500, 64, 3 };
+
+		for (auto delta : { 1.0, 0.73, 1.37 })
+		{
+			StreamingSamplerVoice voice(&threadPool);
+			voice.setTemporaryVoiceBuffer(&voiceBuffer);
+			voice.setIsNonRealtime(true);
+			voice.setInterpolationMode(Interpolator::Mode::Sinc);
+			voice.prepareToPlay(sampleRate, maxBlockSize);
+
+			voice.setPitchFactor(60, 60, sound.get(), delta);
+			voice.startNote(60, 1.0f, sound.get(), 0);
+
+			AudioSampleBuffer actual(2, numOutputSamples);
+			actual.clear();
+
+			int pos = 0;
+			int blockIndex = 0;
+
+			while (pos < numOutputSamples && voice.getLoadedSound() != nullptr)
+			{
+				auto numThisTime = jmin(blockSizes[blockIndex++ % numElementsInArray(blockSizes)], numOutputSamples - pos);
+
+				voice.setPitchCounterForThisBlock(voice.getUptimeDelta() * (double)numThisTime);
+				voice.renderNextBlock(actual, pos, numThisTime);
+				pos += numThisTime;
+			}
+
+			expectEquals(pos, numOutputSamples, "voice was not stopped");
+
+			AudioSampleBuffer expected(2, numOutputSamples);
+
+			Interpolator::processSinc(padded.getReadPointer(0, offset), padded.getReadPointer(1, offset), nullptr,
+									  expected.getWritePointer(0), expected.getWritePointer(1), 0, 0.0, delta, numOutputSamples, delta);
+
+			for (int c = 0; c < 2; c++)
+			{
+				float maxError = 0.0f;
+				int maxErrorIndex = 0;
+
+				for (int i = 0; i < numOutputSamples; i++)
+				{
+					auto error = std::abs(expected.getSample(c, i) - actual.getSample(c, i));
+
+					if (error > maxError)
+					{
+						maxError = error;
+						maxErrorIndex = i;
+					}
+				}
+
+				expect(maxError < 0.0001f, "deviation: " + String(maxError) + " at " + String(maxErrorIndex) + ", delta: " + String(delta));
+			}
+
+			voice.resetVoice();
+		}
+	}
+
+	void benchmark()
+	{
+		beginTest("Benchmarking sampler interpolation");
+
+		HeapBlock<float> out[2];
+		out[0].calloc(BlockSize);
+		out[1].calloc(BlockSize);
+
+		const int numBlocks = 4000;
+
+		// The time that is available for one block at 44.1kHz
+		const double blockTime = (double)BlockSize / 44100.0;
+
+		for (int i = 0; i <= (int)hlac::BitCompressors::getBestSupportedInstructionSet(); i++)
+		{
+			auto s = (InstructionSet)i;
+			Interpolator::setInstructionSet(s);
+
+			for (auto useSinc : { false, true })
+			{
+				for (auto useModulation : { false, true })
+				{
+					auto start = Time::getMillisecondCounterHiRes();
+
+					for (int b = 0; b < numBlocks; b++)
+					{
+						if (useSinc)
+							renderSinc(useModulation, 1.1, 1.1, BlockSize, out);
+						else
+							render(intData, useModulation, 1.1, BlockSize, NumSourceSamples, out);
+					}
+
+					auto seconds = (Time::getMillisecondCounterHiRes() - start) * 0.001 / (double)numBlocks;
+
+					String m;
+					m << hlac::BitCompressors::getInstructionSetName(s);
+					m << (useSinc ? " Sinc" : " Linear");
+					m << (useModulation ? " (pitch modulation): " : " (constant pitch): ");
+					m << String(roundToInt(blockTime / seconds)) << " voices / core";
+
+					logMessage(m);
+				}
+			}
+		}
+	}
+
+	HeapBlock<float> floatData[2];
+	HeapBlock<int16> intData[2];
+	HeapBlock<float> pitchValues;
+};
+
+static SamplerInterpolationTest samplerInterpolationTest;
+
+class MappedPreloadBufferTest : public UnitTest
+{
+public:
+
+	MappedPreloadBufferTest() :
+		UnitTest("Testing read only preload buffer views")
+	{}
+
+	static constexpr int NumSamples = 1000;
+
+	void runTest() override
+	{
+		HeapBlock<int16> data;
+		data.calloc(NumSamples * 2);
+
+		for (int i = 0; i < NumSamples; i++)
+		{
+			data[2 * i] = (int16)i;
+			data[2 * i + 1] = (int16)-i;
+		}
+
+		beginTest("Testing mono view");
+
+		{
+			auto view = hlac::HiseSampleBuffer::createReadOnlyView(data, 1, NumSamples);
+
+			expect(view.isReadOnlyView(), "is view");
+			expect(!view.isInterleaved(), "mono is not interleaved");
+			expectEquals(view.getNumSamples(), NumSamples, "size");
+			expect(view.getReadPointer(0, 10) == data.get() + 10, "no copy");
+		}
+
+		beginTest("Testing interleaved stereo view");
+
+		{
+			auto view = hlac::HiseSampleBuffer::createReadOnlyView(data, 2, NumSamples);
+
+			expect(view.isInterleaved(), "stereo is interleaved");
+			expectEquals(view.getNumSamples(), NumSamples, "size");
+
+			hlac::HiseSampleBuffer b(false, 2, 256);
+			hlac::HiseSampleBuffer::copy(b, view, 6, 300, 250);
+
+			expectChannels(b, 6, 300, 250);
+
+			view.copyReadOnlyViewIntoOwnedData();
+
+			expect(!view.isReadOnlyView(), "not a view after copying");
+			expect(!view.isInterleaved(), "deinterleaved after copying");
+			expect(view.getReadPointer(0) != data.get(), "owns data");
+			expectChannels(view, 0, 0, NumSamples);
+
+			auto w = static_cast<int16*>(view.getWritePointer(0, 0));
+			w[0] = 42;
+			expectEquals((int)data[0], 0, "source is untouched");
+		}
+
+		testMonolithSound(1);
+		testMonolithSound(2);
+	}
+
+	/** Writes an uncompressed monolith, loads a sound from it and streams it through a voice.
+
+		If HISE_USE_MAPPED_PRELOAD_BUFFERS is enabled, the preload buffer points into the mapped file
+		and the voice has to deinterleave the stereo data when it reads from the preload buffer.
+	*/
+	void testMonolithSound(int numChannels)
+	{
+		beginTest("Testing " + String(numChannels == 2 ? "stereo" : "mono") + " monolith preload buffer");
+
+		const int numFileSamples = 20000;
+		const int numOutputSamples = 12000;
+		const int maxBlockSize = 512;
+		const double sampleRate = 44100.0;
+
+		HeapBlock<int16> fileData;
+		fileData.calloc(numFileSamples * numChannels);
+
+		for (int i = 0; i < numFileSamples; i++)
+		{
+			for (int c = 0; c < numChannels; c++)
+				fileData[i * numChannels + c] = (int16)(0.8f * std::sin((float)i * 0.05f + (float)c) * (float)INT16_MAX);
+		}
+
+		TemporaryFile tempFile(".ch1");
+
+		{
+			FileOutputStream fos(tempFile.getFile());
+
+			// The old monolith format just stores the channel amount (0 = stereo, 1 = mono) before the interleaved data
+			fos.writeByte(numChannels == 2 ? 0 : 1);
+
+			for (int i = 0; i < numFileSamples * numChannels; i++)
+				fos.writeShort(fileData[i]);
+		}
+
+		ValueTree sampleMap("samplemap");
+		ValueTree sample("sample");
+		sample.setProperty(MonolithIds::MonolithOffset, 0, nullptr);
+		sample.setProperty(MonolithIds::MonolithLength, numFileSamples, nullptr);
+		sample.setProperty("SampleRate", sampleRate, nullptr);
+		sample.setProperty(MonolithIds::FileName, "sample.wav", nullptr);
+		sampleMap.addChild(sample, -1, nullptr);
+
+		Array<File> monolithFiles;
+		monolithFiles.add(tempFile.getFile());
+
+		HlacMonolithInfo::Ptr info = new HlacMonolithInfo(monolithFiles);
+		info->fillMetadataInfo(sampleMap);
+
+		StreamingSamplerSound::Ptr sound = new StreamingSamplerSound(info, 0, 0);
+		sound->setPreloadSize(4096, true);
+
+		const bool useView = HISE_USE_MAPPED_PRELOAD_BUFFERS != 0;
+
+		expect(!sound->isEntireSampleLoaded(), "sample is streamed");
+		expect(sound->getPreloadBuffer().isReadOnlyView() == useView, "preload buffer is mapped");
+		expect(sound->getPreloadBuffer().isInterleaved() == (useView && numChannels == 2), "interleaved preload buffer");
+
+		sound->setReversed(true);
+		expect(!sound->getPreloadBuffer().isReadOnlyView(), "reversed samples are copied");
+
+		sound->setReversed(false);
+		expect(sound->getPreloadBuffer().isReadOnlyView() == useView, "mapped again after reversing back");
+
+		StreamingSamplerSoundPool soundPool;
+		SampleThreadPool threadPool(1);
+
+		hlac::HiseSampleBuffer voiceBuffer(true, 2, 0);
+		StreamingSamplerVoice::initTemporaryVoiceBuffer(&voiceBuffer, maxBlockSize, (double)MAX_SAMPLER_PITCH);
+
+		StreamingSamplerVoice voice(&threadPool);
+		voice.setTemporaryVoiceBuffer(&voiceBuffer);
+		voice.setIsNonRealtime(true);
+		voice.setInterpolationMode(StreamingSamplerVoice::Interpolator::Mode::Linear);
+		voice.prepareToPlay(sampleRate, maxBlockSize);
+
+		voice.setPitchFactor(60, 60, sound.get(), 1.0);
+		voice.startNote(60, 1.0f, sound.get(), 0);
+
+		AudioSampleBuffer actual(2, numOutputSamples);
+		actual.clear();
+
+		const int blockSizes[] = { 512, 37, 1, 256, 129, 500, 64, 3 };
+
+		int pos = 0;
+		int blockIndex = 0;
+
+		while (pos < numOutputSamples && voice.getLoadedSound() != nullptr)
+		{
+			auto numThisTime = jmin(blockSizes[blockIndex++ % numElementsInArray(blockSizes)], numOutputSamples - pos);
+
+			voice.setPitchCounterForThisBlock(voice.getUptimeDelta() * (double)numThisTime);
+			voice.renderNextBlock(actual, pos, numThisTime);
+			pos += numThisTime;
+		}
+
+		voice.resetVoice();
+
+		expectEquals(pos, numOutputSamples, "voice was not stopped");
+
+		for (int c = 0; c < 2; c++)
+		{
+			float maxError = 0.0f;
+			const int sourceChannel = jmin(c, numChannels - 1);
+
+			for (int i = 0; i < numOutputSamples; i++)
+			{
+				auto expected = (float)fileData[i * numChannels + sourceChannel] / (float)INT16_MAX;
+				maxError = jmax(maxError, std::abs(expected - actual.getSample(c, i)));
+			}
+
+			expect(maxError < 0.001f, "channel " + String(c) + " deviation: " + String(maxError));
+		}
+	}
+
+	void expectChannels(const hlac::HiseSampleBuffer& b, int offset, int expectedStart, int numSamples)
+	{
+		auto l = static_cast<const int16*>(b.getReadPointer(0, offset));
+		auto r = static_cast<const int16*>(b.getReadPointer(1, offset));
+
+		bool ok = true;
+
+		for (int i = 0; i < numSamples; i++)
+		{
+			ok &= l[i] == (int16)(expectedStart + i);
+			ok &= r[i] == (int16)-(expectedStart + i);
+		}
+
+		expect(ok, "deinterleaved data matches");
+	}
+};
+
+static MappedPreloadBufferTest mappedPreloadBufferTest;
+
+#endif
@@ -365,6 +365,68 @@ HiseEventBuffer::HiseEventBuffer()
 	clear();
 }
 
+HiseEventBuffer::HiseEventBuffer(const HiseEventBuffer& other) :
+	HiseEventBuffer()
+{
+	setCapacity(other.capacity);
+	copyFrom(other);
+}
+
+HiseEventBuffer& HiseEventBuffer::operator=(const HiseEventBuffer& other)
+{
+	if (this != &other)
+	{
+		if (other.capacity > capacity)
+			setCapacity(other.capacity);
+
+		copyFrom(other);
+	}
+
+	return *this;
+}
+
+int HiseEventBuffer::getCapacityForBlockSize(int samplesPerBlock)
+{
+	return jmax<int>(HISE_EVENT_BUFFER_SIZE, nextPowerOfTwo(samplesPerBlock) * NumEventsPerSample);
+}
+
+void HiseEventBuffer::setCapacity(int newCapacity)
+{
+	newCapacity = jmax<int>(HISE_EVENT_BUFFER_SIZE, newCapacity);
+
+	if (newCapacity == capacity)
+		return;
+
+	HeapBlock<HiseEvent> newHeapBuffer;
+	HiseEvent* newBuffer = inlineBuffer;
+
+	if (newCapacity > HISE_EVENT_BUFFER_SIZE)
+	{
+		newHeapBuffer.calloc(newCapacity);
+		newBuffer = newHeapBuffer.get();
+
+		sortBuffer.calloc(newCapacity);
+	}
+	else
+	{
+		sortBuffer.free();
+	}
+
+	const int numToKeep = jmin<int>(numUsed, newCapacity);
+
+	numOverflows += numUsed - numToKeep;
+
+	CopyHelpers::copyEvents(newBuffer, buffer, numToKeep);
+
+	if (newBuffer == inlineBuffer)
+		HiseEvent::clear(inlineBuffer + numToKeep, HISE_EVENT_BUFFER_SIZE - numToKeep);
+
+	heapBuffer.swapWith(newHeapBuffer);
+	buffer = newBuffer;
+	capacity = newCapacity;
+	numUsed = numToKeep;
+}
+
 void HiseEventBuffer::clear()
 {
 	if (numUsed != 0)
@@ -377,49 +439,36 @@ void HiseEventBuffer::clear()
 
 void HiseEventBuffer::addEvent(const HiseEvent& hiseEvent)
 {
-	if (numUsed >= HISE_EVENT_BUFFER_SIZE)
+	if (numUsed >= capacity)
 	{
-		// Buffer full..
-		jassertfalse;
+		// Buffer full, the event will be reported as overflow
+		numOverflows++;
 		return;
 	}
 
-	if (numUsed == 0)
+	const int timestamp = hiseEvent.getTimeStamp();
+
+	// Most events are added in order, so check the end first
+	if (numUsed == 0 || buffer[numUsed - 1].getTimeStamp() <= timestamp)
 	{
-		insertEventAtPosition(hiseEvent, 0);
+		buffer[numUsed++] = hiseEvent;
 		return;
 	}
 
-	jassert(numUsed < HISE_EVENT_BUFFER_SIZE);
+	insertEventAtPosition(hiseEvent, getIndexAfterTimestamp(timestamp, 0, numUsed));
 
-    const int numToLookFor = jmin<int>(numUsed, HISE_EVENT_BUFFER_SIZE);
-    
-	for (int i = 0; i < numToLookFor; i++)
-	{
-		const int timestampInBuffer = buffer[i].getTimeStamp();
-		const int messageTimestamp = hiseEvent.getTimeStamp();
-
-		if (timestampInBuffer > messageTimestamp)
-		{
-			insertEventAtPosition(hiseEvent, i);
-
-#if JUCE_DEBUG
-			if (!timeStampsAreSorted())
-			{
-				for (int j = 0; j < numToLookFor; j++)
-					DBG(buffer[j].toDebugString());
-			}
-#endif
-
-			jassert(timeStampsAreSorted());
+	jassert(timeStampsAreSorted());
+}
 
-			return;
-		}
+void HiseEventBuffer::appendEvent(const HiseEvent& hiseEvent)
+{
+	if (numUsed >= capacity)
+	{
+		numOverflows++;
+		return;
 	}
 
-	insertEventAtPosition(hiseEvent, numUsed);
-
-	jassert(timeStampsAreSorted());
+	buffer[numUsed++] = hiseEvent;
 }
 
 void HiseEventBuffer::addEvent(const MidiMessage& midiMessage, int sampleNumber)
@@ -438,32 +487,26 @@ void HiseEventBuffer::addEvents(const MidiBuffer& otherBuffer)
 	MidiMessage m;
 	int samplePos;
 
-	int index = 0;
-
 	MidiBuffer::Iterator it(otherBuffer);
 
 	while (it.getNextEvent(m, samplePos))
 	{
-		jassert(index < HISE_EVENT_BUFFER_SIZE);
-
 		HiseEvent e(m);
 
 		if (e.isEmpty()) continue;
 
-		e.swapWith(buffer[index]);
-
-		buffer[index].setTimeStamp(samplePos);
-
-		numUsed++;
-
-		if (numUsed >= HISE_EVENT_BUFFER_SIZE)
+		if (numUsed >= capacity)
 		{
-			// Buffer full..
-			jassertfalse;
-			return;
+			// Buffer full, the event will be reported as overflow
+			numOverflows++;
+			continue;
 		}
 
-		index++;
+		e.swapWith(buffer[numUsed]);
+
+		buffer[numUsed].setTimeStamp(samplePos);
+
+		numUsed++;
 	}
 
 	jassert(timeStampsAreSorted());
@@ -472,11 +515,16 @@ void HiseEventBuffer::addEvents(const MidiBuffer& otherBuffer)
 
 void HiseEventBuffer::addEvents(const HiseEventBuffer &otherBuffer)
 {
-	Iterator iter(otherBuffer);
+	jassert(&otherBuffer != this);
 
-	while (HiseEvent* e = iter.getNextEventPointer(false, false))
+	if (otherBuffer.timeStampsAreSorted())
 	{
-		addEvent(*e);
+		mergeEvents(otherBuffer.buffer, otherBuffer.numUsed);
+	}
+	else
+	{
+		for (const auto& e : otherBuffer)
+			addEvent(e);
 	}
 
 	jassert(timeStampsAreSorted());
@@ -484,18 +532,48 @@ void HiseEventBuffer::addEvents(const HiseEventBuffer &otherBuffer)
 
 void HiseEventBuffer::sortTimestamps()
 {
-	switch(numUsed)
-	{
-		case 0: 
-		case 1: return;
-		case 2: 
-			if (buffer[1] < buffer[0]) 
-				std::swap(buffer[0], buffer[1]);
-			return;
-		default:
-			std::sort(begin(), end());
-			return;
+	if (timeStampsAreSorted())
+		return;
+
+	// Small buffers are sorted with a binary insertion sort which
+	// is stable and doesn't need any additional memory
+	if (sortBuffer == nullptr || numUsed <= HISE_EVENT_BUFFER_SIZE)
+	{
+		sortRange(0, numUsed);
+		return;
 	}
+
+	// Bigger buffers use a bottom-up merge sort with the buffer that was allocated in setCapacity()
+	static constexpr int RunLength = 32;
+
+	for (int i = 0; i < numUsed; i += RunLength)
+		sortRange(i, jmin<int>(i + RunLength, numUsed));
+
+	auto compareTimestamps = [](const HiseEvent& first, const HiseEvent& second)
+	{
+		return first.getTimeStamp() < second.getTimeStamp();
+	};
+
+	HiseEvent* source = buffer;
+	HiseEvent* destination = sortBuffer.get();
+
+	for (int width = RunLength; width < numUsed; width *= 2)
+	{
+		for (int start = 0; start < numUsed; start += 2 * width)
+		{
+			const int middle = jmin<int>(start + width, numUsed);
+			const int end = jmin<int>(start + 2 * width, numUsed);
+
+			std::merge(source + start, source + middle, source + middle, source + end, destination + start, compareTimestamps);
+		}
+
+		std::swap(source, destination);
+	}
+
+	if (source != buffer)
+		CopyHelpers::copyEvents(buffer, source, numUsed);
+
+	jassert(timeStampsAreSorted());
 }
 
 void HiseEventBuffer::multiplyTimestamps(int factor)
@@ -545,7 +623,7 @@ int HiseEventBuffer::getMaxTimeStamp() const
 
 HiseEvent HiseEventBuffer::getEvent(int index) const
 {
-	if (index >= 0 && index < HISE_EVENT_BUFFER_SIZE)
+	if (index >= 0 && index < capacity)
 	{
 		return buffer[index];
 	}
@@ -559,8 +637,7 @@ hise::HiseEvent HiseEventBuffer::popEvent(int index)
 	{
 		auto e = getEvent(index);
 
-		for (int i = index; i < numUsed; i++)
-			buffer[i] = buffer[i + 1];
+		memmove(buffer + index, buffer + index + 1, sizeof(HiseEvent) * (numUsed - index - 1));
 
 		buffer[numUsed - 1] = {};
 		numUsed--;
@@ -591,30 +668,18 @@ void HiseEventBuffer::moveEventsBelow(HiseEventBuffer& targetBuffer, int highest
 {
 	if (numUsed == 0) return;
 
-	HiseEventBuffer::Iterator iter(*this);
-
-	int numCopied = 0;
-
 	jassert(targetBuffer.timeStampsAreSorted());
 	jassert(timeStampsAreSorted());
 
-	while (HiseEvent* e = iter.getNextEventPointer())
-	{
-		if (e->getTimeStamp() < highestTimestamp)
-		{
-			targetBuffer.addEvent(*e);
-			numCopied++;
-		}
-		else
-		{
-			break;
-		}
-	}
+	const int numCopied = getIndexOfTimestamp(highestTimestamp);
+
+	if (numCopied == 0) return;
+
+	targetBuffer.mergeEvents(buffer, numCopied);
 
 	const int numRemaining = numUsed - numCopied;
 
-	for (int i = 0; i < numRemaining; i++)
-		buffer[i] = buffer[i + numCopied];
+	memmove(buffer, buffer + numCopied, sizeof(HiseEvent) * numRemaining);
 
 	HiseEvent::clear(buffer + numRemaining, numCopied);
 
@@ -629,23 +694,9 @@ void HiseEventBuffer::moveEventsAbove(HiseEventBuffer& targetBuffer, int lowestT
 	if (numUsed == 0 || (buffer[numUsed - 1].getTimeStamp() < lowestTimestamp)) 
 		return; // Skip the work if no events with bigger timestamps
 
-	int indexOfFirstElementToMove = -1;
+	const int indexOfFirstElementToMove = getIndexOfTimestamp(lowestTimestamp);
 
-	for (int i = 0; i < numUsed; i++)
-	{
-		if (buffer[i].getTimeStamp() >= lowestTimestamp)
-		{
-			indexOfFirstElementToMove = i;
-			break;
-		}
-	}
-
-	if (indexOfFirstElementToMove == -1) return;
-
-	for (int i = indexOfFirstElementToMove; i < numUsed; i++)
-	{
-		targetBuffer.addEvent(buffer[i]);
-	}
+	targetBuffer.mergeEvents(buffer + indexOfFirstElementToMove, numUsed - indexOfFirstElementToMove);
 
 	HiseEvent::clear(buffer + indexOfFirstElementToMove, numUsed - indexOfFirstElementToMove);
 
@@ -654,13 +705,13 @@ void HiseEventBuffer::moveEventsAbove(HiseEventBuffer& targetBuffer, int lowestT
 
 void HiseEventBuffer::copyFrom(const HiseEventBuffer& otherBuffer)
 {
-    const int eventsToCopy = jmin<int>(otherBuffer.numUsed, HISE_EVENT_BUFFER_SIZE);
-    
-	memcpy(buffer, otherBuffer.buffer, sizeof(HiseEvent) * eventsToCopy);
+	const int eventsToCopy = jmin<int>(otherBuffer.numUsed, capacity);
 
-	jassert(otherBuffer.numUsed < HISE_EVENT_BUFFER_SIZE);
+	numOverflows += otherBuffer.numUsed - eventsToCopy;
 
-	numUsed = otherBuffer.numUsed;
+	CopyHelpers::copyEvents(buffer, otherBuffer.buffer, eventsToCopy);
+
+	numUsed = eventsToCopy;
 }
 
 
@@ -678,7 +729,7 @@ bool HiseEventBuffer::Iterator::getNextEvent(HiseEvent& b, int &samplePosition,
 		  (skipIgnoredEvents && buffer->buffer[index].isIgnored())))
 	{
 		index++;
-		jassert(index < HISE_EVENT_BUFFER_SIZE);
+		jassert(index < buffer->capacity);
 	}
 		
 	if (index < buffer->numUsed)
@@ -709,7 +760,7 @@ const HiseEvent* HiseEventBuffer::Iterator::getNextConstEventPointer(bool skipIg
 		  (skipIgnoredEvents && buffer->buffer[index].isIgnored())))
 	{
 		index++;
-		jassert(index < HISE_EVENT_BUFFER_SIZE);
+		jassert(index < buffer->capacity);
 	}
 
 	if (index < buffer->numUsed)
@@ -725,32 +776,80 @@ const HiseEvent* HiseEventBuffer::Iterator::getNextConstEventPointer(bool skipIg
 
 void HiseEventBuffer::insertEventAtPosition(const HiseEvent& e, int positionInBuffer)
 {
-	if (numUsed == 0)
+	jassert(numUsed < capacity);
+	jassert(isPositiveAndNotGreaterThan(positionInBuffer, numUsed));
+
+	memmove(buffer + positionInBuffer + 1, buffer + positionInBuffer, sizeof(HiseEvent) * (numUsed - positionInBuffer));
+
+	buffer[positionInBuffer] = HiseEvent(e);
+	numUsed++;
+}
+
+void HiseEventBuffer::mergeEvents(const HiseEvent* eventsToAdd, int numToAdd)
+{
+	if (numToAdd <= 0)
+		return;
+
+	if (numUsed + numToAdd > capacity)
 	{
-		buffer[0] = HiseEvent(e);
-		numUsed = 1;
+		// Add them one by one so that the overflow drops the same events as before
+		for (int i = 0; i < numToAdd; i++)
+			addEvent(eventsToAdd[i]);
 
 		return;
 	}
 
-	if (numUsed > positionInBuffer)
+	// Merge from the back so that no event is overwritten before it was moved
+	int readIndex = numUsed - 1;
+	int addIndex = numToAdd - 1;
+	int writeIndex = numUsed + numToAdd - 1;
+
+	while (addIndex >= 0)
 	{
-		for (int i = jmin<int>(numUsed-1, HISE_EVENT_BUFFER_SIZE-2); i >= positionInBuffer; i--)
-		{
-			jassert(i + 1 < HISE_EVENT_BUFFER_SIZE);
-			buffer[i + 1] = buffer[i];
-		}
+		if (readIndex >= 0 && buffer[readIndex].getTimeStamp() > eventsToAdd[addIndex].getTimeStamp())
+			buffer[writeIndex--] = buffer[readIndex--];
+		else
+			buffer[writeIndex--] = eventsToAdd[addIndex--];
+	}
+
+	numUsed += numToAdd;
+}
+
+void HiseEventBuffer::sortRange(int startIndex, int endIndex)
+{
+	for (int i = startIndex + 1; i < endIndex; i++)
+	{
+		const int timestamp = buffer[i].getTimeStamp();
+
+		if (buffer[i - 1].getTimeStamp() <= timestamp)
+			continue;
+
+		const HiseEvent e = buffer[i];
+		const int insertIndex = getIndexAfterTimestamp(timestamp, startIndex, i);
+
+		memmove(buffer + insertIndex + 1, buffer + insertIndex, sizeof(HiseEvent) * (i - insertIndex));
+		buffer[insertIndex] = e;
 	}
+}
+
+int HiseEventBuffer::getIndexAfterTimestamp(int timestamp, int startIndex, int endIndex) const noexcept
+{
+	auto e = std::upper_bound(buffer + startIndex, buffer + endIndex, timestamp, [](int t, const HiseEvent& other)
+	{
+		return t < other.getTimeStamp();
+	});
 
-    if(positionInBuffer < HISE_EVENT_BUFFER_SIZE)
-    {
-        buffer[positionInBuffer] = HiseEvent(e);
-        numUsed++;
-    }
-    else
-    {
-        jassertfalse;
-    }
+	return (int)(e - buffer);
+}
+
+int HiseEventBuffer::getIndexOfTimestamp(int timestamp) const noexcept
+{
+	auto e = std::lower_bound(buffer, buffer + numUsed, timestamp, [](const HiseEvent& other, int t)
+	{
+		return other.getTimeStamp() < t;
+	});
+
+	return (int)(e - buffer);
 }
 
 EventIdHandler::EventIdHandler(HiseEventBuffer& masterBuffer_) :
@@ -888,8 +987,8 @@ uint16 EventIdHandler::getEventIdForNoteOff(const HiseEvent &noteOffEvent)
 		if (eventId != 0)
 			return eventId;
 
-		else
-			return lastArtificialEventIds[noteOffEvent.getChannel() % 16][noteOffEvent.getNoteNumber()];
+		SpinLock::ScopedLockType sl(artificialEventLock);
+		return lastArtificialEventIds[noteOffEvent.getChannel() % 16][noteOffEvent.getNoteNumber()];
 	}
 }
 
@@ -898,6 +997,8 @@ void EventIdHandler::pushArtificialNoteOn(HiseEvent& noteOnEvent) noexcept
 	jassert(noteOnEvent.isNoteOn());
 	jassert(noteOnEvent.isArtificial());
 
+	SpinLock::ScopedLockType sl(artificialEventLock);
+
 	noteOnEvent.setEventId(currentEventId);
 	artificialEvents[currentEventId % HISE_EVENT_ID_ARRAY_SIZE] = noteOnEvent;
 	lastArtificialEventIds[noteOnEvent.getChannel() % 16][noteOnEvent.getNoteNumber()] = currentEventId;
@@ -909,6 +1010,8 @@ void EventIdHandler::pushArtificialNoteOn(HiseEvent& noteOnEvent) noexcept
 HiseEvent EventIdHandler::popNoteOnFromEventId(uint16 eventId)
 {
 	HiseEvent e;
+
+	SpinLock::ScopedLockType sl(artificialEventLock);
 	e.swapWith(artificialEvents[eventId % HISE_EVENT_ID_ARRAY_SIZE]);
 
 	return e;
@@ -496,15 +496,25 @@ private:
     uint32 timestamp = 0;
 };
 
+/** The default capacity of a HiseEventBuffer. Buffers that need to hold more events can be resized with setCapacity(). */
 #define HISE_EVENT_BUFFER_SIZE 256
 
 /** The buffer type for the HiseEvent.
 
+	The events are always sorted by their timestamp. The buffer starts with an inline storage of
+	HISE_EVENT_BUFFER_SIZE events, but the capacity can be increased in the prepareToPlay() callback
+	so that it can handle dense MIDI streams (MPE, CC automation) from the host.
+
+	If the buffer is full, new events will be dropped and counted in an overflow counter that
+	can be queried (and reported) with getNumOverflows().
 */
 class HiseEventBuffer
 {
 public:
 
+	/** The amount of events per sample that a buffer created with getCapacityForBlockSize() can handle. */
+	static constexpr int NumEventsPerSample = 4;
+
 	/** A simple stack type with 16 slots. */
 	class EventStack
 	{
@@ -610,6 +620,31 @@ public:
 
 	HiseEventBuffer();
 
+	HiseEventBuffer(const HiseEventBuffer& other);
+
+	/** Copies the events from the other buffer. This will only allocate if the other buffer has a bigger capacity. */
+	HiseEventBuffer& operator=(const HiseEventBuffer& other);
+
+	/** Returns the capacity that is required to handle the events of a block with the given size. */
+	static int getCapacityForBlockSize(int samplesPerBlock);
+
+	/** Changes the amount of events this buffer can hold.
+
+		This allocates (unless it goes back to the inline storage), so call it in the prepareToPlay()
+		callback. The capacity will never be smaller than HISE_EVENT_BUFFER_SIZE and if the new capacity
+		is smaller than the number of events in the buffer, the last events will be removed.
+	*/
+	void setCapacity(int newCapacity);
+
+	/** Returns the amount of events this buffer can hold. */
+	int getCapacity() const noexcept { return capacity; }
+
+	/** Returns the number of events that were dropped because the buffer was full. */
+	int getNumOverflows() const noexcept { return numOverflows; }
+
+	/** Resets the overflow counter. Call this after you've reported the dropped events. */
+	void resetOverflowCounter() noexcept { numOverflows = 0; }
+
 	bool operator==(const HiseEventBuffer& other)
 	{
 		if (other.getNumUsed() != numUsed) return false;
@@ -655,13 +690,21 @@ public:
 
 	void copyFrom(const HiseEventBuffer& otherBuffer);
 
+	/** Inserts the event after all events with the same or a smaller timestamp. */
 	void addEvent(const HiseEvent& hiseEvent);
 
+	/** Adds the event at the end of the buffer without keeping the timestamps sorted.
+
+		Use this if you need to add many events at once and call sortTimestamps() before the buffer is processed.
+	*/
+	void appendEvent(const HiseEvent& hiseEvent);
+
 	void addEvent(const MidiMessage& midiMessage, int sampleNumber);
 	void addEvents(const MidiBuffer& otherBuffer);
 
 	void addEvents(const HiseEventBuffer &otherBuffer);
-	
+
+	/** Sorts the events by their timestamp. Events with the same timestamp will keep their order. */
 	void sortTimestamps();
 	
 	void multiplyTimestamps(int factor);
@@ -740,9 +783,32 @@ private:
 
 	void insertEventAtPosition(const HiseEvent& e, int positionInBuffer);
 
-	event_alignment HiseEvent buffer[HISE_EVENT_BUFFER_SIZE];
+	/** Merges the sorted events into this buffer (the new events will be put after existing events with the same timestamp). */
+	void mergeEvents(const HiseEvent* eventsToAdd, int numToAdd);
+
+	/** Sorts the given range with a binary insertion sort. */
+	void sortRange(int startIndex, int endIndex);
+
+	/** Returns the index of the first event in the range with a timestamp bigger than the given timestamp. */
+	int getIndexAfterTimestamp(int timestamp, int startIndex, int endIndex) const noexcept;
+
+	/** Returns the index of the first event with a timestamp equal or bigger than the given timestamp. */
+	int getIndexOfTimestamp(int timestamp) const noexcept;
+
+	event_alignment HiseEvent inlineBuffer[HISE_EVENT_BUFFER_SIZE];
+
+	HeapBlock<HiseEvent> heapBuffer;
+
+	// Used by sortTimestamps() if the capacity was increased
+	HeapBlock<HiseEvent> sortBuffer;
+
+	HiseEvent* buffer = inlineBuffer;
+
+	int capacity = HISE_EVENT_BUFFER_SIZE;
 
 	int numUsed = 0;
+
+	int numOverflows = 0;
 };
 
 #undef event_alignment
@@ -804,6 +870,7 @@ public:
 	/** Checks whether the event ID points to an active artificial event. */
 	bool isArtificialEventId(uint16 eventId) const
 	{
+		SpinLock::ScopedLockType sl(artificialEventLock);
 		return !artificialEvents[eventId % HISE_EVENT_ID_ARRAY_SIZE].isEmpty();
 	}
 
@@ -827,6 +894,10 @@ private:
 	Array<WeakReference<ChokeListener>> chokeListeners;
 
 	const HiseEventBuffer &masterBuffer;
+
+	// The child synths of the root container might be rendered on multiple threads
+	mutable SpinLock artificialEventLock;
+
 	HeapBlock<HiseEvent> artificialEvents;
 	uint16 lastArtificialEventIds[16][128];
 	HiseEvent realNoteOnEvents[16][128];
@@ -66,7 +66,61 @@ void BitCompressors::UnitTests::runTest()
 	testAutomaticCompression(14);
 	testAutomaticCompression(15);
 
+	testDecompressionThroughput(compressor = new OneBit());
+	testDecompressionThroughput(compressor = new TwoBit());
+	testDecompressionThroughput(compressor = new FourBit());
+	testDecompressionThroughput(compressor = new SixBit());
+	testDecompressionThroughput(compressor = new EightBit());
+	testDecompressionThroughput(compressor = new TenBit());
+	testDecompressionThroughput(compressor = new TwelveBit());
+	testDecompressionThroughput(compressor = new FourteenBit());
+}
+
+void BitCompressors::UnitTests::testDecompressionThroughput(Base* compressor)
+{
+	beginTest("Testing decompression throughput with bit rate " + String(compressor->getAllowedBitRange()));
+
+	const int numValues = COMPRESSION_BLOCK_SIZE;
+	const int numIterations = 2000;
+
+	HeapBlock<int16> uncompressedData(numValues);
+	HeapBlock<uint8> compressedData(compressor->getByteAmount(numValues));
+	HeapBlock<int16> scalarData(numValues, true);
+	HeapBlock<int16> decompressedData(numValues, true);
+
+	fillDataWithAllowedBitRange(uncompressedData, numValues, compressor->getAllowedBitRange());
+	compressor->compress(compressedData, uncompressedData, numValues);
+
+	const auto previousInstructionSet = getInstructionSet();
+
+	double scalarSpeed = 0.0;
+
+	for (int i = 0; i <= (int)getBestSupportedInstructionSet(); i++)
+	{
+		const auto s = (InstructionSet)i;
+		setInstructionSet(s);
+
+		auto d = s == InstructionSet::Scalar ? scalarData.get() : decompressedData.get();
+
+		const double start = Time::getMillisecondCounterHiRes();
 
+		for (int j = 0; j < numIterations; j++)
+			compressor->decompress(d, compressedData, numValues);
+
+		const double seconds = (Time::getMillisecondCounterHiRes() - start) / 1000.0;
+		const double megaBytesPerSecond = (double)(numIterations * numValues * sizeof(int16)) / (1024.0 * 1024.0) / jmax(seconds, 0.000001);
+
+		if (s == InstructionSet::Scalar)
+			scalarSpeed = megaBytesPerSecond;
+		else
+			expect(memcmp(scalarData, decompressedData, numValues * sizeof(int16)) == 0, getInstructionSetName(s) + " output doesn't match");
+
+		logMessage(getInstructionSetName(s) + ": " + String(megaBytesPerSecond, 1) + " MB/s (x" + String(megaBytesPerSecond / jmax(scalarSpeed, 0.000001), 2) + ")");
+	}
+
+	setInstructionSet(previousInstructionSet);
+
+	expect(memcmp(scalarData, uncompressedData, numValues * sizeof(int16)) == 0, "Scalar output doesn't match");
 }
 
 void BitCompressors::UnitTests::testAutomaticCompression(uint8 maxBitSize)
@@ -275,6 +329,7 @@ CodecTest::CodecTest() :
 void CodecTest::runTest()
 {
 	testHiseSampleBufferClearing();
+	testParallelEncoding();
 
 	return;
 
@@ -479,6 +534,72 @@ void CodecTest::testHiseSampleBuffer()
 	expectEquals<int>((int)error, 0, "Test HiseSampleBuffer");
 }
 
+void CodecTest::testParallelEncoding()
+{
+	beginTest("Testing parallel encoding");
+
+	const int numSamples = 44100 * 30;
+	const int numChannels = 2;
+	const int chunkSize = 16384;
+
+	auto signal = createTestSignal(numSamples, numChannels, SignalType::DecayingSineWithHarmonic, 0.8f);
+
+	MemoryBlock serialData;
+	HeapBlock<uint32> serialOffsets;
+	serialOffsets.calloc(numSamples / COMPRESSION_BLOCK_SIZE + 1);
+	uint32 numSerialBlocks = 0;
+
+	Array<int> threadAmounts = { 0, 1, 2, 4, 8 };
+
+	if (!threadAmounts.contains(SystemStats::getNumCpus()))
+		threadAmounts.add(SystemStats::getNumCpus());
+
+	for (auto numThreads : threadAmounts)
+	{
+		ScopedPointer<ThreadPool> pool = numThreads > 0 ? new ThreadPool(numThreads) : nullptr;
+
+		MemoryOutputStream mos;
+		HeapBlock<uint32> blockOffsets;
+		blockOffsets.calloc(numSamples / COMPRESSION_BLOCK_SIZE + 1);
+
+		HlacEncoder encoder;
+		encoder.setOptions(options[(int)Option::Diff]);
+		encoder.setChecksumSeed(1234);
+		encoder.setThreadPool(pool);
+
+		const double start = Time::getMillisecondCounterHiRes();
+
+		// Use the same chunk size as AudioFormatWriter::writeFromAudioReader()
+		for (int i = 0; i < numSamples; i += chunkSize)
+		{
+			const int numToDo = jmin(chunkSize, numSamples - i);
+			AudioSampleBuffer chunk(signal.getArrayOfWritePointers(), numChannels, i, numToDo);
+
+			encoder.compress(chunk, mos, blockOffsets);
+		}
+
+		const double seconds = (Time::getMillisecondCounterHiRes() - start) / 1000.0;
+		const double megaBytes = (double)(numSamples * numChannels * sizeof(int16)) / (1024.0 * 1024.0);
+
+		logMessage((numThreads == 0 ? String("Serial") : String(numThreads) + " threads") + ": " + String(megaBytes / jmax(seconds, 0.001), 1) + " MB/s");
+
+		mos.flush();
+
+		if (numThreads == 0)
+		{
+			serialData = mos.getMemoryBlock();
+			numSerialBlocks = encoder.getNumBlocksWritten();
+			memcpy(serialOffsets, blockOffsets, sizeof(uint32) * numSerialBlocks);
+		}
+		else
+		{
+			expect(mos.getMemoryBlock() == serialData, "Data mismatch with " + String(numThreads) + " threads");
+			expectEquals<int>(encoder.getNumBlocksWritten(), numSerialBlocks, "Block amount mismatch");
+			expect(memcmp(serialOffsets, blockOffsets, sizeof(uint32) * numSerialBlocks) == 0, "Block offset mismatch");
+		}
+	}
+}
+
 void CodecTest::testCodec(SignalType type, Option option, bool /*testStereo*/)
 {
 	
@@ -1099,14 +1220,144 @@ public:
 	{
 		beginTest("Testing Archiver");
 
-		int numChannels = 1;
+		using Flag = HlacArchiver::Flag;
 
-		Array<AudioSampleBuffer> buffers;
+		const int numMonoliths = 12;
+		const int length = 44100 * 60;
 
-		for (int i = 0; i < 12; i++)
+		FlacAudioFormat flac;
+		StringPairArray empty;
+
+		Array<MemoryBlock> flacData;
+
+		for (int i = 0; i < numMonoliths; i++)
 		{
-			buffers.add(createTestBuffer(numChannels));
+			auto signal = createTestBuffer(i % 2 + 1, length);
+
+			auto mos = new MemoryOutputStream();
+			ScopedPointer<AudioFormatWriter> writer = flac.createWriterFor(mos, 44100.0, signal.getNumChannels(), 16, empty, 5);
+
+			writer->writeFromAudioSampleBuffer(signal, 0, signal.getNumSamples());
+			writer->flush();
+			flacData.add(mos->getMemoryBlock());
 		}
+
+		// Write the archive in the format of HlacArchiver::compressSampleData(),
+		// the last monolith is split into a second part file.
+
+		TemporaryFile tempDirectory;
+		auto root = tempDirectory.getFile();
+		root.createDirectory();
+
+		auto archiveFile = root.getChildFile("Archive.hr1");
+
+		{
+			ScopedPointer<FileOutputStream> fos = new FileOutputStream(archiveFile);
+
+			auto writeFlag = [&fos](Flag f) { fos->writeInt((int)f); };
+
+			writeFlag(Flag::BeginMetadata);
+			fos->writeString("{}");
+			writeFlag(Flag::EndMetadata);
+
+			for (int i = 0; i < numMonoliths; i++)
+			{
+				const auto& mb = flacData.getReference(i);
+				const bool split = i == numMonoliths - 1;
+				const int64 firstPart = split ? (int64)mb.getSize() / 2 : (int64)mb.getSize();
+
+				writeFlag(Flag::BeginName);
+				fos->writeString("Monolith" + String(i) + ".ch1");
+				writeFlag(Flag::EndName);
+				writeFlag(Flag::BeginTime);
+				fos->writeString(Time::getCurrentTime().toISO8601(true));
+				writeFlag(Flag::EndTime);
+				writeFlag(Flag::BeginMonolithLength);
+				fos->writeInt64(firstPart);
+				writeFlag(Flag::EndMonolithLength);
+				writeFlag(Flag::BeginMonolith);
+				fos->write(mb.getData(), (size_t)firstPart);
+
+				if (split)
+				{
+					writeFlag(Flag::SplitMonolith);
+					fos = nullptr;
+					fos = new FileOutputStream(root.getChildFile("Archive.hr2"));
+
+					writeFlag(Flag::BeginMonolithLength);
+					fos->writeInt64((int64)mb.getSize() - firstPart);
+					writeFlag(Flag::EndMonolithLength);
+					writeFlag(Flag::ResumeMonolith);
+					fos->write(static_cast<const char*>(mb.getData()) + firstPart, mb.getSize() - (size_t)firstPart);
+				}
+
+				writeFlag(Flag::EndMonolith);
+			}
+
+			writeFlag(Flag::EndOfArchive);
+		}
+
+		auto extract = [&](int numThreads)
+		{
+			auto targetDirectory = root.getChildFile("Threads" + String(numThreads));
+			targetDirectory.createDirectory();
+
+			HlacArchiver::DecompressData data;
+			double progress = 0.0, partProgress = 0.0, totalProgress = 0.0;
+
+			data.option = HlacArchiver::OverwriteOption::ForceOverwrite;
+			data.sourceFile = archiveFile;
+			data.targetDirectory = targetDirectory;
+			data.progress = &progress;
+			data.partProgress = &partProgress;
+			data.totalProgress = &totalProgress;
+			data.numThreads = numThreads;
+
+			HlacArchiver archiver(nullptr);
+
+			const double start = Time::getMillisecondCounterHiRes();
+			const bool ok = archiver.extractSampleData(data);
+			const double delta = (Time::getMillisecondCounterHiRes() - start) / 1000.0;
+
+			expect(ok, "Extraction OK");
+			expectEquals(totalProgress, 1.0, "Total progress");
+
+			logMessage("Extraction time with " + String(numThreads) + " threads: " + String(delta, 3) + "s");
+
+			return targetDirectory;
+		};
+
+		auto sequentialDirectory = extract(1);
+		auto parallelDirectory = extract(4);
+
+		HiseLosslessAudioFormat hlac;
+
+		for (int i = 0; i < numMonoliths; i++)
+		{
+			ScopedPointer<AudioFormatReader> flacReader = flac.createReaderFor(new MemoryInputStream(flacData.getReference(i), false), true);
+
+			AudioSampleBuffer reference(flacReader->numChannels, (int)flacReader->lengthInSamples);
+			flacReader->read(&reference, 0, reference.getNumSamples(), 0, true, true);
+
+			for (auto dir : { sequentialDirectory, parallelDirectory })
+			{
+				auto f = dir.getChildFile("Monolith" + String(i) + ".ch1");
+
+				ScopedPointer<AudioFormatReader> hlacReader = hlac.createReaderFor(new FileInputStream(f), true);
+
+				expect(hlacReader != nullptr, "Monolith " + String(i) + " extracted");
+
+				if (hlacReader == nullptr)
+					continue;
+
+				AudioSampleBuffer extracted(reference.getNumChannels(), (int)hlacReader->lengthInSamples);
+				hlacReader->read(&extracted, 0, extracted.getNumSamples(), 0, true, true);
+
+				expectEquals<int>((int)CompressionHelpers::checkBuffersEqual(extracted, reference), 0, "Monolith " + String(i) + " equal");
+			}
+		}
+
+		root.deleteRecursively();
 	}
 	
 
@@ -49,6 +49,8 @@ struct BitCompressors::UnitTests : public UnitTest
 
 	void testAutomaticCompression(uint8 maxBitSize);
 
+	void testDecompressionThroughput(Base* compressor);
+
 };
 
 struct CodecTest : public UnitTest
@@ -87,6 +89,8 @@ struct CodecTest : public UnitTest
 
 	void testNormalisation();
 
+	void testParallelEncoding();
+
 	static AudioSampleBuffer createTestSignal(int numSamples, int numChannels, SignalType type, float maxAmplitude);
 
 	HlacEncoder::CompressorOptions options[(int)Option::numCompressorOptions];